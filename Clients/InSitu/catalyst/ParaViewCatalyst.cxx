@@ -39,6 +39,58 @@
 
 #include "catalyst_impl_paraview.h"
 
+#include <memory>
+
+namespace
+{
+// When pipelines are executed asynchronously, the channels passed to
+// `catalyst_execute` are snapshotted so that the simulation can proceed while
+// they are being processed. Two snapshots are alternated: the one for the
+// current timestep is filled while the pipelines may still be processing the
+// previous one.
+struct ExecuteSnapshot
+{
+  conduit_cpp::Node Channels;
+  conduit_cpp::Node GlobalFields;
+};
+
+struct ExecuteSnapshots
+{
+  ExecuteSnapshot Buffers[2];
+  int Next = 0;
+
+  ExecuteSnapshot& Swap()
+  {
+    auto& snapshot = this->Buffers[this->Next];
+    this->Next = 1 - this->Next;
+    return snapshot;
+  }
+};
+
+std::unique_ptr<ExecuteSnapshots> AsynchronousSnapshots;
+}
+
+static void snapshot_channels(const conduit_cpp::Node& channels, conduit_cpp::Node& snapshot)
+{
+  snapshot.reset();
+  const conduit_index_t nchildren = channels.number_of_children();
+  for (conduit_index_t i = 0; i < nchildren; ++i)
+  {
+    const auto channel_node = channels.child(i);
+    auto target = snapshot[channel_node.name()];
+    conduit_node* source = const_cast<conduit_node*>(conduit_cpp::c_node(&channel_node));
+    if (channel_node.has_path("immutable") && channel_node["immutable"].to_int64() != 0)
+    {
+      // the simulation promised not to touch the buffers; just reference them.
+      conduit_node_set_external_node(conduit_cpp::c_node(&target), source);
+    }
+    else
+    {
+      conduit_node_set_node(conduit_cpp::c_node(&target), source);
+    }
+  }
+}
+
 static bool update_producer_mesh_blueprint(const std::string& channel_name,
   const conduit_cpp::Node* node, const conduit_cpp::Node* global_fields, bool multimesh)
 {
@@ -153,6 +205,10 @@ enum catalyst_error catalyst_initialize_paraview(const conduit_node* params)
 #else
   const vtkTypeUInt64 comm = 0;
 #endif
+  if (cpp_params.has_path("catalyst/async"))
+  {
+    vtkInSituInitializationHelper::SetAsynchronous(cpp_params["catalyst/async"].to_int64() != 0);
+  }
   vtkInSituInitializationHelper::Initialize(comm);
 
   if (cpp_params.has_path("catalyst/scripts"))
@@ -176,6 +232,13 @@ enum catalyst_error catalyst_initialize_paraview(const conduit_node* params)
         {
           ::process_script_args(vtkInSituPipelinePython::SafeDownCast(pipeline), script["args"]);
         }
+
+        // check for optional 'frequency'
+        if (pipeline && script.has_path("frequency"))
+        {
+          vtkInSituInitializationHelper::SetPipelineFrequency(
+            pipeline, script["frequency"].to_int64());
+        }
       }
     }
     else
@@ -213,13 +276,30 @@ enum catalyst_error catalyst_initialize_paraview(const conduit_node* params)
     conduit_index_t nchildren = pipelines.number_of_children();
     for (conduit_index_t i = 0; i < nchildren; ++i)
     {
-      if (auto p = create_precompiled_pipeline(pipelines.child(i)))
+      const auto pipeline = pipelines.child(i);
+      if (auto p = create_precompiled_pipeline(pipeline))
       {
         vtkInSituInitializationHelper::AddPipeline(p);
+        if (pipeline.has_path("frequency"))
+        {
+          vtkInSituInitializationHelper::SetPipelineFrequency(p, pipeline["frequency"].to_int64());
+        }
       }
     }
   }
 
+  // adding Python pipelines disables asynchronous execution.
+  if (vtkInSituInitializationHelper::GetAsynchronous())
+  {
+    vtkVLogF(PARAVIEW_LOG_CATALYST_VERBOSITY(), "Pipelines will be executed asynchronously.");
+    AsynchronousSnapshots.reset(new ExecuteSnapshots());
+  }
+
+  if (cpp_params.has_path("catalyst/time_budget"))
+  {
+    vtkInSituInitializationHelper::SetTimeBudget(cpp_params["catalyst/time_budget"].to_float64());
+  }
+
   if (!cpp_params.has_path("catalyst/scripts") && !cpp_params.has_path("catalyst/pipelines"))
   {
     // no catalyst initialization specified.
@@ -260,12 +340,30 @@ enum catalyst_error catalyst_execute_paraview(const conduit_node* params)
   vtkVLogScopeF(
     PARAVIEW_LOG_CATALYST_VERBOSITY(), "co-processing for timestep=%d, time=%f", timestep, time);
 
-  conduit_cpp::Node globalFields;
+  conduit_cpp::Node localGlobalFields;
+  conduit_cpp::Node* globalFieldsNode = &localGlobalFields;
 
   // catalyst/channels are used to communicate meshes.
   if (root.has_child("channels"))
   {
-    const auto channels = root["channels"];
+    const auto rootChannels = root["channels"];
+    const conduit_cpp::Node* channelsNode = &rootChannels;
+    if (AsynchronousSnapshots)
+    {
+      // take the snapshot before waiting on the previous timestep so that the
+      // copy overlaps with the pipelines still executing.
+      auto& snapshot = AsynchronousSnapshots->Swap();
+      snapshot_channels(rootChannels, snapshot.Channels);
+      snapshot.GlobalFields.reset();
+      channelsNode = &snapshot.Channels;
+      globalFieldsNode = &snapshot.GlobalFields;
+    }
+
+    // producers cannot be updated while pipelines are executing.
+    vtkInSituInitializationHelper::WaitForPipelines();
+
+    const auto& channels = *channelsNode;
+    auto& globalFields = *globalFieldsNode;
     const conduit_index_t nchildren = channels.number_of_children();
     for (conduit_index_t i = 0; i < nchildren; ++i)
     {
@@ -369,6 +467,7 @@ enum catalyst_error catalyst_finalize_paraview(const conduit_node* params)
   }
 
   vtkInSituInitializationHelper::Finalize();
+  AsynchronousSnapshots.reset();
 
   return catalyst_error_ok;
 }
@@ -105,6 +105,12 @@ bool verify(const std::string& protocol, const conduit_cpp::Node& n)
           return false;
         }
       }
+
+      if (script.has_path("frequency") && !script["frequency"].dtype().is_integer())
+      {
+        vtkLogF(ERROR, "'script/%s/frequency' must be an integer.", script.name().c_str());
+        return false;
+      }
     }
     else
     {
@@ -134,6 +140,12 @@ bool verify(const std::string& protocol, const conduit_cpp::Node& n)
     return false;
   }
 
+  if (n.has_child("frequency") && !n["frequency"].dtype().is_integer())
+  {
+    vtkLogF(ERROR, "'frequency' must be an integer.");
+    return false;
+  }
+
   if (n["type"].as_string() == "io")
   {
     if (!n.has_child("filename") || !n["filename"].dtype().is_string())
@@ -229,6 +241,22 @@ bool verify(const std::string& protocol, const conduit_cpp::Node& n)
       return false;
     }
   }
+  if (n.has_child("async"))
+  {
+    if (!n["async"].dtype().is_integer())
+    {
+      vtkLogF(ERROR, "'async' must be an integer.");
+      return false;
+    }
+  }
+  if (n.has_child("time_budget"))
+  {
+    if (!n["time_budget"].dtype().is_number())
+    {
+      vtkLogF(ERROR, "'time_budget' must be a number.");
+      return false;
+    }
+  }
   return true;
 }
 
@@ -323,6 +351,12 @@ bool verify(const std::string& protocol, const conduit_cpp::Node& n)
     return false;
   }
 
+  if (n.has_child("immutable") && !n["immutable"].dtype().is_integer())
+  {
+    vtkLogF(ERROR, "'immutable' must be an integer.");
+    return false;
+  }
+
   auto type = n["type"].as_string();
   if (type == "mesh")
   {
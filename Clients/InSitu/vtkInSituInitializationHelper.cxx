@@ -17,6 +17,7 @@
 #include "vtkArrayDispatch.h"
 #include "vtkCPCxxHelper.h"
 #include "vtkCallbackCommand.h"
+#include "vtkCommunicator.h"
 #include "vtkConduitSource.h"
 #include "vtkDataArrayAccessor.h"
 #include "vtkFieldData.h"
@@ -40,8 +41,15 @@
 #include "vtkSteeringDataGenerator.h"
 
 #include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <functional>
 #include <map>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <utility>
 
 #if VTK_MODULE_ENABLE_ParaView_PythonCatalyst
 extern "C" {
@@ -53,6 +61,12 @@ void vtkPVInitializePythonModules();
 #include "vtkMPI.h"
 #include "vtkMPICommunicator.h"
 #include "vtkMPIController.h"
+
+namespace
+{
+// communicator duplicated for asynchronous execution, if any.
+MPI_Comm AsynchronousComm = MPI_COMM_NULL;
+}
 #endif
 
 // #include "ParaView_paraview_plugins.h"
@@ -63,9 +77,19 @@ public:
   struct PipelineInfo
   {
     vtkSmartPointer<vtkInSituPipeline> Pipeline;
-    bool Initialized;
-    bool InitializationFailed;
-    bool ExecuteFailed;
+    bool Initialized = false;
+    bool InitializationFailed = false;
+    bool ExecuteFailed = false;
+
+    // scheduling state.
+    int Frequency = 1;
+    double Cost = -1.0;
+    int Deferred = 0;
+
+    PipelineInfo(vtkInSituPipeline* pipeline)
+      : Pipeline(pipeline)
+    {
+    }
   };
 
   vtkSmartPointer<vtkCPCxxHelper> CPCxxHelper;
@@ -76,8 +100,133 @@ public:
   bool InExecutePipelines = false;
   int TimeStep = 0;
   double Time = 0.0;
+  double TimeBudget = 0.0;
+
+  // thread used to execute pipelines asynchronously.
+  std::thread Worker;
+  std::mutex WorkerMutex;
+  std::condition_variable WorkerCondition;
+  std::function<void()> Task;
+  bool Busy = false;
+  bool Terminate = false;
+
+  ~vtkInternals() { this->StopWorker(); }
+
+  bool IsWorkerThread() const { return std::this_thread::get_id() == this->Worker.get_id(); }
+
+  /**
+   * Hands off `task` to the worker thread, starting the thread if needed.
+   * The worker must be idle, see `Wait`.
+   */
+  void Dispatch(std::function<void()> task)
+  {
+    if (!this->Worker.joinable())
+    {
+      this->Worker = std::thread([this]() { this->WorkerLoop(); });
+    }
+    {
+      std::lock_guard<std::mutex> lock(this->WorkerMutex);
+      this->Task = std::move(task);
+      this->Busy = true;
+    }
+    this->WorkerCondition.notify_all();
+  }
+
+  /**
+   * Blocks until the task dispatched to the worker thread, if any, is done.
+   * This is a no-op when called on the worker thread itself.
+   */
+  void Wait()
+  {
+    if (!this->Worker.joinable() || this->IsWorkerThread())
+    {
+      return;
+    }
+    std::unique_lock<std::mutex> lock(this->WorkerMutex);
+    this->WorkerCondition.wait(lock, [this]() { return !this->Busy; });
+  }
+
+  void StopWorker()
+  {
+    if (!this->Worker.joinable())
+    {
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(this->WorkerMutex);
+      this->Terminate = true;
+    }
+    this->WorkerCondition.notify_all();
+    this->Worker.join();
+  }
+
+  void WorkerLoop()
+  {
+    vtkLogger::SetThreadName("catalyst");
+    std::unique_lock<std::mutex> lock(this->WorkerMutex);
+    while (true)
+    {
+      this->WorkerCondition.wait(lock, [this]() { return this->Terminate || this->Task; });
+      if (!this->Task)
+      {
+        return;
+      }
+      auto task = std::move(this->Task);
+      this->Task = nullptr;
+      lock.unlock();
+      task();
+      lock.lock();
+      this->Busy = false;
+      this->WorkerCondition.notify_all();
+    }
+  }
+
+  PipelineInfo* FindPipeline(vtkInSituPipeline* pipeline)
+  {
+    for (auto& item : this->Pipelines)
+    {
+      if (item.Pipeline == pipeline)
+      {
+        return &item;
+      }
+    }
+    return nullptr;
+  }
+
+  /**
+   * Reduces the pipeline cost estimates across all ranks so that scheduling
+   * decisions are consistent on all ranks. This must be called once all
+   * scheduling decisions for a timestep have been made.
+   */
+  void SynchronizeCosts()
+  {
+    auto controller = vtkMultiProcessController::GetGlobalController();
+    if (controller == nullptr || controller->GetNumberOfProcesses() <= 1 ||
+      this->Pipelines.empty())
+    {
+      return;
+    }
+
+    std::vector<double> costs(this->Pipelines.size());
+    std::transform(this->Pipelines.begin(), this->Pipelines.end(), costs.begin(),
+      [](const PipelineInfo& item) { return item.Cost; });
+    std::vector<double> result(costs.size());
+    controller->AllReduce(
+      costs.data(), result.data(), static_cast<vtkIdType>(costs.size()), vtkCommunicator::MAX_OP);
+    for (size_t cc = 0; cc < result.size(); ++cc)
+    {
+      this->Pipelines[cc].Cost = result[cc];
+    }
+  }
 };
 
+namespace
+{
+// weight given to the most recent measurement in the running average of a
+// pipeline's cost.
+constexpr double CostSmoothingFactor = 0.25;
+}
+
 template <typename PropertyType>
 struct PropertyCopier
 {
@@ -114,6 +263,7 @@ void SetPropertyValue(T* prop, vtkDataArray* array)
 
 int vtkInSituInitializationHelper::WasInitializedOnce;
 int vtkInSituInitializationHelper::WasFinalizedOnce;
+bool vtkInSituInitializationHelper::Asynchronous = false;
 vtkInSituInitializationHelper::vtkInternals* vtkInSituInitializationHelper::Internals;
 //----------------------------------------------------------------------------
 vtkInSituInitializationHelper::vtkInSituInitializationHelper() = default;
@@ -130,6 +280,26 @@ void vtkInSituInitializationHelper::Initialize(vtkTypeUInt64 comm)
       PARAVIEW_LOG_CATALYST_VERBOSITY(), "Initializing MPI communicator using 'comm' (%llu)", comm);
     // convert comm to MPI handle.
     MPI_Comm mpicomm = MPI_Comm_f2c(comm);
+    if (vtkInSituInitializationHelper::Asynchronous && AsynchronousComm == MPI_COMM_NULL)
+    {
+      int size = 1;
+      int provided = MPI_THREAD_SINGLE;
+      MPI_Comm_size(mpicomm, &size);
+      MPI_Query_thread(&provided);
+      if (size > 1 && provided < MPI_THREAD_MULTIPLE)
+      {
+        vtkLogF(WARNING, "Asynchronous execution requires MPI to be initialized with "
+                         "'MPI_THREAD_MULTIPLE'. Pipelines will be executed synchronously.");
+        vtkInSituInitializationHelper::Asynchronous = false;
+      }
+      else
+      {
+        // pipelines communicate while the simulation may be communicating too;
+        // use a separate communicator so the messages cannot get mixed up.
+        MPI_Comm_dup(mpicomm, &AsynchronousComm);
+        mpicomm = AsynchronousComm;
+      }
+    }
     vtkMPICommunicatorOpaqueComm opaqueComm(&mpicomm);
     vtkNew<vtkMPICommunicator> mpiCommunicator;
     mpiCommunicator->InitializeExternal(&opaqueComm);
@@ -198,18 +368,41 @@ void vtkInSituInitializationHelper::Finalize()
   }
 
   // finalize pipelines.
-  const auto& internals = (*vtkInSituInitializationHelper::Internals);
-  for (auto& item : internals.Pipelines)
-  {
-    if (item.Initialized && !item.InitializationFailed)
+  auto& internals = (*vtkInSituInitializationHelper::Internals);
+  auto finalizePipelines = [&internals]() {
+    for (auto& item : internals.Pipelines)
     {
-      item.Pipeline->Finalize();
+      if (item.Initialized && !item.InitializationFailed)
+      {
+        item.Pipeline->Finalize();
+      }
     }
+  };
+
+  internals.Wait();
+  if (internals.Worker.joinable())
+  {
+    // pipelines were initialized and executed on the worker thread; finalize
+    // them there as well.
+    internals.Dispatch(finalizePipelines);
+    internals.Wait();
+    internals.StopWorker();
+  }
+  else
+  {
+    finalizePipelines();
   }
 
   vtkInSituInitializationHelper::WasFinalizedOnce = 1;
   delete vtkInSituInitializationHelper::Internals;
   vtkInSituInitializationHelper::Internals = nullptr;
+
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+  if (AsynchronousComm != MPI_COMM_NULL)
+  {
+    MPI_Comm_free(&AsynchronousComm);
+  }
+#endif
 }
 
 //----------------------------------------------------------------------------
@@ -246,7 +439,20 @@ void vtkInSituInitializationHelper::AddPipeline(vtkInSituPipeline* pipeline)
   if (pipeline)
   {
     auto& internals = (*vtkInSituInitializationHelper::Internals);
-    internals.Pipelines.push_back(vtkInternals::PipelineInfo{ pipeline, false, false, false });
+    internals.Wait();
+#if VTK_MODULE_ENABLE_ParaView_PythonCatalyst
+    if (vtkInSituInitializationHelper::Asynchronous &&
+      vtkInSituPipelinePython::SafeDownCast(pipeline) != nullptr)
+    {
+      // Python pipelines would need the GIL on the worker thread, while the
+      // simulation thread holds it and may itself be executing Python code.
+      vtkLogF(WARNING, "Asynchronous execution is not supported with Python pipelines. "
+                       "Pipelines will be executed synchronously.");
+      vtkInSituInitializationHelper::Asynchronous = false;
+      internals.StopWorker();
+    }
+#endif
+    internals.Pipelines.push_back(vtkInternals::PipelineInfo(pipeline));
   }
 }
 
@@ -268,6 +474,7 @@ void vtkInSituInitializationHelper::SetProducer(
   }
 
   auto& internals = (*vtkInSituInitializationHelper::Internals);
+  internals.Wait();
   if (internals.Producers.find(channelName) != internals.Producers.end())
   {
     vtkLogF(
@@ -327,6 +534,7 @@ void vtkInSituInitializationHelper::MarkProducerModified(vtkSMSourceProxy* produ
     return;
   }
 
+  vtkInSituInitializationHelper::Internals->Wait();
   producer->UpdateVTKObjects();
   if (auto obj = vtkObject::SafeDownCast(producer->GetClientSideObject()))
   {
@@ -347,18 +555,44 @@ bool vtkInSituInitializationHelper::ExecutePipelines(
   }
 
   auto& internals = (*vtkInSituInitializationHelper::Internals);
+
+  // block until the previous asynchronous execution, if any, is done.
+  internals.Wait();
   if (internals.InExecutePipelines)
   {
     vtkLogF(ERROR, "Recursive call to 'ExecutePipelines' not supported!");
     return false;
   }
 
+  if (vtkInSituInitializationHelper::Asynchronous)
+  {
+    vtkVLogF(PARAVIEW_LOG_CATALYST_VERBOSITY(),
+      "executing pipelines asynchronously for timestep=%d, time=%f", timestep, time);
+    internals.InExecutePipelines = true;
+    internals.Dispatch([timestep, time, parameters]() {
+      vtkInSituInitializationHelper::ExecutePipelinesInternal(timestep, time, parameters);
+    });
+    return true;
+  }
+
   internals.InExecutePipelines = true;
+  vtkInSituInitializationHelper::ExecutePipelinesInternal(timestep, time, parameters);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkInSituInitializationHelper::ExecutePipelinesInternal(
+  int timestep, double time, const std::vector<std::string>& parameters)
+{
+  auto& internals = (*vtkInSituInitializationHelper::Internals);
   internals.TimeStep = timestep;
   internals.Time = time;
 
   UpdateSteerableProxies();
 
+  // Pick the pipelines to execute on this timestep. Pipelines are initialized
+  // on the first call irrespective of their frequency.
+  std::vector<vtkInternals::PipelineInfo*> scheduled;
   for (auto& item : internals.Pipelines)
   {
     if (!item.Initialized)
@@ -367,23 +601,126 @@ bool vtkInSituInitializationHelper::ExecutePipelines(
       item.Initialized = true;
     }
 
-    if (!item.InitializationFailed && !item.ExecuteFailed)
+    // If `Initialize` failed, don't call `Execute` on the Pipeline.
+    // If Execute fails even once, we no longer call Execute on this pipeline
+    // in subsequent calls to `ExecutePipelines`.
+    if (item.InitializationFailed || item.ExecuteFailed)
     {
-      // set the execute parameters for this pipeline
-      auto pipeline = vtkInSituPipelinePython::SafeDownCast(item.Pipeline);
-      if (pipeline)
+      continue;
+    }
+
+    if (item.Frequency > 1 && timestep % item.Frequency != 0)
+    {
+      vtkVLogF(PARAVIEW_LOG_CATALYST_VERBOSITY(), "skipping %s (frequency=%d)",
+        vtkLogIdentifier(item.Pipeline), item.Frequency);
+      continue;
+    }
+    scheduled.push_back(&item);
+  }
+
+  // Cost estimates are identical on all ranks, see `SynchronizeCosts`, hence so
+  // are the scheduling decisions below.
+  const double budget = internals.TimeBudget;
+  if (budget > 0)
+  {
+    // Pipelines that have been deferred the longest go first; otherwise
+    // pipelines are executed in the order they were added.
+    std::stable_sort(scheduled.begin(), scheduled.end(),
+      [](const vtkInternals::PipelineInfo* a, const vtkInternals::PipelineInfo* b) {
+        return a->Deferred > b->Deferred;
+      });
+  }
+
+  double estimated = 0.0;
+  double elapsed = 0.0;
+  int executed = 0;
+  std::vector<std::pair<vtkInternals::PipelineInfo*, double> > measured;
+  for (auto item : scheduled)
+  {
+    if (budget > 0 && item->Cost > 0)
+    {
+      // A pipeline that does not fit in the remaining budget is deferred. If
+      // it cannot fit in the budget at all, it is executed once every
+      // `ceil(cost / budget)` timesteps, instead.
+      const bool fits = (estimated + item->Cost) <= budget;
+      const bool overdue =
+        item->Cost > budget && (item->Deferred + 1) >= std::ceil(item->Cost / budget);
+      if (!fits && !overdue)
+      {
+        ++item->Deferred;
+        vtkVLogF(PARAVIEW_LOG_CATALYST_VERBOSITY(),
+          "deferring %s (estimated cost=%gs, remaining budget=%gs, deferred=%d)",
+          vtkLogIdentifier(item->Pipeline), item->Cost, std::max(budget - estimated, 0.0),
+          item->Deferred);
+        continue;
+      }
+      if (!fits)
       {
-        pipeline->SetParameters(parameters);
+        vtkVLogF(PARAVIEW_LOG_CATALYST_VERBOSITY(),
+          "executing %s even though it exceeds the budget (estimated cost=%gs, deferred=%d)",
+          vtkLogIdentifier(item->Pipeline), item->Cost, item->Deferred);
       }
-      // If `Initialize` failed, don't call `Execute` on the Pipeline.
-      // If Execute fails even once, we no longer call Execute on this pipeline
-      // in subsequent calls to `ExecutePipelines`.
-      item.ExecuteFailed = !item.Pipeline->Execute(timestep, time);
     }
+
+    // set the execute parameters for this pipeline
+    auto pipeline = vtkInSituPipelinePython::SafeDownCast(item->Pipeline);
+    if (pipeline)
+    {
+      pipeline->SetParameters(parameters);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    item->ExecuteFailed = !item->Pipeline->Execute(timestep, time);
+    const double cost =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // the time measured on this rank must not affect the remaining decisions
+    // for this timestep, lest ranks execute different pipelines.
+    measured.emplace_back(item, cost);
+    item->Deferred = 0;
+    estimated += std::max(item->Cost, 0.0);
+    elapsed += cost;
+    ++executed;
+  }
+
+  for (const auto& pair : measured)
+  {
+    auto item = pair.first;
+    const double cost = pair.second;
+    item->Cost = item->Cost < 0 ? cost : item->Cost + CostSmoothingFactor * (cost - item->Cost);
   }
+  internals.SynchronizeCosts();
+
+  vtkVLogF(PARAVIEW_LOG_CATALYST_VERBOSITY(), "executed %d of %d pipelines in %gs (budget=%gs)",
+    executed, static_cast<int>(internals.Pipelines.size()), elapsed, budget);
 
   internals.InExecutePipelines = false;
-  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkInSituInitializationHelper::WaitForPipelines()
+{
+  if (vtkInSituInitializationHelper::Internals != nullptr)
+  {
+    vtkInSituInitializationHelper::Internals->Wait();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkInSituInitializationHelper::SetAsynchronous(bool value)
+{
+  if (vtkInSituInitializationHelper::WasInitializedOnce)
+  {
+    vtkLogF(WARNING, "'SetAsynchronous' must be called before 'Initialize'. Ignoring.");
+    return;
+  }
+  vtkInSituInitializationHelper::Asynchronous = value;
+}
+
+//----------------------------------------------------------------------------
+bool vtkInSituInitializationHelper::GetAsynchronous()
+{
+  return vtkInSituInitializationHelper::Asynchronous;
 }
 
 //----------------------------------------------------------------------------
@@ -552,6 +889,7 @@ void vtkInSituInitializationHelper::UpdateAllProducers(double time)
   vtkVLogScopeF(PARAVIEW_LOG_CATALYST_VERBOSITY(), "Updating all producer (time=%f)", time);
 
   auto& internals = (*vtkInSituInitializationHelper::Internals);
+  internals.Wait();
   for (const auto& pair : internals.Producers)
   {
     vtkVLogF(PARAVIEW_LOG_CATALYST_VERBOSITY(), "updating producer '%s'", pair.first.c_str());
@@ -597,6 +935,88 @@ double vtkInSituInitializationHelper::GetTime()
   return internals.Time;
 }
 
+//----------------------------------------------------------------------------
+void vtkInSituInitializationHelper::SetPipelineFrequency(
+  vtkInSituPipeline* pipeline, int frequency)
+{
+  if (vtkInSituInitializationHelper::Internals == nullptr)
+  {
+    vtkLogF(ERROR, "'SetPipelineFrequency' cannot be called before 'Initialize'.");
+    return;
+  }
+
+  auto& internals = (*vtkInSituInitializationHelper::Internals);
+  internals.Wait();
+  auto item = internals.FindPipeline(pipeline);
+  if (item == nullptr)
+  {
+    vtkLogF(ERROR, "Unknown pipeline passed to 'SetPipelineFrequency'.");
+    return;
+  }
+
+  if (frequency < 1)
+  {
+    vtkLogF(WARNING, "Invalid frequency (%d) specified. Using 1 instead.", frequency);
+    frequency = 1;
+  }
+  item->Frequency = frequency;
+}
+
+//----------------------------------------------------------------------------
+int vtkInSituInitializationHelper::GetPipelineFrequency(vtkInSituPipeline* pipeline)
+{
+  if (vtkInSituInitializationHelper::Internals == nullptr)
+  {
+    vtkLogF(ERROR, "'GetPipelineFrequency' cannot be called before 'Initialize'.");
+    return 0;
+  }
+
+  auto& internals = (*vtkInSituInitializationHelper::Internals);
+  auto item = internals.FindPipeline(pipeline);
+  return item ? item->Frequency : 0;
+}
+
+//----------------------------------------------------------------------------
+double vtkInSituInitializationHelper::GetPipelineCost(vtkInSituPipeline* pipeline)
+{
+  if (vtkInSituInitializationHelper::Internals == nullptr)
+  {
+    vtkLogF(ERROR, "'GetPipelineCost' cannot be called before 'Initialize'.");
+    return -1.0;
+  }
+
+  auto& internals = (*vtkInSituInitializationHelper::Internals);
+  internals.Wait();
+  auto item = internals.FindPipeline(pipeline);
+  return item ? item->Cost : -1.0;
+}
+
+//----------------------------------------------------------------------------
+void vtkInSituInitializationHelper::SetTimeBudget(double seconds)
+{
+  if (vtkInSituInitializationHelper::Internals == nullptr)
+  {
+    vtkLogF(ERROR, "'SetTimeBudget' cannot be called before 'Initialize'.");
+    return;
+  }
+
+  auto& internals = (*vtkInSituInitializationHelper::Internals);
+  internals.Wait();
+  internals.TimeBudget = std::max(seconds, 0.0);
+}
+
+//----------------------------------------------------------------------------
+double vtkInSituInitializationHelper::GetTimeBudget()
+{
+  if (vtkInSituInitializationHelper::Internals == nullptr)
+  {
+    vtkLogF(ERROR, "'GetTimeBudget' cannot be called before 'Initialize'.");
+    return 0.0;
+  }
+
+  return vtkInSituInitializationHelper::Internals->TimeBudget;
+}
+
 //----------------------------------------------------------------------------
 bool vtkInSituInitializationHelper::IsPythonSupported()
 {
@@ -620,6 +1040,7 @@ void vtkInSituInitializationHelper::GetSteerableProxies(
   if (vtkInSituInitializationHelper::Internals != nullptr)
   {
     auto internals = vtkInSituInitializationHelper::Internals;
+    internals->Wait();
     proxies.reserve(proxies.size() + internals->SteerableProxies.size());
     for (auto& proxy : internals->SteerableProxies)
     {
@@ -640,6 +1061,7 @@ void vtkInSituInitializationHelper::UpdateSteerableParameters(
   if (vtkInSituInitializationHelper::Internals != nullptr)
   {
     auto internals = vtkInSituInitializationHelper::Internals;
+    internals->Wait();
 
     auto it = internals->SteerableProxies.lower_bound(steerableProxy);
     if (it == internals->SteerableProxies.end() || it->first != steerableProxy)
@@ -123,11 +123,75 @@ public:
   //@}
 
   /**
-   * Executes pipelines.
+   * Executes pipelines. When executing asynchronously, this returns as soon as
+   * the pipelines have been handed off to the worker thread.
    */
   static bool ExecutePipelines(
     int timestep, double time, const std::vector<std::string>& parameters = {});
 
+  //@{
+  /**
+   * Set/Get whether pipelines are executed asynchronously. When enabled, all
+   * pipelines are initialized, executed and finalized on a dedicated thread
+   * and `ExecutePipelines` only blocks if the previous execution is still in
+   * flight. Hence, the data produced for a timestep must remain valid until
+   * the next call to `ExecutePipelines` or `Finalize` returns.
+   *
+   * This must be set before `Initialize`. In MPI-enabled builds, asynchronous
+   * execution requires MPI to be initialized with `MPI_THREAD_MULTIPLE` when
+   * running on more than one rank; otherwise pipelines are executed
+   * synchronously. Pipelines use a duplicate of the communicator passed to
+   * `Initialize` so that their communication cannot interfere with that of
+   * the simulation.
+   *
+   * Python pipelines are not supported: adding one disables asynchronous
+   * execution. Default is false.
+   */
+  static void SetAsynchronous(bool value);
+  static bool GetAsynchronous();
+  //@}
+
+  /**
+   * Blocks until the pipelines being executed asynchronously, if any, are
+   * done. Methods on this class that affect the pipelines or the producers
+   * call this implicitly.
+   */
+  static void WaitForPipelines();
+
+  //@{
+  /**
+   * Set/Get how often a pipeline is executed. A pipeline with frequency `N` is
+   * only executed on timesteps that are a multiple of `N`. Default is 1 i.e.
+   * the pipeline is executed on every call to `ExecutePipelines`.
+   */
+  static void SetPipelineFrequency(vtkInSituPipeline* pipeline, int frequency);
+  static int GetPipelineFrequency(vtkInSituPipeline* pipeline);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the wall-clock budget, in seconds, for a single `ExecutePipelines`
+   * call. When positive, the measured cost of each pipeline is used to skip
+   * pipelines that would not fit within the remaining budget. Skipped
+   * pipelines are given priority on the following timesteps and a pipeline
+   * that alone costs more than the budget is decimated such that its cost,
+   * amortized over the timesteps, stays within the budget.
+   *
+   * In distributed runs, the costs are reduced across all ranks so that every
+   * rank makes the same decisions. Hence, the same budget must be used on all
+   * ranks. Default is 0 i.e. no budget.
+   */
+  static void SetTimeBudget(double seconds);
+  static double GetTimeBudget();
+  //@}
+
+  /**
+   * Returns the estimated cost, in seconds, for executing the pipeline. This is
+   * a running average of the measured execution times. Returns a negative
+   * value if the pipeline has not been executed yet.
+   */
+  static double GetPipelineCost(vtkInSituPipeline* pipeline);
+
   //@{
   /**
    * Provides access to current time and timestep during `ExecutePipelines`
@@ -161,10 +225,13 @@ private:
   void operator=(const vtkInSituInitializationHelper&) = delete;
 
   static void UpdateSteerableProxies();
+  static void ExecutePipelinesInternal(
+    int timestep, double time, const std::vector<std::string>& parameters);
   static int GetAttributeTypeFromString(const std::string& associationString);
 
   static int WasInitializedOnce;
   static int WasFinalizedOnce;
+  static bool Asynchronous;
 
   class vtkInternals;
   static vtkInternals* Internals;
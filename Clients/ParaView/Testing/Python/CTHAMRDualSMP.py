@@ -0,0 +1,95 @@
+#!/usr/bin/env python
+
+# Checks that the AMR Dual Contour and AMR Dual Clip filters generate the same
+# output whether the blocks of each level are processed in parallel or one
+# after the other, and reports the time taken in both cases.
+
+import os
+import re
+import sys
+import time
+
+from paraview.simple import *
+from paraview import smtesting
+from paraview.vtk import vtkMultiBlockDataSet
+
+smtesting.ProcessCommandLineArguments()
+
+fname = os.path.join(smtesting.DataDir, "Testing/Data/SPCTH/Dave_Karelitz_Small/spcth_a")
+reader = SpyPlotReader(FileName=fname)
+reader.UpdatePipelineInformation()
+# as in the CTHAMRContour and CTHAMRDualClip tests, only the first material
+# is processed.
+materials = [name for name in reader.CellArrayInfo[::2]
+             if re.search("[vV]olume [fF]raction", name)][:1]
+if not materials:
+    print("ERROR: no volume fraction arrays in %s" % fname)
+    sys.exit(1)
+reader.CellArrayStatus = materials
+reader.UpdatePipeline()
+
+def getLeaves(dobj):
+    leaves = []
+    iterator = dobj.NewIterator()
+    iterator.InitTraversal()
+    while not iterator.IsDoneWithTraversal():
+        leaves.append(iterator.GetCurrentDataObject())
+        iterator.GoToNextItem()
+    return leaves
+
+def run(proxy, parallel):
+    algo = proxy.GetClientSideObject()
+    algo.SetEnableParallelBlocks(parallel)
+    start = time.time()
+    proxy.UpdatePipeline()
+    elapsed = time.time() - start
+    output = vtkMultiBlockDataSet()
+    output.DeepCopy(algo.GetOutputDataObject(0))
+    return output, elapsed
+
+def compare(name, serial, parallel):
+    serialLeaves = getLeaves(serial)
+    parallelLeaves = getLeaves(parallel)
+    if len(serialLeaves) != len(parallelLeaves):
+        print("ERROR: %s: different number of blocks" % name)
+        return False
+    numberOfPoints = 0
+    for expected, actual in zip(serialLeaves, parallelLeaves):
+        if expected.GetNumberOfPoints() != actual.GetNumberOfPoints() or \
+           expected.GetNumberOfCells() != actual.GetNumberOfCells():
+            print("ERROR: %s: %d points and %d cells, expected %d points and %d cells" %
+                (name, actual.GetNumberOfPoints(), actual.GetNumberOfCells(),
+                 expected.GetNumberOfPoints(), expected.GetNumberOfCells()))
+            return False
+        for ptId in range(expected.GetNumberOfPoints()):
+            if expected.GetPoint(ptId) != actual.GetPoint(ptId):
+                print("ERROR: %s: point %d differs" % (name, ptId))
+                return False
+        for cellId in range(expected.GetNumberOfCells()):
+            expectedIds = expected.GetCell(cellId).GetPointIds()
+            actualIds = actual.GetCell(cellId).GetPointIds()
+            if [expectedIds.GetId(i) for i in range(expectedIds.GetNumberOfIds())] != \
+               [actualIds.GetId(i) for i in range(actualIds.GetNumberOfIds())]:
+                print("ERROR: %s: cell %d differs" % (name, cellId))
+                return False
+        numberOfPoints += expected.GetNumberOfPoints()
+    if numberOfPoints == 0:
+        print("ERROR: %s: empty output" % name)
+        return False
+    return True
+
+success = True
+filters = [("AMRDualContour", AMRContour(Input=reader)),
+           ("AMRDualClip", AMRDualClip(Input=reader))]
+for name, proxy in filters:
+    proxy.SelectMaterialArrays = materials
+    serial, serialTime = run(proxy, 0)
+    parallel, parallelTime = run(proxy, 1)
+    print('<DartMeasurement name="%sSerialTime" type="numeric/double">%f</DartMeasurement>' %
+        (name, serialTime))
+    print('<DartMeasurement name="%sParallelTime" type="numeric/double">%f</DartMeasurement>' %
+        (name, parallelTime))
+    success = compare(name, serial, parallel) and success
+
+if not success:
+    sys.exit(1)
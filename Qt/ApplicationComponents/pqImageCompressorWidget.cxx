@@ -42,7 +42,8 @@ static const int NO_COMPRESSION = 0;
 static const int LZ4_COMPRESSION = 1;
 static const int SQUIRT_COMPRESSION = 2;
 static const int ZLIB_COMPRESSION = 3;
-static const int NVPIPE_COMPRESSION = 4;
+static const int LZ4_DELTA_COMPRESSION = 4;
+static const int NVPIPE_COMPRESSION = 5;
 //-----------------------------------------------------------------------------
 
 class pqImageCompressorWidget::pqInternals
@@ -75,6 +76,7 @@ pqImageCompressorWidget::pqImageCompressorWidget(
   this->connect(
     ui.compressionType, SIGNAL(currentIndexChanged(int)), SIGNAL(compressorConfigChanged()));
   this->connect(ui.squirtColorSpace, SIGNAL(valueChanged(int)), SIGNAL(compressorConfigChanged()));
+  this->connect(ui.useStrips, SIGNAL(stateChanged(int)), SIGNAL(compressorConfigChanged()));
   this->connect(ui.zlibColorSpace, SIGNAL(valueChanged(int)), SIGNAL(compressorConfigChanged()));
   this->connect(ui.zlibLevel, SIGNAL(valueChanged(int)), SIGNAL(compressorConfigChanged()));
   this->connect(ui.zlibStripAlpha, SIGNAL(stateChanged(int)), SIGNAL(compressorConfigChanged()));
@@ -101,10 +103,11 @@ void pqImageCompressorWidget::setCompressorConfig(const QString& value)
   // Need to fix it.
   Ui::ImageCompressorWidget& ui = this->Internals->Ui;
   QRegExp squirtRegExp("^vtkSquirtCompressor"
-                       "\\s+"     // space
-                       "0"        // 0
-                       "\\s+"     // space
-                       "([0-9]+)" // num-of-bits.
+                       "\\s+"            // space
+                       "0"               // 0
+                       "\\s+"            // space
+                       "([0-9]+)"        // num-of-bits.
+                       "(?:\\s+([01]))?" // use strips (0 or 1), optional.
                        "$");
   QRegExp zlibRegExp("^vtkZlibImageCompressor"
                      "\\s+"
@@ -117,11 +120,18 @@ void pqImageCompressorWidget::setCompressorConfig(const QString& value)
                      "([01])" // strip alpha (0 or 1).
                      "$");
   QRegExp lz4RegExp("^vtkLZ4Compressor"
-                    "\\s+"     // space
-                    "0"        // 0
-                    "\\s+"     // space
-                    "([0-9]+)" // num-of-bits.
+                    "\\s+"            // space
+                    "0"               // 0
+                    "\\s+"            // space
+                    "([0-9]+)"        // num-of-bits.
+                    "(?:\\s+([01]))?" // use strips (0 or 1), optional.
                     "$");
+  QRegExp lz4DeltaRegExp("^vtkLZ4DeltaCompressor"
+                         "\\s+"     // space
+                         "0"        // 0
+                         "\\s+"     // space
+                         "([0-9]+)" // num-of-bits.
+                         "$");
   QRegExp nvpipeRegExp("^vtkNvPipeCompressor"
                        "\\s+"     // space
                        "0"        // 0
@@ -132,14 +142,25 @@ void pqImageCompressorWidget::setCompressorConfig(const QString& value)
   if (lz4RegExp.exactMatch(value))
   {
     int numBits = lz4RegExp.cap(1).toInt();
+    // configurations without the token use the legacy format.
+    bool useStrips = (lz4RegExp.cap(2).toInt() == 1);
     ui.compressionType->setCurrentIndex(LZ4_COMPRESSION);
     ui.squirtColorSpace->setValue(numBits);
+    ui.useStrips->setCheckState(useStrips ? Qt::Checked : Qt::Unchecked);
+  }
+  else if (lz4DeltaRegExp.exactMatch(value))
+  {
+    int numBits = lz4DeltaRegExp.cap(1).toInt();
+    ui.compressionType->setCurrentIndex(LZ4_DELTA_COMPRESSION);
+    ui.squirtColorSpace->setValue(numBits);
   }
   else if (squirtRegExp.exactMatch(value))
   {
     int numBits = squirtRegExp.cap(1).toInt();
+    bool useStrips = (squirtRegExp.cap(2).toInt() == 1);
     ui.compressionType->setCurrentIndex(SQUIRT_COMPRESSION);
     ui.squirtColorSpace->setValue(numBits);
+    ui.useStrips->setCheckState(useStrips ? Qt::Checked : Qt::Unchecked);
   }
   else if (zlibRegExp.exactMatch(value))
   {
@@ -170,10 +191,14 @@ QString pqImageCompressorWidget::compressorConfig() const
   switch (ui.compressionType->currentIndex())
   {
     case LZ4_COMPRESSION:
-      return QString("vtkLZ4Compressor 0 %1").arg(ui.squirtColorSpace->value());
+      return QString("vtkLZ4Compressor 0 %1 %2")
+        .arg(ui.squirtColorSpace->value())
+        .arg(ui.useStrips->isChecked() ? 1 : 0);
 
     case SQUIRT_COMPRESSION: // squirt
-      return QString("vtkSquirtCompressor 0 %1").arg(ui.squirtColorSpace->value());
+      return QString("vtkSquirtCompressor 0 %1 %2")
+        .arg(ui.squirtColorSpace->value())
+        .arg(ui.useStrips->isChecked() ? 1 : 0);
 
     case ZLIB_COMPRESSION: // zlib
       return QString("vtkZlibImageCompressor 0 %1 %2 %3")
@@ -181,6 +206,9 @@ QString pqImageCompressorWidget::compressorConfig() const
         .arg(ui.zlibColorSpace->value())
         .arg(ui.zlibStripAlpha->isChecked() ? 1 : 0);
 
+    case LZ4_DELTA_COMPRESSION: // lz4 with frame differencing
+      return QString("vtkLZ4DeltaCompressor 0 %1").arg(ui.squirtColorSpace->value());
+
     case NVPIPE_COMPRESSION: // nvpipe
       return QString("vtkNvPipeCompressor 0 %1").arg(ui.nvpLevel->value());
   }
@@ -192,8 +220,11 @@ QString pqImageCompressorWidget::compressorConfig() const
 void pqImageCompressorWidget::currentIndexChanged(int index)
 {
   Ui::ImageCompressorWidget& ui = this->Internals->Ui;
-  ui.squirtLabel->setVisible(index == SQUIRT_COMPRESSION || index == LZ4_COMPRESSION);
-  ui.squirtColorSpace->setVisible(index == SQUIRT_COMPRESSION || index == LZ4_COMPRESSION);
+  const bool hasColorSpace = index == SQUIRT_COMPRESSION || index == LZ4_COMPRESSION ||
+    index == LZ4_DELTA_COMPRESSION;
+  ui.squirtLabel->setVisible(hasColorSpace);
+  ui.squirtColorSpace->setVisible(hasColorSpace);
+  ui.useStrips->setVisible(index == SQUIRT_COMPRESSION || index == LZ4_COMPRESSION);
 
   ui.zlibLabel1->setVisible(index == ZLIB_COMPRESSION);
   ui.zlibLabel2->setVisible(index == ZLIB_COMPRESSION);
@@ -233,11 +264,11 @@ void pqImageCompressorWidget::setConfigurationDefault(int index)
       break;
 
     case ETHERNET_1_GIG:
-      this->setCompressorConfig("vtkLZ4Compressor 0 5");
+      this->setCompressorConfig("vtkLZ4Compressor 0 5 1");
       break;
 
     case ETHERNET_10_GIG:
-      this->setCompressorConfig("vtkLZ4Compressor 0 3");
+      this->setCompressorConfig("vtkLZ4Compressor 0 3 1");
       break;
 
     case SHARED_MEMORY:
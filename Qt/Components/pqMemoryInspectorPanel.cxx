@@ -30,9 +30,11 @@ using Ui::pqMemoryInspectorPanelForm;
 #include "vtkSMRenderViewProxy.h"
 
 #include "vtkClientServerStream.h"
+#include "vtkNew.h"
 #include "vtkPVDisableStackTraceSignalHandler.h"
 #include "vtkPVEnableStackTraceSignalHandler.h"
 #include "vtkPVInformation.h"
+#include "vtkPVMemoryCensusInformation.h"
 #include "vtkPVMemoryUseInformation.h"
 #include "vtkPVSystemConfigInformation.h"
 #include "vtkProcessModule.h"
@@ -56,6 +58,7 @@ using Ui::pqMemoryInspectorPanelForm;
 #include <QString>
 #include <QStringList>
 #include <QStyleFactory>
+#include <QTableWidget>
 #include <QTreeWidgetItem>
 #include <QTreeWidgetItemIterator>
 
@@ -110,6 +113,18 @@ enum
   ITEM_KEY_SYSTEM_TYPE    // int (0 unix like, 1 win)
 };
 
+// columns of the array census table
+enum
+{
+  CENSUS_COLUMN_PROXY,
+  CENSUS_COLUMN_PORT,
+  CENSUS_COLUMN_LOCATION,
+  CENSUS_COLUMN_ARRAY,
+  CENSUS_COLUMN_MEMORY,
+  CENSUS_COLUMN_LARGEST_RANK,
+  CENSUS_COLUMN_RANKS
+};
+
 // data for tree items
 enum
 {
@@ -246,6 +261,37 @@ QString translateUnits(float memUse)
   return fmt.arg(memUse / p250, 0, 'f', 2).arg("PiB");
 }
 
+// ****************************************************************************
+// table item displaying a memory size, sorted by size rather than by text.
+class MemoryTableItem : public QTableWidgetItem
+{
+public:
+  MemoryTableItem(long long bytes)
+    : QTableWidgetItem(translateUnits(static_cast<float>(bytes) / 1024.0f))
+    , Bytes(bytes)
+  {
+    this->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+  }
+
+  bool operator<(const QTableWidgetItem& other) const override
+  {
+    const MemoryTableItem* item = dynamic_cast<const MemoryTableItem*>(&other);
+    return item ? this->Bytes < item->Bytes : this->QTableWidgetItem::operator<(other);
+  }
+
+private:
+  long long Bytes;
+};
+
+// ****************************************************************************
+QTableWidgetItem* newNumberTableItem(int value)
+{
+  QTableWidgetItem* item = new QTableWidgetItem;
+  item->setData(Qt::DisplayRole, value);
+  item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+  return item;
+}
+
 // ****************************************************************************
 template <typename T>
 void ClearVectorOfPointers(vector<T*> data)
@@ -703,6 +749,12 @@ pqMemoryInspectorPanel::pqMemoryInspectorPanel(QWidget* pWidget, Qt::WindowFlags
   // listen for manual update request
   QObject::connect(this->Ui->updateMemUse, SIGNAL(released()), this, SLOT(Update()));
 
+  // the array census walks the server side pipeline, only do it on request.
+  this->Ui->censusTable->setVisible(false);
+  this->Ui->censusTable->sortByColumn(CENSUS_COLUMN_MEMORY, Qt::DescendingOrder);
+  QObject::connect(
+    this->Ui->arrayCensus, SIGNAL(toggled(bool)), this, SLOT(EnableArrayCensus(bool)));
+
   // listen to context menu events
   QObject::connect(this->Ui->configView, SIGNAL(customContextMenuRequested(const QPoint&)), this,
     SLOT(ConfigViewContextMenu(const QPoint&)));
@@ -1020,6 +1072,7 @@ void pqMemoryInspectorPanel::Clear()
   this->StackTraceOnRenderServer = 0;
 
   this->Ui->configView->clear();
+  this->Ui->censusTable->setRowCount(0);
 }
 
 //-----------------------------------------------------------------------------
@@ -1250,6 +1303,10 @@ void pqMemoryInspectorPanel::Update()
 
   this->UpdateRanks();
   this->UpdateHosts();
+  if (this->Ui->arrayCensus->isChecked())
+  {
+    this->UpdateArrayCensus();
+  }
 
   this->PendingUpdate = false;
   this->UpdateEnabled = false;
@@ -1394,6 +1451,69 @@ void pqMemoryInspectorPanel::UpdateHosts(map<string, HostData*>& hosts)
   }
 }
 
+//-----------------------------------------------------------------------------
+void pqMemoryInspectorPanel::UpdateArrayCensus()
+{
+#if defined pqMemoryInspectorPanelDEBUG
+  cerr << ":::::pqMemoryInspectorPanel::UpdateArrayCensus" << endl;
+#endif
+
+  pqServer* server = pqActiveObjects::instance().activeServer();
+  if (!server)
+  {
+    return;
+  }
+
+  // arrays of the same proxy are merged across ranks on the server.
+  vtkSMSession* session = server->session();
+  vtkNew<vtkPVMemoryCensusInformation> census;
+  session->GatherInformation(vtkPVSession::DATA_SERVER, census, 0);
+  if (session->GetRenderClientMode() == vtkSMSession::RENDERING_SPLIT)
+  {
+    vtkNew<vtkPVMemoryCensusInformation> rsCensus;
+    session->GatherInformation(vtkPVSession::RENDER_SERVER, rsCensus, 0);
+    census->AddInformation(rsCensus);
+  }
+
+  QTableWidget* table = this->Ui->censusTable;
+  table->setSortingEnabled(false);
+  const int nArrays = census->GetNumberOfArrays();
+  table->setRowCount(nArrays);
+  for (int i = 0; i < nArrays; ++i)
+  {
+    table->setItem(i, CENSUS_COLUMN_PROXY, new QTableWidgetItem(census->GetProxyName(i)));
+    table->setItem(i, CENSUS_COLUMN_PORT, newNumberTableItem(census->GetPort(i)));
+    const bool cached = census->GetLocation(i) == vtkPVMemoryCensusInformation::DELIVERY_CACHE;
+    table->setItem(i, CENSUS_COLUMN_LOCATION,
+      new QTableWidgetItem(cached ? tr("Delivery cache") : tr("Pipeline output")));
+    table->setItem(i, CENSUS_COLUMN_ARRAY, new QTableWidgetItem(census->GetArrayName(i)));
+    table->setItem(i, CENSUS_COLUMN_MEMORY, new MemoryTableItem(census->GetBytes(i)));
+    table->setItem(
+      i, CENSUS_COLUMN_LARGEST_RANK, new MemoryTableItem(census->GetMaximumRankBytes(i)));
+    table->setItem(i, CENSUS_COLUMN_RANKS, newNumberTableItem(census->GetNumberOfRanks(i)));
+  }
+  table->setSortingEnabled(true);
+  table->resizeColumnsToContents();
+
+  const float totalKiB = static_cast<float>(census->GetTotalBytes()) / 1024.0f;
+  this->Ui->arrayCensus->setTitle(tr("Array Memory (%1)").arg(translateUnits(totalKiB)));
+}
+
+//-----------------------------------------------------------------------------
+void pqMemoryInspectorPanel::EnableArrayCensus(bool enable)
+{
+  this->Ui->censusTable->setVisible(enable);
+  if (!enable)
+  {
+    this->Ui->censusTable->setRowCount(0);
+    this->Ui->arrayCensus->setTitle(tr("Array Memory"));
+  }
+  else if (this->Initialized())
+  {
+    this->UpdateArrayCensus();
+  }
+}
+
 //-----------------------------------------------------------------------------
 void pqMemoryInspectorPanel::EnableStackTraceOnClient(bool enable)
 {
@@ -108,6 +108,10 @@ protected Q_SLOTS:
   void ShowOnlyNodes();
   void ShowAllRanks();
 
+  // Description:
+  // Show/hide the memory used by the arrays of each pipeline object.
+  void EnableArrayCensus(bool enable);
+
 private:
   void ClearClient();
   void ClearServers();
@@ -116,6 +120,7 @@ private:
   void UpdateRanks();
   void UpdateHosts();
   void UpdateHosts(map<string, HostData*>& hosts);
+  void UpdateArrayCensus();
 
   void InitializeServerGroup(long long clientPid, vtkPVSystemConfigInformation* configs,
     int validProcessType, QTreeWidgetItem* group, string groupName, map<string, HostData*>& hosts,
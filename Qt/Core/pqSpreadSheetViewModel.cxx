@@ -98,6 +98,7 @@ public:
   QItemSelectionModel SelectionModel;
   pqTimer Timer;
   pqTimer SelectionTimer;
+  pqTimer PrefetchTimer;
   int DecimalPrecision;
   bool FixedRepresentation;
   vtkIdType LastRowCount;
@@ -130,6 +131,12 @@ pqSpreadSheetViewModel::pqSpreadSheetViewModel(vtkSMProxy* view, QObject* parent
   this->Internal->Timer.setInterval(500); // milliseconds.
   QObject::connect(&this->Internal->Timer, SIGNAL(timeout()), this, SLOT(delayedUpdate()));
 
+  // prefetch blocks once the event loop is idle, i.e. after the fetched rows
+  // are shown.
+  this->Internal->PrefetchTimer.setSingleShot(true);
+  this->Internal->PrefetchTimer.setInterval(0);
+  QObject::connect(&this->Internal->PrefetchTimer, SIGNAL(timeout()), this, SLOT(prefetch()));
+
   this->Internal->SelectionTimer.setSingleShot(true);
   this->Internal->SelectionTimer.setInterval(100); // milliseconds.
   QObject::connect(
@@ -210,6 +217,7 @@ void pqSpreadSheetViewModel::forceUpdate()
   this->Internal->SelectionModel.clear();
   this->Internal->Timer.stop();
   this->Internal->SelectionTimer.stop();
+  this->Internal->PrefetchTimer.stop();
 
   vtkIdType& rows = this->Internal->LastRowCount;
   vtkIdType& columns = this->Internal->LastColumnCount;
@@ -246,6 +254,17 @@ void pqSpreadSheetViewModel::delayedUpdate()
   }
 }
 
+//-----------------------------------------------------------------------------
+void pqSpreadSheetViewModel::prefetch()
+{
+  // blocks are prefetched one piece per call, to keep the application
+  // responsive, until there is nothing left to prefetch.
+  if (this->Internal->VTKView->Prefetch())
+  {
+    this->Internal->PrefetchTimer.start();
+  }
+}
+
 //-----------------------------------------------------------------------------
 void pqSpreadSheetViewModel::triggerSelectionChanged()
 {
@@ -285,6 +304,8 @@ void pqSpreadSheetViewModel::onDataFetched(vtkObject*, unsigned long, void*, voi
   this->dataChanged(topLeft, bottomRight);
   // we always invalidate header data, just to be on a safe side.
   this->headerDataChanged(Qt::Horizontal, 0, this->columnCount() - 1);
+
+  this->Internal->PrefetchTimer.start();
 }
 namespace
 {
@@ -602,5 +623,12 @@ void pqSpreadSheetViewModel::hiddenColumnsChanged()
   if (numCols > 0)
   {
     Q_EMIT this->headerDataChanged(Qt::Horizontal, 0, this->columnCount() - 1);
+    // hidden columns are not fetched, so the rows are fetched again when
+    // columns are shown.
+    const int numRows = this->rowCount();
+    if (numRows > 0)
+    {
+      Q_EMIT this->dataChanged(this->index(0, 0), this->index(numRows - 1, numCols - 1));
+    }
   }
 }
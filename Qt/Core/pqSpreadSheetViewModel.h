@@ -213,6 +213,11 @@ private Q_SLOTS:
   */
   void delayedUpdate();
 
+  /**
+   * called to prefetch the next piece of the blocks after the ones being shown.
+   */
+  void prefetch();
+
   void triggerSelectionChanged();
 
   /**
@@ -0,0 +1,116 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestClientServerStreamThroughput.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Microbenchmark for vtkClientServerStream message encode and decode.
+// Reports throughput so that regressions in the stream implementation
+// show up in the test output, and validates the round trip.
+
+#include "vtkClientServerStream.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+// Encode a typical property push: a handful of small scalar arguments
+// followed by one array payload.
+void EncodeMessage(vtkClientServerStream& css, const std::vector<double>& payload)
+{
+  css << vtkClientServerStream::Invoke << vtkClientServerID(1) << "SetValues" << 1 << 2.0
+      << "name"
+      << vtkClientServerStream::InsertArray(payload.data(), static_cast<int>(payload.size()))
+      << vtkClientServerStream::End;
+}
+
+bool RunCase(size_t arraySize, int messagesPerStream, int iterations)
+{
+  std::vector<double> payload(arraySize);
+  for (size_t cc = 0; cc < arraySize; ++cc)
+  {
+    payload[cc] = static_cast<double>(cc);
+  }
+
+  std::vector<double> result(arraySize);
+  vtkClientServerStream css;
+  vtkClientServerStream received;
+  double encodeSeconds = 0.0;
+  double decodeSeconds = 0.0;
+  size_t totalBytes = 0;
+
+  for (int iter = 0; iter < iterations; ++iter)
+  {
+    // Reuse the same stream for every iteration, as the interpreter and
+    // session do for their result and scratch streams.
+    auto start = std::chrono::steady_clock::now();
+    css.Reset();
+    for (int m = 0; m < messagesPerStream; ++m)
+    {
+      EncodeMessage(css, payload);
+    }
+    auto encoded = std::chrono::steady_clock::now();
+
+    const unsigned char* data;
+    size_t length;
+    if (!css.GetData(&data, &length))
+    {
+      std::cerr << "Encoded stream is invalid." << std::endl;
+      return false;
+    }
+    totalBytes += length;
+
+    auto decodeStart = std::chrono::steady_clock::now();
+    if (!received.SetData(data, length))
+    {
+      std::cerr << "Failed to parse encoded stream." << std::endl;
+      return false;
+    }
+    for (int m = 0; m < received.GetNumberOfMessages(); ++m)
+    {
+      if (!received.GetArgument(
+            m, 5, result.data(), static_cast<vtkTypeUInt32>(result.size())))
+      {
+        std::cerr << "Failed to extract array argument." << std::endl;
+        return false;
+      }
+    }
+    auto decoded = std::chrono::steady_clock::now();
+
+    encodeSeconds += std::chrono::duration<double>(encoded - start).count();
+    decodeSeconds += std::chrono::duration<double>(decoded - decodeStart).count();
+  }
+
+  if (received.GetNumberOfMessages() != messagesPerStream || result != payload)
+  {
+    std::cerr << "Round trip mismatch for array size " << arraySize << std::endl;
+    return false;
+  }
+
+  const double megabytes = static_cast<double>(totalBytes) / (1024.0 * 1024.0);
+  std::cout << "array size " << arraySize << " x " << messagesPerStream << " messages: encode "
+            << (encodeSeconds > 0 ? megabytes / encodeSeconds : 0.0) << " MB/s, decode "
+            << (decodeSeconds > 0 ? megabytes / decodeSeconds : 0.0) << " MB/s" << std::endl;
+  return true;
+}
+}
+
+int TestClientServerStreamThroughput(int, char* [])
+{
+  bool success = true;
+  success &= RunCase(4, 1000, 50);
+  success &= RunCase(1024, 100, 50);
+  success &= RunCase(1024 * 1024, 2, 10);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
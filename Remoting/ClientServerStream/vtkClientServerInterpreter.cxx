@@ -22,9 +22,12 @@
 #include "vtksys/FStream.hxx"
 #include "vtksys/SystemTools.hxx"
 
+#include <chrono>
 #include <map>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 vtkStandardNewMacro(vtkClientServerInterpreter);
@@ -76,6 +79,86 @@ public:
   NewInstanceFunctionsType NewInstanceFunctions;
   ClassToFunctionMapType ClassToFunctionMap;
   IDToMessageMapType IDToMessageMap;
+
+  // Cache of the command function that handled an Invoke, keyed by the
+  // object's class name, the method name, the argument types and the
+  // classes of the object arguments.  The generated wrappers resolve a
+  // method by string comparison against every wrapped method of the class
+  // and then recurse into each superclass wrapper, so resolving the
+  // handler once saves that walk on every later call.
+  typedef std::unordered_map<std::string, const CommandFunction*> DispatchCacheType;
+  DispatchCacheType DispatchCache;
+  std::string DispatchKey;
+
+  // The innermost command function that succeeded during the current
+  // top-level dispatch.  Set by CallCommandFunction.
+  const CommandFunction* DispatchHandler = nullptr;
+
+  // Statistics reported by the interpreter.
+  vtkTypeUInt64 DispatchCacheHits = 0;
+  vtkTypeUInt64 DispatchCacheMisses = 0;
+  double ProcessingTime = 0.0;
+  int ProcessingDepth = 0;
+
+  // Build the dispatch cache key for the given message into DispatchKey.
+  const std::string& BuildDispatchKey(
+    const char* cname, const char* method, const vtkClientServerStream& msg)
+  {
+    std::string& key = this->DispatchKey;
+    key.assign(cname);
+    key.push_back('\0');
+    key.append(method);
+    key.push_back('\0');
+    const int numArgs = msg.GetNumberOfArguments(0);
+    for (int a = 2; a < numArgs; ++a)
+    {
+      const vtkClientServerStream::Types type = msg.GetArgumentType(0, a);
+      key.push_back(static_cast<char>(type));
+      // Overloads taking different object types share the same argument
+      // type, so the dynamic class of object arguments is part of the key.
+      vtkObjectBase* arg = nullptr;
+      if (type == vtkClientServerStream::vtk_object_pointer && msg.GetArgument(0, a, &arg) && arg)
+      {
+        key.append(arg->GetClassName());
+        key.push_back('\0');
+      }
+    }
+    return key;
+  }
+
+  // Scratch streams used to hold expanded messages.  They are reused
+  // across commands so that their buffers are not reallocated for every
+  // Invoke.  There is one per nesting level since evaluating a
+  // stream_value argument recursively processes another stream.
+  std::vector<std::unique_ptr<vtkClientServerStream> > ExpandedMessages;
+  size_t ExpandedMessagesDepth = 0;
+
+  // Acquire the scratch stream for the current nesting level for the
+  // lifetime of this object.
+  class ScopedExpandedMessage
+  {
+  public:
+    ScopedExpandedMessage(vtkClientServerInterpreterInternals* internals)
+      : Internals(internals)
+    {
+      auto& messages = this->Internals->ExpandedMessages;
+      if (messages.size() <= this->Internals->ExpandedMessagesDepth)
+      {
+        messages.emplace_back(new vtkClientServerStream);
+      }
+      this->Message = messages[this->Internals->ExpandedMessagesDepth++].get();
+    }
+    ~ScopedExpandedMessage() { --this->Internals->ExpandedMessagesDepth; }
+
+    vtkClientServerStream& operator*() const { return *this->Message; }
+
+  private:
+    vtkClientServerInterpreterInternals* Internals;
+    vtkClientServerStream* Message;
+
+    ScopedExpandedMessage(const ScopedExpandedMessage&) = delete;
+    ScopedExpandedMessage& operator=(const ScopedExpandedMessage&) = delete;
+  };
 };
 
 //----------------------------------------------------------------------------
@@ -253,6 +336,14 @@ int vtkClientServerInterpreter::ProcessOneMessage(const vtkClientServerStream& c
     this->LogStream->flush();
   }
 
+  // Only time the outermost message; nested messages are included in it.
+  const bool outermost = (this->Internal->ProcessingDepth++ == 0);
+  std::chrono::steady_clock::time_point start;
+  if (outermost)
+  {
+    start = std::chrono::steady_clock::now();
+  }
+
   // Look for known commands in the message.
   int result = 0;
   vtkClientServerStream::Commands cmd = css.GetCommand(message);
@@ -283,6 +374,13 @@ int vtkClientServerInterpreter::ProcessOneMessage(const vtkClientServerStream& c
     break;
   }
 
+  if (outermost)
+  {
+    this->Internal->ProcessingTime +=
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+  --this->Internal->ProcessingDepth;
+
   // Log the result of the message.
   if (this->LogStream)
   {
@@ -393,7 +491,8 @@ int vtkClientServerInterpreter::ProcessCommandNew(const vtkClientServerStream& c
 int vtkClientServerInterpreter::ProcessCommandInvoke(const vtkClientServerStream& css, int midx)
 {
   // Create a message with all known id_value arguments expanded.
-  vtkClientServerStream msg;
+  vtkClientServerInterpreterInternals::ScopedExpandedMessage scratch(this->Internal);
+  vtkClientServerStream& msg = *scratch;
   if (!this->ExpandMessage(css, midx, 0, msg))
   {
     // ExpandMessage left an error in the LastResultMessage for us.
@@ -421,8 +520,7 @@ int vtkClientServerInterpreter::ProcessCommandInvoke(const vtkClientServerStream
     // Find the command function for this object's type.
     if (obj && this->HasCommandFunction(obj->GetClassName()))
     {
-      if (this->CallCommandFunction(
-            obj->GetClassName(), obj, method, msg, *this->LastResultMessage))
+      if (this->DispatchCommandFunction(obj, method, msg, *this->LastResultMessage))
       {
         return 1;
       }
@@ -521,7 +619,8 @@ int vtkClientServerInterpreter::ProcessCommandAssign(const vtkClientServerStream
 {
   // Create a message with all known id_value arguments expanded
   // except for the first argument.
-  vtkClientServerStream msg;
+  vtkClientServerInterpreterInternals::ScopedExpandedMessage scratch(this->Internal);
+  vtkClientServerStream& msg = *scratch;
   if (!this->ExpandMessage(css, midx, 1, msg))
   {
     // ExpandMessage left an error in the LastResultMessage for us.
@@ -778,6 +877,9 @@ void vtkClientServerInterpreter::AddCommandFunction(const char* cname,
 
   this->Internal->ClassToFunctionMap[cname] =
     new vtkClientServerInterpreterInternals::CommandFunction(func, context);
+
+  // A newly wrapped class may change how methods resolve.
+  this->Internal->DispatchCache.clear();
 }
 
 //----------------------------------------------------------------------------
@@ -807,7 +909,91 @@ int vtkClientServerInterpreter::CallCommandFunction(const char* cname, vtkObject
 
   vtkClientServerCommandFunction function = n->Function;
   void* ctx = n->Context ? n->Context->Context : nullptr;
-  return function(this, ptr, method, msg, result, ctx);
+  int retVal = function(this, ptr, method, msg, result, ctx);
+
+  // Superclass wrappers are invoked through this method too, so the first
+  // success seen during a dispatch is the wrapper that actually handled it.
+  if (retVal && !this->Internal->DispatchHandler)
+  {
+    this->Internal->DispatchHandler = n;
+  }
+  return retVal;
+}
+
+//----------------------------------------------------------------------------
+int vtkClientServerInterpreter::DispatchCommandFunction(vtkObjectBase* obj, const char* method,
+  const vtkClientServerStream& msg, vtkClientServerStream& result)
+{
+  vtkClientServerInterpreterInternals* internal = this->Internal;
+  const char* cname = obj->GetClassName();
+
+  // Nested dispatches happen when a wrapped method itself processes a
+  // stream; save the outer handler so that it is not overwritten.
+  const vtkClientServerInterpreterInternals::CommandFunction* outerHandler =
+    internal->DispatchHandler;
+  internal->DispatchHandler = nullptr;
+
+  int retVal = 0;
+  vtkClientServerInterpreterInternals::DispatchCacheType::const_iterator iter =
+    internal->DispatchCache.find(internal->BuildDispatchKey(cname, method, msg));
+  if (iter != internal->DispatchCache.end())
+  {
+    const vtkClientServerInterpreterInternals::CommandFunction* n = iter->second;
+    retVal = n->Function(this, obj, method, msg, result, n->Context ? n->Context->Context : nullptr);
+    if (retVal)
+    {
+      ++internal->DispatchCacheHits;
+    }
+    else
+    {
+      // The cached wrapper did not accept the call after all; forget it
+      // and fall back to the full lookup below.  The key is rebuilt since
+      // nested dispatches reuse the same buffer.
+      internal->DispatchCache.erase(internal->BuildDispatchKey(cname, method, msg));
+      result.Reset();
+    }
+  }
+
+  if (!retVal)
+  {
+    ++internal->DispatchCacheMisses;
+    internal->DispatchHandler = nullptr;
+    retVal = this->CallCommandFunction(cname, obj, method, msg, result);
+    if (retVal && internal->DispatchHandler)
+    {
+      internal->DispatchCache[internal->BuildDispatchKey(cname, method, msg)] =
+        internal->DispatchHandler;
+    }
+  }
+
+  internal->DispatchHandler = outerHandler;
+  return retVal;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkClientServerInterpreter::GetDispatchCacheHits() const
+{
+  return this->Internal->DispatchCacheHits;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkClientServerInterpreter::GetDispatchCacheMisses() const
+{
+  return this->Internal->DispatchCacheMisses;
+}
+
+//----------------------------------------------------------------------------
+double vtkClientServerInterpreter::GetProcessingTime() const
+{
+  return this->Internal->ProcessingTime;
+}
+
+//----------------------------------------------------------------------------
+void vtkClientServerInterpreter::ResetStatistics()
+{
+  this->Internal->DispatchCacheHits = 0;
+  this->Internal->DispatchCacheMisses = 0;
+  this->Internal->ProcessingTime = 0.0;
 }
 
 void vtkClientServerInterpreter::AddNewInstanceFunction(const char* name,
@@ -1019,4 +1205,7 @@ vtkObjectBase* vtkClientServerInterpreter::NewInstance(const char* classname)
 void vtkClientServerInterpreter::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "DispatchCacheHits: " << this->Internal->DispatchCacheHits << endl;
+  os << indent << "DispatchCacheMisses: " << this->Internal->DispatchCacheMisses << endl;
+  os << indent << "ProcessingTime: " << this->Internal->ProcessingTime << endl;
 }
@@ -149,6 +149,21 @@ public:
   int CallCommandFunction(const char* classname, vtkObjectBase* ptr, const char* method,
     const vtkClientServerStream& msg, vtkClientServerStream& result);
 
+  //@{
+  /**
+   * Statistics about message processing.  The interpreter remembers which
+   * wrapper command function handled an Invoke for a given class, method
+   * name and argument types so that later calls skip the lookup through
+   * the class hierarchy.  Hits and misses count Invoke messages resolved
+   * with and without that cache.  The processing time is the wall-clock
+   * time in seconds spent in ProcessOneMessage.
+   */
+  vtkTypeUInt64 GetDispatchCacheHits() const;
+  vtkTypeUInt64 GetDispatchCacheMisses() const;
+  double GetProcessingTime() const;
+  void ResetStatistics();
+  //@}
+
   /**
    * Add a function used to create new objects.
    */
@@ -209,6 +224,11 @@ protected:
   int ExpandMessage(
     const vtkClientServerStream& in, int inIndex, int startArgument, vtkClientServerStream& out);
 
+  // Call the command function handling the given method for the object,
+  // using the dispatch cache when possible.
+  int DispatchCommandFunction(vtkObjectBase* obj, const char* method,
+    const vtkClientServerStream& msg, vtkClientServerStream& result);
+
   // Load a module dynamically given the full path to it.
   int LoadInternal(const char* moduleName, const char* fullPath);
 
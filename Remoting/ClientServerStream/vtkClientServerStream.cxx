@@ -226,6 +226,11 @@ public:
   };
   ObjectsType Objects;
 
+  // Largest buffer capacity kept alive across Reset calls.  Larger
+  // buffers are released so that a single huge message does not pin
+  // memory for the lifetime of the stream.
+  static const DataType::size_type MaximumRetainedCapacity;
+
   // Index into ValueOffsets where the last Command started.  Used to
   // detect valid message completion.
   static const ValueOffsetsType::size_type InvalidStartIndex;
@@ -237,6 +242,18 @@ public:
   // Buffer for return value from StreamToString.
   std::string String;
 
+  // Make sure at least the given number of bytes can be appended to
+  // Data without reallocation.  Growth stays geometric so that many
+  // small reservations do not degrade into one reallocation each.
+  void ReserveAdditional(size_t length)
+  {
+    const DataType::size_type needed = this->Data.size() + length;
+    if (needed > this->Data.capacity())
+    {
+      this->Data.reserve(std::max(needed, 2 * this->Data.capacity()));
+    }
+  }
+
   // Access to protected members of vtkClientServerStream.
   static vtkClientServerStream& Write(vtkClientServerStream& css, const void* data, size_t length)
   {
@@ -251,6 +268,8 @@ public:
 const vtkClientServerStreamInternals::ValueOffsetsType::size_type
   vtkClientServerStreamInternals::InvalidStartIndex =
     static_cast<vtkClientServerStreamInternals::ValueOffsetsType::size_type>(-1);
+const vtkClientServerStreamInternals::DataType::size_type
+  vtkClientServerStreamInternals::MaximumRetainedCapacity = 16 * 1024 * 1024;
 
 //----------------------------------------------------------------------------
 vtkClientServerStream::vtkClientServerStream(vtkObjectBase* owner)
@@ -301,9 +320,11 @@ vtkClientServerStream& vtkClientServerStream::Write(const void* data, size_t len
     return *this;
   }
 
-  // Copy the value into the data.
-  this->Internal->Data.resize(this->Internal->Data.size() + length);
-  memcpy(&*(this->Internal->Data.end() - length), data, length);
+  // Append the value to the data.  Using insert rather than
+  // resize+memcpy avoids value-initializing the new bytes before they
+  // are overwritten, which matters for large array arguments.
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  this->Internal->Data.insert(this->Internal->Data.end(), bytes, bytes + length);
   return *this;
 }
 
@@ -316,8 +337,17 @@ void vtkClientServerStream::Reserve(size_t size)
 //----------------------------------------------------------------------------
 void vtkClientServerStream::Reset()
 {
-  // Empty the entire stream.
-  vtkClientServerStreamInternals::DataType().swap(this->Internal->Data);
+  // Empty the entire stream.  Streams are typically reset and refilled
+  // once per message (e.g. the interpreter's last result), so keep the
+  // allocated buffer around for reuse unless it grew unreasonably large.
+  if (this->Internal->Data.capacity() > vtkClientServerStreamInternals::MaximumRetainedCapacity)
+  {
+    vtkClientServerStreamInternals::DataType().swap(this->Internal->Data);
+  }
+  else
+  {
+    this->Internal->Data.clear();
+  }
 
   this->Internal->ValueOffsets.erase(
     this->Internal->ValueOffsets.begin(), this->Internal->ValueOffsets.end());
@@ -421,6 +451,9 @@ vtkClientServerStream& vtkClientServerStream::operator<<(vtkClientServerStream::
 //----------------------------------------------------------------------------
 vtkClientServerStream& vtkClientServerStream::operator<<(vtkClientServerStream::Array a)
 {
+  // Grow the buffer once for the whole array instead of once per piece.
+  this->Internal->ReserveAdditional(sizeof(vtkTypeUInt32) + sizeof(a.Length) + a.Size + 1);
+
   // Store the array type, then length, then data.
   *this << a.Type;
   this->Write(&a.Length, sizeof(a.Length));
@@ -444,6 +477,7 @@ vtkClientServerStream& vtkClientServerStream::operator<<(const vtkClientServerSt
   if (this != &css && css.Internal->Objects.empty() && css.GetData(&data, &length))
   {
     // Store the stream_value type, then length, then data.
+    this->Internal->ReserveAdditional(sizeof(vtkTypeUInt32) + sizeof(vtkTypeUInt32) + length);
     *this << vtkClientServerStream::stream_value;
     vtkTypeUInt32 size = static_cast<vtkTypeUInt32>(length);
     this->Write(&size, sizeof(size));
@@ -111,7 +111,9 @@ public:
   void Reserve(size_t size);
 
   /**
-   * Reset the stream to an empty state.
+   * Reset the stream to an empty state.  The memory allocated for the
+   * stream data is kept for reuse by subsequent messages unless it is
+   * very large.
    */
   void Reset();
 
@@ -190,6 +190,22 @@ void vtkPVArrayInformation::GetComponentFiniteRange(int comp, double range[2]) c
   range[1] = r[1];
 }
 
+//----------------------------------------------------------------------------
+void vtkPVArrayInformation::ExtendComponentRange(int comp, const double range[2])
+{
+  try
+  {
+    auto& compInfo = this->Components.at(comp + 1);
+    const vtkTuple<double, 2> other({ range[0], range[1] });
+    compInfo.Range = ::MergeRanges(compInfo.Range, other);
+    compInfo.FiniteRange = ::MergeRanges(compInfo.FiniteRange, other);
+  }
+  catch (std::out_of_range&)
+  {
+    vtkErrorMacro("Invalid component number " << comp);
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkPVArrayInformation::GetDataTypeRange(double range[2]) const
 {
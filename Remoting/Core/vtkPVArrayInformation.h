@@ -108,6 +108,13 @@ public:
   void GetComponentFiniteRange(int comp, double range[2]) const;
   //@}
 
+  /**
+   * Extends both the range and the finite range of a component, `-1` standing
+   * for the magnitude, to include `range`. This is used to accumulate the
+   * ranges of an array over several time steps.
+   */
+  void ExtendComponentRange(int comp, const double range[2]);
+
   /**
    * This method return the Min and Max possible range of the native
    * data type. For example if a vtkScalars consists of unsigned char
@@ -163,6 +163,7 @@ vtkStandardNewMacro(vtkPVDataInformation);
 vtkPVDataInformation::vtkPVDataInformation()
 {
   this->Initialize();
+  this->Cacheable = true;
 }
 
 //----------------------------------------------------------------------------
@@ -174,7 +175,8 @@ vtkPVDataInformation::~vtkPVDataInformation()
 //----------------------------------------------------------------------------
 void vtkPVDataInformation::CopyParametersToStream(vtkMultiProcessStream& str)
 {
-  str << 828792 << this->PortNumber << std::string(this->SubsetSelector ? SubsetSelector : "")
+  str << 828793 << this->PortNumber << this->Rank
+      << std::string(this->SubsetSelector ? SubsetSelector : "")
       << std::string(this->SubsetAssemblyName ? this->SubsetAssemblyName : "");
 }
 
@@ -183,8 +185,8 @@ void vtkPVDataInformation::CopyParametersFromStream(vtkMultiProcessStream& str)
 {
   int magic_number;
   std::string path, name;
-  str >> magic_number >> this->PortNumber >> path >> name;
-  if (magic_number != 828792)
+  str >> magic_number >> this->PortNumber >> this->Rank >> path >> name;
+  if (magic_number != 828793)
   {
     vtkErrorMacro("Magic number mismatch.");
   }
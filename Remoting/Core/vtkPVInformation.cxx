@@ -18,6 +18,7 @@
 vtkPVInformation::vtkPVInformation()
 {
   this->RootOnly = 0;
+  this->Cacheable = false;
 }
 
 //----------------------------------------------------------------------------
@@ -28,6 +29,7 @@ void vtkPVInformation::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "RootOnly: " << this->RootOnly << endl;
+  os << indent << "Cacheable: " << this->Cacheable << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -70,6 +70,16 @@ public:
   vtkGetMacro(RootOnly, int);
   //@}
 
+  //@{
+  /**
+   * Get whether the gathered information only depends on the parameters and
+   * on the pipeline outputs of the object it is gathered from. Such
+   * information is cached by vtkPVSessionCore and gathered again only once
+   * the object or its outputs are modified. False by default.
+   */
+  vtkGetMacro(Cacheable, bool);
+  //@}
+
 protected:
   vtkPVInformation();
   ~vtkPVInformation() override;
@@ -77,6 +87,9 @@ protected:
   int RootOnly;
   vtkSetMacro(RootOnly, int);
 
+  bool Cacheable;
+  vtkSetMacro(Cacheable, bool);
+
   vtkPVInformation(const vtkPVInformation&) = delete;
   void operator=(const vtkPVInformation&) = delete;
 };
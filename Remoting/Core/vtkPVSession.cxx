@@ -25,6 +25,7 @@ vtkPVSession::vtkPVSession()
   this->ProgressHandler->SetSession(this); // not reference counted.
   this->ProgressCount = 0;
   this->InCleanupPendingProgress = false;
+  this->LODGeometryCache = nullptr;
 }
 
 //----------------------------------------------------------------------------
@@ -33,6 +34,7 @@ vtkPVSession::~vtkPVSession()
   this->ProgressHandler->SetSession(nullptr);
   this->ProgressHandler->Delete();
   this->ProgressHandler = nullptr;
+  this->SetLODGeometryCache(nullptr);
 }
 
 //----------------------------------------------------------------------------
@@ -117,6 +117,16 @@ public:
    */
   bool GetPendingProgress();
 
+  //@{
+  /**
+   * Cache of level-of-detail geometry shared by the representations of this
+   * session, see vtkGeometryRepresentation. It is created by the first
+   * representation that needs it and released with the session.
+   */
+  vtkSetObjectMacro(LODGeometryCache, vtkObject);
+  vtkGetObjectMacro(LODGeometryCache, vtkObject);
+  //@}
+
 protected:
   vtkPVSession();
   ~vtkPVSession() override;
@@ -141,6 +151,7 @@ protected:
   //@}
 
   vtkPVProgressHandler* ProgressHandler;
+  vtkObject* LODGeometryCache;
 
 private:
   vtkPVSession(const vtkPVSession&) = delete;
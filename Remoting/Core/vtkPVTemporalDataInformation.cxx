@@ -16,20 +16,93 @@
 
 #include "vtkAlgorithm.h"
 #include "vtkAlgorithmOutput.h"
+#include "vtkCommunicator.h"
 #include "vtkDataObject.h"
 #include "vtkInformation.h"
+#include "vtkMultiProcessController.h"
+#include "vtkMultiProcessStream.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVArrayInformation.h"
+#include "vtkPVDataSetAttributesInformation.h"
+#include "vtkPVTemporalRangeIndex.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <vtksys/SystemTools.hxx>
+
+#include <string>
 #include <vector>
 
+namespace
+{
+// Returns whether `index` records, over `timesteps`, the ranges of all the
+// numeric arrays of `info`. Arrays generated by vtkPVPostFilter, e.g.
+// components extracted on request, are not indexed since the index records
+// the input of vtkPVPostFilter.
+bool HasRanges(vtkPVDataInformation* info, vtkPVTemporalRangeIndex* index,
+  const std::vector<double>& timesteps)
+{
+  for (int association : { vtkDataObject::POINT, vtkDataObject::CELL, vtkDataObject::FIELD,
+         vtkDataObject::VERTEX, vtkDataObject::EDGE, vtkDataObject::ROW })
+  {
+    auto attributes = info->GetAttributeInformation(association);
+    for (int cc = 0; attributes && cc < attributes->GetNumberOfArrays(); ++cc)
+    {
+      auto arrayInfo = attributes->GetArrayInformation(cc);
+      const int dataType = arrayInfo->GetDataType();
+      if (!arrayInfo->GetName() || dataType == VTK_STRING || dataType == VTK_UNICODE_STRING ||
+        dataType == VTK_VARIANT)
+      {
+        continue;
+      }
+      double range[2];
+      if (!index->GetRange(association, arrayInfo->GetName(), -1, timesteps, range))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Extends the ranges of the arrays of `info` with the ones recorded in
+// `index` for `timesteps`.
+void ExtendRanges(vtkPVDataInformation* info, vtkPVTemporalRangeIndex* index,
+  const std::vector<double>& timesteps)
+{
+  for (int association : { vtkDataObject::POINT, vtkDataObject::CELL, vtkDataObject::FIELD,
+         vtkDataObject::VERTEX, vtkDataObject::EDGE, vtkDataObject::ROW })
+  {
+    auto attributes = info->GetAttributeInformation(association);
+    for (int cc = 0; attributes && cc < attributes->GetNumberOfArrays(); ++cc)
+    {
+      auto arrayInfo = attributes->GetArrayInformation(cc);
+      for (int comp = -1; comp < arrayInfo->GetNumberOfComponents(); ++comp)
+      {
+        double range[2];
+        if (index->GetRange(association, arrayInfo->GetName(), comp, timesteps, range))
+        {
+          arrayInfo->ExtendComponentRange(comp, range);
+        }
+      }
+    }
+  }
+}
+}
+
 vtkStandardNewMacro(vtkPVTemporalDataInformation);
 //----------------------------------------------------------------------------
-vtkPVTemporalDataInformation::vtkPVTemporalDataInformation() = default;
+vtkPVTemporalDataInformation::vtkPVTemporalDataInformation()
+{
+  // gathering updates the pipeline over all time steps.
+  this->Cacheable = false;
+}
 
 //----------------------------------------------------------------------------
-vtkPVTemporalDataInformation::~vtkPVTemporalDataInformation() = default;
+vtkPVTemporalDataInformation::~vtkPVTemporalDataInformation()
+{
+  this->SetSourceFileName(nullptr);
+}
 
 //----------------------------------------------------------------------------
 void vtkPVTemporalDataInformation::CopyFromObject(vtkObject* object)
@@ -90,27 +163,107 @@ void vtkPVTemporalDataInformation::CopyFromObject(vtkObject* object)
     return;
   }
 
-  double current_time = this->GetTime();
-  for (auto time : timesteps)
+  // The ranges are indexed by vtkPVPostFilter in the information of its input.
+  vtkAlgorithmOutput* source = port;
+  if (port->GetProducer()->IsA("vtkPVPostFilter"))
+  {
+    source = port->GetProducer()->GetInputConnection(0, 0);
+  }
+  vtkInformation* sourceInfo = source->GetProducer()->GetOutputInformation(source->GetIndex());
+  vtkPVTemporalRangeIndex* index = vtkPVTemporalRangeIndex::GetIndex(sourceInfo);
+  auto sourceExecutive =
+    vtkDemandDrivenPipeline::SafeDownCast(source->GetProducer()->GetExecutive());
+  if (sourceExecutive)
+  {
+    index->CheckPipelineMTime(sourceExecutive->GetPipelineMTime());
+  }
+
+  // All ranks must take the same decision since updating the pipeline may be
+  // a collective operation, hence the index is reduced first.
+  auto controller = vtkMultiProcessController::GetGlobalController();
+  const bool isRoot = !controller || controller->GetLocalProcessId() == 0;
+  std::string sidecar;
+  bool sidecarComplete = false;
+  if (this->SourceFileName && *this->SourceFileName)
   {
-    if (time == current_time)
+    sidecar = std::string(this->SourceFileName) + ".pvranges";
+    int newer = -1;
+    if (isRoot && vtksys::SystemTools::FileExists(sidecar, /*isFile=*/true) &&
+      vtksys::SystemTools::FileTimeCompare(sidecar, this->SourceFileName, &newer) && newer >= 0)
     {
-      // skip the timestep already seen.
-      continue;
+      sidecarComplete = index->Load(sidecar.c_str()) && index->HasTimeSteps(timesteps);
     }
-    pipelineInfo->Set(sddp->UPDATE_TIME_STEP(), time);
-    sddp->Update(port->GetIndex());
+  }
+  index->AllReduce(controller);
 
-    dobj = port->GetProducer()->GetOutputDataObject(port->GetIndex());
+  // arrays may be missing from the index on some ranks only.
+  int indexed = index->HasTimeSteps(timesteps) && ::HasRanges(this, index, timesteps) ? 1 : 0;
+  if (controller && controller->GetNumberOfProcesses() > 1)
+  {
+    int allIndexed = 0;
+    controller->AllReduce(&indexed, &allIndexed, 1, vtkCommunicator::MIN_OP);
+    indexed = allIndexed;
+  }
 
-    vtkNew<vtkPVDataInformation> dinfo;
-    dinfo->CopyFromObject(dobj);
-    this->AddInformation(dinfo);
+  if (indexed)
+  {
+    ::ExtendRanges(this, index, timesteps);
   }
+  else
+  {
+    double current_time = this->GetTime();
+    for (auto time : timesteps)
+    {
+      if (time == current_time)
+      {
+        // skip the timestep already seen.
+        continue;
+      }
+      pipelineInfo->Set(sddp->UPDATE_TIME_STEP(), time);
+      sddp->Update(port->GetIndex());
+
+      dobj = port->GetProducer()->GetOutputDataObject(port->GetIndex());
+
+      vtkNew<vtkPVDataInformation> dinfo;
+      dinfo->CopyFromObject(dobj);
+      this->AddInformation(dinfo);
+    }
+
+    if (!sidecar.empty())
+    {
+      // vtkPVPostFilter indexed each timestep while updating.
+      index->AllReduce(controller);
+    }
+  }
+
+  // the index may have been completed while updating, or earlier, e.g. during
+  // animation playback.
+  if (isRoot && !sidecar.empty() && !sidecarComplete && index->HasTimeSteps(timesteps))
+  {
+    index->Save(sidecar.c_str());
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTemporalDataInformation::CopyParametersToStream(vtkMultiProcessStream& str)
+{
+  this->Superclass::CopyParametersToStream(str);
+  str << std::string(this->SourceFileName ? this->SourceFileName : "");
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTemporalDataInformation::CopyParametersFromStream(vtkMultiProcessStream& str)
+{
+  this->Superclass::CopyParametersFromStream(str);
+  std::string filename;
+  str >> filename;
+  this->SetSourceFileName(filename.empty() ? nullptr : filename.c_str());
 }
 
 //----------------------------------------------------------------------------
 void vtkPVTemporalDataInformation::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "SourceFileName: " << (this->SourceFileName ? this->SourceFileName : "(nullptr)")
+     << endl;
 }
@@ -19,6 +19,12 @@
  * vtkPVTemporalDataInformation is used to gather data information over time.
  * It simply overrides `vtkPVDataInformation::CopyFromObject` to ensure that the
  * data information is collected from all timesteps and not just 1.
+ *
+ * When the vtkPVTemporalRangeIndex of the producer has the ranges of all the
+ * timesteps, e.g. after the animation was played once, the ranges of the
+ * arrays are looked up in it instead of updating the pipeline for each
+ * timestep. The other information, and the ranges of arrays that are not
+ * indexed, then only reflect the current timestep.
  */
 
 #ifndef vtkPVTemporalDataInformation_h
@@ -43,10 +49,33 @@ public:
    */
   void CopyFromObject(vtkObject* object) override;
 
+  //@{
+  /**
+   * When set, the vtkPVTemporalRangeIndex of the producer is also loaded from
+   * and saved to a sidecar file, `<SourceFileName>.pvranges`, so that it
+   * persists across sessions. The sidecar file is ignored when it is older
+   * than the source file.
+   */
+  vtkSetStringMacro(SourceFileName);
+  vtkGetStringMacro(SourceFileName);
+  //@}
+
+  //@{
+  /**
+   * Serialize/Deserialize the parameters that control how/what information is
+   * gathered. This are different from the ivars that constitute the gathered
+   * information itself.
+   */
+  void CopyParametersToStream(vtkMultiProcessStream&) override;
+  void CopyParametersFromStream(vtkMultiProcessStream&) override;
+  //@}
+
 protected:
   vtkPVTemporalDataInformation();
   ~vtkPVTemporalDataInformation() override;
 
+  char* SourceFileName = nullptr;
+
 private:
   vtkPVTemporalDataInformation(const vtkPVTemporalDataInformation&) = delete;
   void operator=(const vtkPVTemporalDataInformation&) = delete;
@@ -22,6 +22,7 @@
 #include "vtkDummyController.h"
 #include "vtkFloatingPointExceptions.h"
 #include "vtkInformation.h"
+#include "vtkLogTraceRecorder.h"
 #include "vtkLogger.h"
 #include "vtkMultiThreader.h"
 #include "vtkNew.h"
@@ -146,6 +147,42 @@ void HandleDisplay(int& argc, char**& argv)
 }
 }
 
+namespace
+{
+// Records log scopes when `--log-trace` is specified.
+vtkSmartPointer<vtkLogTraceRecorder> TraceRecorder;
+
+// Returns the `--log-trace` filename annotated with the role of the process
+// and its rank, so that processes started from the same directory, e.g. the
+// client and the server, do not overwrite each other's trace.
+std::string GetTraceFileName(vtkProcessModule::ProcessTypes type, const std::string& fname)
+{
+  std::string role;
+  switch (type)
+  {
+    case vtkProcessModule::PROCESS_CLIENT:
+      role = "paraview";
+      break;
+    case vtkProcessModule::PROCESS_SERVER:
+      role = "pvserver";
+      break;
+    case vtkProcessModule::PROCESS_DATA_SERVER:
+      role = "pvdataserver";
+      break;
+    case vtkProcessModule::PROCESS_RENDER_SERVER:
+      role = "pvrenderserver";
+      break;
+    case vtkProcessModule::PROCESS_BATCH:
+      role = "pvbatch";
+      break;
+    default:
+      break;
+  }
+  return vtkProcessModuleConfiguration::GetRankAnnotatedFileName(
+    role.empty() ? fname : fname + "." + role);
+}
+}
+
 //----------------------------------------------------------------------------
 // * STATICS
 vtkProcessModule::ProcessTypes vtkProcessModule::ProcessType = vtkProcessModule::PROCESS_INVALID;
@@ -271,6 +308,13 @@ bool vtkProcessModule::Initialize(ProcessTypes type, int& argc, char**& argv)
       vtkProcessModuleConfiguration::GetRankAnnotatedFileName(log_pair.first).c_str(),
       vtkLogger::TRUNCATE, log_pair.second);
   }
+  if (!config->GetLogTraceFileName().empty())
+  {
+    TraceRecorder = vtkSmartPointer<vtkLogTraceRecorder>::New();
+    TraceRecorder->SetController(vtkProcessModule::GlobalController);
+    TraceRecorder->SetVerbosity(config->GetLogTraceVerbosity());
+    TraceRecorder->StartRecording();
+  }
 
   // This is left over for legacy cases, just in case users are still using
   // this.
@@ -363,6 +407,15 @@ bool vtkProcessModule::Finalize()
   // destroy the process-module.
   vtkProcessModule::Singleton = nullptr;
 
+  if (TraceRecorder)
+  {
+    TraceRecorder->StopRecording();
+    const std::string fname = GetTraceFileName(vtkProcessModule::ProcessType,
+      vtkProcessModuleConfiguration::GetInstance()->GetLogTraceFileName());
+    TraceRecorder->WriteChromeTrace(fname.c_str());
+    TraceRecorder = nullptr;
+  }
+
   // We don't really need to call SetGlobalController(nullptr) since
   // it's really stored with a weak pointer.  We set it to nullptr anyways
   // in case it gets changed later to reference counting the pointer
@@ -105,6 +105,33 @@ bool vtkProcessModuleConfiguration::PopulateOptions(
     ->multi_option_policy(CLI::MultiOptionPolicy::TakeAll)
     ->type_name("TEXT:filename[,ENUM:verbosity] ...");
 
+  groupLogging
+    ->add_option("--log-trace",
+      [this](const CLI::results_t& results) {
+        const auto& value = results.back();
+        const auto separator = value.find_last_of(',');
+        this->LogTraceFileName = value.substr(0, separator);
+        this->LogTraceVerbosity = vtkLogger::VERBOSITY_TRACE;
+        if (separator != std::string::npos)
+        {
+          const auto verbosityString = value.substr(separator + 1);
+          this->LogTraceVerbosity = vtkLogger::ConvertToVerbosity(verbosityString.c_str());
+          if (this->LogTraceVerbosity == vtkLogger::VERBOSITY_INVALID)
+          {
+            vtkLogF(ERROR, "Invalid verbosity specified '%s'", verbosityString.c_str());
+            return false;
+          }
+        }
+        return true;
+      },
+      "Record log scopes on all ranks and write them, on exit, to the given file in the "
+      "Chrome trace event format, which can be loaded in `chrome://tracing` or Perfetto. "
+      "The filename is suffixed with the role of the process, e.g. `.pvserver`. "
+      "By default, scopes are recorded at TRACE(9) verbosity, which may be overridden "
+      "by adding suffix `,verbosity`.")
+    ->delimiter('+')
+    ->type_name("TEXT:filename[,ENUM:verbosity]");
+
   auto group = app->add_option_group("MPI", "MPI-specific options");
   auto mpi = group->add_flag(
     "--mpi", this->ForceMPIInit, "Initialize MPI on current process, even if not necessary.");
@@ -157,6 +184,8 @@ void vtkProcessModuleConfiguration::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "EnableStackTrace: " << this->EnableStackTrace << endl;
   os << indent << "LogStdErrVerbosity: " << this->LogStdErrVerbosity << endl;
   os << indent << "CSLogFileName: " << this->CSLogFileName.c_str() << endl;
+  os << indent << "LogTraceFileName: " << this->LogTraceFileName.c_str() << endl;
+  os << indent << "LogTraceVerbosity: " << this->LogTraceVerbosity << endl;
   os << indent << "LogFiles (count=" << this->LogFiles.size() << "):" << endl;
   for (auto& pair : this->LogFiles)
   {
@@ -103,6 +103,17 @@ public:
     return this->LogFiles;
   }
 
+  //@{
+  /**
+   * Get the filename to write the log scopes recorded on all ranks to, in
+   * the Chrome trace event format, and the verbosity of the recorded scopes.
+   * The trace is written to this filename suffixed with the role of the
+   * process, e.g. `.paraview` or `.pvserver`. See vtkLogTraceRecorder.
+   */
+  vtkGetMacro(LogTraceFileName, std::string);
+  vtkGetMacro(LogTraceVerbosity, vtkLogger::Verbosity);
+  //@}
+
   /**
    * Populate command line options.
    * `processType` indicates which type of ParaView process the options are
@@ -133,6 +144,8 @@ private:
   vtkLogger::Verbosity LogStdErrVerbosity = vtkLogger::VERBOSITY_INVALID;
   std::string CSLogFileName;
   std::vector<std::pair<std::string, vtkLogger::Verbosity> > LogFiles;
+  std::string LogTraceFileName;
+  vtkLogger::Verbosity LogTraceVerbosity = vtkLogger::VERBOSITY_TRACE;
   static vtkProcessModuleConfiguration* New();
 };
 
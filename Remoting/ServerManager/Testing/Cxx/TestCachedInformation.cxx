@@ -0,0 +1,105 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestCachedInformation.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that data information cached by vtkPVSessionCore is reused while
+// the pipeline does not change, and gathered again once it does. Cache hits
+// are counted from the messages vtkPVSessionCore logs.
+
+#include "vtkInitializationHelper.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPVDataInformation.h"
+#include "vtkPVLogger.h"
+#include "vtkPVSession.h"
+#include "vtkProcessModule.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
+
+#include <cstring>
+
+#define VERIFY(x, y)                                                                               \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    vtkLogF(ERROR, y);                                                                             \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+// Counts the information reused from the cache, as logged by vtkPVSessionCore.
+int CacheHits = 0;
+void CountCacheHits(void*, const vtkLogger::Message& message)
+{
+  if (message.message && strstr(message.message, "reusing cached vtkPVDataInformation"))
+  {
+    ++CacheHits;
+  }
+}
+
+vtkIdType GetNumberOfPoints(vtkSMSession* session, vtkSMProxy* proxy)
+{
+  vtkNew<vtkPVDataInformation> info;
+  session->GatherInformation(vtkPVSession::DATA_SERVER, info, proxy->GetGlobalID());
+  return info->GetNumberOfPoints();
+}
+
+int RunTest(vtkSMSession* session)
+{
+  vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+  vtkSmartPointer<vtkSMSourceProxy> wavelet;
+  wavelet.TakeReference(
+    vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("sources", "RTAnalyticSource")));
+  wavelet->UpdateVTKObjects();
+
+  VERIFY(GetNumberOfPoints(session, wavelet) == 0, "unexpected information before update.");
+  wavelet->UpdatePipeline();
+  CacheHits = 0;
+  VERIFY(GetNumberOfPoints(session, wavelet) == 21 * 21 * 21, "stale information after update.");
+  VERIFY(CacheHits == 0, "information reused after update.");
+  VERIFY(GetNumberOfPoints(session, wavelet) == 21 * 21 * 21, "unexpected cached information.");
+  VERIFY(CacheHits == 1, "information not reused while the pipeline did not change.");
+
+  vtkSMPropertyHelper(wavelet, "WholeExtent").Set(0, -5);
+  vtkSMPropertyHelper(wavelet, "WholeExtent").Set(2, -5);
+  vtkSMPropertyHelper(wavelet, "WholeExtent").Set(4, -5);
+  wavelet->UpdateVTKObjects();
+  wavelet->UpdatePipeline();
+  CacheHits = 0;
+  VERIFY(GetNumberOfPoints(session, wavelet) == 16 * 16 * 16, "stale information after change.");
+  VERIFY(CacheHits == 0, "information reused after change.");
+  VERIFY(GetNumberOfPoints(session, wavelet) == 16 * 16 * 16, "unexpected cached information.");
+  VERIFY(CacheHits == 1, "information not reused while the pipeline did not change.");
+  return EXIT_SUCCESS;
+}
+}
+
+int TestCachedInformation(int, char* argv[])
+{
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  // cache hits are logged at the pipeline verbosity.
+  vtkPVLogger::SetPipelineVerbosity(vtkLogger::VERBOSITY_1);
+  vtkLogger::AddCallback("cache-hits", &CountCacheHits, nullptr, vtkLogger::VERBOSITY_1);
+
+  vtkNew<vtkSMSession> session;
+  const int result = RunTest(session);
+
+  vtkLogger::RemoveCallback("cache-hits");
+
+  vtkInitializationHelper::Finalize();
+  return result;
+}
@@ -14,18 +14,23 @@
 =========================================================================*/
 #include "vtkPVSessionCore.h"
 
+#include "vtkAlgorithm.h"
 #include "vtkClientServerID.h"
 #include "vtkClientServerInterpreter.h"
 #include "vtkClientServerInterpreterInitializer.h"
 #include "vtkClientServerStream.h"
 #include "vtkClientServerStreamInstantiator.h"
 #include "vtkCollection.h"
+#include "vtkDataObject.h"
+#include "vtkExecutive.h"
+#include "vtkInformation.h"
 #include "vtkMPIMToNSocketConnection.h"
 #include "vtkMemberFunctionCommand.h"
 #include "vtkMultiProcessController.h"
 #include "vtkMultiProcessStream.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVInformation.h"
+#include "vtkPVLogger.h"
 #include "vtkPVSession.h"
 #include "vtkPVSessionCoreInterpreterHelper.h"
 #include "vtkProcessModule.h"
@@ -38,10 +43,14 @@
 
 #include "vtksys/FStream.hxx"
 
+#include <algorithm>
 #include <cassert>
+#include <map>
 #include <set>
 #include <sstream>
 #include <string>
+#include <tuple>
+#include <vector>
 
 #define LOG(x)                                                                                     \
   if (this->LogStream)                                                                             \
@@ -79,6 +88,39 @@ void RMICallback(
       break;
   }
 }
+
+// Returns the object information is gathered from for a vtkSIObject.
+vtkObject* GetInformationSource(vtkSIObject* siObject)
+{
+  vtkSIProxy* siProxy = vtkSIProxy::SafeDownCast(siObject);
+  return siProxy ? vtkObject::SafeDownCast(siProxy->GetVTKObject()) : siObject;
+}
+
+// Returns the modification time of an object and, for algorithms, of the
+// information and data objects on their output ports, e.g. time steps or
+// extents.
+vtkMTimeType GetPipelineMTime(vtkObject* object)
+{
+  vtkMTimeType mtime = object->GetMTime();
+  if (vtkAlgorithm* algo = vtkAlgorithm::SafeDownCast(object))
+  {
+    // don't use vtkAlgorithm::GetOutputDataObject(), which would update the
+    // data objects.
+    vtkExecutive* executive = algo->GetExecutive();
+    for (int port = 0; port < algo->GetNumberOfOutputPorts(); ++port)
+    {
+      if (vtkInformation* outInfo = executive->GetOutputInformation(port))
+      {
+        mtime = std::max(mtime, outInfo->GetMTime());
+      }
+      if (vtkDataObject* data = executive->GetOutputData(port))
+      {
+        mtime = std::max(mtime, data->GetMTime());
+      }
+    }
+  }
+  return mtime;
+}
 };
 //****************************************************************************/
 //                        Internal Class
@@ -208,6 +250,27 @@ public:
     }
   }
   //---------------------------------------------------------------------------
+  void GetAllSIObjects(vtkCollection* collection)
+  {
+    for (const auto& item : this->SIObjectMap)
+    {
+      if (item.second)
+      {
+        collection->AddItem(item.second);
+      }
+    }
+  }
+  //---------------------------------------------------------------------------
+  void ClearInformationCache(vtkTypeUInt32 globalUniqueId)
+  {
+    auto iter = this->InformationCache.lower_bound(
+      InformationCacheKeyType(globalUniqueId, false, std::string(), std::vector<unsigned char>()));
+    while (iter != this->InformationCache.end() && std::get<0>(iter->first) == globalUniqueId)
+    {
+      iter = this->InformationCache.erase(iter);
+    }
+  }
+  //---------------------------------------------------------------------------
   void PrintRemoteMap()
   {
     RemoteObjectMapType::iterator iter = this->RemoteObjectMap.begin();
@@ -228,6 +291,20 @@ public:
   unsigned long InterpreterObserverID;
   std::map<vtkTypeUInt32, vtkSMMessage> MessageCacheMap;
   std::set<int> KnownClients;
+  // Receive buffer for streams broadcast to satellites.
+  std::vector<unsigned char> ExecuteStreamBuffer;
+
+  // Cacheable information gathered before, keyed by global id, whether
+  // satellites were skipped, information class name and serialized
+  // parameters, along with the pipeline MTime it was gathered at.
+  typedef std::tuple<vtkTypeUInt32, bool, std::string, std::vector<unsigned char> >
+    InformationCacheKeyType;
+  struct InformationCacheItem
+  {
+    vtkMTimeType PipelineMTime;
+    vtkClientServerStream Information;
+  };
+  std::map<InformationCacheKeyType, InformationCacheItem> InformationCache;
   // Used for collaboration as client may trigger invalid server request when
   // they are in a transitional state.
   bool DisableErrorMacro;
@@ -595,13 +672,19 @@ void vtkPVSessionCore::ExecuteStreamSatelliteCallback()
 {
   int byte_size[2] = { 0, 0 };
   this->ParallelController->Broadcast(byte_size, 2, 0);
-  unsigned char* raw_data = new unsigned char[byte_size[0] + 1];
-  this->ParallelController->Broadcast(raw_data, byte_size[0], 0);
+
+  // Reuse the receive buffer across calls. It is taken out of the
+  // internals while the stream executes in case execution re-enters
+  // this callback.
+  std::vector<unsigned char> raw_data;
+  raw_data.swap(this->Internals->ExecuteStreamBuffer);
+  raw_data.resize(byte_size[0] + 1);
+  this->ParallelController->Broadcast(raw_data.data(), byte_size[0], 0);
 
   vtkClientServerStream stream;
-  stream.SetData(raw_data, byte_size[0]);
+  stream.SetData(raw_data.data(), byte_size[0]);
   this->ExecuteStreamInternal(stream, byte_size[1] != 0);
-  delete[] raw_data;
+  raw_data.swap(this->Internals->ExecuteStreamBuffer);
 }
 
 //----------------------------------------------------------------------------
@@ -615,10 +698,24 @@ void vtkPVSessionCore::ExecuteStreamInternal(
 
   this->Interpreter->ClearLastResult();
 
+  const vtkTypeUInt64 hits = this->Interpreter->GetDispatchCacheHits();
+  const vtkTypeUInt64 misses = this->Interpreter->GetDispatchCacheMisses();
+  const double time = this->Interpreter->GetProcessingTime();
+
   int temp = this->Interpreter->GetGlobalWarningDisplay();
   this->Interpreter->SetGlobalWarningDisplay(ignore_errors ? 0 : 1);
   this->Interpreter->ProcessStream(stream);
   this->Interpreter->SetGlobalWarningDisplay(temp);
+
+  vtkVLogF(PARAVIEW_LOG_EXECUTION_VERBOSITY(),
+    "interpreted %d message(s) in %.6fs (dispatch cache: %llu hit(s), %llu miss(es); "
+    "totals: %llu hit(s), %llu miss(es), %.3fs)",
+    stream.GetNumberOfMessages(), this->Interpreter->GetProcessingTime() - time,
+    static_cast<unsigned long long>(this->Interpreter->GetDispatchCacheHits() - hits),
+    static_cast<unsigned long long>(this->Interpreter->GetDispatchCacheMisses() - misses),
+    static_cast<unsigned long long>(this->Interpreter->GetDispatchCacheHits()),
+    static_cast<unsigned long long>(this->Interpreter->GetDispatchCacheMisses()),
+    this->Interpreter->GetProcessingTime());
 }
 
 //----------------------------------------------------------------------------
@@ -747,6 +844,7 @@ void vtkPVSessionCore::UnRegisterSIObjectInternal(vtkSMMessage* message)
       << "----------------------------------------------------------------\n"
       << message->DebugString().c_str());
   this->Internals->UnRegisterSI(message->global_id(), message->client_id());
+  this->Internals->ClearInformationCache(message->global_id());
 }
 //----------------------------------------------------------------------------
 void vtkPVSessionCore::RegisterSIObjectInternal(vtkSMMessage* message)
@@ -780,17 +878,9 @@ bool vtkPVSessionCore::GatherInformationInternal(
     return false;
   }
 
-  vtkSIProxy* siProxy = vtkSIProxy::SafeDownCast(siObject);
-  if (siProxy /*&& !information->GetUseSIObject()*/)
-  {
-    vtkObject* object = vtkObject::SafeDownCast(siProxy->GetVTKObject());
-    information->CopyFromObject(object);
-  }
-  else
-  {
-    // gather information from SIObject itself.
-    information->CopyFromObject(siObject);
-  }
+  // gather information from the VTK object of proxies, else from the
+  // SIObject itself.
+  information->CopyFromObject(::GetInformationSource(siObject));
   return true;
 }
 
@@ -809,6 +899,34 @@ bool vtkPVSessionCore::GatherInformation(
   const bool skip_satellites = (information->GetRootOnly() ||
     (location & vtkProcessModule::SERVERS) == 0 || this->SymmetricMPIMode);
 
+  // reuse cacheable information if the object it was gathered from and its
+  // outputs were not modified since, without involving the satellites.
+  vtkSmartPointer<vtkObject> source;
+  vtkInternals::InformationCacheKeyType cacheKey;
+  if (information->GetCacheable() && globalid != 0)
+  {
+    source = ::GetInformationSource(this->GetSIObject(globalid));
+  }
+  if (source)
+  {
+    vtkMultiProcessStream parameters;
+    information->CopyParametersToStream(parameters);
+    std::vector<unsigned char> rawParameters;
+    parameters.GetRawData(rawParameters);
+    cacheKey = vtkInternals::InformationCacheKeyType(
+      globalid, skip_satellites, information->GetClassName(), rawParameters);
+
+    auto iter = this->Internals->InformationCache.find(cacheKey);
+    if (iter != this->Internals->InformationCache.end() &&
+      iter->second.PipelineMTime == ::GetPipelineMTime(source))
+    {
+      vtkVLogF(PARAVIEW_LOG_PIPELINE_VERBOSITY(), "reusing cached %s for %u",
+        information->GetClassName(), globalid);
+      information->CopyFromStream(&iter->second.Information);
+      return true;
+    }
+  }
+
   // send message to satellites and then start processing.
   // this must be done before calling `GatherInformationInternal` on this process to
   // avoid deadlocks if the gather results in pipeline updates
@@ -837,8 +955,17 @@ bool vtkPVSessionCore::GatherInformation(
 
   // Now collect local information.
   const bool status = this->GatherInformationInternal(information, globalid);
+  const bool collected = skip_satellites || this->CollectInformation(information);
 
-  return (skip_satellites || this->CollectInformation(information)) && status;
+  // the pipeline may have been updated while gathering.
+  if (source && status && collected)
+  {
+    auto& item = this->Internals->InformationCache[cacheKey];
+    item.PipelineMTime = ::GetPipelineMTime(source);
+    item.Information.Reset();
+    information->CopyToStream(&item.Information);
+  }
+  return collected && status;
 }
 
 //----------------------------------------------------------------------------
@@ -869,23 +996,11 @@ void vtkPVSessionCore::GatherInformationStatelliteCallback()
 }
 
 //----------------------------------------------------------------------------
-#define SafeDeleteArray(array_ptr)                                                                 \
-  {                                                                                                \
-    if ((array_ptr) != nullptr)                                                                    \
-    {                                                                                              \
-      delete[](array_ptr);                                                                         \
-      (array_ptr) = nullptr;                                                                       \
-    }                                                                                              \
-  }
-
 bool vtkPVSessionCore::CollectInformation(vtkPVInformation* info)
 {
-  // Sanity checks
-  assert("pre: nullptr PV information!" && (info != nullptr));
-
-  // STEP 0: temporary variables
-  int rank = this->ParallelController->GetLocalProcessId();
-  int nranks = this->ParallelController->GetNumberOfProcesses();
+  auto controller = this->ParallelController;
+  const int rank = controller->GetLocalProcessId();
+  const int nranks = controller->GetNumberOfProcesses();
 
   if (nranks == 1)
   {
@@ -893,82 +1008,61 @@ bool vtkPVSessionCore::CollectInformation(vtkPVInformation* info)
     return true;
   }
 
-  vtkIdType* rcvcounts = nullptr;     /* significant only at rank 0 */
-  vtkIdType* offSet = nullptr;        /* significant only at rank 0 */
-  int rbufsize = 0;                   /* significant only at rank 0 */
-  unsigned char* rcvbuffer = nullptr; /* significant only at rank 0 */
-
-  // STEP 1: Initialize data-structures at rank 0
-  if (rank == 0)
+  // Binomial tree reduction: at each step, ranks that are an odd multiple of
+  // `step` send their partial information to `rank - step` and are done,
+  // while the others add the partial information of `rank + step`, if any.
+  // Information is hence added in rank order in log2(nranks) steps, and the
+  // root ends up with the information of all ranks.
+  //
+  // `info` is nullptr on satellites that failed to create the information
+  // object, these still take part in the reduction to avoid deadlocks but
+  // only send empty streams.
+  for (int step = 1; step < nranks; step *= 2)
   {
-    rcvcounts = new vtkIdType[nranks];
-    offSet = new vtkIdType[nranks];
-  } // END if rank == 0
-
-  // STEP 2: Serialize the vtkPVInformation object
-  vtkClientServerStream stream;
-  info->CopyToStream(&stream);
-
-  const unsigned char* data;
-  size_t length;
-
-  // Get pointer to the raw stream data. Note, this is a shallow copy, no
-  // need to delete the data.
-  stream.GetData(&data, &length);
-  vtkIdType local_length = static_cast<vtkIdType>(length);
-
-  // STEP 3: Get number of bytes that each process will send
-  this->ParallelController->Gather(&local_length, rcvcounts, 1, 0);
-
-  // STEP 4: Allocate temporary arrays at rank 0
-  if (rank == 0)
-  {
-    // STEP 4.1: Calculate rcvbuffer size & allocate rcvbuffer
-    rbufsize = rcvcounts[0];
-    for (int i = 1; i < nranks; ++i)
+    if (rank % (2 * step) != 0)
     {
-      rbufsize += rcvcounts[i];
+      vtkClientServerStream stream;
+      if (info)
+      {
+        info->CopyToStream(&stream);
+      }
+
+      // Get pointer to the raw stream data. Note, this is a shallow copy, no
+      // need to delete the data.
+      const unsigned char* data;
+      size_t length;
+      stream.GetData(&data, &length);
+      vtkIdType local_length = info ? static_cast<vtkIdType>(length) : 0;
+      controller->Send(&local_length, 1, rank - step, ROOT_SATELLITE_INFO_TAG);
+      if (local_length > 0)
+      {
+        controller->Send(data, local_length, rank - step, ROOT_SATELLITE_INFO_TAG);
+      }
+      break;
     }
-    rcvbuffer = new unsigned char[rbufsize];
 
-    // STEP 4.2: populate offset array
-    offSet[0] = 0;
-    for (int i = 1; i < nranks; ++i)
+    if (rank + step < nranks)
     {
-      offSet[i] = offSet[i - 1] + rcvcounts[i - 1];
+      vtkIdType remote_length = 0;
+      controller->Receive(&remote_length, 1, rank + step, ROOT_SATELLITE_INFO_TAG);
+      if (remote_length > 0)
+      {
+        std::vector<unsigned char> buffer(remote_length);
+        controller->Receive(buffer.data(), remote_length, rank + step, ROOT_SATELLITE_INFO_TAG);
+        if (info)
+        {
+          vtkClientServerStream rcvStream;
+          rcvStream.SetData(buffer.data(), remote_length);
+          vtkSmartPointer<vtkPVInformation> tempInfo;
+          tempInfo.TakeReference(info->NewInstance());
+          tempInfo->CopyFromStream(&rcvStream);
+          info->AddInformation(tempInfo);
+        }
+      }
     }
-  } // END if rank==0
-
-  // STEP 5: GatherV all data from satellites
-  this->ParallelController->GatherV(data, rcvbuffer, local_length, rcvcounts, offSet, 0);
+  }
 
-  // STEP 6: Deserialize data from other ranks at rank 0 and add them to
-  // the information object associated with rank 0.
-  if (rank == 0)
-  {
-    vtkClientServerStream rcvStream;
-    for (int i = 1; i < nranks; ++i)
-    {
-      rcvStream.SetData(&rcvbuffer[offSet[i]], rcvcounts[i]);
-      vtkPVInformation* tempInfo = info->NewInstance();
-      tempInfo->CopyFromStream(&rcvStream);
-      info->AddInformation(tempInfo);
-      tempInfo->Delete();
-    } // END for all remote ranks
-  }   // END if rank == 0
-
-  // STEP 7: De-allocate temporary arrays at rank 0
-  SafeDeleteArray(rcvcounts);
-  SafeDeleteArray(offSet);
-  SafeDeleteArray(rcvbuffer);
-
-  // Sanity checks -- ensure we return all dynamically allocated memory
-  assert("post: rcvcounts should be nullptr" && (rcvcounts == nullptr));
-  assert("post: offSet should be nullptr" && (offSet == nullptr));
-  assert("post: rcvbuffer should be nullptr" && (rcvbuffer == nullptr));
-
-  // STEP 8: Barrier synchronization
-  this->ParallelController->Barrier();
+  controller->Barrier();
   return true;
 }
 
@@ -991,6 +1085,12 @@ void vtkPVSessionCore::GetAllRemoteObjects(vtkCollection* collection)
   this->Internals->GetAllRemoteObjects(collection);
 }
 
+//----------------------------------------------------------------------------
+void vtkPVSessionCore::GetAllSIObjects(vtkCollection* collection)
+{
+  this->Internals->GetAllSIObjects(collection);
+}
+
 //----------------------------------------------------------------------------
 const vtkClientServerStream& vtkPVSessionCore::GetLastResult()
 {
@@ -123,6 +123,9 @@ public:
   /**
    * Gather information about an object referred by the \c globalid.
    * \c location identifies the processes to gather the information from.
+   * Cacheable information (see vtkPVInformation::GetCacheable) is reused
+   * without gathering it again as long as the object and its outputs are not
+   * modified.
    */
   virtual bool GatherInformation(
     vtkTypeUInt32 location, vtkPVInformation* information, vtkTypeUInt32 globalid);
@@ -182,6 +185,13 @@ public:
    */
   virtual void GetAllRemoteObjects(vtkCollection* collection);
 
+  /**
+   * Fill a vtkCollection with all the SIObjects currently registered
+   * on this process. This is useful to inspect the server side state, e.g.
+   * to account for the memory used by the pipeline objects.
+   */
+  virtual void GetAllSIObjects(vtkCollection* collection);
+
   /**
    * Delete SIObject that are held by clients that disappeared
    * from the given list.
@@ -211,7 +221,8 @@ protected:
   bool GatherInformationInternal(vtkPVInformation* information, vtkTypeUInt32 globalid);
 
   /**
-   * Gather information across MPI satellites.
+   * Gather information across MPI satellites, merging it along a binary tree
+   * rooted at the root node.
    */
   bool CollectInformation(vtkPVInformation*);
 
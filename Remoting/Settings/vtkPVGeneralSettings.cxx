@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkPVGeneralSettings.h"
 
+#include "vtkFileSeriesReader.h"
 #include "vtkObjectFactory.h"
 #include "vtkProcessModule.h"
 #include "vtkProcessModuleAutoMPI.h"
@@ -59,6 +60,7 @@ vtkPVGeneralSettings::vtkPVGeneralSettings()
   , TransferFunctionResetMode(0)
 #endif
   , ScalarBarMode(vtkPVGeneralSettings::AUTOMATICALLY_HIDE_SCALAR_BARS)
+  , UseTemporalRangeIndexFiles(false)
   , AnimationGeometryCacheLimit(0)
   , AnimationTimePrecision(6)
   , ShowAnimationShortcuts(0)
@@ -173,6 +175,38 @@ void vtkPVGeneralSettings::SetAnimationGeometryCacheLimit(unsigned long val)
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkPVGeneralSettings::SetFileSeriesReaderCacheLimit(unsigned long val)
+{
+  if (this->GetFileSeriesReaderCacheLimit() != val)
+  {
+    vtkFileSeriesReader::SetCacheLimit(val);
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+unsigned long vtkPVGeneralSettings::GetFileSeriesReaderCacheLimit()
+{
+  return vtkFileSeriesReader::GetCacheLimit();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVGeneralSettings::SetFileSeriesReaderPrefetchDepth(int val)
+{
+  if (this->GetFileSeriesReaderPrefetchDepth() != val && val >= 0)
+  {
+    vtkFileSeriesReader::SetPrefetchDepth(val);
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkPVGeneralSettings::GetFileSeriesReaderPrefetchDepth()
+{
+  return vtkFileSeriesReader::GetPrefetchDepth();
+}
+
 //----------------------------------------------------------------------------
 void vtkPVGeneralSettings::SetIgnoreNegativeLogAxisWarning(bool val)
 {
@@ -298,8 +332,12 @@ void vtkPVGeneralSettings::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "DefaultViewType: " << this->DefaultViewType << "\n";
   os << indent << "TransferFunctionResetMode: " << this->TransferFunctionResetMode << "\n";
   os << indent << "ScalarBarMode: " << this->ScalarBarMode << "\n";
+  os << indent << "UseTemporalRangeIndexFiles: " << this->UseTemporalRangeIndexFiles << "\n";
   os << indent << "CacheGeometryForAnimation: " << this->CacheGeometryForAnimation << "\n";
   os << indent << "AnimationGeometryCacheLimit: " << this->AnimationGeometryCacheLimit << "\n";
+  os << indent << "FileSeriesReaderCacheLimit: " << this->GetFileSeriesReaderCacheLimit() << "\n";
+  os << indent << "FileSeriesReaderPrefetchDepth: " << this->GetFileSeriesReaderPrefetchDepth()
+     << "\n";
   os << indent << "PropertiesPanelMode: " << this->PropertiesPanelMode << "\n";
   os << indent << "LockPanels: " << this->LockPanels << "\n";
 }
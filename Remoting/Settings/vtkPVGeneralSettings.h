@@ -136,6 +136,17 @@ public:
   void SetScalarBarMode(int);
   //@}
 
+  //@{
+  /**
+   * When enabled, rescaling color maps to the data range over all timesteps
+   * saves the ranges of the arrays read from a file in a sidecar file next to
+   * it, `<filename>.pvranges`, and reuses them afterwards instead of reading
+   * all timesteps again. Disabled by default.
+   */
+  vtkGetMacro(UseTemporalRangeIndexFiles, bool);
+  vtkSetMacro(UseTemporalRangeIndexFiles, bool);
+  //@}
+
   //@{
   /**
    * Set when animation geometry caching is enabled.
@@ -152,6 +163,25 @@ public:
   vtkGetMacro(AnimationGeometryCacheLimit, unsigned long);
   //@}
 
+  //@{
+  /**
+   * Set the memory limit, in MBs, each file series reader may use to keep the
+   * outputs of previously read files. 0 disables the cache.
+   */
+  void SetFileSeriesReaderCacheLimit(unsigned long val);
+  unsigned long GetFileSeriesReaderCacheLimit();
+  //@}
+
+  //@{
+  /**
+   * Set the number of upcoming files of a file series each reader reads ahead
+   * in the background, e.g. while the current time step renders during
+   * animation playback. 0 disables prefetching.
+   */
+  void SetFileSeriesReaderPrefetchDepth(int val);
+  int GetFileSeriesReaderPrefetchDepth();
+  //@}
+
   //@{
   /**
    * Set the precision of the animation time toolbar.
@@ -320,6 +350,7 @@ protected:
   char* DefaultViewType;
   int TransferFunctionResetMode;
   int ScalarBarMode;
+  bool UseTemporalRangeIndexFiles;
   bool CacheGeometryForAnimation;
   unsigned long AnimationGeometryCacheLimit;
   int AnimationTimePrecision;
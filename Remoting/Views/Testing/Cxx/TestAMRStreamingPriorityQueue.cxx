@@ -0,0 +1,255 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestAMRStreamingPriorityQueue.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Streams the blocks of an AMR hierarchy refined around a spherical shell
+// using each priority mode of vtkAMRStreamingPriorityQueue and reports the
+// number of blocks delivered before the image converges, i.e. before all
+// visible blocks refining cells larger than the pixel threshold are delivered.
+
+#include "vtkAMRBox.h"
+#include "vtkAMRInformation.h"
+#include "vtkAMRStreamingPriorityQueue.h"
+#include "vtkCamera.h"
+#include "vtkLogger.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkOverlappingAMR.h"
+#include "vtkSmartPointer.h"
+#include "vtkStructuredData.h"
+
+#include <cmath>
+#include <iostream>
+#include <set>
+#include <vector>
+
+#define VERIFY(x, y)                                                                               \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    vtkLogF(ERROR, y);                                                                             \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+const int ViewportSize[2] = { 800, 600 };
+const double PixelThreshold = 2.0;
+
+// Creates a 4 levels hierarchy, with blocks of 8^3 cells, refined around a
+// spherical shell of radius 10 centered in the 32^3 root grid.
+vtkSmartPointer<vtkOverlappingAMR> CreateAMR()
+{
+  const int numLevels = 4;
+  const int blockSize = 8;
+  std::vector<std::vector<vtkAMRBox> > boxes(numLevels);
+  for (int level = 0; level < numLevels; ++level)
+  {
+    const int blocksPerAxis = (32 / blockSize) << level;
+    const double spacing = 1.0 / (1 << level);
+    const double halfDiagonal = std::sqrt(3.0) * blockSize * spacing / 2;
+    for (int k = 0; k < blocksPerAxis; ++k)
+    {
+      for (int j = 0; j < blocksPerAxis; ++j)
+      {
+        for (int i = 0; i < blocksPerAxis; ++i)
+        {
+          const int ijk[3] = { i, j, k };
+          double distance = 0;
+          for (int axis = 0; axis < 3; ++axis)
+          {
+            const double center = (ijk[axis] + 0.5) * blockSize * spacing;
+            distance += (center - 16) * (center - 16);
+          }
+          if (level == 0 || std::abs(std::sqrt(distance) - 10) < halfDiagonal)
+          {
+            const int lo[3] = { i * blockSize, j * blockSize, k * blockSize };
+            const int hi[3] = { lo[0] + blockSize - 1, lo[1] + blockSize - 1,
+              lo[2] + blockSize - 1 };
+            boxes[level].push_back(vtkAMRBox(lo, hi));
+          }
+        }
+      }
+    }
+  }
+
+  std::vector<int> blocksPerLevel;
+  for (const auto& levelBoxes : boxes)
+  {
+    blocksPerLevel.push_back(static_cast<int>(levelBoxes.size()));
+  }
+  auto amr = vtkSmartPointer<vtkOverlappingAMR>::New();
+  amr->Initialize(numLevels, &blocksPerLevel[0]);
+  amr->SetGridDescription(VTK_XYZ_GRID);
+  const double origin[3] = { 0, 0, 0 };
+  amr->SetOrigin(origin);
+  for (int level = 0; level < numLevels; ++level)
+  {
+    const double spacing[3] = { 1.0 / (1 << level), 1.0 / (1 << level), 1.0 / (1 << level) };
+    amr->SetSpacing(level, spacing);
+    amr->SetRefinementRatio(level, 2);
+    for (unsigned int cc = 0; cc < boxes[level].size(); ++cc)
+    {
+      amr->SetAMRBox(level, cc, boxes[level][cc]);
+    }
+  }
+  return amr;
+}
+
+void GetViewPlanes(const double position[3], double planes[24])
+{
+  vtkNew<vtkCamera> camera;
+  camera->SetFocalPoint(16, 16, 16);
+  camera->SetPosition(position[0], position[1], position[2]);
+  camera->SetViewUp(0, 1, 0);
+  camera->SetClippingRange(0.01, 1000);
+  camera->GetFrustumPlanes(static_cast<double>(ViewportSize[0]) / ViewportSize[1], planes);
+}
+
+// Returns the composite ids of the blocks that are visible and refine cells
+// larger than PixelThreshold. This is a conservative estimate computed
+// independently of vtkAMRStreamingPriorityQueue.
+std::set<unsigned int> GetNeededBlocks(vtkAMRInformation* info, const double position[3])
+{
+  vtkNew<vtkCamera> camera;
+  camera->SetFocalPoint(16, 16, 16);
+  camera->SetPosition(position[0], position[1], position[2]);
+  double planes[24];
+  GetViewPlanes(position, planes);
+  double direction[3];
+  camera->GetDirectionOfProjection(direction);
+  const double pixelsPerUnitAtUnitDistance =
+    ViewportSize[1] / (2 * std::tan(vtkMath::RadiansFromDegrees(camera->GetViewAngle() / 2)));
+
+  std::set<unsigned int> needed;
+  for (unsigned int cc = 0; cc < info->GetTotalNumberOfBlocks(); ++cc)
+  {
+    unsigned int level, index;
+    info->ComputeIndexPair(cc, level, index);
+    double bounds[6];
+    info->GetBounds(level, index, bounds);
+
+    bool visible = true;
+    for (int plane = 0; plane < 6 && visible; ++plane)
+    {
+      const double* p = planes + 4 * plane;
+      const double corner[3] = { p[0] > 0 ? bounds[1] : bounds[0],
+        p[1] > 0 ? bounds[3] : bounds[2], p[2] > 0 ? bounds[5] : bounds[4] };
+      visible = vtkMath::Dot(p, corner) + p[3] >= 0;
+    }
+    if (!visible)
+    {
+      continue;
+    }
+    if (level == 0)
+    {
+      needed.insert(cc);
+      continue;
+    }
+
+    double spacing[3];
+    info->GetSpacing(level - 1, spacing);
+    const double center[3] = { (bounds[0] + bounds[1]) / 2, (bounds[2] + bounds[3]) / 2,
+      (bounds[4] + bounds[5]) / 2 };
+    const double offset[3] = { center[0] - position[0], center[1] - position[1],
+      center[2] - position[2] };
+    const double depth = vtkMath::Dot(offset, direction);
+    if (depth <= 0 || spacing[0] * pixelsPerUnitAtUnitDistance / depth >= PixelThreshold)
+    {
+      needed.insert(cc);
+    }
+  }
+  return needed;
+}
+
+struct StreamingResult
+{
+  size_t Delivered = 0;
+  size_t DeliveredBeforeConvergence = 0;
+  bool Converged = false;
+};
+
+StreamingResult Stream(vtkAMRStreamingPriorityQueue* queue, const double planes[24],
+  const std::set<unsigned int>& needed)
+{
+  StreamingResult result;
+  std::set<unsigned int> remaining = needed;
+  queue->Update(planes);
+  while (!queue->IsEmpty())
+  {
+    const unsigned int id = queue->Pop();
+    ++result.Delivered;
+    if (remaining.erase(id) && remaining.empty())
+    {
+      result.DeliveredBeforeConvergence = result.Delivered;
+    }
+  }
+  result.Converged = remaining.empty();
+  return result;
+}
+}
+
+int TestAMRStreamingPriorityQueue(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  auto amr = CreateAMR();
+  vtkAMRInformation* info = amr->GetAMRInfo();
+  std::cout << "Number of blocks: " << info->GetTotalNumberOfBlocks() << std::endl;
+
+  const double overview[3] = { 16, 16, 300 };
+  const double closeUp[3] = { 16, 16, 30 };
+  for (const double* position : { overview, closeUp })
+  {
+    double planes[24];
+    GetViewPlanes(position, planes);
+    const auto needed = GetNeededBlocks(info, position);
+
+    StreamingResult results[2];
+    for (int mode = vtkAMRStreamingPriorityQueue::COVERAGE;
+         mode <= vtkAMRStreamingPriorityQueue::SCREEN_SPACE_ERROR; ++mode)
+    {
+      vtkNew<vtkAMRStreamingPriorityQueue> queue;
+      queue->SetController(nullptr);
+      queue->SetPriorityMode(mode);
+      queue->SetPixelThreshold(PixelThreshold);
+      queue->SetViewportSize(ViewportSize[0], ViewportSize[1]);
+      queue->Initialize(info);
+      results[mode] = Stream(queue, planes, needed);
+      std::cout << "camera at z=" << position[2]
+                << (mode == vtkAMRStreamingPriorityQueue::COVERAGE ? ", coverage"
+                                                                   : ", screen space error")
+                << ": " << needed.size() << " blocks needed, "
+                << results[mode].DeliveredBeforeConvergence << " blocks delivered before "
+                << "convergence, " << results[mode].Delivered << " blocks delivered" << std::endl;
+      VERIFY(results[mode].Converged, "not all needed blocks were delivered.");
+    }
+    VERIFY(results[0].Delivered == info->GetTotalNumberOfBlocks(),
+      "all blocks should be delivered using COVERAGE priorities.");
+    VERIFY(results[1].Delivered < results[0].Delivered,
+      "SCREEN_SPACE_ERROR priorities should deliver fewer blocks.");
+  }
+
+  // Blocks deferred with one view are delivered when the view changes.
+  vtkNew<vtkAMRStreamingPriorityQueue> queue;
+  queue->SetController(nullptr);
+  queue->SetPriorityMode(vtkAMRStreamingPriorityQueue::SCREEN_SPACE_ERROR);
+  queue->SetPixelThreshold(PixelThreshold);
+  queue->SetViewportSize(ViewportSize[0], ViewportSize[1]);
+  queue->Initialize(info);
+  double planes[24];
+  GetViewPlanes(overview, planes);
+  Stream(queue, planes, std::set<unsigned int>());
+  VERIFY(queue->IsEmpty() && queue->HasDeferredBlocks(), "deferred blocks expected.");
+  GetViewPlanes(closeUp, planes);
+  auto result = Stream(queue, planes, std::set<unsigned int>());
+  VERIFY(result.Delivered > 0, "deferred blocks should be delivered after zooming in.");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,118 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestMemoryCensusInformation.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Accounts for the arrays of a wavelet source and a pass through filter
+// sharing its arrays, and checks that shared buffers are only counted once.
+
+#include "vtkClientServerStream.h"
+#include "vtkInitializationHelper.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPVMemoryCensusInformation.h"
+#include "vtkPVSession.h"
+#include "vtkProcessModule.h"
+#include "vtkSMParaViewPipelineController.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
+
+#include <string>
+
+#define VERIFY(x, y)                                                                               \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    vtkLogF(ERROR, y);                                                                             \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+vtkSmartPointer<vtkSMSourceProxy> CreatePipelineProxy(
+  vtkSMSession* session, const char* xmlgroup, const char* xmlname, vtkSMProxy* input = nullptr)
+{
+  vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+  vtkSmartPointer<vtkSMSourceProxy> proxy;
+  proxy.TakeReference(vtkSMSourceProxy::SafeDownCast(pxm->NewProxy(xmlgroup, xmlname)));
+
+  vtkNew<vtkSMParaViewPipelineController> controller;
+  controller->PreInitializeProxy(proxy);
+  if (input != nullptr)
+  {
+    vtkSMPropertyHelper(proxy, "Input").Set(input);
+  }
+  controller->PostInitializeProxy(proxy);
+  proxy->UpdateVTKObjects();
+  return proxy;
+}
+
+int FindArray(vtkPVMemoryCensusInformation* census, vtkTypeUInt32 proxyId, const char* name)
+{
+  for (int cc = 0; cc < census->GetNumberOfArrays(); ++cc)
+  {
+    if (census->GetProxyId(cc) == proxyId && std::string(census->GetArrayName(cc)) == name)
+    {
+      return cc;
+    }
+  }
+  return -1;
+}
+}
+
+int TestMemoryCensusInformation(int, char* argv[])
+{
+  vtkInitializationHelper::SetApplicationName("TestMemoryCensusInformation");
+  vtkInitializationHelper::SetOrganizationName("Humanity");
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  vtkNew<vtkSMSession> session;
+  vtkProcessModule::GetProcessModule()->RegisterSession(session);
+  vtkNew<vtkSMParaViewPipelineController> controller;
+  controller->InitializeSession(session);
+
+  {
+    auto wavelet = CreatePipelineProxy(session, "sources", "RTAnalyticSource");
+    auto passThrough = CreatePipelineProxy(session, "filters", "PassThrough", wavelet);
+    passThrough->UpdatePipeline();
+
+    vtkNew<vtkPVMemoryCensusInformation> census;
+    session->GatherInformation(vtkPVSession::DATA_SERVER, census, 0);
+
+    const int rtData = FindArray(census, wavelet->GetGlobalID(), "RTData (point data)");
+    VERIFY(rtData >= 0, "missing wavelet array.");
+    VERIFY(census->GetLocation(rtData) == vtkPVMemoryCensusInformation::PIPELINE_OUTPUT,
+      "unexpected location.");
+    VERIFY(census->GetBytes(rtData) >= 21 * 21 * 21 * 4, "unexpected array size.");
+    VERIFY(FindArray(census, passThrough->GetGlobalID(), "RTData (point data)") < 0,
+      "shared arrays should only be accounted once.");
+
+    // Arrays are merged when gathered from several ranks.
+    vtkClientServerStream stream;
+    census->CopyToStream(&stream);
+    vtkNew<vtkPVMemoryCensusInformation> other;
+    other->CopyFromStream(&stream);
+    VERIFY(other->GetNumberOfArrays() == census->GetNumberOfArrays(), "serialization failed.");
+    const long long totalBytes = census->GetTotalBytes();
+    census->AddInformation(other);
+    VERIFY(census->GetTotalBytes() == 2 * totalBytes, "unexpected total after merging.");
+    VERIFY(census->GetNumberOfRanks(rtData) == 2, "unexpected number of ranks after merging.");
+    VERIFY(census->GetMaximumRankBytes(rtData) == census->GetBytes(rtData) / 2,
+      "unexpected largest rank size after merging.");
+  }
+
+  vtkProcessModule::GetProcessModule()->UnRegisterSession(session);
+  vtkInitializationHelper::Finalize();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,220 @@
+/*=========================================================================
+
+Program:   ParaView
+Module:    TestSpreadSheetViewBlocks.cxx
+
+Copyright (c) Kitware, Inc.
+All rights reserved.
+See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkAlgorithm.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkInitializationHelper.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkProcessModule.h"
+#include "vtkSMParaViewPipelineControllerWithRendering.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSMViewProxy.h"
+#include "vtkSmartPointer.h"
+#include "vtkSpreadSheetView.h"
+#include "vtkVariant.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+// Checks the values shown by the spreadsheet view while columns are hidden
+// and shown again, that its block cache stays within its KiB limit and that
+// blocks prefetched in pieces hold the same values as blocks fetched at once.
+
+#define VERIFY(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    std::cerr << "ERROR: " << msg << std::endl;                                                    \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+const vtkIdType BlockSize = 1024;
+
+vtkSMSourceProxy* CreatePipelineProxy(
+  vtkSMSession* session, const char* xmlgroup, const char* xmlname, vtkSMProxy* input = nullptr)
+{
+  vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+  vtkSmartPointer<vtkSMSourceProxy> proxy;
+  proxy.TakeReference(vtkSMSourceProxy::SafeDownCast(pxm->NewProxy(xmlgroup, xmlname)));
+  if (!proxy)
+  {
+    vtkGenericWarningMacro("Failed to create: " << xmlgroup << ", " << xmlname << ". Aborting !!!");
+    abort();
+  }
+
+  vtkNew<vtkSMParaViewPipelineController> controller;
+  controller->PreInitializeProxy(proxy.Get());
+  if (input != nullptr)
+  {
+    vtkSMPropertyHelper(proxy, "Input").Set(input);
+  }
+  controller->PostInitializeProxy(proxy.Get());
+  proxy->UpdateVTKObjects();
+
+  controller->RegisterPipelineProxy(proxy);
+  return proxy.Get();
+}
+
+// Checks the values of a column in the rows of a block against the source.
+bool CheckBlock(vtkSpreadSheetView* view, vtkDataSet* source, vtkIdType block, const char* name)
+{
+  const vtkIdType idColumn = view->GetColumnByName("vtkOriginalIndices");
+  const vtkIdType column = view->GetColumnByName(name);
+  VERIFY(idColumn >= 0 && column >= 0, "missing column " << name);
+  vtkDataArray* expected = source->GetPointData()->GetArray(name);
+
+  const vtkIdType first = block * BlockSize;
+  const vtkIdType last = std::min(first + BlockSize, view->GetNumberOfRows());
+  for (vtkIdType row = first; row < last; ++row)
+  {
+    const vtkIdType id = view->GetValue(row, idColumn).ToTypeInt64();
+    VERIFY(id >= 0 && id < expected->GetNumberOfTuples(), "unexpected id in row " << row);
+    VERIFY(view->GetValue(row, column).ToDouble() == expected->GetTuple1(id),
+      "unexpected value of " << name << " in row " << row);
+  }
+  return true;
+}
+
+bool TestColumnProjection(vtkSpreadSheetView* view, vtkDataSet* source)
+{
+  VERIFY(CheckBlock(view, source, 0, "RTData") && CheckBlock(view, source, 0, "Elevation"),
+    "unexpected values with all columns shown.");
+
+  // hidden columns are still listed but not delivered.
+  view->HideColumnByName("RTData");
+  const vtkIdType column = view->GetColumnByName("RTData");
+  VERIFY(column >= 0 && !view->GetColumnVisibility(column), "hidden column not listed.");
+  VERIFY(!view->GetValue(0, column).IsValid(), "hidden column delivered.");
+  VERIFY(CheckBlock(view, source, 0, "Elevation") && CheckBlock(view, source, 1, "Elevation"),
+    "unexpected values with a hidden column.");
+
+  view->ClearHiddenColumnsByName();
+  VERIFY(CheckBlock(view, source, 0, "RTData") && CheckBlock(view, source, 1, "Elevation"),
+    "unexpected values once the column is shown again.");
+  return true;
+}
+
+bool TestCacheLimit(vtkSpreadSheetView* view)
+{
+  const vtkIdType numBlocks = (view->GetNumberOfRows() + BlockSize - 1) / BlockSize;
+
+  // only the block being accessed is kept when it exceeds the limit by itself.
+  view->ClearCache();
+  view->SetCacheLimit(1);
+  for (vtkIdType block = 0; block < 3; ++block)
+  {
+    view->GetValue(block * BlockSize, 0);
+    VERIFY(block == 0 || !view->IsAvailable((block - 1) * BlockSize),
+      "block " << block - 1 << " kept above the cache limit.");
+    VERIFY(view->IsAvailable(block * BlockSize), "accessed block " << block << " released.");
+  }
+
+  // room for two blocks and a half.
+  view->ClearCache();
+  view->SetCacheLimit(100 * 1024);
+  view->GetValue(0, 0);
+  const unsigned long limit = view->GetCacheSize() * 5 / 2;
+  VERIFY(limit > 0, "cached block has no size.");
+  view->SetCacheLimit(limit);
+  for (vtkIdType block = 0; block < numBlocks; ++block)
+  {
+    view->GetValue(block * BlockSize, 0);
+    VERIFY(view->GetCacheSize() <= limit,
+      "cache of " << view->GetCacheSize() << " KiB exceeds " << limit << " KiB.");
+  }
+  VERIFY(!view->IsAvailable(0), "least recently used block kept.");
+  VERIFY(view->IsAvailable((numBlocks - 1) * BlockSize), "most recently used block released.");
+  view->SetCacheLimit(100 * 1024);
+  return true;
+}
+
+bool TestPrefetch(vtkSpreadSheetView* view, vtkDataSet* source)
+{
+  view->ClearCache();
+  view->SetPrefetchDepth(1);
+  view->SetPrefetchPieceSize(BlockSize / 4);
+
+  // scrolling down through blocks 2 and 3 prefetches block 4, one piece per
+  // call.
+  view->GetValue(2 * BlockSize, 0);
+  view->GetValue(3 * BlockSize, 0);
+  int pieces = 0;
+  while (view->Prefetch())
+  {
+    ++pieces;
+    VERIFY(pieces == 4 || !view->IsAvailable(4 * BlockSize), "block cached before all pieces.");
+  }
+  VERIFY(pieces == 4, "expected 4 pieces, got " << pieces << ".");
+  VERIFY(view->IsAvailable(4 * BlockSize), "prefetched block not cached.");
+  VERIFY(CheckBlock(view, source, 4, "RTData") && CheckBlock(view, source, 4, "Elevation"),
+    "unexpected values in the prefetched block.");
+  return true;
+}
+}
+
+int TestSpreadSheetViewBlocks(int, char* argv[])
+{
+  vtkInitializationHelper::SetApplicationName("TestSpreadSheetViewBlocks");
+  vtkInitializationHelper::SetOrganizationName("Humanity");
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  vtkNew<vtkSMParaViewPipelineControllerWithRendering> controller;
+  vtkNew<vtkSMSession> session;
+  vtkProcessModule::GetProcessModule()->RegisterSession(session.Get());
+  controller->InitializeSession(session.Get());
+
+  vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+  vtkSmartPointer<vtkSMViewProxy> view;
+  view.TakeReference(vtkSMViewProxy::SafeDownCast(pxm->NewProxy("views", "SpreadSheetView")));
+  controller->InitializeProxy(view.Get());
+  vtkSMPropertyHelper(view, "BlockSize").Set(BlockSize);
+  view->UpdateVTKObjects();
+  controller->RegisterViewProxy(view.Get());
+
+  // 21^3 rows, i.e. 10 blocks of 1024 rows, with two data columns.
+  vtkSMSourceProxy* wavelet = CreatePipelineProxy(session.Get(), "sources", "RTAnalyticSource");
+  vtkSMSourceProxy* elevation =
+    CreatePipelineProxy(session.Get(), "filters", "ElevationFilter", wavelet);
+  controller->Show(elevation, 0, view);
+  view->Update();
+  view->StillRender();
+
+  auto ssview = vtkSpreadSheetView::SafeDownCast(view->GetClientSideObject());
+  auto source = vtkDataSet::SafeDownCast(
+    vtkAlgorithm::SafeDownCast(elevation->GetClientSideObject())->GetOutputDataObject(0));
+
+  bool success = ssview && source && ssview->GetNumberOfRows() == source->GetNumberOfPoints();
+  if (!success)
+  {
+    std::cerr << "ERROR: unexpected number of rows." << std::endl;
+  }
+  success = success && TestColumnProjection(ssview, source);
+  success = success && TestCacheLimit(ssview);
+  success = success && TestPrefetch(ssview, source);
+
+  controller->UnRegisterProxy(elevation);
+  controller->UnRegisterProxy(wavelet);
+  controller->UnRegisterProxy(view);
+
+  vtkProcessModule::GetProcessModule()->UnRegisterSession(session.Get());
+  vtkInitializationHelper::Finalize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -17,6 +17,7 @@
 #include "vtkAMRStreamingPriorityQueue.h"
 #include "vtkAlgorithmOutput.h"
 #include "vtkAppendCompositeDataLeaves.h"
+#include "vtkCamera.h"
 #include "vtkCompositeDataPipeline.h"
 #include "vtkCompositePolyDataMapper2.h"
 #include "vtkInformation.h"
@@ -115,7 +116,8 @@ int vtkAMROutlineRepresentation::ProcessViewRequest(
       // This is a streaming update request, request next piece.
       double view_planes[24];
       inInfo->Get(vtkPVRenderView::VIEW_PLANES(), view_planes);
-      if (this->StreamingUpdate(view_planes))
+      vtkPVRenderView* view = vtkPVRenderView::SafeDownCast(inInfo->Get(vtkPVView::VIEW()));
+      if (this->StreamingUpdate(view, view_planes))
       {
         // since we indeed "had" a next piece to produce, give it to the view
         // so it can deliver it to the rendering nodes.
@@ -278,9 +280,21 @@ int vtkAMROutlineRepresentation::RequestData(
 }
 
 //----------------------------------------------------------------------------
-bool vtkAMROutlineRepresentation::StreamingUpdate(const double view_planes[24])
+bool vtkAMROutlineRepresentation::StreamingUpdate(
+  vtkPVRenderView* view, const double view_planes[24])
 {
   assert(this->InStreamingUpdate == false);
+  vtkMTimeType viewMTime = 0;
+  if (view)
+  {
+    this->PriorityQueue->SetViewportSize(view->GetSize());
+    viewMTime = view->GetActiveCamera()->GetMTime();
+  }
+  if (this->PriorityQueue->IsEmpty() && this->PriorityQueue->NeedsDeferredBlocksUpdate(viewMTime))
+  {
+    // blocks deferred by the priority queue may be worth streaming now.
+    this->PriorityQueue->Update(view_planes);
+  }
   if (!this->PriorityQueue->IsEmpty())
   {
     this->InStreamingUpdate = true;
@@ -448,9 +462,35 @@ void vtkAMROutlineRepresentation::SetUserTransform(const double matrix[16])
   this->Actor->SetUserTransform(transform.GetPointer());
 }
 
+//----------------------------------------------------------------------------
+void vtkAMROutlineRepresentation::SetStreamingPriorityMode(int mode)
+{
+  this->PriorityQueue->SetPriorityMode(mode);
+}
+
+//----------------------------------------------------------------------------
+int vtkAMROutlineRepresentation::GetStreamingPriorityMode()
+{
+  return this->PriorityQueue->GetPriorityMode();
+}
+
+//----------------------------------------------------------------------------
+void vtkAMROutlineRepresentation::SetStreamingPixelThreshold(double threshold)
+{
+  this->PriorityQueue->SetPixelThreshold(threshold);
+}
+
+//----------------------------------------------------------------------------
+double vtkAMROutlineRepresentation::GetStreamingPixelThreshold()
+{
+  return this->PriorityQueue->GetPixelThreshold();
+}
+
 //----------------------------------------------------------------------------
 void vtkAMROutlineRepresentation::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "StreamingCapablePipeline: " << this->StreamingCapablePipeline << endl;
+  os << indent << "StreamingPriorityMode: " << this->GetStreamingPriorityMode() << endl;
+  os << indent << "StreamingPixelThreshold: " << this->GetStreamingPixelThreshold() << endl;
 }
@@ -35,6 +35,7 @@
 class vtkAMRStreamingPriorityQueue;
 class vtkCompositePolyDataMapper2;
 class vtkPVLODActor;
+class vtkPVRenderView;
 
 class VTKREMOTINGVIEWS_EXPORT vtkAMROutlineRepresentation : public vtkPVDataRepresentation
 {
@@ -84,6 +85,18 @@ public:
   void SetUserTransform(const double[16]);
   //@}
 
+  //@{
+  /**
+   * Set/Get how blocks are prioritized when streaming. Forwarded to
+   * vtkAMRStreamingPriorityQueue::SetPriorityMode() and
+   * vtkAMRStreamingPriorityQueue::SetPixelThreshold().
+   */
+  void SetStreamingPriorityMode(int mode);
+  int GetStreamingPriorityMode();
+  void SetStreamingPixelThreshold(double threshold);
+  double GetStreamingPixelThreshold();
+  //@}
+
 protected:
   vtkAMROutlineRepresentation();
   ~vtkAMROutlineRepresentation() override;
@@ -154,7 +167,7 @@ protected:
    * and then call Update() on the representation, making it reexecute and
    * regenerate the outline for the next "piece" of data.
    */
-  bool StreamingUpdate(const double view_planes[24]);
+  bool StreamingUpdate(vtkPVRenderView* view, const double view_planes[24]);
 
   /**
    * This is the data object generated processed by the most recent call to
@@ -20,16 +20,70 @@
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
 #include "vtkStreamingPriorityQueue.h"
+#include "vtkTimeStamp.h"
 
+#include <algorithm>
 #include <cassert>
+#include <limits>
 #include <queue>
 #include <vector>
 
+namespace
+{
+// Returns the size, in pixels, of a length `size` at the center of `bounds`.
+// The planes returned by vtkCamera::GetFrustumPlanes() are normalized, hence
+// the sum of the signed distances to the left and right (resp. bottom and top)
+// planes is the width (resp. height) of the view frustum at that point.
+double vtkComputeProjectedSize(
+  const double planes[24], const double bounds[6], double size, const int viewport[2])
+{
+  const double center[3] = { (bounds[0] + bounds[1]) / 2.0, (bounds[2] + bounds[3]) / 2.0,
+    (bounds[4] + bounds[5]) / 2.0 };
+  double pixels = 0.0;
+  for (int axis = 0; axis < 2; ++axis)
+  {
+    const double* first = planes + 8 * axis;
+    const double* second = planes + 8 * axis + 4;
+    const double extent =
+      vtkMath::Dot(first, center) + first[3] + vtkMath::Dot(second, center) + second[3];
+    if (extent <= 0)
+    {
+      // the center is behind the camera, the block surrounds the camera.
+      return std::numeric_limits<double>::max();
+    }
+    pixels = std::max(pixels, size / extent * std::max(viewport[axis], 1));
+  }
+  return pixels;
+}
+
+// Returns true if `bounds` intersects the view frustum.
+bool vtkIntersectsFrustum(const double planes[24], const double bounds[6])
+{
+  for (int cc = 0; cc < 6; ++cc)
+  {
+    const double* plane = planes + 4 * cc;
+    // the corner of the box the furthest along the plane normal.
+    const double corner[3] = { plane[0] > 0 ? bounds[1] : bounds[0],
+      plane[1] > 0 ? bounds[3] : bounds[2], plane[2] > 0 ? bounds[5] : bounds[4] };
+    if (vtkMath::Dot(plane, corner) + plane[3] < 0)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
 class vtkAMRStreamingPriorityQueue::vtkInternals
 {
 public:
   vtkStreamingPriorityQueue<> PriorityQueue;
   vtkSmartPointer<vtkAMRInformation> AMRMetadata;
+
+  // Blocks not worth streaming with the view given to the last Update(), when
+  // using SCREEN_SPACE_ERROR priorities.
+  std::vector<vtkStreamingPriorityQueueItem> DeferredItems;
+  vtkTimeStamp UpdateTime;
 };
 
 vtkStandardNewMacro(vtkAMRStreamingPriorityQueue);
@@ -40,6 +94,9 @@ vtkAMRStreamingPriorityQueue::vtkAMRStreamingPriorityQueue()
   this->Internals = new vtkInternals();
   this->Controller = nullptr;
   this->SetController(vtkMultiProcessController::GetGlobalController());
+  this->PriorityMode = COVERAGE;
+  this->PixelThreshold = 1.0;
+  this->ViewportSize[0] = this->ViewportSize[1] = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -71,6 +128,18 @@ void vtkAMRStreamingPriorityQueue::Initialize(vtkAMRInformation* amr)
     this->Internals->AMRMetadata->GetBounds(level, index, block_bounds);
     item.Bounds.SetBounds(block_bounds);
 
+    // Blocks in the root level add everything, other blocks refine the cells
+    // of the level above.
+    double spacing[3] = { 0.0, 0.0, 0.0 };
+    if (level == 0)
+    {
+      item.GeometricError = item.Bounds.GetDiagonalLength();
+    }
+    else if (amr->GetSpacing(level - 1, spacing))
+    {
+      item.GeometricError = std::max(std::max(spacing[0], spacing[1]), spacing[2]);
+    }
+
     // default priority is to prefer lower levels. Thus even without
     // view-planes we have reasonable priority.
     this->Internals->PriorityQueue.push(item);
@@ -93,6 +162,19 @@ bool vtkAMRStreamingPriorityQueue::IsEmpty()
   return this->Internals->PriorityQueue.empty();
 }
 
+//----------------------------------------------------------------------------
+bool vtkAMRStreamingPriorityQueue::HasDeferredBlocks()
+{
+  return !this->Internals->DeferredItems.empty();
+}
+
+//----------------------------------------------------------------------------
+bool vtkAMRStreamingPriorityQueue::NeedsDeferredBlocksUpdate(vtkMTimeType viewMTime)
+{
+  const vtkMTimeType updateTime = this->Internals->UpdateTime.GetMTime();
+  return this->HasDeferredBlocks() && (viewMTime > updateTime || this->GetMTime() > updateTime);
+}
+
 //----------------------------------------------------------------------------
 unsigned int vtkAMRStreamingPriorityQueue::Pop()
 {
@@ -136,7 +218,71 @@ void vtkAMRStreamingPriorityQueue::Update(
   {
     return;
   }
-  this->Internals->PriorityQueue.UpdatePriorities(view_planes, clamp_bounds);
+  this->Internals->UpdateTime.Modified();
+
+  auto& queue = this->Internals->PriorityQueue;
+  auto& deferred = this->Internals->DeferredItems;
+  if (this->PriorityMode == COVERAGE)
+  {
+    for (const auto& item : deferred)
+    {
+      queue.push(item);
+    }
+    deferred.clear();
+    queue.UpdatePriorities(view_planes, clamp_bounds);
+    return;
+  }
+
+  std::vector<vtkStreamingPriorityQueueItem> items;
+  items.swap(deferred);
+  for (; !queue.empty(); queue.pop())
+  {
+    items.push_back(queue.top());
+  }
+
+  const bool clamp_bounds_initialized =
+    (vtkMath::AreBoundsInitialized(const_cast<double*>(clamp_bounds)) != 0);
+  vtkBoundingBox clampBox(const_cast<double*>(clamp_bounds));
+  const bool use_threshold = this->ViewportSize[0] > 0 && this->ViewportSize[1] > 0;
+  for (auto& item : items)
+  {
+    if (!item.Bounds.IsValid())
+    {
+      continue;
+    }
+
+    double block_bounds[6];
+    item.Bounds.GetBounds(block_bounds);
+    if (clamp_bounds_initialized &&
+      !clampBox.ContainsPoint(block_bounds[0], block_bounds[2], block_bounds[4]) &&
+      !clampBox.ContainsPoint(block_bounds[1], block_bounds[3], block_bounds[5]))
+    {
+      // if the block_bounds is totally outside the clamp_bounds, skip it.
+      continue;
+    }
+
+    double distance, centeredness, itemCoverage;
+    item.ScreenCoverage =
+      vtkComputeScreenCoverage(view_planes, block_bounds, distance, centeredness, itemCoverage);
+    item.Distance = distance;
+    item.Centeredness = centeredness;
+    item.ItemCoverage = itemCoverage;
+    item.AmountOfDetail =
+      vtkComputeProjectedSize(view_planes, block_bounds, item.GeometricError, this->ViewportSize);
+
+    if (!vtkIntersectsFrustum(view_planes, block_bounds) ||
+      (use_threshold && item.AmountOfDetail < this->PixelThreshold))
+    {
+      // the block is not in view or its details would not be visible.
+      deferred.push_back(item);
+      continue;
+    }
+
+    // prefer blocks refining the largest cells on screen, weighted by how
+    // much of the block is actually on screen.
+    item.Priority = item.AmountOfDetail * vtkMath::ClampValue(itemCoverage, 0.01, 1.0);
+    queue.push(item);
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -144,4 +290,8 @@ void vtkAMRStreamingPriorityQueue::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "Controller: " << this->Controller << endl;
+  os << indent << "PriorityMode: " << this->PriorityMode << endl;
+  os << indent << "PixelThreshold: " << this->PixelThreshold << endl;
+  os << indent << "ViewportSize: " << this->ViewportSize[0] << ", " << this->ViewportSize[1]
+     << endl;
 }
@@ -24,6 +24,13 @@
  * provide the view planes (returned by vtkCamera::GetFrustumPlanes()) to the
  * vtkAMRStreamingPriorityQueue::Update() call to update the prorities for the
  * blocks currently in the queue.
+ *
+ * Two priority modes are supported. COVERAGE, the default, prefers coarse
+ * blocks covering a large part of the view. SCREEN_SPACE_ERROR prefers the
+ * blocks refining the cells that are the largest on screen, so coarse blocks
+ * close to the camera are streamed before fine blocks far away. Blocks that
+ * only refine cells smaller than `PixelThreshold` pixels, or that are not in
+ * view, are deferred until an Update() with a view in which they matter.
  * @sa
  * vtkAMROutlineRepresentation, vtkAMRStreamingVolumeRepresentation.
 */
@@ -58,6 +65,39 @@ public:
   vtkGetObjectMacro(Controller, vtkMultiProcessController);
   //@}
 
+  enum PriorityModes
+  {
+    COVERAGE = 0,
+    SCREEN_SPACE_ERROR = 1
+  };
+
+  //@{
+  /**
+   * Set/Get how the priorities of blocks are computed. Default is COVERAGE.
+   */
+  vtkSetClampMacro(PriorityMode, int, COVERAGE, SCREEN_SPACE_ERROR);
+  vtkGetMacro(PriorityMode, int);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the size, in pixels, below which cells are not refined when using
+   * SCREEN_SPACE_ERROR priorities. Only used when `ViewportSize` is set.
+   * Default is 1.
+   */
+  vtkSetClampMacro(PixelThreshold, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(PixelThreshold, double);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the size, in pixels, of the viewport corresponding to the view
+   * planes passed to Update(). Used to compute SCREEN_SPACE_ERROR priorities.
+   */
+  vtkSetVector2Macro(ViewportSize, int);
+  vtkGetVector2Macro(ViewportSize, int);
+  //@}
+
   /**
    * Initializes the queue. All information about items in the is lost.
    */
@@ -84,6 +124,22 @@ public:
    */
   bool IsEmpty();
 
+  /**
+   * Returns true if the last Update() deferred some blocks. Representations
+   * should call Update() when the view changes, even if the queue is empty,
+   * so that these blocks get a chance to be requeued.
+   */
+  bool HasDeferredBlocks();
+
+  /**
+   * Returns true if the last Update() deferred some blocks and the view may
+   * have changed since, i.e. if `viewMTime`, typically the modification time
+   * of the camera, or the modification time of this queue, which changes with
+   * the viewport size, is more recent than that Update(). Representations use
+   * this to only re-evaluate the deferred blocks when needed.
+   */
+  bool NeedsDeferredBlocksUpdate(vtkMTimeType viewMTime);
+
   /**
    * Pops and returns of composite id for the block at the top of the queue.
    * Test if the queue is empty before calling this method.
@@ -95,6 +151,9 @@ protected:
   ~vtkAMRStreamingPriorityQueue() override;
 
   vtkMultiProcessController* Controller;
+  int PriorityMode;
+  double PixelThreshold;
+  int ViewportSize[2];
 
 private:
   vtkAMRStreamingPriorityQueue(const vtkAMRStreamingPriorityQueue&) = delete;
@@ -17,6 +17,7 @@
 #include "vtkAMRStreamingPriorityQueue.h"
 #include "vtkAMRVolumeMapper.h"
 #include "vtkAlgorithmOutput.h"
+#include "vtkCamera.h"
 #include "vtkCompositeDataPipeline.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -104,6 +105,32 @@ void vtkAMRStreamingVolumeRepresentation::PrintSelf(ostream& os, vtkIndent inden
       os << "(invalid)" << endl;
   }
   os << indent << "StreamingRequestSize: " << this->StreamingRequestSize << endl;
+  os << indent << "StreamingPriorityMode: " << this->GetStreamingPriorityMode() << endl;
+  os << indent << "StreamingPixelThreshold: " << this->GetStreamingPixelThreshold() << endl;
+}
+
+//----------------------------------------------------------------------------
+void vtkAMRStreamingVolumeRepresentation::SetStreamingPriorityMode(int mode)
+{
+  this->PriorityQueue->SetPriorityMode(mode);
+}
+
+//----------------------------------------------------------------------------
+int vtkAMRStreamingVolumeRepresentation::GetStreamingPriorityMode()
+{
+  return this->PriorityQueue->GetPriorityMode();
+}
+
+//----------------------------------------------------------------------------
+void vtkAMRStreamingVolumeRepresentation::SetStreamingPixelThreshold(double threshold)
+{
+  this->PriorityQueue->SetPixelThreshold(threshold);
+}
+
+//----------------------------------------------------------------------------
+double vtkAMRStreamingVolumeRepresentation::GetStreamingPixelThreshold()
+{
+  return this->PriorityQueue->GetPixelThreshold();
 }
 
 //----------------------------------------------------------------------------
@@ -335,6 +362,17 @@ bool vtkAMRStreamingVolumeRepresentation::StreamingUpdate(
   vtkPVRenderView* view, const double view_planes[24])
 {
   assert(this->InStreamingUpdate == false);
+  vtkMTimeType viewMTime = 0;
+  if (view)
+  {
+    this->PriorityQueue->SetViewportSize(view->GetSize());
+    viewMTime = view->GetActiveCamera()->GetMTime();
+  }
+  if (this->PriorityQueue->IsEmpty() && this->PriorityQueue->NeedsDeferredBlocksUpdate(viewMTime))
+  {
+    // blocks deferred by the priority queue may be worth streaming now.
+    this->PriorityQueue->Update(view_planes, this->Resampler->GetSpatialBounds());
+  }
   if (!this->PriorityQueue->IsEmpty())
   {
     this->InStreamingUpdate = true;
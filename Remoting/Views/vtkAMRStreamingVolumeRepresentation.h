@@ -98,6 +98,18 @@ public:
   vtkGetMacro(StreamingRequestSize, int);
   //@}
 
+  //@{
+  /**
+   * Set/Get how blocks are prioritized when streaming. Forwarded to
+   * vtkAMRStreamingPriorityQueue::SetPriorityMode() and
+   * vtkAMRStreamingPriorityQueue::SetPixelThreshold().
+   */
+  void SetStreamingPriorityMode(int mode);
+  int GetStreamingPriorityMode();
+  void SetStreamingPixelThreshold(double threshold);
+  double GetStreamingPixelThreshold();
+  //@}
+
   //@{
   /**
    * Set the input data arrays that this algorithm will process.
@@ -23,6 +23,7 @@
 #include "vtkCompositePolyDataMapper2.h"
 #include "vtkDataAssembly.h"
 #include "vtkDataAssemblyUtilities.h"
+#include "vtkDataObjectTree.h"
 #include "vtkDataObjectTreeIterator.h"
 #include "vtkDataObjectTreeRange.h"
 #include "vtkHyperTreeGrid.h"
@@ -41,6 +42,7 @@
 #include "vtkPVLODActor.h"
 #include "vtkPVLogger.h"
 #include "vtkPVRenderView.h"
+#include "vtkPVSession.h"
 #include "vtkPVTrivialProducer.h"
 #include "vtkPointData.h"
 #include "vtkProcessModule.h"
@@ -55,6 +57,7 @@
 #include "vtkTexture.h"
 #include "vtkTransform.h"
 #include "vtkUnstructuredGrid.h"
+#include "vtkWeakPointer.h"
 
 #if VTK_MODULE_ENABLE_VTK_RenderingRayTracing
 #include "vtkOSPRayActorNode.h"
@@ -63,11 +66,248 @@
 #include <vtk_jsoncpp.h>
 #include <vtksys/SystemTools.hxx>
 
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <numeric>
+#include <sstream>
+#include <thread>
 #include <tuple>
 #include <vector>
 
+//*****************************************************************************
+// LOD geometry is generated in the background as soon as the full resolution
+// geometry is available and is shared by the representations of a session
+// showing the same input with the same settings, e.g. a source shown in several
+// views. Entries are owned by the representations using them, the cache only
+// keeps track of them.
+namespace vtkGeometryRepresentation_detail
+{
+struct LODCacheEntry
+{
+  vtkWeakPointer<vtkDataObject> Input;
+  vtkMTimeType InputMTime = 0;
+  std::string Settings;
+  double Factor = 0.5;
+  std::shared_future<vtkSmartPointer<vtkDataObject> > Result;
+
+  bool Matches(const LODCacheEntry& other) const
+  {
+    return this->Input.GetPointer() != nullptr &&
+      this->Input.GetPointer() == other.Input.GetPointer() &&
+      this->InputMTime == other.InputMTime && !this->Settings.empty() &&
+      this->Settings == other.Settings && this->Factor == other.Factor;
+  }
+};
+}
+
+namespace
+{
+using vtkGeometryRepresentation_detail::LODCacheEntry;
+using LODPromise = std::promise<vtkSmartPointer<vtkDataObject> >;
+
+// Returns a copy of `data` that does not share any data object, but only
+// arrays, with `data`.
+vtkSmartPointer<vtkDataObject> CopyForLOD(vtkDataObject* data)
+{
+  auto copy = vtkSmartPointer<vtkDataObject>::Take(data->NewInstance());
+  auto tree = vtkDataObjectTree::SafeDownCast(data);
+  if (tree == nullptr)
+  {
+    copy->ShallowCopy(data);
+    return copy;
+  }
+
+  auto treeCopy = vtkDataObjectTree::SafeDownCast(copy);
+  treeCopy->CopyStructure(tree);
+  vtkSmartPointer<vtkDataObjectTreeIterator> iter;
+  iter.TakeReference(tree->NewTreeIterator());
+  iter->SkipEmptyNodesOn();
+  iter->VisitOnlyLeavesOn();
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    vtkDataObject* leaf = iter->GetCurrentDataObject();
+    auto leafCopy = vtkSmartPointer<vtkDataObject>::Take(leaf->NewInstance());
+    leafCopy->ShallowCopy(leaf);
+    treeCopy->SetDataSetFrom(iter, leafCopy);
+  }
+  return copy;
+}
+
+// Returns a copy of the output of `decimator`, so that it is not modified
+// when `decimator` re-executes.
+vtkSmartPointer<vtkDataObject> Decimate(
+  vtkGeometryRepresentation_detail::DecimationFilterType* decimator, vtkDataObject* data,
+  double factor)
+{
+  decimator->SetLODFactor(factor);
+  decimator->SetInputDataObject(data);
+  decimator->Update();
+  return CopyForLOD(decimator->GetOutputDataObject(0));
+}
+}
+
+//*****************************************************************************
+// The LOD geometry cache of a session, see vtkPVSession::GetLODGeometryCache().
+// The LOD geometry is decimated by a single worker thread, one entry at a time,
+// since the decimation filters already use all available cores. Entries that
+// no representation uses anymore by the time the worker gets to them are
+// skipped. Besides the worker, the cache is only accessed from the main thread.
+class vtkGeometryRepresentationLODCache : public vtkObject
+{
+public:
+  static vtkGeometryRepresentationLODCache* New();
+  vtkTypeMacro(vtkGeometryRepresentationLODCache, vtkObject);
+
+  // Returns the cache of the session `view` belongs to, creating it if needed.
+  static vtkGeometryRepresentationLODCache* GetInstance(vtkView* view)
+  {
+    auto pvview = vtkPVView::SafeDownCast(view);
+    vtkPVSession* session = pvview ? pvview->GetSession() : nullptr;
+    if (session == nullptr)
+    {
+      return nullptr;
+    }
+    auto cache = vtkGeometryRepresentationLODCache::SafeDownCast(session->GetLODGeometryCache());
+    if (cache == nullptr)
+    {
+      vtkNew<vtkGeometryRepresentationLODCache> newCache;
+      session->SetLODGeometryCache(newCache);
+      cache = newCache;
+    }
+    return cache;
+  }
+
+  std::shared_ptr<LODCacheEntry> Find(const LODCacheEntry& key) const
+  {
+    for (const auto& weakEntry : this->Entries)
+    {
+      auto entry = weakEntry.lock();
+      if (entry && entry->Result.valid() && entry->Matches(key))
+      {
+        return entry;
+      }
+    }
+    return nullptr;
+  }
+
+  void Add(const std::shared_ptr<LODCacheEntry>& entry)
+  {
+    if (entry->Settings.empty() || entry->Input.GetPointer() == nullptr)
+    {
+      return;
+    }
+    auto expired = [](const std::weak_ptr<LODCacheEntry>& weakEntry) {
+      return weakEntry.expired();
+    };
+    this->Entries.erase(
+      std::remove_if(this->Entries.begin(), this->Entries.end(), expired), this->Entries.end());
+    this->Entries.push_back(entry);
+  }
+
+  // Decimates `data` on the worker thread to provide the result of `entry`.
+  // `data` must not share anything with data used on the main thread.
+  void Schedule(const std::shared_ptr<LODCacheEntry>& entry, vtkSmartPointer<vtkDataObject> data)
+  {
+    auto promise = std::make_shared<LODPromise>();
+    entry->Result = promise->get_future().share();
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Tasks.push_back(Task{ entry, std::move(data), entry->Factor, promise });
+      if (!this->Worker.joinable())
+      {
+        this->Worker = std::thread(&vtkGeometryRepresentationLODCache::Run, this);
+      }
+    }
+    this->Condition.notify_one();
+    this->Add(entry);
+  }
+
+  // Removes the task providing the result of `entry` if the worker has not
+  // started it yet, so that the caller can do it instead. Returns the promise
+  // to fulfill in that case.
+  std::shared_ptr<LODPromise> Cancel(const std::shared_ptr<LODCacheEntry>& entry)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    for (auto iter = this->Tasks.begin(); iter != this->Tasks.end(); ++iter)
+    {
+      if (iter->Entry.lock() == entry)
+      {
+        auto promise = iter->Promise;
+        this->Tasks.erase(iter);
+        return promise;
+      }
+    }
+    return nullptr;
+  }
+
+protected:
+  vtkGeometryRepresentationLODCache() = default;
+  ~vtkGeometryRepresentationLODCache() override
+  {
+    // pending tasks are still done, representations may outlive the session.
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Stop = true;
+    }
+    this->Condition.notify_one();
+    if (this->Worker.joinable())
+    {
+      this->Worker.join();
+    }
+  }
+
+  void Run()
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    while (true)
+    {
+      this->Condition.wait(lock, [this]() { return this->Stop || !this->Tasks.empty(); });
+      if (this->Tasks.empty())
+      {
+        return;
+      }
+      Task task = std::move(this->Tasks.front());
+      this->Tasks.pop_front();
+      if (task.Entry.expired())
+      {
+        continue;
+      }
+      lock.unlock();
+      // The decimator has no observers since it executes outside of the main
+      // thread.
+      vtkNew<vtkGeometryRepresentation_detail::DecimationFilterType> decimator;
+      task.Promise->set_value(Decimate(decimator, task.Data, task.Factor));
+      task = Task();
+      lock.lock();
+    }
+  }
+
+private:
+  vtkGeometryRepresentationLODCache(const vtkGeometryRepresentationLODCache&) = delete;
+  void operator=(const vtkGeometryRepresentationLODCache&) = delete;
+
+  struct Task
+  {
+    std::weak_ptr<LODCacheEntry> Entry;
+    vtkSmartPointer<vtkDataObject> Data;
+    double Factor;
+    std::shared_ptr<LODPromise> Promise;
+  };
+
+  std::vector<std::weak_ptr<LODCacheEntry> > Entries;
+  std::deque<Task> Tasks;
+  std::mutex Mutex;
+  std::condition_variable Condition;
+  std::thread Worker;
+  bool Stop = false;
+};
+vtkStandardNewMacro(vtkGeometryRepresentationLODCache);
+
 //*****************************************************************************
 // This is used to convert a vtkPolyData to a vtkMultiBlockDataSet. If input is
 // vtkMultiBlockDataSet, then this is simply a pass-through filter. This makes
@@ -427,20 +667,15 @@ int vtkGeometryRepresentation::ProcessViewRequest(
       }
       else
       {
-        if (inInfo->Has(vtkPVRenderView::LOD_RESOLUTION()))
-        {
-          // We handle this number differently depending on decimator
-          // implementation.
-          const double factor = inInfo->Get(vtkPVRenderView::LOD_RESOLUTION());
-          this->Decimator->SetLODFactor(factor);
-        }
-
-        this->Decimator->SetInputDataObject(data);
-        this->Decimator->Update();
+        // We handle this number differently depending on decimator
+        // implementation.
+        const double factor = inInfo->Has(vtkPVRenderView::LOD_RESOLUTION())
+          ? inInfo->Get(vtkPVRenderView::LOD_RESOLUTION())
+          : 0.5;
 
         // Pass along the LOD geometry to the view so that it can deliver it to
         // the rendering node as and when needed.
-        vtkPVView::SetPieceLOD(inInfo, this, this->Decimator->GetOutputDataObject(0));
+        vtkPVView::SetPieceLOD(inInfo, this, this->GetLODGeometry(data, factor));
       }
     }
   }
@@ -515,9 +750,11 @@ int vtkGeometryRepresentation::RequestUpdateExtent(
 int vtkGeometryRepresentation::RequestData(
   vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
 {
+  vtkDataObject* input = nullptr;
   if (inputVector[0]->GetNumberOfInformationObjects() == 1)
   {
     // vtkLogF(INFO, "%s->RequestData", this->GetLogName().c_str());
+    input = vtkDataObject::GetData(inputVector[0], 0);
     vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
     if (inInfo->Has(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT()))
     {
@@ -540,9 +777,133 @@ int vtkGeometryRepresentation::RequestData(
   // does use parallel communication (see #19963).
   this->GeometryFilter->Modified();
   this->MultiBlockMaker->Update();
+  this->ScheduleLODGeometry(input);
   return this->Superclass::RequestData(request, inputVector, outputVector);
 }
 
+//----------------------------------------------------------------------------
+std::string vtkGeometryRepresentation::GetLODCacheSettings()
+{
+  // Subclasses using a different geometry filter may generate different
+  // geometry for the same input, e.g. vtkGeometrySliceRepresentation.
+  auto geomFilter = vtkPVGeometryFilter::SafeDownCast(this->GeometryFilter);
+  if (geomFilter == nullptr || strcmp(geomFilter->GetClassName(), "vtkPVGeometryFilter") != 0)
+  {
+    return std::string();
+  }
+
+  std::ostringstream settings;
+  settings << this->GetClassName() << " " << this->RequestGhostCellsIfNeeded << " "
+           << geomFilter->GetUseOutline() << " " << geomFilter->GetTriangulate() << " "
+           << geomFilter->GetNonlinearSubdivisionLevel() << " "
+           << geomFilter->GetGenerateFeatureEdges() << " "
+           << geomFilter->GetBlockColorsDistinctValues() << " " << geomFilter->GetUseStrips()
+           << " " << geomFilter->GetGenerateCellNormals() << " "
+           << geomFilter->GetGenerateProcessIds() << " " << geomFilter->GetHideInternalAMRFaces()
+           << " " << geomFilter->GetUseNonOverlappingAMRMetaDataForOutlines() << " "
+           << geomFilter->GetPassThroughCellIds() << " " << geomFilter->GetPassThroughPointIds();
+  for (int cc = 0; cc < 3; ++cc)
+  {
+    vtkInformation* info = this->MultiBlockMaker->GetInputArrayInformation(cc);
+    const char* name = info ? info->Get(vtkDataObject::FIELD_NAME()) : nullptr;
+    settings << " \"" << (name ? name : "") << "\"";
+  }
+  return settings.str();
+}
+
+//----------------------------------------------------------------------------
+void vtkGeometryRepresentation::ScheduleLODGeometry(vtkDataObject* input)
+{
+  auto view = vtkPVRenderView::SafeDownCast(this->GetView());
+
+  auto key = std::make_shared<LODCacheEntry>();
+  key->Input = input;
+  key->InputMTime = input ? input->GetMTime() : 0;
+  key->Settings = this->GetLODCacheSettings();
+  key->Factor = view ? view->GetLODResolution() : 0.5;
+  auto cache = vtkGeometryRepresentationLODCache::GetInstance(view);
+  auto entry = cache ? cache->Find(*key) : nullptr;
+  if (entry)
+  {
+    vtkVLogF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "%s: reusing LOD geometry",
+      this->GetLogName().c_str());
+    this->LODEntry = entry;
+    return;
+  }
+  this->LODEntry = key;
+
+  if (cache == nullptr || this->SuppressLOD || view->GetUseOutlineForLODRendering())
+  {
+    return;
+  }
+
+  // Only bother if the view is likely to use LOD rendering. The view decides
+  // based on the total geometry size across all ranks, hence we estimate it.
+  vtkDataObject* data = this->MultiBlockMaker->GetOutputDataObject(0);
+  auto controller = vtkMultiProcessController::GetGlobalController();
+  const double geometrySize = data->GetActualMemorySize() / 1024.0 *
+    (controller ? controller->GetNumberOfProcesses() : 1);
+  if (geometrySize <= 0 || geometrySize < view->GetLODRenderingThreshold())
+  {
+    return;
+  }
+
+  vtkVLogF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "%s: generating LOD geometry in the background",
+    this->GetLogName().c_str());
+  // A deep copy, since the decimation may compute and cache array ranges and
+  // the representation may change arrays in place while it executes.
+  auto copy = vtkSmartPointer<vtkDataObject>::Take(data->NewInstance());
+  copy->DeepCopy(data);
+  cache->Schedule(key, copy);
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkGeometryRepresentation::GetLODGeometry(
+  vtkDataObject* data, double factor)
+{
+  auto cache = vtkGeometryRepresentationLODCache::GetInstance(this->GetView());
+  if (this->LODEntry && this->LODEntry->Factor != factor)
+  {
+    // The LOD resolution changed since the last update.
+    auto key = std::make_shared<LODCacheEntry>();
+    key->Input = this->LODEntry->Input;
+    key->InputMTime = this->LODEntry->InputMTime;
+    key->Settings = this->LODEntry->Settings;
+    key->Factor = factor;
+    auto entry = cache ? cache->Find(*key) : nullptr;
+    this->LODEntry = entry ? entry : key;
+  }
+
+  std::shared_ptr<LODPromise> promise;
+  if (this->LODEntry && this->LODEntry->Result.valid())
+  {
+    // Rather than waiting for the worker to get to it, decimate here if it
+    // has not started yet.
+    promise = cache ? cache->Cancel(this->LODEntry) : nullptr;
+    if (promise == nullptr)
+    {
+      return this->LODEntry->Result.get();
+    }
+  }
+
+  auto result = Decimate(this->Decimator, data, factor);
+  if (promise)
+  {
+    promise->set_value(result);
+  }
+  else if (this->LODEntry)
+  {
+    promise = std::make_shared<LODPromise>();
+    promise->set_value(result);
+    this->LODEntry->Result = promise->get_future().share();
+    if (cache)
+    {
+      cache->Add(this->LODEntry);
+    }
+  }
+  return result;
+}
+
 //----------------------------------------------------------------------------
 bool vtkGeometryRepresentation::GetBounds(
   vtkDataObject* dataObject, double bounds[6], vtkCompositeDataDisplayAttributes* cdAttributes)
@@ -31,8 +31,10 @@
 #include "vtkPVDataRepresentation.h"
 #include "vtkProperty.h"            // needed for VTK_POINTS etc.
 #include "vtkRemotingViewsModule.h" // needed for exports
+#include "vtkSmartPointer.h"        // needed for vtkSmartPointer
 #include "vtkVector.h"              // for vtkVector.
 
+#include <memory>        // needed for std::shared_ptr
 #include <set>           // needed for std::set
 #include <string>        // needed for std::string
 #include <unordered_map> // needed for std::unordered_map
@@ -48,9 +50,10 @@ class vtkTexture;
 
 namespace vtkGeometryRepresentation_detail
 {
-// This is defined to either vtkQuadricClustering or vtkmLevelOfDetail in the
+// This is defined to either vtkPVVertexClustering or vtkmLevelOfDetail in the
 // implementation file:
 class DecimationFilterType;
+struct LODCacheEntry;
 }
 
 class VTKREMOTINGVIEWS_EXPORT vtkGeometryRepresentation : public vtkPVDataRepresentation
@@ -459,6 +462,30 @@ protected:
    */
   virtual void SetPointArrayToProcess(int p, const char* val);
 
+  /**
+   * Returns a string describing everything, besides the input, the geometry
+   * generated by this representation depends on. LOD geometry is shared with
+   * other representations of the same input with identical settings, e.g. when
+   * a source is shown in several views. Returns an empty string to never share
+   * the LOD geometry, which is the default unless the geometry filter is a
+   * vtkPVGeometryFilter.
+   */
+  virtual std::string GetLODCacheSettings();
+
+  /**
+   * Called at the end of RequestData to start generating the LOD geometry in
+   * the background, provided the view is likely to use it, so that it is ready
+   * by the time the user starts interacting.
+   */
+  void ScheduleLODGeometry(vtkDataObject* input);
+
+  /**
+   * Returns the LOD geometry for `data`, the output of MultiBlockMaker, using
+   * the LOD geometry generated in the background or by another representation
+   * when available.
+   */
+  vtkSmartPointer<vtkDataObject> GetLODGeometry(vtkDataObject* data, double factor);
+
   vtkAlgorithm* GeometryFilter;
   vtkAlgorithm* MultiBlockMaker;
   vtkGeometryRepresentation_detail::DecimationFilterType* Decimator;
@@ -497,6 +524,8 @@ protected:
   std::unordered_map<std::string, double> BlockOpacities;
   std::unordered_map<std::string, vtkVector3d> BlockColors;
 
+  std::shared_ptr<vtkGeometryRepresentation_detail::LODCacheEntry> LODEntry;
+
 private:
   vtkGeometryRepresentation(const vtkGeometryRepresentation&) = delete;
   void operator=(const vtkGeometryRepresentation&) = delete;
@@ -21,7 +21,7 @@
 #include "vtkPolyData.h"          // for vtkPolyData
 
 // We'll use the VTKm decimation filter if TBB is enabled, otherwise we'll
-// fallback to vtkQuadricClustering, since vtkmLevelOfDetail is slow on the
+// fallback to vtkPVVertexClustering, since vtkmLevelOfDetail is slow on the
 // serial backend.
 #ifndef __VTK_WRAP__
 #if VTK_MODULE_ENABLE_VTK_vtkm
@@ -107,19 +107,19 @@ protected:
 vtkStandardNewMacro(DecimationFilterType);
 }
 #else // VTKM_ENABLE_TBB
-#include "vtkQuadricClustering.h"
+#include "vtkPVVertexClustering.h"
 namespace vtkGeometryRepresentation_detail
 {
-class DecimationFilterType : public vtkQuadricClustering
+class DecimationFilterType : public vtkPVVertexClustering
 {
 public:
   static DecimationFilterType* New();
-  vtkTypeMacro(DecimationFilterType, vtkQuadricClustering);
+  vtkTypeMacro(DecimationFilterType, vtkPVVertexClustering);
 
-  // This version gets slower as the grid increases, while the VTKM version
-  // scales with number of points. This means we can get away with a much finer
-  // grid with the VTKM filter, so we'll just reduce the mesh quality a bit
-  // here.
+  // Like the VTKM version, vtkPVVertexClustering scales with the number of
+  // points rather than the grid size. We nevertheless keep the grid sizes that
+  // were used with vtkQuadricClustering so that the LOD geometry does not get
+  // any heavier to render.
   void SetLODFactor(double factor)
   {
     factor = vtkMath::ClampValue(factor, 0., 1.);
@@ -131,14 +131,6 @@ public:
     int divs = static_cast<int>(150 * factor) + 10;
     this->SetNumberOfDivisions(divs, divs, divs);
   }
-
-protected:
-  DecimationFilterType()
-  {
-    this->SetUseInputPoints(1);
-    this->SetCopyCellData(1);
-    this->SetUseInternalTriangles(0);
-  }
 };
 vtkStandardNewMacro(DecimationFilterType);
 }
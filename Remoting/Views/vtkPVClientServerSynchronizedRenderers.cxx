@@ -15,7 +15,9 @@
 =========================================================================*/
 #include "vtkPVClientServerSynchronizedRenderers.h"
 
+#include "vtkCompositeMultiProcessController.h"
 #include "vtkLZ4Compressor.h"
+#include "vtkLZ4DeltaCompressor.h"
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
 #include "vtkOpenGLRenderer.h"
@@ -37,6 +39,7 @@ vtkPVClientServerSynchronizedRenderers::vtkPVClientServerSynchronizedRenderers()
   : Compressor(nullptr)
   , LossLessCompression(true)
   , NVPipeSupport(false)
+  , KeyFrameRequested(false)
 {
   this->ConfigureCompressor("vtkLZ4Compressor 0 3");
 }
@@ -47,6 +50,31 @@ vtkPVClientServerSynchronizedRenderers::~vtkPVClientServerSynchronizedRenderers(
   this->SetCompressor(nullptr);
 }
 
+//----------------------------------------------------------------------------
+void vtkPVClientServerSynchronizedRenderers::MasterStartRender()
+{
+  this->Superclass::MasterStartRender();
+
+  // let the server know if the last image could not be decompressed, so that
+  // a stateful compressor starts over with a key frame.
+  int requestKeyFrame = this->KeyFrameRequested ? 1 : 0;
+  this->ParallelController->Send(&requestKeyFrame, 1, 1, 0x023431);
+  this->KeyFrameRequested = false;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVClientServerSynchronizedRenderers::SlaveStartRender()
+{
+  this->Superclass::SlaveStartRender();
+
+  int requestKeyFrame = 0;
+  this->ParallelController->Receive(&requestKeyFrame, 1, 1, 0x023431);
+  if (requestKeyFrame)
+  {
+    this->ResetCompressor();
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkPVClientServerSynchronizedRenderers::MasterEndRender()
 {
@@ -66,8 +94,14 @@ void vtkPVClientServerSynchronizedRenderers::MasterEndRender()
       vtkUnsignedCharArray* data = vtkUnsignedCharArray::New();
       this->ParallelController->Receive(data, 1, 0x023430);
       this->Compressor->SetImageResolution(header[1], header[2]);
-      this->Decompress(data, rawImage.GetRawPtr());
+      const bool decompressed = this->Decompress(data, rawImage.GetRawPtr());
       data->Delete();
+      if (!decompressed)
+      {
+        // don't show a partially decoded image, ask for a key frame instead.
+        this->KeyFrameRequested = true;
+        return;
+      }
     }
     else
     {
@@ -98,6 +132,13 @@ void vtkPVClientServerSynchronizedRenderers::SlaveEndRender()
   {
     if (this->Compressor)
     {
+      // with several collaborating clients, the client receiving this image
+      // may not have received the previous one.
+      auto composite = vtkCompositeMultiProcessController::SafeDownCast(this->ParallelController);
+      if (composite && composite->GetNumberOfControllers() > 1)
+      {
+        this->ResetCompressor();
+      }
       this->Compressor->SetImageResolution(header[1], header[2]);
       this->ParallelController->Send(this->Compress(rawImage.GetRawPtr()), 1, 0x023430);
     }
@@ -118,6 +159,9 @@ vtkUnsignedCharArray* vtkPVClientServerSynchronizedRenderers::Compress(vtkUnsign
     if (this->Compressor->Compress() == 0)
     {
       vtkErrorMacro("Image compression failed!");
+      // the client cannot decode the raw image, the next one must not
+      // depend on it.
+      this->ResetCompressor();
       return data;
     }
     return this->Compressor->GetOutput();
@@ -127,7 +171,7 @@ vtkUnsignedCharArray* vtkPVClientServerSynchronizedRenderers::Compress(vtkUnsign
 }
 
 //----------------------------------------------------------------------------
-void vtkPVClientServerSynchronizedRenderers::Decompress(
+bool vtkPVClientServerSynchronizedRenderers::Decompress(
   vtkUnsignedCharArray* data, vtkUnsignedCharArray* outputBuffer)
 {
   if (this->Compressor)
@@ -138,11 +182,21 @@ void vtkPVClientServerSynchronizedRenderers::Decompress(
     if (this->Compressor->Decompress() == 0)
     {
       vtkErrorMacro("Image de-compression failed!");
+      return false;
     }
+    return true;
   }
-  else
+
+  vtkErrorMacro("No compressor present.");
+  return false;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVClientServerSynchronizedRenderers::ResetCompressor()
+{
+  if (auto deltaCompressor = vtkLZ4DeltaCompressor::SafeDownCast(this->Compressor))
   {
-    vtkErrorMacro("No compressor present.");
+    deltaCompressor->Reset();
   }
 }
 
@@ -172,6 +226,10 @@ void vtkPVClientServerSynchronizedRenderers::ConfigureCompressor(const char* str
     {
       comp = vtkLZ4Compressor::New();
     }
+    else if (className == "vtkLZ4DeltaCompressor")
+    {
+      comp = vtkLZ4DeltaCompressor::New();
+    }
     else if (className == "vtkNvPipeCompressor" && this->NVPipeSupport)
     {
 #if VTK_MODULE_ENABLE_ParaView_nvpipe
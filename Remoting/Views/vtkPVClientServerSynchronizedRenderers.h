@@ -72,8 +72,16 @@ protected:
   //@}
 
   vtkUnsignedCharArray* Compress(vtkUnsignedCharArray*);
-  void Decompress(vtkUnsignedCharArray* input, vtkUnsignedCharArray* outputBuffer);
+  bool Decompress(vtkUnsignedCharArray* input, vtkUnsignedCharArray* outputBuffer);
 
+  /**
+   * Make the next compressed image a key frame, for compressors that encode
+   * an image relative to the previous one.
+   */
+  void ResetCompressor();
+
+  void MasterStartRender() override;
+  void SlaveStartRender() override;
   void MasterEndRender() override;
   void SlaveEndRender() override;
 
@@ -81,6 +89,12 @@ protected:
   bool LossLessCompression;
   bool NVPipeSupport;
 
+  /**
+   * Set by the client when an image could not be decompressed. Sent to the
+   * server at the start of the next render.
+   */
+  bool KeyFrameRequested;
+
 private:
   vtkPVClientServerSynchronizedRenderers(const vtkPVClientServerSynchronizedRenderers&) = delete;
   void operator=(const vtkPVClientServerSynchronizedRenderers&) = delete;
@@ -297,6 +297,19 @@ void vtkPVDataDeliveryManager::ClearCache(vtkPVDataRepresentation* repr)
   this->Internals->ClearCache(repr);
 }
 
+//----------------------------------------------------------------------------
+void vtkPVDataDeliveryManager::GetCachedDataObjects(
+  vtkPVDataRepresentation* repr, int port, std::vector<vtkDataObject*>& objects)
+{
+  for (bool low_res : { false, true })
+  {
+    if (auto item = this->Internals->GetItem(repr, low_res, port))
+    {
+      item->GetDataObjects(objects);
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkPVDataDeliveryManager::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -107,6 +107,14 @@ public:
    */
   void ClearCache(vtkPVDataRepresentation* repr);
 
+  /**
+   * Returns all data objects held for the given representation port, i.e.
+   * the pieces for every cache key, at full and low resolution, both before
+   * and after delivery. The same data object may be returned more than once.
+   */
+  void GetCachedDataObjects(
+    vtkPVDataRepresentation* repr, int port, std::vector<vtkDataObject*>& objects);
+
   //@{
   /**
    * Provides access to the producer port for the geometry of a registered
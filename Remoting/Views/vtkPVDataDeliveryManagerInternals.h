@@ -29,6 +29,7 @@
 #include <map>     // for std::map
 #include <numeric> // for std::accumulate
 #include <utility> // for std::pair
+#include <vector>  // for std::vector
 
 class vtkPVDataDeliveryManager::vtkInternals
 {
@@ -190,6 +191,24 @@ public:
       return store.Information;
     }
 
+    void GetDataObjects(std::vector<vtkDataObject*>& objects) const
+    {
+      for (const auto& pair : this->Data)
+      {
+        if (pair.second.DataObject)
+        {
+          objects.push_back(pair.second.DataObject);
+        }
+        for (const auto& delivered : pair.second.DeliveredDataObjects)
+        {
+          if (delivered.second)
+          {
+            objects.push_back(delivered.second);
+          }
+        }
+      }
+    }
+
     vtkMTimeType GetTimeStamp() const { return this->TimeStamp; }
     vtkMTimeType GetDeliveryTimeStamp(int dataKey, double cacheKey) const
     {
@@ -0,0 +1,341 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVMemoryCensusInformation.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVMemoryCensusInformation.h"
+
+#include "vtkAbstractArray.h"
+#include "vtkAlgorithm.h"
+#include "vtkCellArray.h"
+#include "vtkClientServerStream.h"
+#include "vtkCollection.h"
+#include "vtkCollectionIterator.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataArray.h"
+#include "vtkExecutive.h"
+#include "vtkFieldData.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVDataDeliveryManager.h"
+#include "vtkPVDataRepresentation.h"
+#include "vtkPVSessionBase.h"
+#include "vtkPVSessionCore.h"
+#include "vtkPVView.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkProcessModule.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkSIProxy.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <tuple>
+
+#define vtkVerifyParseMacro(_call, _field)                                                         \
+  if (!(_call))                                                                                    \
+  {                                                                                                \
+    vtkErrorMacro("Error parsing " _field ".");                                                    \
+    return;                                                                                        \
+  }
+
+//----------------------------------------------------------------------------
+class vtkPVMemoryCensusInformation::vtkCensus
+{
+public:
+  vtkSIProxy* Proxy = nullptr;
+  int Port = 0;
+  int Location = PIPELINE_OUTPUT;
+
+  void AddDataObject(vtkDataObject* dobj)
+  {
+    if (auto cd = vtkCompositeDataSet::SafeDownCast(dobj))
+    {
+      vtkSmartPointer<vtkCompositeDataIterator> iter;
+      iter.TakeReference(cd->NewIterator());
+      for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+      {
+        this->AddDataObject(iter->GetCurrentDataObject());
+      }
+      return;
+    }
+    if (!dobj)
+    {
+      return;
+    }
+
+    static const char* attributeLabels[vtkDataObject::NUMBER_OF_ATTRIBUTE_TYPES] = { "point data",
+      "cell data", "field data", nullptr, "vertex data", "edge data", "row data" };
+    for (int type = 0; type < vtkDataObject::NUMBER_OF_ATTRIBUTE_TYPES; ++type)
+    {
+      vtkFieldData* fd = attributeLabels[type] ? dobj->GetAttributesAsFieldData(type) : nullptr;
+      for (int cc = 0; fd && cc < fd->GetNumberOfArrays(); ++cc)
+      {
+        this->AddArray(fd->GetAbstractArray(cc), attributeLabels[type]);
+      }
+    }
+
+    if (auto ps = vtkPointSet::SafeDownCast(dobj))
+    {
+      this->AddArray(ps->GetPoints() ? ps->GetPoints()->GetData() : nullptr, "geometry", "Points");
+    }
+    if (auto pd = vtkPolyData::SafeDownCast(dobj))
+    {
+      this->AddCells(pd->GetVerts(), "verts");
+      this->AddCells(pd->GetLines(), "lines");
+      this->AddCells(pd->GetPolys(), "polys");
+      this->AddCells(pd->GetStrips(), "strips");
+    }
+    else if (auto ug = vtkUnstructuredGrid::SafeDownCast(dobj))
+    {
+      this->AddCells(ug->GetCells(), "cells");
+      this->AddArray(ug->GetCellTypesArray(), "topology", "Cell types");
+      this->AddArray(ug->GetCellLocationsArray(), "topology", "Cell locations");
+      this->AddArray(ug->GetFaces(), "topology", "Faces");
+      this->AddArray(ug->GetFaceLocations(), "topology", "Face locations");
+    }
+    else if (auto rg = vtkRectilinearGrid::SafeDownCast(dobj))
+    {
+      this->AddArray(rg->GetXCoordinates(), "geometry", "X coordinates");
+      this->AddArray(rg->GetYCoordinates(), "geometry", "Y coordinates");
+      this->AddArray(rg->GetZCoordinates(), "geometry", "Z coordinates");
+    }
+  }
+
+  std::vector<ArrayUse> GetArrays() const
+  {
+    std::vector<ArrayUse> arrays;
+    arrays.reserve(this->Arrays.size());
+    for (const auto& item : this->Arrays)
+    {
+      arrays.push_back(item.second);
+    }
+    return arrays;
+  }
+
+private:
+  void AddCells(vtkCellArray* cells, const char* label)
+  {
+    if (cells)
+    {
+      this->AddArray(cells->GetConnectivityArray(), label, "Connectivity");
+      this->AddArray(cells->GetOffsetsArray(), label, "Offsets");
+    }
+  }
+
+  void AddArray(vtkAbstractArray* array, const char* label, const char* name = nullptr)
+  {
+    if (!array)
+    {
+      return;
+    }
+
+    // Shallow copies share the same buffer, while arrays which do not use
+    // the standard memory layout can only be identified by their instance.
+    const void* buffer = array;
+    if (array->HasStandardMemoryLayout() && array->GetNumberOfValues() > 0)
+    {
+      buffer = array->GetVoidPointer(0);
+    }
+    if (!this->Buffers.insert(buffer).second)
+    {
+      return;
+    }
+
+    std::string arrayName = name ? name : (array->GetName() ? array->GetName() : "(unnamed)");
+    arrayName += std::string(" (") + label + ")";
+    auto& use = this->Arrays[std::make_tuple(
+      this->Proxy->GetGlobalID(), this->Port, this->Location, arrayName)];
+    if (use.NumberOfRanks == 0)
+    {
+      use.ProxyId = this->Proxy->GetGlobalID();
+      use.ProxyName = this->Proxy->GetLogNameOrDefault();
+      use.Port = this->Port;
+      use.Location = this->Location;
+      use.ArrayName = arrayName;
+      use.NumberOfRanks = 1;
+    }
+    use.Bytes += static_cast<long long>(array->GetActualMemorySize()) * 1024;
+    use.MaximumRankBytes = use.Bytes;
+  }
+
+  std::set<const void*> Buffers;
+  std::map<std::tuple<vtkTypeUInt32, int, int, std::string>, ArrayUse> Arrays;
+};
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkPVMemoryCensusInformation);
+
+//----------------------------------------------------------------------------
+vtkPVMemoryCensusInformation::vtkPVMemoryCensusInformation() = default;
+
+//----------------------------------------------------------------------------
+vtkPVMemoryCensusInformation::~vtkPVMemoryCensusInformation() = default;
+
+//----------------------------------------------------------------------------
+void vtkPVMemoryCensusInformation::CopyFromObject(vtkObject*)
+{
+  this->Arrays.clear();
+
+  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+  vtkPVSessionBase* session = vtkPVSessionBase::SafeDownCast(pm ? pm->GetActiveSession() : nullptr);
+  vtkPVSessionCore* core = session ? session->GetSessionCore() : nullptr;
+  if (!core)
+  {
+    return;
+  }
+
+  vtkNew<vtkCollection> siObjects;
+  core->GetAllSIObjects(siObjects);
+  std::vector<vtkSIProxy*> proxies;
+  vtkSmartPointer<vtkCollectionIterator> iter;
+  iter.TakeReference(siObjects->NewIterator());
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    vtkSIProxy* proxy = vtkSIProxy::SafeDownCast(iter->GetCurrentObject());
+    if (proxy && proxy->GetVTKObject())
+    {
+      proxies.push_back(proxy);
+    }
+  }
+
+  // Walk the pipeline outputs first, so that buffers shared with the delivery
+  // caches are attributed to the pipeline objects producing them.
+  vtkCensus census;
+  census.Location = PIPELINE_OUTPUT;
+  for (vtkSIProxy* proxy : proxies)
+  {
+    census.Proxy = proxy;
+    if (auto algorithm = vtkAlgorithm::SafeDownCast(proxy->GetVTKObject()))
+    {
+      for (int port = 0; port < algorithm->GetNumberOfOutputPorts(); ++port)
+      {
+        census.Port = port;
+        census.AddDataObject(algorithm->GetExecutive()->GetOutputData(port));
+      }
+    }
+  }
+
+  census.Location = DELIVERY_CACHE;
+  for (vtkSIProxy* proxy : proxies)
+  {
+    census.Proxy = proxy;
+    auto repr = vtkPVDataRepresentation::SafeDownCast(proxy->GetVTKObject());
+    auto view = repr ? vtkPVView::SafeDownCast(repr->GetView()) : nullptr;
+    vtkPVDataDeliveryManager* dmgr = view ? view->GetDeliveryManager() : nullptr;
+    if (dmgr)
+    {
+      for (int port = 0; port < dmgr->GetNumberOfPorts(repr); ++port)
+      {
+        std::vector<vtkDataObject*> objects;
+        dmgr->GetCachedDataObjects(repr, port, objects);
+        census.Port = port;
+        for (vtkDataObject* dobj : objects)
+        {
+          census.AddDataObject(dobj);
+        }
+      }
+    }
+  }
+
+  this->Arrays = census.GetArrays();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVMemoryCensusInformation::AddInformation(vtkPVInformation* pvinfo)
+{
+  auto info = vtkPVMemoryCensusInformation::SafeDownCast(pvinfo);
+  if (!info)
+  {
+    return;
+  }
+
+  // Proxies have the same global id on all processes.
+  std::map<std::tuple<vtkTypeUInt32, int, int, std::string>, size_t> indices;
+  for (size_t cc = 0; cc < this->Arrays.size(); ++cc)
+  {
+    const auto& use = this->Arrays[cc];
+    indices[std::make_tuple(use.ProxyId, use.Port, use.Location, use.ArrayName)] = cc;
+  }
+  for (const auto& other : info->Arrays)
+  {
+    auto iter =
+      indices.find(std::make_tuple(other.ProxyId, other.Port, other.Location, other.ArrayName));
+    if (iter == indices.end())
+    {
+      this->Arrays.push_back(other);
+      continue;
+    }
+    auto& use = this->Arrays[iter->second];
+    use.Bytes += other.Bytes;
+    use.MaximumRankBytes = std::max(use.MaximumRankBytes, other.MaximumRankBytes);
+    use.NumberOfRanks += other.NumberOfRanks;
+  }
+}
+
+//----------------------------------------------------------------------------
+long long vtkPVMemoryCensusInformation::GetTotalBytes() const
+{
+  long long total = 0;
+  for (const auto& use : this->Arrays)
+  {
+    total += use.Bytes;
+  }
+  return total;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVMemoryCensusInformation::CopyToStream(vtkClientServerStream* css)
+{
+  css->Reset();
+  *css << vtkClientServerStream::Reply << static_cast<int>(this->Arrays.size());
+  for (const auto& use : this->Arrays)
+  {
+    *css << use.ProxyId << use.ProxyName.c_str() << use.Port << use.Location
+         << use.ArrayName.c_str() << use.Bytes << use.MaximumRankBytes << use.NumberOfRanks;
+  }
+  *css << vtkClientServerStream::End;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVMemoryCensusInformation::CopyFromStream(const vtkClientServerStream* css)
+{
+  int offset = 0;
+  int count = 0;
+  vtkVerifyParseMacro(css->GetArgument(0, offset++, &count), "count");
+
+  this->Arrays.resize(count);
+  for (auto& use : this->Arrays)
+  {
+    vtkVerifyParseMacro(css->GetArgument(0, offset++, &use.ProxyId), "ProxyId");
+    vtkVerifyParseMacro(css->GetArgument(0, offset++, &use.ProxyName), "ProxyName");
+    vtkVerifyParseMacro(css->GetArgument(0, offset++, &use.Port), "Port");
+    vtkVerifyParseMacro(css->GetArgument(0, offset++, &use.Location), "Location");
+    vtkVerifyParseMacro(css->GetArgument(0, offset++, &use.ArrayName), "ArrayName");
+    vtkVerifyParseMacro(css->GetArgument(0, offset++, &use.Bytes), "Bytes");
+    vtkVerifyParseMacro(css->GetArgument(0, offset++, &use.MaximumRankBytes), "MaximumRankBytes");
+    vtkVerifyParseMacro(css->GetArgument(0, offset++, &use.NumberOfRanks), "NumberOfRanks");
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVMemoryCensusInformation::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfArrays: " << this->Arrays.size() << endl;
+  os << indent << "TotalBytes: " << this->GetTotalBytes() << endl;
+}
@@ -0,0 +1,129 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVMemoryCensusInformation.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class vtkPVMemoryCensusInformation
+ * @brief memory used by the arrays of each pipeline object.
+ *
+ * vtkPVMemoryCensusInformation complements vtkPVMemoryUseInformation, which
+ * reports the memory used by each process, by attributing the memory held by
+ * data arrays to the proxies holding them. It is gathered with a global id of
+ * 0 and walks all the vtkSIProxy instances of the session: the outputs of
+ * their algorithms and, for representations, the data cached by the
+ * vtkPVDataDeliveryManager of their view, at every cache key and before and
+ * after delivery.
+ *
+ * Each array buffer is only accounted for once per process, with the first
+ * proxy found holding it, since shallow copies share the same buffer
+ * between pipeline outputs and delivery caches. Memory is accounted using
+ * `vtkAbstractArray::GetActualMemorySize`, hence rounded up to the kibibyte.
+ *
+ * Arrays of the same proxy, port and name are merged across processes while
+ * gathering, keeping the total, the largest size on a single process and the
+ * number of processes holding it, hence the gathered information does not
+ * grow with the number of ranks.
+ */
+
+#ifndef vtkPVMemoryCensusInformation_h
+#define vtkPVMemoryCensusInformation_h
+
+#include "vtkPVInformation.h"
+#include "vtkRemotingViewsModule.h" //needed for exports
+
+#include <string> // for std::string
+#include <vector> // for std::vector
+
+class VTKREMOTINGVIEWS_EXPORT vtkPVMemoryCensusInformation : public vtkPVInformation
+{
+public:
+  static vtkPVMemoryCensusInformation* New();
+  vtkTypeMacro(vtkPVMemoryCensusInformation, vtkPVInformation);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Where the array was found.
+   */
+  enum Locations
+  {
+    PIPELINE_OUTPUT = 0,
+    DELIVERY_CACHE = 1
+  };
+
+  /**
+   * Walks the proxies of the active session. The object is ignored.
+   */
+  void CopyFromObject(vtkObject*) override;
+
+  /**
+   * Merge another information object.
+   */
+  void AddInformation(vtkPVInformation*) override;
+
+  //@{
+  /**
+   * Manage a serialized version of the information.
+   */
+  void CopyToStream(vtkClientServerStream*) override;
+  void CopyFromStream(const vtkClientServerStream*) override;
+  //@}
+
+  /**
+   * Returns the number of arrays accounted for.
+   */
+  int GetNumberOfArrays() const { return static_cast<int>(this->Arrays.size()); }
+
+  //@{
+  /**
+   * Access the accounted arrays.
+   */
+  vtkTypeUInt32 GetProxyId(int i) const { return this->Arrays[i].ProxyId; }
+  const char* GetProxyName(int i) const { return this->Arrays[i].ProxyName.c_str(); }
+  int GetPort(int i) const { return this->Arrays[i].Port; }
+  int GetLocation(int i) const { return this->Arrays[i].Location; }
+  const char* GetArrayName(int i) const { return this->Arrays[i].ArrayName.c_str(); }
+  long long GetBytes(int i) const { return this->Arrays[i].Bytes; }
+  long long GetMaximumRankBytes(int i) const { return this->Arrays[i].MaximumRankBytes; }
+  int GetNumberOfRanks(int i) const { return this->Arrays[i].NumberOfRanks; }
+  //@}
+
+  /**
+   * Returns the memory used by all accounted arrays, in bytes.
+   */
+  long long GetTotalBytes() const;
+
+protected:
+  vtkPVMemoryCensusInformation();
+  ~vtkPVMemoryCensusInformation() override;
+
+private:
+  vtkPVMemoryCensusInformation(const vtkPVMemoryCensusInformation&) = delete;
+  void operator=(const vtkPVMemoryCensusInformation&) = delete;
+
+  struct ArrayUse
+  {
+    vtkTypeUInt32 ProxyId = 0;
+    std::string ProxyName;
+    int Port = 0;
+    int Location = PIPELINE_OUTPUT;
+    std::string ArrayName;
+    long long Bytes = 0;
+    long long MaximumRankBytes = 0;
+    int NumberOfRanks = 0;
+  };
+  std::vector<ArrayUse> Arrays;
+
+  class vtkCensus;
+};
+
+#endif
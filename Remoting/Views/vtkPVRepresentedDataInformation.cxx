@@ -20,7 +20,11 @@
 
 vtkStandardNewMacro(vtkPVRepresentedDataInformation);
 //----------------------------------------------------------------------------
-vtkPVRepresentedDataInformation::vtkPVRepresentedDataInformation() = default;
+vtkPVRepresentedDataInformation::vtkPVRepresentedDataInformation()
+{
+  // the rendered data object is not a pipeline output of the representation.
+  this->Cacheable = false;
+}
 
 //----------------------------------------------------------------------------
 vtkPVRepresentedDataInformation::~vtkPVRepresentedDataInformation() = default;
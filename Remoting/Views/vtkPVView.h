@@ -288,6 +288,11 @@ public:
    */
   virtual void ClearCache(vtkPVDataRepresentation*);
 
+  /**
+   * Returns the session this view was created in.
+   */
+  vtkPVSession* GetSession();
+
 protected:
   vtkPVView(bool create_render_window = true);
   ~vtkPVView() override;
@@ -351,8 +356,6 @@ protected:
     vtkInformationRequestKey* passType, vtkInformation* request, vtkInformationVector* reply);
   //@}
 
-  vtkPVSession* GetSession();
-
   /**
    * Flag set to true between calls to `PrepareForScreenshot` and
    * `CleanupAfterScreenshot`.
@@ -269,6 +269,26 @@ bool vtkSMPVRepresentationProxy::RescaleTransferFunctionToDataRangeOverTime(
     return false;
   }
 
+  // When enabled, the ranges over time of the arrays read from a file are
+  // persisted in a sidecar file next to it, see vtkPVTemporalRangeIndex.
+  vtkSMProxy* settingsProxy =
+    this->GetSessionProxyManager()->GetProxy("settings", "GeneralSettings");
+  const char* fileNameProperty = vtkSMCoreUtilities::GetFileNameProperty(inputProxy);
+  if (settingsProxy && fileNameProperty &&
+    vtkSMPropertyHelper(settingsProxy, "UseTemporalRangeIndexFiles", true).GetAsInt() != 0)
+  {
+    const char* fileName = vtkSMPropertyHelper(inputProxy, fileNameProperty).GetAsString(0);
+    if (fileName && *fileName)
+    {
+      vtkNew<vtkPVTemporalDataInformation> dataInfo;
+      dataInfo->SetPortNumber(port);
+      dataInfo->SetSourceFileName(fileName);
+      inputProxy->GatherInformation(dataInfo);
+      vtkPVArrayInformation* info = dataInfo->GetArrayInformation(arrayname, attribute_type);
+      return info ? this->RescaleTransferFunctionToDataRange(info) : false;
+    }
+  }
+
   vtkPVTemporalDataInformation* dataInfo =
     inputProxy->GetOutputPort(port)->GetTemporalDataInformation();
   vtkPVArrayInformation* info = dataInfo->GetArrayInformation(arrayname, attribute_type);
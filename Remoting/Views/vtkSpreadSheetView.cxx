@@ -42,6 +42,7 @@
 #include "vtkSpreadSheetRepresentation.h"
 #include "vtkStringArray.h"
 #include "vtkTable.h"
+#include "vtkTableAlgorithm.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkVariant.h"
 
@@ -55,13 +56,16 @@
 
 namespace
 {
+// Columns identifying the rows, shown first.
+const char* const IdColumnNames[] = { "vtkBlockNameIndices", "vtkOriginalProcessIds",
+  "vtkCompositeIndexArray", "vtkOriginalIndices", "vtkOriginalCellIds", "vtkOriginalPointIds",
+  "vtkOriginalRowIds", "Structured Coordinates", nullptr };
+
 struct OrderByNames : std::binary_function<vtkAbstractArray*, vtkAbstractArray*, bool>
 {
   bool operator()(vtkAbstractArray* a1, vtkAbstractArray* a2)
   {
-    const char* order[] = { "vtkBlockNameIndices", "vtkOriginalProcessIds",
-      "vtkCompositeIndexArray", "vtkOriginalIndices", "vtkOriginalCellIds", "vtkOriginalPointIds",
-      "vtkOriginalRowIds", "Structured Coordinates", nullptr };
+    const char* const* order = IdColumnNames;
     std::string a1Name = a1->GetName() ? a1->GetName() : "";
     std::string a2Name = a2->GetName() ? a2->GetName() : "";
     int a1Index = VTK_INT_MAX, a2Index = VTK_INT_MAX;
@@ -179,6 +183,163 @@ const char* get_userfriendly_name(
   return name;
 }
 
+/// internal function to get the label of a column as
+/// vtkSpreadSheetView::GetColumnLabel does, but from the column itself since
+/// the view only knows the columns on the client.
+std::string get_column_label(vtkAbstractArray* column, vtkSpreadSheetView* self)
+{
+  bool converted = false;
+  const char* name = get_userfriendly_name(column->GetName(), self, &converted);
+  if (!converted && column->HasInformation())
+  {
+    auto colInfo = column->GetInformation();
+    if (colInfo->Has(vtkSplitColumnComponents::ORIGINAL_ARRAY_NAME()) &&
+      colInfo->Has(vtkSplitColumnComponents::ORIGINAL_COMPONENT_NUMBER()) &&
+      colInfo->Get(vtkSplitColumnComponents::ORIGINAL_COMPONENT_NUMBER()) >= 0)
+    {
+      return colInfo->Get(vtkSplitColumnComponents::ORIGINAL_ARRAY_NAME());
+    }
+  }
+  return name ? name : std::string();
+}
+
+/// internal function that returns true if a column is hidden in the view and
+/// hence not delivered to the client. Columns identifying the rows are always
+/// delivered since they are needed for selection.
+bool is_column_projected(vtkAbstractArray* column, vtkTable* table, vtkSpreadSheetView* self)
+{
+  const char* name = column->GetName();
+  if (name == nullptr)
+  {
+    return false;
+  }
+
+  const char* maskPrefix = "__vtkValidMask__";
+  if (std::strstr(name, maskPrefix) == name)
+  {
+    // masks are projected out along with the column they apply to.
+    auto maskedColumn = table->GetColumnByName(name + std::strlen(maskPrefix));
+    return maskedColumn != nullptr && is_column_projected(maskedColumn, table, self);
+  }
+
+  if (self->IsColumnInternal(name))
+  {
+    return false;
+  }
+  for (int cc = 0; IdColumnNames[cc] != nullptr; ++cc)
+  {
+    if (strcmp(IdColumnNames[cc], name) == 0)
+    {
+      return false;
+    }
+  }
+  return self->IsColumnHiddenByName(name) ||
+    self->IsColumnHiddenByLabel(get_column_label(column, self));
+}
+
+/**
+ * A vtkTableAlgorithm used as the pre-gather helper of the reduction filter
+ * to remove the columns hidden in the view from the blocks before they are
+ * reduced and delivered to the client. The name, original array name and
+ * component of the removed columns are listed in the "vtkProjectedColumns"
+ * field data array so that the client still knows of all columns.
+ */
+class SpreadSheetViewProjectColumns : public vtkTableAlgorithm
+{
+public:
+  static SpreadSheetViewProjectColumns* New();
+  vtkTypeMacro(SpreadSheetViewProjectColumns, vtkTableAlgorithm);
+
+  vtkSpreadSheetView* View = nullptr;
+
+protected:
+  SpreadSheetViewProjectColumns() = default;
+  ~SpreadSheetViewProjectColumns() override = default;
+
+  int RequestData(
+    vtkInformation*, vtkInformationVector** inputVector, vtkInformationVector* outputVector) override
+  {
+    auto input = vtkTable::GetData(inputVector[0], 0);
+    auto output = vtkTable::GetData(outputVector, 0);
+    output->ShallowCopy(input);
+    if (this->View == nullptr)
+    {
+      return 1;
+    }
+
+    vtkNew<vtkStringArray> projected;
+    projected->SetName("vtkProjectedColumns");
+    projected->SetNumberOfComponents(3);
+    for (vtkIdType cc = 0, max = input->GetNumberOfColumns(); cc < max; ++cc)
+    {
+      auto column = input->GetColumn(cc);
+      if (column == nullptr || !::is_column_projected(column, input, this->View))
+      {
+        continue;
+      }
+
+      vtkInformation* colInfo = column->HasInformation() ? column->GetInformation() : nullptr;
+      const int original_component =
+        colInfo && colInfo->Has(vtkSplitColumnComponents::ORIGINAL_COMPONENT_NUMBER())
+        ? colInfo->Get(vtkSplitColumnComponents::ORIGINAL_COMPONENT_NUMBER())
+        : -1;
+      projected->InsertNextValue(column->GetName());
+      projected->InsertNextValue(original_component >= 0 &&
+          colInfo->Has(vtkSplitColumnComponents::ORIGINAL_ARRAY_NAME())
+          ? colInfo->Get(vtkSplitColumnComponents::ORIGINAL_ARRAY_NAME())
+          : "");
+      projected->InsertNextValue(vtkVariant(original_component).ToString());
+      output->RemoveColumnByName(column->GetName());
+    }
+
+    if (projected->GetNumberOfTuples() > 0)
+    {
+      // don't modify the field data shared with the input.
+      vtkNew<vtkFieldData> fd;
+      fd->ShallowCopy(input->GetFieldData());
+      fd->AddArray(projected);
+      output->SetFieldData(fd);
+    }
+    return 1;
+  }
+
+private:
+  SpreadSheetViewProjectColumns(const SpreadSheetViewProjectColumns&) = delete;
+  void operator=(const SpreadSheetViewProjectColumns&) = delete;
+};
+vtkStandardNewMacro(SpreadSheetViewProjectColumns);
+
+/// internal function to list the columns projected out on any rank in the
+/// output of the reduction.
+void merge_projected_columns(const std::vector<vtkTable*>& inputs, vtkTable* output)
+{
+  vtkNew<vtkStringArray> merged;
+  merged->SetName("vtkProjectedColumns");
+  merged->SetNumberOfComponents(3);
+  std::set<std::string> names;
+  for (auto input : inputs)
+  {
+    auto projected =
+      vtkStringArray::SafeDownCast(input->GetFieldData()->GetAbstractArray("vtkProjectedColumns"));
+    for (vtkIdType cc = 0, max = projected ? projected->GetNumberOfTuples() : 0; cc < max; ++cc)
+    {
+      if (names.insert(projected->GetValue(3 * cc)).second)
+      {
+        for (int comp = 0; comp < 3; ++comp)
+        {
+          merged->InsertNextValue(projected->GetValue(3 * cc + comp));
+        }
+      }
+    }
+  }
+
+  output->GetFieldData()->RemoveArray("vtkProjectedColumns");
+  if (merged->GetNumberOfTuples() > 0)
+  {
+    output->GetFieldData()->AddArray(merged);
+  }
+}
+
 /**
  * A subclass of vtkPVMergeTables to handle reduction for "vtkBlockNameIndices"
  * and "vtkBlockNames" arrays correctly.
@@ -203,7 +364,12 @@ protected:
       (!inputs.empty() && inputs[0]->GetFieldData()->GetAbstractArray("vtkBlockNames"));
     if (!has_block_names)
     {
-      return this->Superclass::RequestData(req, inputVector, outputVector);
+      if (!this->Superclass::RequestData(req, inputVector, outputVector))
+      {
+        return 0;
+      }
+      ::merge_projected_columns(inputs, output);
+      return 1;
     }
 
     // Reduce vtkBlockNameIndices array correctly.
@@ -266,6 +432,7 @@ protected:
     }
     output->GetFieldData()->RemoveArray("vtkBlockNames");
     output->GetFieldData()->AddArray(outNames);
+    ::merge_projected_columns(inputs, output);
     return 1;
   }
 
@@ -281,16 +448,15 @@ class vtkSpreadSheetView::vtkInternals
   std::vector<std::tuple<std::string, std::string, int> > ColumnMetaData;
   std::map<std::string, size_t> ColumnIndexMap;
 
-  void UpdateColumnMetaData(vtkTable* table)
+  void UpdateColumnMetaData(const std::vector<vtkSmartPointer<vtkAbstractArray> >& columns)
   {
     this->ColumnMetaData.clear();
     this->ColumnIndexMap.clear();
 
     std::map<std::string, vtkIdType> index_map; // this is just to make the lookup faster.
-    for (vtkIdType cc = 0, max = table->GetNumberOfColumns(); cc < max; ++cc)
+    for (const auto& col : columns)
     {
       // this build a tuple that indicates it's not an extracted component
-      auto col = table->GetColumn(cc);
       auto colInfo = col->GetInformation();
 
       const std::string original_name =
@@ -311,7 +477,7 @@ class vtkSpreadSheetView::vtkInternals
     }
 
     assert(this->ColumnMetaData.size() == this->ColumnIndexMap.size() &&
-      this->ColumnIndexMap.size() == static_cast<size_t>(table->GetNumberOfColumns()));
+      this->ColumnIndexMap.size() == columns.size());
   }
 
   vtkIdType GetMostRecentlyAccessedBlock(vtkSpreadSheetView* self)
@@ -330,19 +496,144 @@ class vtkSpreadSheetView::vtkInternals
   public:
     vtkSmartPointer<vtkTable> Dataobject;
     vtkTimeStamp RecentUseTime;
+    unsigned long Size; // in KiB
+    // column of the block for each column of the view, -1 if not delivered.
+    std::vector<vtkIdType> ColumnIndices;
   };
 
   typedef std::map<vtkIdType, CacheInfo> CacheType;
   CacheType CachedBlocks;
 
+  // hidden columns the cached blocks were projected with.
+  std::set<std::string> ProjectedColumnsByName;
+  std::set<std::string> ProjectedColumnsByLabel;
+
+  void Access(vtkIdType blockId)
+  {
+    if (this->MostRecentlyAccessedBlock >= 0 && blockId != this->MostRecentlyAccessedBlock)
+    {
+      this->ScrollDirection = blockId > this->MostRecentlyAccessedBlock ? 1 : -1;
+    }
+    this->MostRecentlyAccessedBlock = blockId;
+  }
+
 public:
   void ClearCache()
   {
     this->CachedBlocks.clear();
     this->ColumnMetaData.clear();
     this->ColumnIndexMap.clear();
+    this->ResetPrefetch();
+  }
+
+  /**
+   * Releases the cached blocks if columns were hidden or shown since they
+   * were fetched, hidden columns are not delivered to the client. The column
+   * metadata is kept since it includes hidden columns.
+   */
+  void ValidateProjection()
+  {
+    if (this->ProjectedColumnsByName != this->HiddenColumnsByName ||
+      this->ProjectedColumnsByLabel != this->HiddenColumnsByLabel)
+    {
+      this->CachedBlocks.clear();
+      this->ResetPrefetch();
+      this->ProjectedColumnsByName = this->HiddenColumnsByName;
+      this->ProjectedColumnsByLabel = this->HiddenColumnsByLabel;
+    }
+  }
+
+  /**
+   * Returns the index of the next block to prefetch, i.e. the closest block
+   * that is not cached yet within `depth` blocks from the most recently
+   * accessed one in the scroll direction, or -1 if there is none.
+   */
+  vtkIdType GetBlockToPrefetch(vtkSpreadSheetView* self, int depth)
+  {
+    const vtkIdType blockSize = self->TableStreamer->GetBlockSize();
+    const vtkIdType numBlocks = (self->GetNumberOfRows() + blockSize - 1) / blockSize;
+    if (this->MostRecentlyAccessedBlock < 0)
+    {
+      return -1;
+    }
+    for (int cc = 1; cc <= depth; ++cc)
+    {
+      const vtkIdType blockId = this->MostRecentlyAccessedBlock + cc * this->ScrollDirection;
+      if (blockId < 0 || blockId >= numBlocks)
+      {
+        break;
+      }
+      if (this->CachedBlocks.find(blockId) == this->CachedBlocks.end())
+      {
+        return blockId;
+      }
+    }
+    return -1;
+  }
+
+  /**
+   * Drops the rows fetched so far for the block being prefetched.
+   */
+  void ResetPrefetch()
+  {
+    this->PrefetchedRows = nullptr;
+    this->PrefetchedBlock = -1;
+    this->PrefetchedPieces = 0;
+  }
+
+  /**
+   * Appends the rows of a piece of the block being prefetched to the ones
+   * fetched before. Block names are resolved for each piece since every piece
+   * has its own "vtkBlockNames". Returns false if the piece does not have the
+   * same columns as the previous ones.
+   */
+  bool AppendPrefetchedPiece(vtkTable* piece)
+  {
+    if (piece == nullptr)
+    {
+      return false;
+    }
+    auto names =
+      vtkStringArray::SafeDownCast(piece->GetFieldData()->GetAbstractArray("vtkBlockNames"));
+    if (this->PrefetchedRows == nullptr)
+    {
+      this->PrefetchedRows = vtkSmartPointer<vtkTable>::New();
+      this->PrefetchedRows->GetFieldData()->DeepCopy(piece->GetFieldData());
+      for (vtkIdType cc = 0, max = piece->GetNumberOfColumns(); cc < max; ++cc)
+      {
+        auto column = ::MapBlockNames(piece->GetColumn(cc), names);
+        vtkSmartPointer<vtkAbstractArray> copy;
+        copy.TakeReference(column->NewInstance());
+        copy->DeepCopy(column);
+        this->PrefetchedRows->AddColumn(copy);
+      }
+      return true;
+    }
+
+    if (piece->GetNumberOfColumns() != this->PrefetchedRows->GetNumberOfColumns())
+    {
+      return false;
+    }
+    for (vtkIdType cc = 0, max = piece->GetNumberOfColumns(); cc < max; ++cc)
+    {
+      auto column = ::MapBlockNames(piece->GetColumn(cc), names);
+      auto rows = column->GetName() ? this->PrefetchedRows->GetColumnByName(column->GetName())
+                                    : nullptr;
+      if (rows == nullptr || rows->GetDataType() != column->GetDataType() ||
+        rows->GetNumberOfComponents() != column->GetNumberOfComponents())
+      {
+        return false;
+      }
+      rows->InsertTuples(rows->GetNumberOfTuples(), column->GetNumberOfTuples(), 0, column);
+    }
+    return true;
   }
 
+  // rows of the block being prefetched, fetched in pieces.
+  vtkSmartPointer<vtkTable> PrefetchedRows;
+  vtkIdType PrefetchedBlock = -1;
+  vtkIdType PrefetchedPieces = 0;
+
   vtkIdType GetNumberOfColumns(vtkSpreadSheetView* self)
   {
     if (this->ActiveRepresentation != nullptr && this->ColumnMetaData.empty())
@@ -389,33 +680,51 @@ public:
     if (iter != this->CachedBlocks.end())
     {
       iter->second.RecentUseTime.Modified();
-      this->MostRecentlyAccessedBlock = blockId;
+      this->Access(blockId);
       return iter->second.Dataobject.GetPointer();
     }
     return nullptr;
   }
 
-  vtkTable* AddToCache(vtkIdType blockId, vtkTable* data, vtkIdType max)
+  /**
+   * Returns the size, in KiB, of the cached blocks.
+   */
+  unsigned long GetCacheSize() const
   {
-    CacheType::iterator iter = this->CachedBlocks.find(blockId);
-    if (iter != this->CachedBlocks.end())
+    unsigned long size = 0;
+    for (const auto& item : this->CachedBlocks)
     {
-      this->CachedBlocks.erase(iter);
+      size += item.second.Size;
+    }
+    return size;
+  }
+
+  /**
+   * Returns the index, in a cached block, of a column of the view or -1 if the
+   * block does not have it, e.g. since it is hidden.
+   */
+  vtkIdType GetBlockColumnIndex(vtkIdType blockId, vtkIdType col) const
+  {
+    CacheType::const_iterator iter = this->CachedBlocks.find(blockId);
+    if (iter == this->CachedBlocks.end() || col < 0 ||
+      col >= static_cast<vtkIdType>(iter->second.ColumnIndices.size()))
+    {
+      return -1;
     }
+    return iter->second.ColumnIndices[col];
+  }
 
-    if (static_cast<vtkIdType>(this->CachedBlocks.size()) == max)
+  /**
+   * Adds a block to the cache, releasing the least recently used blocks, but
+   * the most recently accessed one, while the cache exceeds `limit` KiB.
+   * Prefetched blocks do not count as accessed.
+   */
+  vtkTable* AddToCache(vtkIdType blockId, vtkTable* data, unsigned long limit, bool prefetched)
+  {
+    CacheType::iterator iter = this->CachedBlocks.find(blockId);
+    if (iter != this->CachedBlocks.end())
     {
-      // remove least-recent-used block.
-      iter = this->CachedBlocks.begin();
-      CacheType::iterator iterToRemove = this->CachedBlocks.begin();
-      for (; iter != this->CachedBlocks.end(); ++iter)
-      {
-        if (iterToRemove->second.RecentUseTime > iter->second.RecentUseTime)
-        {
-          iterToRemove = iter;
-        }
-      }
-      this->CachedBlocks.erase(iterToRemove);
+      this->CachedBlocks.erase(iter);
     }
 
     CacheInfo info;
@@ -438,20 +747,83 @@ public:
         }
       }
     }
+
+    // columns hidden in the view are not delivered, add empty placeholders so
+    // that they are still listed in the column metadata.
+    std::set<vtkAbstractArray*> placeholders;
+    if (auto projected = vtkStringArray::SafeDownCast(
+          data->GetFieldData()->GetAbstractArray("vtkProjectedColumns")))
+    {
+      for (vtkIdType cc = 0; cc < projected->GetNumberOfTuples(); ++cc)
+      {
+        vtkNew<vtkCharArray> placeholder;
+        placeholder->SetName(projected->GetValue(3 * cc).c_str());
+        const int original_component = vtkVariant(projected->GetValue(3 * cc + 2)).ToInt();
+        if (original_component >= 0)
+        {
+          auto colInfo = placeholder->GetInformation();
+          colInfo->Set(vtkSplitColumnComponents::ORIGINAL_ARRAY_NAME(),
+            projected->GetValue(3 * cc + 1).c_str());
+          colInfo->Set(vtkSplitColumnComponents::ORIGINAL_COMPONENT_NUMBER(), original_component);
+        }
+        placeholders.insert(placeholder.GetPointer());
+        arrays.push_back(placeholder.GetPointer());
+      }
+    }
+
     // if block-names are present in field-data, create an array
     std::sort(arrays.begin(), arrays.end(), OrderByNames());
     for (const auto& column : arrays)
     {
-      clone->AddColumn(column);
+      if (placeholders.find(column) == placeholders.end())
+      {
+        clone->AddColumn(column);
+      }
     }
     info.Dataobject = clone;
     clone->FastDelete();
     info.RecentUseTime.Modified();
-    this->CachedBlocks[blockId] = info;
-    this->MostRecentlyAccessedBlock = blockId;
-    if (this->CachedBlocks.size() == 1)
+    info.Size = clone->GetActualMemorySize();
+    if (this->CachedBlocks.empty())
+    {
+      this->UpdateColumnMetaData(arrays);
+    }
+    info.ColumnIndices.resize(this->ColumnMetaData.size(), -1);
+    for (vtkIdType cc = 0, max = clone->GetNumberOfColumns(); cc < max; ++cc)
+    {
+      const char* name = clone->GetColumnName(cc);
+      auto colIter = this->ColumnIndexMap.find(name ? name : "<None>");
+      if (colIter != this->ColumnIndexMap.end())
+      {
+        info.ColumnIndices[colIter->second] = cc;
+      }
+    }
+    this->CachedBlocks[blockId] = std::move(info);
+    if (!prefetched || this->MostRecentlyAccessedBlock < 0)
     {
-      this->UpdateColumnMetaData(clone);
+      this->Access(blockId);
+    }
+
+    unsigned long size = this->GetCacheSize();
+    while (size > limit)
+    {
+      // remove least-recent-used block.
+      CacheType::iterator iterToRemove = this->CachedBlocks.end();
+      for (iter = this->CachedBlocks.begin(); iter != this->CachedBlocks.end(); ++iter)
+      {
+        if (iter->first != this->MostRecentlyAccessedBlock && iter->first != blockId &&
+          (iterToRemove == this->CachedBlocks.end() ||
+            iterToRemove->second.RecentUseTime > iter->second.RecentUseTime))
+        {
+          iterToRemove = iter;
+        }
+      }
+      if (iterToRemove == this->CachedBlocks.end())
+      {
+        break;
+      }
+      size -= iterToRemove->second.Size;
+      this->CachedBlocks.erase(iterToRemove);
     }
     return clone;
   }
@@ -480,6 +852,7 @@ public:
   }
 
   vtkIdType MostRecentlyAccessedBlock;
+  int ScrollDirection = 1;
   vtkWeakPointer<vtkSpreadSheetRepresentation> ActiveRepresentation;
   vtkCommand* Observer;
 
@@ -491,14 +864,14 @@ namespace
 {
 void FetchRMI(void* localArg, void* remoteArg, int remoteArgLength, int)
 {
-  assert(remoteArgLength == sizeof(vtkTypeUInt64) * 2);
+  assert(remoteArgLength == sizeof(vtkTypeUInt64) * 3);
   (void)remoteArgLength;
 
   auto arg = reinterpret_cast<vtkTypeUInt64*>(remoteArg);
   vtkSpreadSheetView* self = reinterpret_cast<vtkSpreadSheetView*>(localArg);
   if (static_cast<vtkTypeUInt32>(self->GetIdentifier()) == arg[0])
   {
-    self->FetchBlockCallback(static_cast<vtkIdType>(arg[1]));
+    self->FetchBlockCallback(static_cast<vtkIdType>(arg[1]), static_cast<vtkIdType>(arg[2]));
   }
 }
 
@@ -568,6 +941,9 @@ vtkSpreadSheetView::vtkSpreadSheetView()
   , ReductionFilter(vtkReductionFilter::New())
   , DeliveryFilter(vtkClientServerMoveData::New())
   , NumberOfRows(0)
+  , CacheLimit(100 * 1024)
+  , PrefetchDepth(1)
+  , PrefetchPieceSize(256)
   , CRMICallbackTag(0)
   , PRMICallbackTag(0)
   , Identifier(0)
@@ -576,6 +952,9 @@ vtkSpreadSheetView::vtkSpreadSheetView()
   , FieldAssociation(vtkDataObject::FIELD_ASSOCIATION_POINTS)
 {
   this->ReductionFilter->SetController(vtkMultiProcessController::GetGlobalController());
+  vtkNew<SpreadSheetViewProjectColumns> projectColumns;
+  projectColumns->View = this;
+  this->ReductionFilter->SetPreGatherHelper(projectColumns.GetPointer());
   this->ReductionFilter->SetPostGatherHelper(vtkNew<SpreadSheetViewMergeTables>().GetPointer());
   this->DeliveryFilter->SetOutputDataType(VTK_TABLE);
   this->ReductionFilter->SetInputConnection(this->TableStreamer->GetOutputPort());
@@ -716,6 +1095,9 @@ bool vtkSpreadSheetView::IsColumnInternal(const char* columnName)
 void vtkSpreadSheetView::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "CacheLimit: " << this->CacheLimit << endl;
+  os << indent << "PrefetchDepth: " << this->PrefetchDepth << endl;
+  os << indent << "PrefetchPieceSize: " << this->PrefetchPieceSize << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -816,20 +1198,81 @@ void vtkSpreadSheetView::OnRepresentationUpdated()
 //----------------------------------------------------------------------------
 vtkTable* vtkSpreadSheetView::FetchBlock(vtkIdType blockindex)
 {
+  this->Internals->ValidateProjection();
   vtkTable* block = this->Internals->GetDataObject(blockindex);
   if (!block)
   {
     block = this->FetchBlockCallback(blockindex);
     // use the block returned from the AddToCache since that is cleaned up
     // to have columns in correct order.
-    block = this->Internals->AddToCache(blockindex, block, 10);
+    block = this->Internals->AddToCache(blockindex, block, this->CacheLimit, false);
     this->InvokeEvent(vtkCommand::UpdateEvent, &blockindex);
   }
   return block;
 }
 
+//----------------------------------------------------------------------------
+unsigned long vtkSpreadSheetView::GetCacheSize()
+{
+  return this->Internals->GetCacheSize();
+}
+
+//----------------------------------------------------------------------------
+bool vtkSpreadSheetView::Prefetch()
+{
+  if (!this->Internals->ActiveRepresentation)
+  {
+    return false;
+  }
+
+  auto& internals = *this->Internals;
+  internals.ValidateProjection();
+  vtkIdType blockindex = internals.GetBlockToPrefetch(this, this->PrefetchDepth);
+  if (blockindex < 0)
+  {
+    internals.ResetPrefetch();
+    return false;
+  }
+  if (internals.PrefetchedBlock != blockindex)
+  {
+    internals.ResetPrefetch();
+    internals.PrefetchedBlock = blockindex;
+  }
+
+  // the block is fetched in pieces of PrefetchPieceSize rows, i.e. as blocks
+  // of that size, so that each call only holds the client for a short time.
+  const vtkIdType blockSize = this->TableStreamer->GetBlockSize();
+  const vtkIdType pieceSize =
+    (this->PrefetchPieceSize < blockSize && blockSize % this->PrefetchPieceSize == 0)
+    ? this->PrefetchPieceSize
+    : blockSize;
+  const vtkIdType numPieces = blockSize / pieceSize;
+  vtkTable* piece =
+    this->FetchBlockCallback(blockindex * numPieces + internals.PrefetchedPieces, pieceSize);
+  if (!internals.AppendPrefetchedPiece(piece))
+  {
+    internals.ResetPrefetch();
+    return false;
+  }
+
+  if (++internals.PrefetchedPieces == numPieces || piece->GetNumberOfRows() < pieceSize)
+  {
+    vtkSmartPointer<vtkTable> block = internals.PrefetchedRows;
+    internals.ResetPrefetch();
+    internals.AddToCache(blockindex, block, this->CacheLimit, true);
+    this->InvokeEvent(vtkCommand::UpdateEvent, &blockindex);
+  }
+  return true;
+}
+
 //----------------------------------------------------------------------------
 vtkTable* vtkSpreadSheetView::FetchBlockCallback(vtkIdType blockindex)
+{
+  return this->FetchBlockCallback(blockindex, this->TableStreamer->GetBlockSize());
+}
+
+//----------------------------------------------------------------------------
+vtkTable* vtkSpreadSheetView::FetchBlockCallback(vtkIdType blockindex, vtkIdType blockSize)
 {
   // Sanity Check
   if (!this->Internals->ActiveRepresentation)
@@ -838,24 +1281,29 @@ vtkTable* vtkSpreadSheetView::FetchBlockCallback(vtkIdType blockindex)
   }
 
   // cout << "FetchBlockCallback" << endl;
-  vtkTypeUInt64 data[2] = { this->Identifier, static_cast<vtkTypeUInt64>(blockindex) };
+  vtkTypeUInt64 data[3] = { this->Identifier, static_cast<vtkTypeUInt64>(blockindex),
+    static_cast<vtkTypeUInt64>(blockSize) };
   if (auto dController = this->GetSession()->GetController(vtkPVSession::DATA_SERVER_ROOT))
   {
-    dController->TriggerRMIOnAllChildren(data, sizeof(vtkTypeUInt64) * 2, FETCH_BLOCK_TAG);
+    dController->TriggerRMIOnAllChildren(data, sizeof(vtkTypeUInt64) * 3, FETCH_BLOCK_TAG);
   }
   auto pController = vtkMultiProcessController::GetGlobalController();
   if (pController && pController->GetLocalProcessId() == 0 &&
     pController->GetNumberOfProcesses() > 1)
   {
-    pController->TriggerRMIOnAllChildren(data, sizeof(vtkTypeUInt64) * 2, FETCH_BLOCK_TAG);
+    pController->TriggerRMIOnAllChildren(data, sizeof(vtkTypeUInt64) * 3, FETCH_BLOCK_TAG);
   }
 
+  // blocks may be requested with a smaller size, e.g. for prefetching.
+  const vtkIdType viewBlockSize = this->TableStreamer->GetBlockSize();
+  this->TableStreamer->SetBlockSize(blockSize);
   this->TableStreamer->SetBlock(blockindex);
   this->TableStreamer->Modified();
   this->TableSelectionMarker->SetFieldAssociation(this->FieldAssociation);
   this->ReductionFilter->Modified();
   this->DeliveryFilter->Modified();
   this->DeliveryFilter->Update();
+  this->TableStreamer->SetBlockSize(viewBlockSize);
   return vtkTable::SafeDownCast(this->DeliveryFilter->GetOutput());
 }
 
@@ -914,7 +1362,9 @@ vtkVariant vtkSpreadSheetView::GetValue(vtkIdType row, vtkIdType col)
   vtkIdType blockIndex = row / blockSize;
   vtkTable* block = this->FetchBlock(blockIndex);
   vtkIdType blockOffset = row - (blockIndex * blockSize);
-  return block->GetValue(blockOffset, col);
+  // blocks miss the columns hidden in the view, hence the mapping of columns.
+  vtkIdType blockColumn = block ? this->Internals->GetBlockColumnIndex(blockIndex, col) : -1;
+  return blockColumn >= 0 ? block->GetValue(blockOffset, blockColumn) : vtkVariant();
 }
 
 //----------------------------------------------------------------------------
@@ -946,6 +1396,7 @@ bool vtkSpreadSheetView::IsRowSelected(vtkIdType row)
 //----------------------------------------------------------------------------
 bool vtkSpreadSheetView::IsAvailable(vtkIdType row)
 {
+  this->Internals->ValidateProjection();
   vtkIdType blockSize = this->TableStreamer->GetBlockSize();
   vtkIdType blockIndex = row / blockSize;
   return this->Internals->GetDataObject(blockIndex) != nullptr;
@@ -19,6 +19,11 @@
  * as a spreadsheet. This view can only show one representation at a
  * time. If more than one representation is added to this view, only the first
  * visible representation will be shown.
+ *
+ * Rows are fetched from the data server in blocks of BlockSize rows, which
+ * are cached on the client up to CacheLimit. Columns hidden in the view are
+ * not delivered to the client, and the blocks following the ones being
+ * scrolled through can be prefetched using `Prefetch`.
 */
 
 #ifndef vtkSpreadSheetView_h
@@ -212,6 +217,53 @@ public:
    */
   void SetBlockSize(vtkIdType val);
 
+  //@{
+  /**
+   * Get/Set the maximum size, in KiB, of the blocks cached on the client. The
+   * least recently used blocks are released first, the most recently accessed
+   * block is always kept. Defaults to 100 MiB.
+   */
+  vtkSetMacro(CacheLimit, unsigned long);
+  vtkGetMacro(CacheLimit, unsigned long);
+  //@}
+
+  /**
+   * Returns the size, in KiB, of the blocks currently cached on the client.
+   */
+  unsigned long GetCacheSize();
+
+  //@{
+  /**
+   * Get/Set the number of blocks to prefetch after the most recently accessed
+   * block, in the direction the rows are scrolled in. 0 disables prefetching.
+   * Defaults to 1.
+   */
+  vtkSetClampMacro(PrefetchDepth, int, 0, VTK_INT_MAX);
+  vtkGetMacro(PrefetchDepth, int);
+  //@}
+
+  //@{
+  /**
+   * Get/Set the number of rows fetched by each call to `Prefetch`. Blocks are
+   * prefetched in pieces of that many rows so that no call holds the client
+   * for as long as fetching a whole block does. Blocks are prefetched at once
+   * if it does not divide the block size. Defaults to 256.
+   */
+  vtkSetClampMacro(PrefetchPieceSize, vtkIdType, 1, VTK_ID_MAX);
+  vtkGetMacro(PrefetchPieceSize, vtkIdType);
+  //@}
+
+  /**
+   * Fetches the next piece of the closest block to prefetch that is not cached
+   * yet, see PrefetchDepth and PrefetchPieceSize. The block is added to the
+   * cache once all its pieces are fetched. Returns false if there was nothing
+   * to prefetch, true if it should be called again. This is meant to be
+   * called when the client is idle, e.g. once the visible rows are shown, so
+   * that prefetching does not delay fetching the blocks needed right away.
+   * \note CallOnClient
+   */
+  bool Prefetch();
+
   /**
    * Export the contents of this view using the exporter.
    */
@@ -223,8 +275,11 @@ public:
   void ClearCache();
   using Superclass::ClearCache;
 
+  //@{
   // INTERNAL METHOD. Don't call directly.
   vtkTable* FetchBlockCallback(vtkIdType blockindex);
+  vtkTable* FetchBlockCallback(vtkIdType blockindex, vtkIdType blockSize);
+  //@}
 
 protected:
   vtkSpreadSheetView();
@@ -249,6 +304,9 @@ protected:
   vtkReductionFilter* ReductionFilter;
   vtkClientServerMoveData* DeliveryFilter;
   vtkIdType NumberOfRows;
+  unsigned long CacheLimit;
+  int PrefetchDepth;
+  vtkIdType PrefetchPieceSize;
 
   unsigned long CRMICallbackTag;
   unsigned long PRMICallbackTag;
@@ -184,6 +184,8 @@ public:
   double AmountOfDetail;
   double ItemCoverage;   // amount of the item that is onscreen (fraction, if whole item is onscreen
                          // it is 1)
+  double GeometricError; // size of the details the block adds i.e. size of the coarser cells it
+                         // refines (0 is considered as undefined).
   vtkBoundingBox Bounds; // Bounds for the block.
 
   vtkStreamingPriorityQueueItem()
@@ -193,6 +195,7 @@ public:
     , Priority(0)
     , Distance(0)
     , AmountOfDetail(-1)
+    , GeometricError(0)
   {
   }
 };
@@ -41,12 +41,15 @@
 #include "vtkMultiPieceDataSet.h"
 #include "vtkNonOverlappingAMR.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 #include "vtkUnstructuredGrid.h"
 #include <cmath>
+#include <memory>
 #include <ctime>
 
 vtkStandardNewMacro(vtkAMRDualClip);
@@ -145,6 +148,15 @@ public:
 
   vtkUnsignedCharArray* GetLevelMaskArray() { return this->LevelMaskArray; }
 
+  // Used to process a block with another locator than the one it owns.
+  void CopyLevelMask(vtkAMRDualClipLocator* source);
+
+  // Description:
+  // Index of a pointer returned by GetEdgePointer or GetCornerPointer, and
+  // pointer to the same entry in another locator of the same dimensions.
+  vtkIdType GetSlot(const vtkIdType* ptIdPtr) const { return ptIdPtr - this->XEdges; }
+  vtkIdType* GetSlotPointer(vtkIdType slot) { return this->XEdges + slot; }
+
 private:
   int DualCellDimensions[3];
   // Increments for translating 3d to 1d.  XIncrement = 1;
@@ -610,9 +622,7 @@ void vtkAMRDualClipLocator::Initialize(int xDualCellDim, int yDualCellDim, int z
     if (this->XEdges)
     { // They are all allocated at once, so separate checks are not necessary.
       delete[] this->XEdges;
-      delete[] this->YEdges;
-      delete[] this->ZEdges;
-      delete[] this->Corners;
+      this->XEdges = this->YEdges = this->ZEdges = this->Corners = nullptr;
       this->LevelMaskArray->Delete();
       this->LevelMaskArray = nullptr;
     }
@@ -625,10 +635,11 @@ void vtkAMRDualClipLocator::Initialize(int xDualCellDim, int yDualCellDim, int z
       this->YIncrement = this->DualCellDimensions[0] + 1;
       this->ZIncrement = this->YIncrement * (this->DualCellDimensions[1] + 1);
       this->ArrayLength = this->ZIncrement * (this->DualCellDimensions[2] + 1);
-      this->XEdges = new vtkIdType[this->ArrayLength];
-      this->YEdges = new vtkIdType[this->ArrayLength];
-      this->ZEdges = new vtkIdType[this->ArrayLength];
-      this->Corners = new vtkIdType[this->ArrayLength];
+      // A single allocation lets slots index all the arrays.
+      this->XEdges = new vtkIdType[4 * this->ArrayLength];
+      this->YEdges = this->XEdges + this->ArrayLength;
+      this->ZEdges = this->YEdges + this->ArrayLength;
+      this->Corners = this->ZEdges + this->ArrayLength;
       this->LevelMaskArray = vtkUnsignedCharArray::New();
       this->LevelMaskArray->SetNumberOfTuples(this->ArrayLength);
       // 255 is a special value that means the pixel is uninitialized.
@@ -644,10 +655,18 @@ void vtkAMRDualClipLocator::Initialize(int xDualCellDim, int yDualCellDim, int z
     }
   }
 
-  for (int idx = 0; idx < this->ArrayLength; ++idx)
+  for (int idx = 0; idx < 4 * this->ArrayLength; ++idx)
   {
-    this->XEdges[idx] = this->YEdges[idx] = this->ZEdges[idx] = -1;
-    this->Corners[idx] = -1;
+    this->XEdges[idx] = -1;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkAMRDualClipLocator::CopyLevelMask(vtkAMRDualClipLocator* source)
+{
+  if (this->ArrayLength > 0 && this->ArrayLength == source->ArrayLength)
+  {
+    memcpy(this->GetLevelMaskPointer(), source->GetLevelMaskPointer(), this->ArrayLength);
   }
 }
 
@@ -1016,6 +1035,49 @@ void vtkAMRDualClipLocator::ShareBlockLocatorWithNeighbor(
   }
 }
 
+//============================================================================
+// Tetrahedra generated for one block.  Blocks are processed in parallel with
+// a thread local locator, so point ids are local to the piece.  Pieces are
+// stitched into the output in block order, where the block locators merge
+// the points shared with neighbor blocks.
+class vtkAMRDualClipPiece
+{
+public:
+  vtkAMRDualClipPiece()
+    : Locator(nullptr)
+    , Processed(false)
+  {
+  }
+
+  // Description:
+  // Adds a point and stores its id in the locator entry.  The attributes of
+  // the point are interpolated from two input cells, or copied from the first
+  // one when the second offset is -1.
+  void InsertNextPoint(const double pt[3], vtkIdType* ptIdPtr, unsigned char levelMaskValue,
+    vtkIdType offset0, vtkIdType offset1, double k)
+  {
+    *ptIdPtr = static_cast<vtkIdType>(this->PointSlots.size());
+    this->Points.insert(this->Points.end(), pt, pt + 3);
+    this->PointSlots.push_back(this->Locator->GetSlot(ptIdPtr));
+    this->LevelMaskValues.push_back(levelMaskValue);
+    this->AttributeOffsets.push_back(offset0);
+    this->AttributeOffsets.push_back(offset1);
+    this->AttributeWeights.push_back(k);
+  }
+
+  // Only set while the block is processed.
+  vtkAMRDualClipLocator* Locator;
+  bool Processed;
+
+  std::vector<double> Points;
+  std::vector<vtkIdType> PointSlots;
+  std::vector<unsigned char> LevelMaskValues;
+  std::vector<vtkIdType> AttributeOffsets;
+  std::vector<double> AttributeWeights;
+  // Four point ids per tetrahedron.
+  std::vector<vtkIdType> Tetras;
+};
+
 //============================================================================
 //----------------------------------------------------------------------------
 // Description:
@@ -1030,6 +1092,7 @@ vtkAMRDualClip::vtkAMRDualClip()
   this->EnableDegenerateCells = 1;
   this->EnableMultiProcessCommunication = 0;
   this->EnableMergePoints = 0;
+  this->EnableParallelBlocks = 1;
 
   this->Controller = nullptr;
   this->SetController(vtkMultiProcessController::GetGlobalController());
@@ -1040,18 +1103,11 @@ vtkAMRDualClip::vtkAMRDualClip()
   this->LevelMaskPointArray = nullptr;
   this->BlockIdCellArray = nullptr;
   this->Helper = nullptr;
-
-  this->BlockLocator = nullptr;
 }
 
 //----------------------------------------------------------------------------
 vtkAMRDualClip::~vtkAMRDualClip()
 {
-  if (this->BlockLocator)
-  {
-    delete this->BlockLocator;
-    this->BlockLocator = nullptr;
-  }
   this->SetController(nullptr);
 }
 
@@ -1064,6 +1120,7 @@ void vtkAMRDualClip::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "EnableInternalDecimation: " << this->EnableInternalDecimation << endl;
   os << indent << "EnableDegenerateCells: " << this->EnableDegenerateCells << endl;
   os << indent << "EnableMergePoints: " << this->EnableMergePoints << endl;
+  os << indent << "EnableParallelBlocks: " << this->EnableParallelBlocks << endl;
   os << indent << "Controller: " << this->Controller << endl;
 }
 
@@ -1207,17 +1264,58 @@ vtkMultiBlockDataSet* vtkAMRDualClip::DoRequestData(
   int numBlocks;
   int blockId;
 
+  // Locators merge points in a block.  They are reused by each thread.
+  vtkSMPThreadLocal<std::shared_ptr<vtkAMRDualClipLocator> > locators;
+
   // Add each block.
   for (int level = 0; level < numLevels; ++level)
   {
     numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
+    // Level masks only depend on the input, they are set up before the
+    // blocks of the level are processed in parallel.  Blocks are then
+    // stitched in order so that points are shared with neighbors as if the
+    // blocks were processed one after the other.
+    if (this->EnableMergePoints)
+    {
+      for (blockId = 0; blockId < numBlocks; ++blockId)
+      {
+        vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
+        if (block->Image && block->Image->GetCellData()->GetArray(arrayNameToProcess))
+        {
+          this->InitializeLevelMask(block);
+          this->ShareLevelMask(block);
+        }
+      }
+    }
+    std::vector<vtkAMRDualClipPiece> pieces(numBlocks);
+    auto processBlocks = [&](vtkIdType first, vtkIdType last) {
+      auto& locator = locators.Local();
+      if (!locator)
+      {
+        locator = std::make_shared<vtkAMRDualClipLocator>();
+      }
+      for (vtkIdType idx = first; idx < last; ++idx)
+      {
+        vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, static_cast<int>(idx));
+        pieces[idx].Locator = locator.get();
+        this->ProcessBlock(block, arrayNameToProcess, &pieces[idx]);
+        pieces[idx].Locator = nullptr;
+      }
+    };
+    if (this->EnableParallelBlocks)
+    {
+      vtkSMPTools::For(0, numBlocks, processBlocks);
+    }
+    else
+    {
+      processBlocks(0, numBlocks);
+    }
     for (blockId = 0; blockId < numBlocks; ++blockId)
     {
       vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
-      this->ProcessBlock(block, blockId, arrayNameToProcess);
+      this->StitchPiece(block, blockId, &pieces[blockId]);
     }
   }
-
   this->BlockIdCellArray->Delete();
   this->BlockIdCellArray = nullptr;
   this->LevelMaskPointArray->Delete();
@@ -1456,7 +1554,7 @@ void vtkAMRDualClip::ShareLevelMask(vtkAMRDualGridHelperBlock* block)
 
 //----------------------------------------------------------------------------
 void vtkAMRDualClip::ProcessBlock(
-  vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayNameToProcess)
+  vtkAMRDualGridHelperBlock* block, const char* arrayNameToProcess, vtkAMRDualClipPiece* piece)
 {
   vtkImageData* image = block->Image;
   if (image == nullptr)
@@ -1486,21 +1584,13 @@ void vtkAMRDualClip::ProcessBlock(
 
   // Locator merges points in this block.
   // Input the dimensions of the dual cells with ghosts.
+  // Points are merged with neighbor blocks when the piece is stitched.
+  piece->Locator->Initialize(extent[1] - extent[0], extent[3] - extent[2], extent[5] - extent[4]);
   if (this->EnableMergePoints)
-  {
-    this->InitializeLevelMask(block);
-    this->BlockLocator = vtkAMRDualClipGetBlockLocator(block);
-  }
-  else
-  { // Shared locator.
-    if (this->BlockLocator == nullptr)
-    {
-      this->BlockLocator = new vtkAMRDualClipLocator;
-    }
-    this->BlockLocator->Initialize(
-      extent[1] - extent[0], extent[3] - extent[2], extent[5] - extent[4]);
-    // this->BlockLocator->CopyRegionLevelDifferences(block);
+  { // The level mask was initialized in the locator owned by the block.
+    piece->Locator->CopyLevelMask(vtkAMRDualClipGetBlockLocator(block));
   }
+  piece->Processed = true;
   image->GetOrigin(origin);
   spacing = image->GetSpacing();
   // Dual cells are shifted half a pixel.
@@ -1575,7 +1665,7 @@ void vtkAMRDualClip::ProcessBlock(
           cornerOffsets[5] = xOffset + 1 + zInc;
           cornerOffsets[6] = xOffset + yInc + zInc;
           cornerOffsets[7] = xOffset + 1 + yInc + zInc;
-          this->ProcessDualCell(block, blockId, x, y, z, cornerOffsets, volumeFractionArray);
+          this->ProcessDualCell(block, piece, x, y, z, cornerOffsets, volumeFractionArray);
         }
         xOffset += 1; // xInc
       }
@@ -1583,15 +1673,83 @@ void vtkAMRDualClip::ProcessBlock(
     }
     zOffset += zInc;
   }
+}
+
+//----------------------------------------------------------------------------
+// Adds the points and tetrahedra of a processed block to the output.  Points
+// already created by neighbor blocks are found in the block locator, and the
+// new ones are recorded in it to be shared with the next neighbors.
+void vtkAMRDualClip::StitchPiece(
+  vtkAMRDualGridHelperBlock* block, int blockId, vtkAMRDualClipPiece* piece)
+{
+  if (!piece->Processed)
+  {
+    return;
+  }
+
+  vtkAMRDualClipLocator* locator = nullptr;
+  if (this->EnableMergePoints)
+  {
+    locator = vtkAMRDualClipGetBlockLocator(block);
+  }
+
+  vtkIdType numPoints = static_cast<vtkIdType>(piece->PointSlots.size());
+  std::vector<vtkIdType> pointMap(numPoints);
+  for (vtkIdType ptId = 0; ptId < numPoints; ++ptId)
+  {
+    vtkIdType* ptIdPtr = nullptr;
+    if (locator)
+    {
+      ptIdPtr = locator->GetSlotPointer(piece->PointSlots[ptId]);
+      if (*ptIdPtr != -1)
+      { // A neighbor already created this point.
+        pointMap[ptId] = *ptIdPtr;
+        continue;
+      }
+    }
+    vtkIdType outId = this->Points->InsertNextPoint(&piece->Points[3 * ptId]);
+    vtkIdType offset0 = piece->AttributeOffsets[2 * ptId];
+    vtkIdType offset1 = piece->AttributeOffsets[2 * ptId + 1];
+    if (offset1 == -1)
+    {
+      this->Mesh->GetPointData()->CopyData(block->Image->GetCellData(), offset0, outId);
+    }
+    else
+    {
+      this->Mesh->GetPointData()->InterpolateEdge(
+        block->Image->GetCellData(), outId, offset0, offset1, piece->AttributeWeights[ptId]);
+    }
+    this->LevelMaskPointArray->InsertNextValue(piece->LevelMaskValues[ptId]);
+    if (ptIdPtr)
+    {
+      *ptIdPtr = outId;
+    }
+    pointMap[ptId] = outId;
+  }
+
+  vtkIdType numTetras = static_cast<vtkIdType>(piece->Tetras.size()) / 4;
+  for (vtkIdType tetraId = 0; tetraId < numTetras; ++tetraId)
+  {
+    vtkIdType* pointIds = &piece->Tetras[4 * tetraId];
+    for (int ii = 0; ii < 4; ++ii)
+    {
+      pointIds[ii] = pointMap[pointIds[ii]];
+    }
+    // Points merged with neighbors can make a tetrahedron degenerate.
+    if (pointIds[0] != pointIds[1] && pointIds[0] != pointIds[2] && pointIds[0] != pointIds[3] &&
+      pointIds[1] != pointIds[2] && pointIds[1] != pointIds[3] && pointIds[2] != pointIds[3])
+    {
+      this->Cells->InsertNextCell(4, pointIds);
+      this->BlockIdCellArray->InsertNextValue(blockId);
+    }
+  }
 
   if (this->EnableMergePoints)
   {
-    this->ShareLevelMask(block);
     // Copy point ids into neighbor locators.
     this->ShareBlockLocatorWithNeighbors(block);
     // We are done.  We no longer need the locator for this block.
-    delete this->BlockLocator;
-    this->BlockLocator = nullptr;
+    delete locator;
     block->UserData = nullptr;
     // Lets use this unused flag (owner of center region/block) to indicate
     // that the block is already processes.
@@ -1606,8 +1764,8 @@ void vtkAMRDualClip::ProcessBlock(
 //----------------------------------------------------------------------------
 // Not implemented as optimally as we could.  It can be improved by making
 // a fast path for internal cells (with no degeneracies).
-void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y,
-  int z, vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray)
+void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, vtkAMRDualClipPiece* piece,
+  int x, int y, int z, vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray)
 {
   // compute the case index
   vtkImageData* image = block->Image;
@@ -1835,8 +1993,8 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
       // convert from VTK corner ids to bit (x,y,z) corner ids.
       if (casePtId < 8)
       { // Corner (internal point)
-        ptIdPtr = this->BlockLocator->GetCornerPointer(x, y, z, casePtId, block->OriginIndex);
-        levelMaskValue = this->BlockLocator->GetLevelMaskValue(
+        ptIdPtr = piece->Locator->GetCornerPointer(x, y, z, casePtId, block->OriginIndex);
+        levelMaskValue = piece->Locator->GetLevelMaskValue(
           x + ((casePtId & 1) ? 1 : 0), y + ((casePtId & 2) ? 1 : 0), z + ((casePtId & 4) ? 1 : 0));
         if (levelMaskValue == 0)
         { // bug !!!!! trying to figure out what is going on.
@@ -1888,7 +2046,6 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
           pt[0] = origin[0] + spacing[0] * (double)(1 << levelDiff) * ((double)(px) + dx);
           pt[1] = origin[1] + spacing[1] * (double)(1 << levelDiff) * ((double)(py) + dy);
           pt[2] = origin[2] + spacing[2] * (double)(1 << levelDiff) * ((double)(pz) + dz);
-          *ptIdPtr = this->Points->InsertNextPoint(pt);
           if (pt[1] > 100000.0)
           {
             cerr << "bug\n";
@@ -1902,14 +2059,12 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
           // Averaging could be a pre processing step but we would have to modify input attributes
           // .......
           vtkIdType offset = cornerOffsets[casePtId];
-          this->Mesh->GetPointData()->CopyData(block->Image->GetCellData(), offset, *ptIdPtr);
-
-          this->LevelMaskPointArray->InsertNextValue(levelMaskValue);
+          piece->InsertNextPoint(pt, ptIdPtr, levelMaskValue, offset, -1, 0.0);
         }
       }
       else
       { // Edge (clipped cell, point on iso surface)
-        ptIdPtr = this->BlockLocator->GetEdgePointer(x, y, z, casePtId - 8);
+        ptIdPtr = piece->Locator->GetEdgePointer(x, y, z, casePtId - 8);
         if (*ptIdPtr == -1)
         {
           int edge = casePtId - 8;
@@ -1926,7 +2081,6 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
             cornerPoints[pt1Idx | 1] + k * (cornerPoints[pt2Idx | 1] - cornerPoints[pt1Idx | 1]);
           pt[2] =
             cornerPoints[pt1Idx | 2] + k * (cornerPoints[pt2Idx | 2] - cornerPoints[pt1Idx | 2]);
-          *ptIdPtr = this->Points->InsertNextPoint(pt);
           if (pt[1] > 100000.0)
           {
             cerr << "bug\n";
@@ -1936,10 +2090,7 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
           // Find the offsets of the two attributes to interpolate
           vtkIdType offset0 = cornerOffsets[pt1Idx >> 2];
           vtkIdType offset1 = cornerOffsets[pt2Idx >> 2];
-          this->Mesh->GetPointData()->InterpolateEdge(
-            block->Image->GetCellData(), *ptIdPtr, offset0, offset1, k);
-
-          this->LevelMaskPointArray->InsertNextValue(levelMaskValue);
+          piece->InsertNextPoint(pt, ptIdPtr, levelMaskValue, offset0, offset1, k);
         }
       }
       pointIds[ii] = *ptIdPtr;
@@ -1947,8 +2098,7 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
     if (pointIds[0] != pointIds[1] && pointIds[0] != pointIds[2] && pointIds[0] != pointIds[3] &&
       pointIds[1] != pointIds[2] && pointIds[1] != pointIds[3] && pointIds[2] != pointIds[3])
     {
-      this->Cells->InsertNextCell(4, pointIds);
-      this->BlockIdCellArray->InsertNextValue(blockId);
+      piece->Tetras.insert(piece->Tetras.end(), pointIds, pointIds + 4);
     }
   }
 }
@@ -47,6 +47,7 @@ class vtkAMRDualGridHelper;
 class vtkAMRDualGridHelperBlock;
 class vtkAMRDualGridHelperFace;
 class vtkAMRDualClipLocator;
+class vtkAMRDualClipPiece;
 
 class VTKPVVTKEXTENSIONSAMR_EXPORT vtkAMRDualClip : public vtkMultiBlockDataSetAlgorithm
 {
@@ -85,6 +86,17 @@ public:
   vtkBooleanMacro(EnableMergePoints, int);
   //@}
 
+  //@{
+  /**
+   * This flag causes the blocks of each level to be processed in parallel
+   * using vtkSMPTools. When off, they are processed one after the other,
+   * e.g. to compare the output or the performance of both. On by default.
+   */
+  vtkSetMacro(EnableParallelBlocks, int);
+  vtkGetMacro(EnableParallelBlocks, int);
+  vtkBooleanMacro(EnableParallelBlocks, int);
+  //@}
+
   vtkGetObjectMacro(Controller, vtkMultiProcessController);
   virtual void SetController(vtkMultiProcessController*);
 
@@ -99,6 +111,7 @@ protected:
   int EnableDegenerateCells;
   int EnableMultiProcessCommunication;
   int EnableMergePoints;
+  int EnableParallelBlocks;
 
   // Needed for copying cell data to point data.
   vtkUnstructuredGrid* Mesh;
@@ -118,10 +131,22 @@ protected:
 
   void ShareBlockLocatorWithNeighbors(vtkAMRDualGridHelperBlock* block);
 
-  void ProcessBlock(vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayName);
+  /**
+   * Generates the tetrahedra of a block with point ids local to the piece.
+   * Blocks are processed in parallel, this must not modify shared state.
+   */
+  void ProcessBlock(
+    vtkAMRDualGridHelperBlock* block, const char* arrayName, vtkAMRDualClipPiece* piece);
 
-  void ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y, int z,
-    vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray);
+  /**
+   * Adds a piece to the output mesh, merging the points shared with the
+   * neighbor blocks. Pieces must be stitched in the order blocks are listed
+   * by the helper, from low level to high.
+   */
+  void StitchPiece(vtkAMRDualGridHelperBlock* block, int blockId, vtkAMRDualClipPiece* piece);
+
+  void ProcessDualCell(vtkAMRDualGridHelperBlock* block, vtkAMRDualClipPiece* piece, int x, int y,
+    int z, vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray);
 
   void InitializeLevelMask(vtkAMRDualGridHelperBlock* block);
   void ShareLevelMask(vtkAMRDualGridHelperBlock* block);
@@ -148,8 +173,6 @@ protected:
   int* MessageBuffer;
   int* MessageBufferLength;
 
-  vtkAMRDualClipLocator* BlockLocator;
-
 private:
   vtkAMRDualClip(const vtkAMRDualClip&) = delete;
   void operator=(const vtkAMRDualClip&) = delete;
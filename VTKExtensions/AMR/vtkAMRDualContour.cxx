@@ -41,10 +41,13 @@
 #include "vtkNonOverlappingAMR.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 #include <cmath>
+#include <memory>
 #include <ctime>
 
 vtkStandardNewMacro(vtkAMRDualContour);
@@ -103,6 +106,12 @@ public:
   void ShareBlockLocatorWithNeighbor(
     vtkAMRDualGridHelperBlock* block, vtkAMRDualGridHelperBlock* neighbor);
 
+  // Description:
+  // Index of a pointer returned by GetEdgePointer or GetCornerPointer, and
+  // pointer to the same entry in another locator of the same dimensions.
+  vtkIdType GetSlot(const vtkIdType* ptIdPtr) const { return ptIdPtr - this->XEdges; }
+  vtkIdType* GetSlotPointer(vtkIdType slot) { return this->XEdges + slot; }
+
 private:
   int DualCellDimensions[3];
   // Increments for translating 3d to 1d.  XIncrement = 1;
@@ -158,9 +167,7 @@ void vtkAMRDualContourEdgeLocator::Initialize(int xDualCellDim, int yDualCellDim
     if (this->XEdges)
     { // They are all allocated at once, so separate checks are not necessary.
       delete[] this->XEdges;
-      delete[] this->YEdges;
-      delete[] this->ZEdges;
-      delete[] this->Corners;
+      this->XEdges = this->YEdges = this->ZEdges = this->Corners = nullptr;
     }
     if (xDualCellDim > 0 && yDualCellDim > 0 && zDualCellDim > 0)
     {
@@ -171,10 +178,11 @@ void vtkAMRDualContourEdgeLocator::Initialize(int xDualCellDim, int yDualCellDim
       this->YIncrement = this->DualCellDimensions[0] + 1;
       this->ZIncrement = this->YIncrement * (this->DualCellDimensions[1] + 1);
       this->ArrayLength = this->ZIncrement * (this->DualCellDimensions[2] + 1);
-      this->XEdges = new vtkIdType[this->ArrayLength];
-      this->YEdges = new vtkIdType[this->ArrayLength];
-      this->ZEdges = new vtkIdType[this->ArrayLength];
-      this->Corners = new vtkIdType[this->ArrayLength];
+      // A single allocation lets slots index all the arrays.
+      this->XEdges = new vtkIdType[4 * this->ArrayLength];
+      this->YEdges = this->XEdges + this->ArrayLength;
+      this->ZEdges = this->YEdges + this->ArrayLength;
+      this->Corners = this->ZEdges + this->ArrayLength;
     }
     else
     {
@@ -186,10 +194,9 @@ void vtkAMRDualContourEdgeLocator::Initialize(int xDualCellDim, int yDualCellDim
     }
   }
 
-  for (int idx = 0; idx < this->ArrayLength; ++idx)
+  for (int idx = 0; idx < 4 * this->ArrayLength; ++idx)
   {
-    this->XEdges[idx] = this->YEdges[idx] = this->ZEdges[idx] = -1;
-    this->Corners[idx] = -1;
+    this->XEdges[idx] = -1;
   }
 
   int x, y, z;
@@ -608,6 +615,53 @@ void vtkAMRDualContourEdgeLocator::ShareBlockLocatorWithNeighbor(
   }
 }
 
+//============================================================================
+// Surface generated for one block.  Blocks are processed in parallel with a
+// thread local locator, so point ids are local to the piece.  Pieces are
+// stitched into the output in block order, where the block locators merge
+// the points shared with neighbor blocks.
+class vtkAMRDualContourPiece
+{
+public:
+  vtkAMRDualContourPiece()
+    : Locator(nullptr)
+    , Processed(false)
+  {
+  }
+
+  // Description:
+  // Adds a point and stores its id in the locator entry.  The attributes of
+  // the point are interpolated from two input cells, or copied from the first
+  // one when the second offset is -1.
+  void InsertNextPoint(
+    const double pt[3], vtkIdType* ptIdPtr, vtkIdType offset0, vtkIdType offset1, double k)
+  {
+    *ptIdPtr = static_cast<vtkIdType>(this->PointSlots.size());
+    this->Points.insert(this->Points.end(), pt, pt + 3);
+    this->PointSlots.push_back(this->Locator->GetSlot(ptIdPtr));
+    this->AttributeOffsets.push_back(offset0);
+    this->AttributeOffsets.push_back(offset1);
+    this->AttributeWeights.push_back(k);
+  }
+
+  void InsertNextCell(int numPts, const vtkIdType* pointIds)
+  {
+    this->Cells.push_back(numPts);
+    this->Cells.insert(this->Cells.end(), pointIds, pointIds + numPts);
+  }
+
+  // Only set while the block is processed.
+  vtkAMRDualContourEdgeLocator* Locator;
+  bool Processed;
+
+  std::vector<double> Points;
+  std::vector<vtkIdType> PointSlots;
+  std::vector<vtkIdType> AttributeOffsets;
+  std::vector<double> AttributeWeights;
+  // Number of points followed by the point ids of each cell.
+  std::vector<vtkIdType> Cells;
+};
+
 //============================================================================
 //----------------------------------------------------------------------------
 // Description:
@@ -622,6 +676,7 @@ vtkAMRDualContour::vtkAMRDualContour()
   this->EnableCapping = 1;
   this->EnableMultiProcessCommunication = 1;
   this->EnableMergePoints = 1;
+  this->EnableParallelBlocks = 1;
   this->TriangulateCap = 1;
 
   this->Controller = nullptr;
@@ -633,18 +688,11 @@ vtkAMRDualContour::vtkAMRDualContour()
   this->TemperatureArray = nullptr;
   this->BlockIdCellArray = nullptr;
   this->Helper = nullptr;
-
-  this->BlockLocator = nullptr;
 }
 
 //----------------------------------------------------------------------------
 vtkAMRDualContour::~vtkAMRDualContour()
 {
-  if (this->BlockLocator)
-  {
-    delete this->BlockLocator;
-    this->BlockLocator = nullptr;
-  }
   this->SetController(nullptr);
 }
 
@@ -659,6 +707,7 @@ void vtkAMRDualContour::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "EnableMultiProcessCommunication: " << this->EnableMultiProcessCommunication
      << endl;
   os << indent << "EnableMergePoints: " << this->EnableMergePoints << endl;
+  os << indent << "EnableParallelBlocks: " << this->EnableParallelBlocks << endl;
   os << indent << "TriangulateCap: " << this->TriangulateCap << endl;
   os << indent << "SkipGhostCopy: " << this->SkipGhostCopy << endl;
 }
@@ -809,17 +858,46 @@ vtkMultiBlockDataSet* vtkAMRDualContour::DoRequestData(
   // Loop through blocks
   int numLevels = hbdsInput->GetNumberOfLevels();
 
+  // Locators merge points in a block.  They are reused by each thread.
+  vtkSMPThreadLocal<std::shared_ptr<vtkAMRDualContourEdgeLocator> > locators;
+
   // Add each block.
   for (int level = 0; level < numLevels; ++level)
   {
     int numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
+    // The blocks of a level are processed in parallel, then stitched in
+    // order so that points are shared with neighbors as if the blocks were
+    // processed one after the other.
+    std::vector<vtkAMRDualContourPiece> pieces(numBlocks);
+    auto processBlocks = [&](vtkIdType first, vtkIdType last) {
+      auto& locator = locators.Local();
+      if (!locator)
+      {
+        locator = std::make_shared<vtkAMRDualContourEdgeLocator>();
+      }
+      for (vtkIdType blockId = first; blockId < last; ++blockId)
+      {
+        vtkAMRDualGridHelperBlock* block =
+          this->Helper->GetBlock(level, static_cast<int>(blockId));
+        pieces[blockId].Locator = locator.get();
+        this->ProcessBlock(block, arrayNameToProcess, &pieces[blockId]);
+        pieces[blockId].Locator = nullptr;
+      }
+    };
+    if (this->EnableParallelBlocks)
+    {
+      vtkSMPTools::For(0, numBlocks, processBlocks);
+    }
+    else
+    {
+      processBlocks(0, numBlocks);
+    }
     for (int blockId = 0; blockId < numBlocks; ++blockId)
     {
       vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
-      this->ProcessBlock(block, blockId, arrayNameToProcess);
+      this->StitchPiece(block, blockId, &pieces[blockId]);
     }
   }
-
   this->FinalizeCopyAttributes(this->Mesh);
   this->BlockIdCellArray->Delete();
   this->BlockIdCellArray = nullptr;
@@ -885,7 +963,7 @@ void vtkAMRDualContour::ShareBlockLocatorWithNeighbors(vtkAMRDualGridHelperBlock
 
 //----------------------------------------------------------------------------
 void vtkAMRDualContour::ProcessBlock(
-  vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayNameToProcess)
+  vtkAMRDualGridHelperBlock* block, const char* arrayNameToProcess, vtkAMRDualContourPiece* piece)
 {
   vtkImageData* image = block->Image;
   if (image == nullptr)
@@ -914,20 +992,10 @@ void vtkAMRDualContour::ProcessBlock(
 
   // Locator merges points in this block.
   // Input the dimensions of the dual cells with ghosts.
-  if (this->EnableMergePoints)
-  {
-    this->BlockLocator = vtkAMRDualContourGetBlockLocator(block);
-  }
-  else
-  { // Shared locator.
-    if (this->BlockLocator == nullptr)
-    {
-      this->BlockLocator = new vtkAMRDualContourEdgeLocator;
-    }
-    this->BlockLocator->Initialize(
-      extent[1] - extent[0], extent[3] - extent[2], extent[5] - extent[4]);
-    this->BlockLocator->CopyRegionLevelDifferences(block);
-  }
+  // Points are merged with neighbor blocks when the piece is stitched.
+  piece->Locator->Initialize(extent[1] - extent[0], extent[3] - extent[2], extent[5] - extent[4]);
+  piece->Locator->CopyRegionLevelDifferences(block);
+  piece->Processed = true;
   image->GetOrigin(origin);
   spacing = image->GetSpacing();
   // Dual cells are shifted half a pixel.
@@ -1007,7 +1075,7 @@ void vtkAMRDualContour::ProcessBlock(
           cornerOffsets[5] = xOffset + 1 + zInc;
           cornerOffsets[6] = xOffset + 1 + yInc + zInc;
           cornerOffsets[7] = xOffset + yInc + zInc;
-          this->ProcessDualCell(block, blockId, x, y, z, cornerOffsets, volumeFractionArray);
+          this->ProcessDualCell(block, piece, x, y, z, cornerOffsets, volumeFractionArray);
         }
         xOffset += 1; // xInc
       }
@@ -1015,14 +1083,85 @@ void vtkAMRDualContour::ProcessBlock(
     }
     zOffset += zInc;
   }
+}
+
+//----------------------------------------------------------------------------
+// Adds the points and faces of a processed block to the output.  Points
+// already created by neighbor blocks are found in the block locator, and the
+// new ones are recorded in it to be shared with the next neighbors.
+void vtkAMRDualContour::StitchPiece(
+  vtkAMRDualGridHelperBlock* block, int blockId, vtkAMRDualContourPiece* piece)
+{
+  if (!piece->Processed)
+  {
+    return;
+  }
+
+  vtkAMRDualContourEdgeLocator* locator = nullptr;
+  if (this->EnableMergePoints)
+  {
+    locator = vtkAMRDualContourGetBlockLocator(block);
+  }
+
+  vtkIdType numPoints = static_cast<vtkIdType>(piece->PointSlots.size());
+  std::vector<vtkIdType> pointMap(numPoints);
+  for (vtkIdType ptId = 0; ptId < numPoints; ++ptId)
+  {
+    vtkIdType* ptIdPtr = nullptr;
+    if (locator)
+    {
+      ptIdPtr = locator->GetSlotPointer(piece->PointSlots[ptId]);
+      if (*ptIdPtr != -1)
+      { // A neighbor already created this point.
+        pointMap[ptId] = *ptIdPtr;
+        continue;
+      }
+    }
+    vtkIdType outId = this->Points->InsertNextPoint(&piece->Points[3 * ptId]);
+    vtkIdType offset0 = piece->AttributeOffsets[2 * ptId];
+    vtkIdType offset1 = piece->AttributeOffsets[2 * ptId + 1];
+    if (offset1 == -1)
+    {
+      this->CopyAttributes(block->Image, offset0, this->Mesh, outId);
+    }
+    else
+    {
+      this->InterpolateAttributes(
+        block->Image, offset0, offset1, piece->AttributeWeights[ptId], this->Mesh, outId);
+    }
+    if (ptIdPtr)
+    {
+      *ptIdPtr = outId;
+    }
+    pointMap[ptId] = outId;
+  }
+
+  std::vector<vtkIdType>& cells = piece->Cells;
+  vtkIdType cellsSize = static_cast<vtkIdType>(cells.size());
+  for (vtkIdType idx = 0; idx < cellsSize; idx += cells[idx] + 1)
+  {
+    vtkIdType numCellPoints = cells[idx];
+    vtkIdType* pointIds = &cells[idx + 1];
+    for (vtkIdType ii = 0; ii < numCellPoints; ++ii)
+    {
+      pointIds[ii] = pointMap[pointIds[ii]];
+    }
+    // Points merged with neighbors can make a triangle degenerate.
+    if (numCellPoints == 3 &&
+      (pointIds[0] == pointIds[1] || pointIds[0] == pointIds[2] || pointIds[1] == pointIds[2]))
+    {
+      continue;
+    }
+    this->Faces->InsertNextCell(numCellPoints, pointIds);
+    this->BlockIdCellArray->InsertNextValue(blockId);
+  }
 
   if (this->EnableMergePoints)
   {
     // Copy point ids into neighbor locators.
     this->ShareBlockLocatorWithNeighbors(block);
     // We are done.  We no longer need the locator for this block.
-    delete this->BlockLocator;
-    this->BlockLocator = nullptr;
+    delete locator;
     block->UserData = nullptr;
     // Lets use this unused flag (owner of center region/block) to indicate
     // that the block is already processes.
@@ -1091,8 +1230,9 @@ static int vtkAMRDualLegacyIdToBitIdMap[8] = { 0, 1, 3, 2, 4, 5, 7, 6 };
 // Not implemented as optimally as we could.  It can be improved by making
 // a fast path for internal cells (with no degeneracies).
 // Corner offsets are absolute (relative to origin / 0).
-void vtkAMRDualContour::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y,
-  int z, vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray)
+void vtkAMRDualContour::ProcessDualCell(vtkAMRDualGridHelperBlock* block,
+  vtkAMRDualContourPiece* piece, int x, int y, int z, vtkIdType cornerOffsets[8],
+  vtkDataArray* volumeFractionArray)
 {
   // compute the case index
   vtkImageData* image = block->Image;
@@ -1329,7 +1469,7 @@ void vtkAMRDualContour::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int bl
     // Only permanently keep locator for edges shared between two blocks.
     for (int ii = 0; ii < 3; ++ii, ++edge) // insert triangle
     {
-      vtkIdType* ptIdPtr = this->BlockLocator->GetEdgePointer(x, y, z, *edge);
+      vtkIdType* ptIdPtr = piece->Locator->GetEdgePointer(x, y, z, *edge);
 
       if (*ptIdPtr == -1)
       {
@@ -1357,31 +1497,30 @@ void vtkAMRDualContour::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int bl
           cornerPoints[pt1Idx | 1] + k * (cornerPoints[pt2Idx | 1] - cornerPoints[pt1Idx | 1]);
         pt[2] =
           cornerPoints[pt1Idx | 2] + k * (cornerPoints[pt2Idx | 2] - cornerPoints[pt1Idx | 2]);
-        *ptIdPtr = this->Points->InsertNextPoint(pt);
         // Interpolate attributes
         // Find the offsets of the two attributes to interpolate
         vtkIdType offset0 = cornerOffsets[vtkAMRDualIsoEdgeToVTKPointsTable[*edge][0]];
         vtkIdType offset1 = cornerOffsets[vtkAMRDualIsoEdgeToVTKPointsTable[*edge][1]];
-        this->InterpolateAttributes(block->Image, offset0, offset1, k, this->Mesh, *ptIdPtr);
+        piece->InsertNextPoint(pt, ptIdPtr, offset0, offset1, k);
       }
       edgePointIds[*edge] = pointIds[ii] = *ptIdPtr;
     }
     if (pointIds[0] != pointIds[1] && pointIds[0] != pointIds[2] && pointIds[1] != pointIds[2])
     {
-      this->Faces->InsertNextCell(3, pointIds);
-      this->BlockIdCellArray->InsertNextValue(blockId);
+      piece->InsertNextCell(3, pointIds);
     }
   }
 
   if (this->EnableCapping)
   {
-    this->CapCell(x, y, z, cubeBoundaryBits, cubeCase, edgePointIds, cornerPoints, cornerOffsets,
-      blockId, block->Image);
+    this->CapCell(
+      x, y, z, cubeBoundaryBits, cubeCase, edgePointIds, cornerPoints, cornerOffsets, piece);
   }
 }
 
 //----------------------------------------------------------------------------
-void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int blockId)
+void vtkAMRDualContour::AddCapPolygon(
+  int ptCount, vtkIdType* pointIds, vtkAMRDualContourPiece* piece)
 {
   if (this->TriangulateCap)
   {
@@ -1397,8 +1536,7 @@ void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int bloc
         tri[2] = pointIds[low];
         if (tri[0] != tri[1] && tri[0] != tri[2] && tri[1] != tri[2])
         {
-          this->Faces->InsertNextCell(3, tri);
-          this->BlockIdCellArray->InsertNextValue(blockId);
+          piece->InsertNextCell(3, tri);
         }
       }
       else
@@ -1408,16 +1546,14 @@ void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int bloc
         tri[2] = pointIds[low];
         if (tri[0] != tri[1] && tri[0] != tri[2] && tri[1] != tri[2])
         {
-          this->Faces->InsertNextCell(3, tri);
-          this->BlockIdCellArray->InsertNextValue(blockId);
+          piece->InsertNextCell(3, tri);
         }
         tri[0] = pointIds[high];
         tri[1] = pointIds[high + 1];
         tri[2] = pointIds[low];
         if (tri[0] != tri[1] && tri[0] != tri[2] && tri[1] != tri[2])
         {
-          this->Faces->InsertNextCell(3, tri);
-          this->BlockIdCellArray->InsertNextValue(blockId);
+          piece->InsertNextCell(3, tri);
         }
       }
       ++low;
@@ -1427,8 +1563,7 @@ void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int bloc
   else
   {
     // Do not worry about degenerate polygons in this path.
-    this->Faces->InsertNextCell(ptCount, pointIds);
-    this->BlockIdCellArray->InsertNextValue(blockId);
+    piece->InsertNextCell(ptCount, pointIds);
   }
 }
 
@@ -1450,10 +1585,8 @@ void vtkAMRDualContour::CapCell(int cellX, int cellY, int cellZ, // cell index i
   double cornerPoints[32],
   // The id order is VTK from marching cube cases.  Different than axis ordered "cornerPoints".
   vtkIdType cornerOffsets[8],
-  // For block id array (for debugging).  I should just make this an ivar.
-  int blockId,
-  // For passing attributes to output mesh
-  vtkDataSet* inData)
+  // Receives the points and polygons.
+  vtkAMRDualContourPiece* piece)
 {
   int cornerIdx;
   vtkIdType* ptIdPtr;
@@ -1472,12 +1605,11 @@ void vtkAMRDualContour::CapCell(int cellX, int cellY, int cellZ, // cell index i
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoNXCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = piece->Locator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
-            this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+            piece->InsertNextPoint(cornerPoints + (cornerIdx << 2), ptIdPtr,
+              cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], -1, 0.0);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1487,7 +1619,7 @@ void vtkAMRDualContour::CapCell(int cellX, int cellY, int cellZ, // cell index i
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(ptCount, pointIds, piece);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1508,12 +1640,11 @@ void vtkAMRDualContour::CapCell(int cellX, int cellY, int cellZ, // cell index i
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoPXCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = piece->Locator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
-            this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+            piece->InsertNextPoint(cornerPoints + (cornerIdx << 2), ptIdPtr,
+              cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], -1, 0.0);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1523,7 +1654,7 @@ void vtkAMRDualContour::CapCell(int cellX, int cellY, int cellZ, // cell index i
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(ptCount, pointIds, piece);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1545,12 +1676,11 @@ void vtkAMRDualContour::CapCell(int cellX, int cellY, int cellZ, // cell index i
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoNYCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = piece->Locator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
-            this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+            piece->InsertNextPoint(cornerPoints + (cornerIdx << 2), ptIdPtr,
+              cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], -1, 0.0);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1560,7 +1690,7 @@ void vtkAMRDualContour::CapCell(int cellX, int cellY, int cellZ, // cell index i
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(ptCount, pointIds, piece);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1582,12 +1712,11 @@ void vtkAMRDualContour::CapCell(int cellX, int cellY, int cellZ, // cell index i
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoPYCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = piece->Locator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
-            this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+            piece->InsertNextPoint(cornerPoints + (cornerIdx << 2), ptIdPtr,
+              cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], -1, 0.0);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1597,7 +1726,7 @@ void vtkAMRDualContour::CapCell(int cellX, int cellY, int cellZ, // cell index i
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(ptCount, pointIds, piece);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1618,12 +1747,11 @@ void vtkAMRDualContour::CapCell(int cellX, int cellY, int cellZ, // cell index i
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoNZCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = piece->Locator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
-            this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+            piece->InsertNextPoint(cornerPoints + (cornerIdx << 2), ptIdPtr,
+              cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], -1, 0.0);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1633,7 +1761,7 @@ void vtkAMRDualContour::CapCell(int cellX, int cellY, int cellZ, // cell index i
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(ptCount, pointIds, piece);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1655,12 +1783,11 @@ void vtkAMRDualContour::CapCell(int cellX, int cellY, int cellZ, // cell index i
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoPZCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = piece->Locator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
-            this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+            piece->InsertNextPoint(cornerPoints + (cornerIdx << 2), ptIdPtr,
+              cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], -1, 0.0);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1670,7 +1797,7 @@ void vtkAMRDualContour::CapCell(int cellX, int cellY, int cellZ, // cell index i
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(ptCount, pointIds, piece);
       if (*capPtr == -1)
       {
         ++capPtr;
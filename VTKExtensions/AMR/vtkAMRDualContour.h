@@ -52,6 +52,7 @@ class vtkAMRDualGridHelper;
 class vtkAMRDualGridHelperBlock;
 class vtkAMRDualGridHelperFace;
 class vtkAMRDualContourEdgeLocator;
+class vtkAMRDualContourPiece;
 
 class VTKPVVTKEXTENSIONSAMR_EXPORT vtkAMRDualContour : public vtkMultiBlockDataSetAlgorithm
 {
@@ -91,6 +92,17 @@ public:
   vtkBooleanMacro(EnableMergePoints, int);
   //@}
 
+  //@{
+  /**
+   * This flag causes the blocks of each level to be processed in parallel
+   * using vtkSMPTools. When off, they are processed one after the other,
+   * e.g. to compare the output or the performance of both. On by default.
+   */
+  vtkSetMacro(EnableParallelBlocks, int);
+  vtkGetMacro(EnableParallelBlocks, int);
+  vtkBooleanMacro(EnableParallelBlocks, int);
+  //@}
+
   //@{
   /**
    * A flag that causes the polygons on the capping surfaces to be triagulated.
@@ -126,6 +138,7 @@ protected:
   int EnableCapping;
   int EnableMultiProcessCommunication;
   int EnableMergePoints;
+  int EnableParallelBlocks;
   int TriangulateCap;
   int SkipGhostCopy;
 
@@ -152,12 +165,24 @@ protected:
 
   void ShareBlockLocatorWithNeighbors(vtkAMRDualGridHelperBlock* block);
 
-  void ProcessBlock(vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayName);
+  /**
+   * Generates the surface of a block with point ids local to the piece.
+   * Blocks are processed in parallel, this must not modify shared state.
+   */
+  void ProcessBlock(
+    vtkAMRDualGridHelperBlock* block, const char* arrayName, vtkAMRDualContourPiece* piece);
 
-  void ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y, int z,
-    vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray);
+  /**
+   * Adds a piece to the output mesh, merging the points shared with the
+   * neighbor blocks. Pieces must be stitched in the order blocks are listed
+   * by the helper, from low level to high.
+   */
+  void StitchPiece(vtkAMRDualGridHelperBlock* block, int blockId, vtkAMRDualContourPiece* piece);
 
-  void AddCapPolygon(int ptCount, vtkIdType* pointIds, int blockId);
+  void ProcessDualCell(vtkAMRDualGridHelperBlock* block, vtkAMRDualContourPiece* piece, int x,
+    int y, int z, vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray);
+
+  void AddCapPolygon(int ptCount, vtkIdType* pointIds, vtkAMRDualContourPiece* piece);
 
   // This method is getting too many arguments!
   // Capping was an after thought...
@@ -172,10 +197,8 @@ protected:
     double cornerPoints[32],
     // The id order is VTK from marching cube cases.  Different than axis ordered "cornerPoints".
     vtkIdType cornerOffsets[8],
-    // For block id array (for debugging).  I should just make this an ivar.
-    int blockId,
-    // For passing attributes to output mesh
-    vtkDataSet* inData);
+    // Receives the points and polygons.
+    vtkAMRDualContourPiece* piece);
 
   // Stuff exclusively for debugging.
   vtkIntArray* BlockIdCellArray;
@@ -194,8 +217,6 @@ protected:
   int* MessageBuffer;
   int* MessageBufferLength;
 
-  vtkAMRDualContourEdgeLocator* BlockLocator;
-
   // Stuff for passing cell attributes to point attributes.
   void InitializeCopyAttributes(vtkNonOverlappingAMR* hbdsInput, vtkDataSet* mesh);
   void InterpolateAttributes(vtkDataSet* uGrid, vtkIdType offset0, vtkIdType offset1, double k,
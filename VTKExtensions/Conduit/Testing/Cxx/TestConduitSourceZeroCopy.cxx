@@ -0,0 +1,170 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestConduitSourceZeroCopy.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks that unstructured connectivity given as O2M relations ("polygonal"
+// and "mixed" shapes) is shared with the Conduit node rather than copied, and
+// reports the conversion time and memory used by the converted mesh compared
+// to the memory of the Conduit arrays.
+
+#include "vtkCellArray.h"
+#include "vtkConduitSource.h"
+#include "vtkDataArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPartitionedDataSet.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <catalyst_conduit_blueprint.hpp>
+
+#include <chrono>
+#include <vector>
+
+#define VERIFY(x, ...)                                                                             \
+  if ((x) == false)                                                                                \
+  {                                                                                                \
+    vtkLogF(ERROR, __VA_ARGS__);                                                                   \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+// A (dim x dim) grid of quads. When `mixed` is true, every other quad is
+// split into two triangles and the topology uses the "mixed" shape.
+struct Mesh
+{
+  std::vector<double> X, Y, Z;
+  std::vector<conduit_int64> Connectivity, Sizes, Offsets, Shapes;
+  conduit_cpp::Node Node;
+
+  Mesh(int dim, bool mixed)
+  {
+    for (int j = 0; j <= dim; ++j)
+    {
+      for (int i = 0; i <= dim; ++i)
+      {
+        this->X.push_back(i);
+        this->Y.push_back(j);
+        this->Z.push_back(0);
+      }
+    }
+    auto addCell = [this](std::initializer_list<conduit_int64> ids, conduit_int64 shape) {
+      this->Offsets.push_back(static_cast<conduit_int64>(this->Connectivity.size()));
+      this->Sizes.push_back(static_cast<conduit_int64>(ids.size()));
+      this->Shapes.push_back(shape);
+      this->Connectivity.insert(this->Connectivity.end(), ids);
+    };
+    for (int j = 0; j < dim; ++j)
+    {
+      for (int i = 0; i < dim; ++i)
+      {
+        const conduit_int64 p0 = j * (dim + 1) + i;
+        const conduit_int64 p1 = p0 + 1;
+        const conduit_int64 p2 = p1 + dim + 1;
+        const conduit_int64 p3 = p0 + dim + 1;
+        if (mixed && (i + j) % 2 == 1)
+        {
+          addCell({ p0, p1, p2 }, 0);
+          addCell({ p0, p2, p3 }, 0);
+        }
+        else
+        {
+          addCell({ p0, p1, p2, p3 }, 1);
+        }
+      }
+    }
+
+    auto& node = this->Node;
+    node["coordsets/coords/type"].set("explicit");
+    node["coordsets/coords/values/x"].set_external(this->X.data(), this->X.size());
+    node["coordsets/coords/values/y"].set_external(this->Y.data(), this->Y.size());
+    node["coordsets/coords/values/z"].set_external(this->Z.data(), this->Z.size());
+    node["topologies/mesh/type"].set("unstructured");
+    node["topologies/mesh/coordset"].set("coords");
+    if (mixed)
+    {
+      node["topologies/mesh/elements/shape"].set("mixed");
+      node["topologies/mesh/elements/shape_map/tri"].set(static_cast<conduit_int64>(0));
+      node["topologies/mesh/elements/shape_map/quad"].set(static_cast<conduit_int64>(1));
+      node["topologies/mesh/elements/shapes"].set_external(
+        this->Shapes.data(), this->Shapes.size());
+    }
+    else
+    {
+      node["topologies/mesh/elements/shape"].set("polygonal");
+    }
+    node["topologies/mesh/elements/connectivity"].set_external(
+      this->Connectivity.data(), this->Connectivity.size());
+    node["topologies/mesh/elements/sizes"].set_external(this->Sizes.data(), this->Sizes.size());
+    node["topologies/mesh/elements/offsets"].set_external(
+      this->Offsets.data(), this->Offsets.size());
+  }
+
+  // Memory of the Conduit arrays describing the cells, in KBs.
+  double GetCellsMemorySize() const
+  {
+    return (this->Connectivity.size() + this->Sizes.size() + this->Offsets.size()) *
+      sizeof(conduit_int64) / 1024.0;
+  }
+};
+
+bool ValidateZeroCopy(bool mixed)
+{
+  Mesh mesh(mixed ? 256 : 512, mixed);
+  conduit_cpp::Node info;
+  VERIFY(conduit_cpp::BlueprintMesh::verify(mesh.Node, info),
+    "Conduit Blueprint does not accept the %s mesh", mixed ? "mixed" : "polygonal");
+
+  vtkNew<vtkConduitSource> source;
+  source->SetNode(conduit_cpp::c_node(&mesh.Node));
+  auto start = std::chrono::steady_clock::now();
+  source->Update();
+  const double seconds =
+    std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  auto pds = vtkPartitionedDataSet::SafeDownCast(source->GetOutputDataObject(0));
+  VERIFY(pds != nullptr && pds->GetNumberOfPartitions() == 1, "incorrect output");
+  auto ug = vtkUnstructuredGrid::SafeDownCast(pds->GetPartition(0));
+  VERIFY(ug != nullptr, "missing partition 0");
+  VERIFY(ug->GetNumberOfCells() == static_cast<vtkIdType>(mesh.Sizes.size()),
+    "incorrect number of cells, expected %d, got %lld", static_cast<int>(mesh.Sizes.size()),
+    ug->GetNumberOfCells());
+
+  vtkCellArray* cells = ug->GetCells();
+  VERIFY(cells->GetConnectivityArray()->GetVoidPointer(0) == mesh.Connectivity.data(),
+    "connectivity was copied instead of shared with the Conduit node");
+
+  for (vtkIdType cc = 0; cc < ug->GetNumberOfCells(); ++cc)
+  {
+    const int expected = mesh.Sizes[cc] == 3 ? VTK_TRIANGLE : mixed ? VTK_QUAD : VTK_POLYGON;
+    VERIFY(ug->GetCellType(cc) == expected, "incorrect type for cell %lld", cc);
+  }
+
+  // Only the cell offsets (and, for mixed shapes, the types) are allocated by
+  // the conversion; the connectivity is shared.
+  const double allocated = (cells->GetOffsetsArray()->GetActualMemorySize() +
+    (mixed ? ug->GetCellTypesArray()->GetActualMemorySize() : 0));
+  vtkLogF(INFO, "%s: %lld cells converted in %g s, %g KB allocated for %g KB of Conduit cells",
+    mixed ? "mixed" : "polygonal", ug->GetNumberOfCells(), seconds, allocated,
+    mesh.GetCellsMemorySize());
+  VERIFY(allocated < mesh.GetCellsMemorySize(), "conversion allocated more than expected");
+  return true;
+}
+}
+
+int TestConduitSourceZeroCopy(int, char* [])
+{
+  return ValidateZeroCopy(false) && ValidateZeroCopy(true) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
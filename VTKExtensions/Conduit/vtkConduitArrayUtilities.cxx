@@ -17,6 +17,7 @@
 #include "vtkArrayDispatch.h"
 #include "vtkCellArray.h"
 #include "vtkLogger.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkSOADataArrayTemplate.h"
 #include "vtkTypeFloat32Array.h"
@@ -495,6 +496,79 @@ struct O2MRelationToVTKCellArrayWorker
     }
   }
 };
+
+// Fills vtkCellArray offsets from O2M sizes and offsets. Fails if elements are
+// not stored back to back in the connectivity array.
+template <typename OutOffsetsArray>
+struct O2MRelationOffsetsWorker
+{
+  OutOffsetsArray* Result;
+  vtkIdType ConnectivitySize;
+  bool Compact;
+
+  O2MRelationOffsetsWorker(OutOffsetsArray* result, vtkIdType connectivitySize)
+    : Result(result)
+    , ConnectivitySize(connectivitySize)
+    , Compact(false)
+  {
+  }
+
+  template <typename SizesArray, typename OffsetsArray>
+  void operator()(SizesArray* sizes, OffsetsArray* offsets)
+  {
+    using ValueType = typename OutOffsetsArray::ValueType;
+    vtkDataArrayAccessor<SizesArray> s(sizes);
+    vtkDataArrayAccessor<OffsetsArray> o(offsets);
+
+    const auto numElements = sizes->GetNumberOfTuples();
+    this->Result->SetNumberOfTuples(numElements + 1);
+    ValueType* result = this->Result->GetPointer(0);
+    vtkIdType next = 0;
+    for (vtkIdType id = 0; id < numElements; ++id)
+    {
+      if (static_cast<vtkIdType>(o.Get(id, 0)) != next)
+      {
+        return;
+      }
+      result[id] = static_cast<ValueType>(next);
+      next += static_cast<vtkIdType>(s.Get(id, 0));
+    }
+    result[numElements] = static_cast<ValueType>(next);
+    this->Compact = (next == this->ConnectivitySize);
+  }
+};
+
+template <typename TypeList, typename ConnectivityArray>
+vtkSmartPointer<vtkCellArray> ShareO2MConnectivity(
+  ConnectivityArray* connectivity, vtkDataArray* sizes, vtkDataArray* offsets)
+{
+  if (!sizes || !offsets || connectivity->GetNumberOfComponents() != 1 ||
+    sizes->GetNumberOfComponents() != 1 || offsets->GetNumberOfComponents() != 1 ||
+    sizes->GetNumberOfTuples() != offsets->GetNumberOfTuples())
+  {
+    return nullptr;
+  }
+
+  vtkNew<ConnectivityArray> cellOffsets;
+  O2MRelationOffsetsWorker<ConnectivityArray> worker(
+    cellOffsets.GetPointer(), connectivity->GetNumberOfTuples());
+  using Dispatcher = vtkArrayDispatch::Dispatch2ByValueType<TypeList, TypeList>;
+  if (!Dispatcher::Execute(sizes, offsets, worker))
+  {
+    worker(sizes, offsets);
+  }
+  if (!worker.Compact)
+  {
+    return nullptr;
+  }
+
+  vtkNew<vtkCellArray> cellArray;
+  if (!cellArray->SetData(cellOffsets, connectivity))
+  {
+    return nullptr;
+  }
+  return cellArray;
+}
 }
 //----------------------------------------------------------------------------
 vtkSmartPointer<vtkCellArray> vtkConduitArrayUtilities::O2MRelationToVTKCellArray(
@@ -522,12 +596,29 @@ vtkSmartPointer<vtkCellArray> vtkConduitArrayUtilities::O2MRelationToVTKCellArra
   auto offsets = vtkConduitArrayUtilities::MCArrayToVTKArrayImpl(
     conduit_cpp::c_node(&node_offsets), /*force_signed*/ true);
 
-  O2MRelationToVTKCellArrayWorker worker;
-
   // Using a reduced type list for typical id types.
   using TypeList =
     vtkTypeList::Unique<vtkTypeList::Create<vtkTypeInt32, vtkTypeInt64, vtkIdType> >::Result;
 
+  // When elements are stored back to back, share the connectivity array. Only
+  // the offsets, which need an extra trailing entry in vtkCellArray, are copied.
+  if (auto connectivity32 = vtkTypeInt32Array::FastDownCast(elements))
+  {
+    if (auto cells = ShareO2MConnectivity<TypeList>(connectivity32, sizes, offsets))
+    {
+      return cells;
+    }
+  }
+  else if (auto connectivity64 = vtkTypeInt64Array::FastDownCast(elements))
+  {
+    if (auto cells = ShareO2MConnectivity<TypeList>(connectivity64, sizes, offsets))
+    {
+      return cells;
+    }
+  }
+
+  O2MRelationToVTKCellArrayWorker worker;
+
   using Dispatcher = vtkArrayDispatch::Dispatch3ByValueType<TypeList, TypeList, TypeList>;
   if (!Dispatcher::Execute(elements.GetPointer(), sizes.GetPointer(), offsets.GetPointer(), worker))
   {
@@ -73,7 +73,11 @@ public:
     vtkDataArray* array, int num_components);
 
   /**
-   * Read a O2MRelation element
+   * Read a O2MRelation element.
+   *
+   * When the elements are stored back to back in the leaf array, the
+   * connectivity is shared with the Conduit node and only the offsets are
+   * copied. Otherwise, the cells are deep-copied.
    */
   static vtkSmartPointer<vtkCellArray> O2MRelationToVTKCellArray(
     const conduit_node* o2mrelation, const std::string& leafname);
@@ -20,6 +20,7 @@
 #include "vtkDataArray.h"
 #include "vtkDataSetAttributes.h"
 #include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -35,6 +36,7 @@
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 #include "vtkStructuredGrid.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
 #include <catalyst_conduit.hpp>
@@ -156,30 +158,58 @@ vtkSmartPointer<vtkPoints> CreatePoints(const conduit_cpp::Node& coords)
 void SetPolyhedralCells(
   vtkUnstructuredGrid* grid, vtkCellArray* elements, vtkCellArray* subelements)
 {
-  vtkNew<vtkCellArray> connectivity;
-  vtkNew<vtkIdTypeArray> faces;
-  vtkNew<vtkIdTypeArray> faceLocations;
-
-  connectivity->AllocateEstimate(elements->GetNumberOfCells(), 10);
-  faces->Allocate(subelements->GetConnectivityArray()->GetNumberOfTuples());
-  faceLocations->Allocate(elements->GetNumberOfCells());
-
+  const vtkIdType numCells = elements->GetNumberOfCells();
   auto eIter = vtk::TakeSmartPointer(elements->NewIterator());
   auto seIter = vtk::TakeSmartPointer(subelements->NewIterator());
 
-  std::vector<vtkIdType> cellPoints;
+  // first pass: compute the exact sizes of the face stream and the cell
+  // connectivity so that they are allocated once, without growing or
+  // squeezing the arrays afterwards.
+  vtkIdType facesSize = 0;
+  vtkIdType connectivitySize = 0;
   for (eIter->GoToFirstCell(); !eIter->IsDoneWithTraversal(); eIter->GoToNextCell())
   {
-    // init;
-    cellPoints.clear();
+    vtkIdType size;
+    vtkIdType const* seIds;
+    eIter->GetCurrentCell(size, seIds);
+    facesSize += 1 + size;
+    for (vtkIdType fIdx = 0; fIdx < size; ++fIdx)
+    {
+      const vtkIdType ptSize = subelements->GetCellSize(seIds[fIdx]);
+      facesSize += ptSize;
+      connectivitySize += ptSize;
+    }
+  }
 
+  vtkNew<vtkIdTypeArray> offsets;
+  vtkNew<vtkIdTypeArray> cellPoints;
+  vtkNew<vtkIdTypeArray> faces;
+  vtkNew<vtkIdTypeArray> faceLocations;
+  offsets->SetNumberOfTuples(numCells + 1);
+  cellPoints->SetNumberOfTuples(connectivitySize);
+  faces->SetNumberOfTuples(facesSize);
+  faceLocations->SetNumberOfTuples(numCells);
+
+  vtkIdType* offsetsPtr = offsets->GetPointer(0);
+  vtkIdType* cellPointsPtr = cellPoints->GetPointer(0);
+  vtkIdType* facesPtr = faces->GetPointer(0);
+  vtkIdType* faceLocationsPtr = faceLocations->GetPointer(0);
+
+  // second pass: fill the face stream and accumulate points from all faces of
+  // each cell to build the 'connectivity' array.
+  vtkIdType cellId = 0;
+  vtkIdType facesPos = 0;
+  vtkIdType cellPointsPos = 0;
+  for (eIter->GoToFirstCell(); !eIter->IsDoneWithTraversal(); eIter->GoToNextCell(), ++cellId)
+  {
     // get cell from 'elements'.
     vtkIdType size;
     vtkIdType const* seIds;
     eIter->GetCurrentCell(size, seIds);
 
-    faceLocations->InsertNextValue(faces->GetNumberOfTuples());
-    faces->InsertNextValue(size); // number-of-cell-faces.
+    offsetsPtr[cellId] = cellPointsPos;
+    faceLocationsPtr[cellId] = facesPos;
+    facesPtr[facesPos++] = size; // number-of-cell-faces.
     for (vtkIdType fIdx = 0; fIdx < size; ++fIdx)
     {
       seIter->GoToCell(seIds[fIdx]);
@@ -187,23 +217,17 @@ void SetPolyhedralCells(
       vtkIdType ptSize;
       vtkIdType const* ptIds;
       seIter->GetCurrentCell(ptSize, ptIds);
-      faces->InsertNextValue(ptSize); // number-of-face-points.
-      for (vtkIdType ptIdx = 0; ptIdx < ptSize; ++ptIdx)
-      {
-        faces->InsertNextValue(ptIds[ptIdx]);
-      }
-
-      // accumulate pts from all faces in this cell to build the 'connectivity' array.
-      std::copy(ptIds, ptIds + ptSize, std::back_inserter(cellPoints));
+      facesPtr[facesPos++] = ptSize; // number-of-face-points.
+      std::copy(ptIds, ptIds + ptSize, facesPtr + facesPos);
+      std::copy(ptIds, ptIds + ptSize, cellPointsPtr + cellPointsPos);
+      facesPos += ptSize;
+      cellPointsPos += ptSize;
     }
-
-    connectivity->InsertNextCell(
-      static_cast<vtkIdType>(cellPoints.size()), cellPoints.empty() ? nullptr : &cellPoints[0]);
   }
+  offsetsPtr[numCells] = cellPointsPos;
 
-  connectivity->Squeeze();
-  faces->Squeeze();
-  faceLocations->Squeeze();
+  vtkNew<vtkCellArray> connectivity;
+  connectivity->SetData(offsets, cellPoints);
 
   vtkNew<vtkUnsignedCharArray> cellTypes;
   cellTypes->SetNumberOfTuples(connectivity->GetNumberOfCells());
@@ -211,6 +235,46 @@ void SetPolyhedralCells(
   grid->SetCells(cellTypes, connectivity, faceLocations, faces);
 }
 
+//----------------------------------------------------------------------------
+// Builds the cell types for a "mixed" shape topology. The connectivity is
+// processed as any other O2MRelation; this is the only per-cell array that
+// needs to be created.
+vtkSmartPointer<vtkUnsignedCharArray> CreateMixedCellTypes(const conduit_cpp::Node& elements)
+{
+  std::map<vtkIdType, unsigned char> shapeMap;
+  const auto shape_map = elements["shape_map"];
+  for (conduit_index_t cc = 0, max = shape_map.number_of_children(); cc < max; ++cc)
+  {
+    const auto child = shape_map.child(cc);
+    const auto vtk_cell_type = GetCellType(child.name());
+    if (vtk_cell_type == VTK_POLYHEDRON)
+    {
+      throw std::runtime_error("polyhedral elements in mixed topologies are not supported");
+    }
+    shapeMap[static_cast<vtkIdType>(child.to_int64())] = static_cast<unsigned char>(vtk_cell_type);
+  }
+
+  conduit_cpp::Node shapes = elements["shapes"];
+  auto shapesArray = vtkConduitArrayUtilities::MCArrayToVTKArray(conduit_cpp::c_node(&shapes));
+  if (shapesArray == nullptr)
+  {
+    throw std::runtime_error("failed to convert 'shapes' to VTK array!");
+  }
+
+  vtkNew<vtkUnsignedCharArray> cellTypes;
+  cellTypes->SetNumberOfTuples(shapesArray->GetNumberOfTuples());
+  for (vtkIdType cc = 0, max = shapesArray->GetNumberOfTuples(); cc < max; ++cc)
+  {
+    auto iter = shapeMap.find(static_cast<vtkIdType>(shapesArray->GetComponent(cc, 0)));
+    if (iter == shapeMap.end())
+    {
+      throw std::runtime_error("shape missing in 'shape_map'");
+    }
+    cellTypes->SetTypedComponent(cc, 0, iter->second);
+  }
+  return cellTypes;
+}
+
 //----------------------------------------------------------------------------
 vtkSmartPointer<vtkDataSet> GetMesh(
   const conduit_cpp::Node& topologyNode, const conduit_cpp::Node& coordsets)
@@ -288,6 +352,21 @@ vtkSmartPointer<vtkDataSet> GetMesh(
     if (nb_cells > 0)
     {
       ug->SetPoints(CreatePoints(coords));
+      if (topologyNode["elements/shape"].as_string() == "mixed")
+      {
+        // mixed shapes use O2M arrays, along with a per-cell shape.
+        conduit_cpp::Node t_elements = topologyNode["elements"];
+        auto cellArray = vtkConduitArrayUtilities::O2MRelationToVTKCellArray(
+          conduit_cpp::c_node(&t_elements), "connectivity");
+        auto cellTypes = CreateMixedCellTypes(t_elements);
+        if (cellArray == nullptr || cellTypes->GetNumberOfTuples() != cellArray->GetNumberOfCells())
+        {
+          throw std::runtime_error("mismatched 'shapes' and 'sizes' for mixed topology!");
+        }
+        ug->SetCells(cellTypes, cellArray);
+        return ug;
+      }
+
       const auto vtk_cell_type = GetCellType(topologyNode["elements/shape"].as_string());
       if (vtk_cell_type == VTK_POLYHEDRON)
       {
@@ -300,8 +379,9 @@ vtkSmartPointer<vtkDataSet> GetMesh(
         auto subelements = vtkConduitArrayUtilities::O2MRelationToVTKCellArray(
           conduit_cpp::c_node(&t_subelements), "connectivity");
 
-        // currently, this is an ugly deep-copy. Once vtkUnstructuredGrid is modified
-        // as proposed here (vtk/vtk#18190), this will get simpler.
+        // currently, this is a deep-copy into the legacy face stream. Once
+        // vtkUnstructuredGrid is modified as proposed here (vtk/vtk#18190), this
+        // will get simpler.
         SetPolyhedralCells(ug, elements, subelements);
       }
       else if (vtk_cell_type == VTK_POLYGON)
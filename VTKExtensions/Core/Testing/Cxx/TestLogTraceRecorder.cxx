@@ -0,0 +1,91 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestLogTraceRecorder.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Records nested log scopes from two threads and checks the generated Chrome
+// trace.
+
+#include "vtkLogTraceRecorder.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+
+#include <string>
+#include <thread>
+
+#define VERIFY(x, y)                                                                               \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    vtkLogF(ERROR, y);                                                                             \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+void Work(const char* name)
+{
+  vtkLogScopeF(TRACE, "%s", name);
+  for (int cc = 0; cc < 3; ++cc)
+  {
+    vtkLogScopeF(TRACE, "%s step \"%d\"", name, cc);
+    vtkLogF(TRACE, "message");
+  }
+}
+
+size_t Count(const std::string& text, const std::string& pattern)
+{
+  size_t count = 0;
+  for (size_t pos = text.find(pattern); pos != std::string::npos;
+       pos = text.find(pattern, pos + 1))
+  {
+    ++count;
+  }
+  return count;
+}
+}
+
+int TestLogTraceRecorder(int, char*[])
+{
+  vtkNew<vtkLogTraceRecorder> recorder;
+  recorder->SetController(nullptr);
+  recorder->StartRecording();
+  VERIFY(recorder->GetRecording(), "recording expected.");
+  Work("main");
+  std::thread thread(Work, "worker");
+  thread.join();
+  recorder->StopRecording();
+  Work("not recorded");
+
+  // 2 threads x (1 + 3) scopes x 2 events + 2 threads x 3 messages.
+  VERIFY(recorder->GetNumberOfEvents() == 22, "unexpected number of events.");
+
+  const std::string trace = recorder->GetChromeTrace();
+  VERIFY(trace.find("\"traceEvents\"") != std::string::npos, "missing trace events.");
+  VERIFY(Count(trace, "\"ph\":\"B\"") == 8, "unexpected number of begin events.");
+  VERIFY(Count(trace, "\"ph\":\"E\"") == 8, "unexpected number of end events.");
+  VERIFY(Count(trace, "\"ph\":\"i\"") == 6, "unexpected number of instant events.");
+  VERIFY(Count(trace, "\"thread_name\"") == 2, "unexpected number of threads.");
+  VERIFY(trace.find("worker step \\\"2\\\"") != std::string::npos, "invalid escaping.");
+  VERIFY(trace.find("not recorded") == std::string::npos, "events recorded after stop.");
+
+  // Older events are dropped when the buffer is full, without leaving
+  // unmatched end events.
+  recorder->SetBufferSize(5);
+  recorder->StartRecording();
+  Work("main");
+  recorder->StopRecording();
+  VERIFY(recorder->GetNumberOfEvents() == 5, "unexpected number of events.");
+  const std::string partialTrace = recorder->GetChromeTrace();
+  VERIFY(Count(partialTrace, "\"ph\":\"E\"") <= Count(partialTrace, "\"ph\":\"B\""),
+    "unmatched end events.");
+  return EXIT_SUCCESS;
+}
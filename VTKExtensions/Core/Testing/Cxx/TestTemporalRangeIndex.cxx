@@ -0,0 +1,117 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestTemporalRangeIndex.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Records the ranges of a multiblock dataset at a few time steps, checks the
+// ranges over time and their round trip through the text format.
+
+#include "vtkDoubleArray.h"
+#include "vtkLogger.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPVTemporalRangeIndex.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+
+#include <sstream>
+#include <vector>
+
+#define VERIFY(x, y)                                                                               \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    vtkLogF(ERROR, y);                                                                             \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+void AddBlock(vtkMultiBlockDataSet* mb, unsigned int index, double scale)
+{
+  vtkNew<vtkDoubleArray> array;
+  array->SetName("velocity with spaces");
+  array->SetNumberOfComponents(2);
+  array->InsertNextTuple2(3 * scale, 4 * scale);
+  array->InsertNextTuple2(-1 * scale, 0);
+
+  vtkNew<vtkPolyData> pd;
+  pd->GetPointData()->AddArray(array);
+  mb->SetBlock(index, pd);
+}
+}
+
+int TestTemporalRangeIndex(int, char*[])
+{
+  vtkNew<vtkPVTemporalRangeIndex> index;
+  for (int step = 0; step < 3; ++step)
+  {
+    vtkNew<vtkMultiBlockDataSet> mb;
+    AddBlock(mb, 0, step + 1);
+    AddBlock(mb, 1, 1);
+    index->AddDataObject(0.5 * step, mb);
+  }
+  VERIFY(index->GetNumberOfTimeSteps() == 3, "unexpected number of time steps.");
+
+  const std::vector<double> timesteps = { 0, 0.5, 1 };
+  double range[2];
+  VERIFY(index->GetRange(vtkDataObject::FIELD_ASSOCIATION_POINTS, "velocity with spaces", 0,
+           timesteps, range) &&
+      range[0] == -3 && range[1] == 9,
+    "unexpected component range.");
+  VERIFY(index->GetRange(vtkDataObject::FIELD_ASSOCIATION_POINTS, "velocity with spaces", -1,
+           timesteps, range) &&
+      range[0] == 1 && range[1] == 15,
+    "unexpected magnitude range.");
+  VERIFY(!index->GetRange(vtkDataObject::FIELD_ASSOCIATION_CELLS, "velocity with spaces", 0,
+           timesteps, range),
+    "unexpected range for a missing array.");
+  VERIFY(!index->HasTimeSteps({ 0, 1.5 }) &&
+      !index->GetRange(
+        vtkDataObject::FIELD_ASSOCIATION_POINTS, "velocity with spaces", 0, { 0, 1.5 }, range),
+    "unexpected range for a missing time step.");
+
+  std::stringstream stream;
+  VERIFY(index->Save(stream), "failed to save.");
+  vtkNew<vtkPVTemporalRangeIndex> loaded;
+  VERIFY(loaded->Load(stream), "failed to load.");
+  VERIFY(loaded->HasTimeSteps(timesteps), "time steps lost in round trip.");
+  VERIFY(loaded->GetRange(vtkDataObject::FIELD_ASSOCIATION_POINTS, "velocity with spaces", 1,
+           { 0.5 }, range) &&
+      range[0] == 0 && range[1] == 8,
+    "ranges lost in round trip.");
+
+  // Empty and malformed lines are skipped.
+  std::stringstream damaged;
+  damaged << "# vtkPVTemporalRangeIndex 1\n"
+          << "\n"
+          << "t 2\n"
+          << "r 0 0 1 2 pressure\n"
+          << "r garbage\n"
+          << "t\n"
+          << "r 0 0 5 6 ignored\n"
+          << "x\n";
+  vtkNew<vtkPVTemporalRangeIndex> recovered;
+  VERIFY(recovered->Load(damaged), "failed to load an index with malformed lines.");
+  VERIFY(recovered->GetNumberOfTimeSteps() == 1 &&
+      recovered->GetRange(vtkDataObject::FIELD_ASSOCIATION_POINTS, "pressure", 0, { 2 }, range) &&
+      range[0] == 1 && range[1] == 2 &&
+      !recovered->GetRange(vtkDataObject::FIELD_ASSOCIATION_POINTS, "ignored", 0, { 2 }, range),
+    "unexpected ranges after skipping malformed lines.");
+
+  // Modifying the pipeline drops the recorded time steps.
+  loaded->CheckPipelineMTime(10);
+  loaded->CheckPipelineMTime(10);
+  VERIFY(loaded->GetNumberOfTimeSteps() == 3, "time steps dropped without modification.");
+  loaded->CheckPipelineMTime(11);
+  VERIFY(loaded->GetNumberOfTimeSteps() == 0, "time steps kept after modification.");
+  return EXIT_SUCCESS;
+}
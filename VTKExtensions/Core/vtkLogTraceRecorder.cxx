@@ -0,0 +1,348 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkLogTraceRecorder.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkLogTraceRecorder.h"
+
+#include "vtkLogger.h"
+#include "vtkMultiProcessController.h"
+#include "vtkMultiProcessStream.h"
+#include "vtkObjectFactory.h"
+
+#include <vtksys/FStream.hxx>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+// Names longer than this are truncated, so that recording an event never
+// allocates memory.
+constexpr size_t MaximumNameLength = 95;
+
+struct TraceEvent
+{
+  double Time; // in microseconds since the start of the recording
+  char Phase;  // 'B'egin, 'E'nd or 'i'nstant, as in the Chrome trace format
+  char Name[MaximumNameLength + 1];
+};
+
+// Ring buffer with a single writer, the thread it belongs to.
+struct ThreadBuffer
+{
+  std::vector<TraceEvent> Events;
+  std::atomic<vtkTypeUInt64> Count{ 0 };
+  int ThreadIndex = 0;
+  std::string ThreadName;
+};
+
+// Identifies recordings, so that the buffer cached by a thread is never used
+// for another recording, even by another recorder allocated at the same
+// address.
+std::atomic<vtkTypeUInt64> NextRecordingId{ 1 };
+
+struct ThreadBufferCache
+{
+  vtkTypeUInt64 RecordingId = 0;
+  ThreadBuffer* Buffer = nullptr;
+};
+thread_local ThreadBufferCache CurrentThreadBuffer;
+
+void AppendEscaped(std::ostringstream& stream, const char* text)
+{
+  for (const char* c = text; *c; ++c)
+  {
+    switch (*c)
+    {
+      case '"':
+        stream << "\\\"";
+        break;
+      case '\\':
+        stream << "\\\\";
+        break;
+      default:
+        if (static_cast<unsigned char>(*c) < 0x20)
+        {
+          char code[7];
+          snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned char>(*c));
+          stream << code;
+        }
+        else
+        {
+          stream << *c;
+        }
+    }
+  }
+}
+}
+
+class vtkLogTraceRecorder::vtkInternals
+{
+public:
+  std::string CallbackName;
+  vtkTypeUInt64 RecordingId = 0;
+  size_t BufferSize = 0;
+  std::chrono::steady_clock::time_point Origin;
+
+  std::mutex BuffersMutex;
+  std::vector<std::unique_ptr<ThreadBuffer> > Buffers;
+
+  ThreadBuffer* GetThreadBuffer()
+  {
+    auto& cache = CurrentThreadBuffer;
+    if (cache.RecordingId != this->RecordingId)
+    {
+      // First event of this thread for this recording.
+      std::unique_ptr<ThreadBuffer> buffer(new ThreadBuffer());
+      buffer->Events.resize(this->BufferSize);
+      buffer->ThreadName = vtkLogger::GetThreadName();
+      std::lock_guard<std::mutex> lock(this->BuffersMutex);
+      buffer->ThreadIndex = static_cast<int>(this->Buffers.size());
+      cache.Buffer = buffer.get();
+      cache.RecordingId = this->RecordingId;
+      this->Buffers.push_back(std::move(buffer));
+    }
+    return cache.Buffer;
+  }
+
+  static void Record(void* userData, const vtkLogger::Message& message)
+  {
+    auto self = reinterpret_cast<vtkInternals*>(userData);
+    const auto now = std::chrono::steady_clock::now();
+    ThreadBuffer* buffer = self->GetThreadBuffer();
+
+    // Scopes are logged as messages prefixed with "{ " when they start and
+    // "} " when they end.
+    char phase = 'i';
+    if (message.prefix && message.prefix[0] == '{')
+    {
+      phase = 'B';
+    }
+    else if (message.prefix && message.prefix[0] == '}')
+    {
+      phase = 'E';
+    }
+
+    const vtkTypeUInt64 count = buffer->Count.load(std::memory_order_relaxed);
+    TraceEvent& event = buffer->Events[count % buffer->Events.size()];
+    event.Time = std::chrono::duration<double, std::micro>(now - self->Origin).count();
+    event.Phase = phase;
+    if (phase == 'E')
+    {
+      // Chrome matches end events with the last begin event of the thread.
+      event.Name[0] = '\0';
+    }
+    else
+    {
+      strncpy(event.Name, message.message ? message.message : "", MaximumNameLength);
+      event.Name[MaximumNameLength] = '\0';
+    }
+    buffer->Count.store(count + 1, std::memory_order_release);
+  }
+
+  // Returns the events of this rank, as comma separated JSON objects.
+  std::string GetEvents(int rank)
+  {
+    std::ostringstream stream;
+    stream.precision(3);
+    stream << std::fixed;
+    stream << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << rank
+           << ",\"args\":{\"name\":\"rank " << rank << "\"}}";
+    const char* separator = ",\n";
+
+    std::lock_guard<std::mutex> lock(this->BuffersMutex);
+    for (const auto& buffer : this->Buffers)
+    {
+      stream << separator << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << rank
+             << ",\"tid\":" << buffer->ThreadIndex << ",\"args\":{\"name\":\"";
+      AppendEscaped(stream, buffer->ThreadName.c_str());
+      stream << "\"}}";
+
+      const vtkTypeUInt64 count = buffer->Count.load(std::memory_order_acquire);
+      const vtkTypeUInt64 size = buffer->Events.size();
+      const vtkTypeUInt64 first = count > size ? count - size : 0;
+      int depth = 0;
+      for (vtkTypeUInt64 cc = first; cc < count; ++cc)
+      {
+        const TraceEvent& event = buffer->Events[cc % size];
+        if (event.Phase == 'E')
+        {
+          if (depth == 0)
+          {
+            // its begin event was overwritten.
+            continue;
+          }
+          --depth;
+        }
+        else if (event.Phase == 'B')
+        {
+          ++depth;
+        }
+
+        stream << separator << "{\"name\":\"";
+        AppendEscaped(stream, event.Name);
+        stream << "\",\"ph\":\"" << event.Phase << "\",\"ts\":" << event.Time
+               << ",\"pid\":" << rank << ",\"tid\":" << buffer->ThreadIndex;
+        if (event.Phase == 'i')
+        {
+          stream << ",\"s\":\"t\"";
+        }
+        stream << "}";
+      }
+    }
+    return stream.str();
+  }
+};
+
+vtkStandardNewMacro(vtkLogTraceRecorder);
+vtkCxxSetObjectMacro(vtkLogTraceRecorder, Controller, vtkMultiProcessController);
+//----------------------------------------------------------------------------
+vtkLogTraceRecorder::vtkLogTraceRecorder()
+  : Verbosity(vtkLogger::VERBOSITY_TRACE)
+  , BufferSize(65536)
+  , Controller(nullptr)
+  , Internals(new vtkLogTraceRecorder::vtkInternals())
+{
+  this->SetController(vtkMultiProcessController::GetGlobalController());
+}
+
+//----------------------------------------------------------------------------
+vtkLogTraceRecorder::~vtkLogTraceRecorder()
+{
+  this->StopRecording();
+  this->SetController(nullptr);
+}
+
+//----------------------------------------------------------------------------
+void vtkLogTraceRecorder::StartRecording()
+{
+  this->StopRecording();
+
+  auto& internals = *this->Internals;
+  internals.Buffers.clear();
+  internals.BufferSize = static_cast<size_t>(this->BufferSize);
+  internals.RecordingId = NextRecordingId++;
+  if (this->Controller)
+  {
+    this->Controller->Barrier();
+  }
+  internals.Origin = std::chrono::steady_clock::now();
+  internals.CallbackName = "trace-recorder_" + std::to_string(internals.RecordingId);
+  vtkLogger::AddCallback(internals.CallbackName.c_str(), &vtkInternals::Record, &internals,
+    static_cast<vtkLogger::Verbosity>(this->Verbosity));
+}
+
+//----------------------------------------------------------------------------
+void vtkLogTraceRecorder::StopRecording()
+{
+  auto& internals = *this->Internals;
+  if (!internals.CallbackName.empty())
+  {
+    vtkLogger::RemoveCallback(internals.CallbackName.c_str());
+    internals.CallbackName.clear();
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkLogTraceRecorder::GetRecording() const
+{
+  return !this->Internals->CallbackName.empty();
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkLogTraceRecorder::GetNumberOfEvents() const
+{
+  auto& internals = *this->Internals;
+  std::lock_guard<std::mutex> lock(internals.BuffersMutex);
+  vtkIdType count = 0;
+  for (const auto& buffer : internals.Buffers)
+  {
+    count += static_cast<vtkIdType>(
+      std::min<vtkTypeUInt64>(buffer->Count.load(), buffer->Events.size()));
+  }
+  return count;
+}
+
+//----------------------------------------------------------------------------
+std::string vtkLogTraceRecorder::GetChromeTrace()
+{
+  const int rank = this->Controller ? this->Controller->GetLocalProcessId() : 0;
+  const int numRanks = this->Controller ? this->Controller->GetNumberOfProcesses() : 1;
+  std::string events = this->Internals->GetEvents(rank);
+
+  std::vector<std::string> allEvents;
+  if (numRanks > 1)
+  {
+    vtkMultiProcessStream stream;
+    stream << events;
+    std::vector<vtkMultiProcessStream> streams;
+    this->Controller->Gather(stream, streams, 0);
+    if (rank != 0)
+    {
+      return std::string();
+    }
+    for (auto& rankStream : streams)
+    {
+      std::string rankEvents;
+      rankStream >> rankEvents;
+      allEvents.push_back(std::move(rankEvents));
+    }
+  }
+  else
+  {
+    allEvents.push_back(std::move(events));
+  }
+
+  std::string trace = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+  for (size_t cc = 0; cc < allEvents.size(); ++cc)
+  {
+    trace += (cc > 0 ? ",\n" : "") + allEvents[cc];
+  }
+  trace += "\n]}\n";
+  return trace;
+}
+
+//----------------------------------------------------------------------------
+bool vtkLogTraceRecorder::WriteChromeTrace(const char* filename)
+{
+  const std::string trace = this->GetChromeTrace();
+  if (this->Controller && this->Controller->GetLocalProcessId() != 0)
+  {
+    return true;
+  }
+
+  vtksys::ofstream file(filename, std::ios::out | std::ios::binary);
+  if (!file)
+  {
+    vtkErrorMacro("Failed to open `" << (filename ? filename : "(null)") << "` for writing.");
+    return false;
+  }
+  file << trace;
+  return static_cast<bool>(file);
+}
+
+//----------------------------------------------------------------------------
+void vtkLogTraceRecorder::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Verbosity: " << this->Verbosity << endl;
+  os << indent << "BufferSize: " << this->BufferSize << endl;
+  os << indent << "Controller: " << this->Controller << endl;
+  os << indent << "Recording: " << this->GetRecording() << endl;
+}
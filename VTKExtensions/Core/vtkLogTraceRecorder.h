@@ -0,0 +1,143 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkLogTraceRecorder.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class vtkLogTraceRecorder
+ * @brief records log scopes as timed events, across all ranks
+ *
+ * vtkLogTraceRecorder records the log scopes, e.g. those started with
+ * `vtkVLogScopeF` using one of the `PARAVIEW_LOG_*_VERBOSITY()` categories, as
+ * begin and end events timestamped with the rank and the thread that
+ * generated them. Other log messages are recorded as instant events.
+ *
+ * Events are recorded in a fixed size ring buffer per thread, hence only the
+ * most recent `BufferSize` events of each thread are kept. A lock is only
+ * taken on the first event of each thread, to register its buffer, but note
+ * that vtkLogger serializes the calls to its callbacks. `GetChromeTrace` and
+ * `WriteChromeTrace` gather the events from all ranks to the root rank and
+ * convert them to the Chrome trace event format, that can be loaded in
+ * `chrome://tracing` or Perfetto (https://ui.perfetto.dev) to inspect a
+ * distributed operation on a single timeline.
+ *
+ * `StartRecording`, `GetChromeTrace` and `WriteChromeTrace` are collective
+ * operations over the processes of the controller. Timestamps are relative to
+ * a barrier in `StartRecording`. Events should only be gathered once
+ * recording is stopped, or while no other thread is logging, since the ring
+ * buffers are not locked.
+ *
+ * ParaView executables start a recording when the `--log-trace` command line
+ * option is specified and write it out on exit.
+ */
+
+#ifndef vtkLogTraceRecorder_h
+#define vtkLogTraceRecorder_h
+
+#include "vtkObject.h"
+#include "vtkPVVTKExtensionsCoreModule.h" // needed for export macro
+
+#include <memory> // for std::unique_ptr
+#include <string> // for std::string
+
+class vtkMultiProcessController;
+
+class VTKPVVTKEXTENSIONSCORE_EXPORT vtkLogTraceRecorder : public vtkObject
+{
+public:
+  static vtkLogTraceRecorder* New();
+  vtkTypeMacro(vtkLogTraceRecorder, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Set/Get the verbosity of the log scopes and messages recorded. Any scope
+   * or message with a verbosity less than or equal to this verbosity is
+   * recorded. Default is `vtkLogger::VERBOSITY_TRACE`, which records all
+   * ParaView categories unless their verbosity was elevated. Changes only
+   * affect the next recording.
+   */
+  vtkSetMacro(Verbosity, int);
+  vtkGetMacro(Verbosity, int);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the number of events kept for each thread. Default is 65536.
+   * Changes only affect the next recording.
+   */
+  vtkSetClampMacro(BufferSize, int, 1, VTK_INT_MAX);
+  vtkGetMacro(BufferSize, int);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the controller used to synchronize and gather the events of all
+   * ranks. Defaults to the global controller. When none, only the events of
+   * the current process are recorded.
+   */
+  void SetController(vtkMultiProcessController*);
+  vtkGetObjectMacro(Controller, vtkMultiProcessController);
+  //@}
+
+  /**
+   * Start recording, discarding any previously recorded event.
+   * This is a collective operation.
+   */
+  void StartRecording();
+
+  /**
+   * Stop recording. Recorded events are kept.
+   */
+  void StopRecording();
+
+  /**
+   * Returns true between StartRecording and StopRecording.
+   */
+  bool GetRecording() const;
+
+  /**
+   * Returns the number of events recorded on this rank, by all threads.
+   */
+  vtkIdType GetNumberOfEvents() const;
+
+  /**
+   * Returns the events of all ranks in the Chrome trace event JSON format on
+   * the root rank, and an empty string on the others.
+   * This is a collective operation.
+   */
+  std::string GetChromeTrace();
+
+  /**
+   * Writes the events of all ranks in the Chrome trace event JSON format
+   * to `filename` on the root rank. Returns false if the file could not be
+   * written. This is a collective operation.
+   */
+  bool WriteChromeTrace(const char* filename);
+
+protected:
+  vtkLogTraceRecorder();
+  ~vtkLogTraceRecorder() override;
+
+  int Verbosity;
+  int BufferSize;
+  vtkMultiProcessController* Controller;
+
+private:
+  vtkLogTraceRecorder(const vtkLogTraceRecorder&) = delete;
+  void operator=(const vtkLogTraceRecorder&) = delete;
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+};
+
+#endif
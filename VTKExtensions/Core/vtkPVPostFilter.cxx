@@ -24,12 +24,15 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkDataObjectTypes.h"
 #include "vtkDataSet.h"
 #include "vtkDoubleArray.h"
+#include "vtkExecutive.h"
 #include "vtkInformation.h"
 #include "vtkInformationStringVectorKey.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVPostFilterExecutive.h"
+#include "vtkPVTemporalRangeIndex.h"
 #include "vtkPointData.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
 
 #if VTK_MODULE_ENABLE_VTK_FiltersCore
 #include "vtkCellDataToPointData.h"
@@ -246,10 +249,45 @@ int vtkPVPostFilter::RequestData(
     {
       this->DoAnyNeededConversions(output);
     }
+    this->RecordRanges(inInfo, input);
   }
   return 1;
 }
 
+//----------------------------------------------------------------------------
+void vtkPVPostFilter::RecordRanges(vtkInformation* inInfo, vtkDataObject* input)
+{
+  // Record the ranges of the input arrays for the time step it was produced
+  // at, so that ranges over time are known once each time step was shown.
+  if (!inInfo->Has(vtkStreamingDemandDrivenPipeline::TIME_STEPS()))
+  {
+    return;
+  }
+  vtkInformation* dataInfo = input->GetInformation();
+  double time;
+  if (dataInfo->Has(vtkDataObject::DATA_TIME_STEP()))
+  {
+    time = dataInfo->Get(vtkDataObject::DATA_TIME_STEP());
+  }
+  else if (inInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP()))
+  {
+    time = inInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+  }
+  else
+  {
+    return;
+  }
+
+  auto index = vtkPVTemporalRangeIndex::GetIndex(inInfo);
+  auto producer =
+    vtkDemandDrivenPipeline::SafeDownCast(vtkExecutive::PRODUCER()->GetExecutive(inInfo));
+  if (producer)
+  {
+    index->CheckPipelineMTime(producer->GetPipelineMTime());
+  }
+  index->AddDataObject(time, input);
+}
+
 //----------------------------------------------------------------------------
 int vtkPVPostFilter::DoAnyNeededConversions(vtkDataObject* output)
 {
@@ -66,6 +66,12 @@ protected:
   int ExtractComponent(vtkDataSetAttributes* dsa, const char* requested_name,
     const char* demangled_name, const char* demagled_component_name);
 
+  /**
+   * Records the ranges of the input arrays in the vtkPVTemporalRangeIndex of
+   * the input, for time dependent inputs.
+   */
+  void RecordRanges(vtkInformation* inInfo, vtkDataObject* input);
+
 private:
   vtkPVPostFilter(const vtkPVPostFilter&) = delete;
   void operator=(const vtkPVPostFilter&) = delete;
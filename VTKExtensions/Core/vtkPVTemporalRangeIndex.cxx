@@ -0,0 +1,392 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVTemporalRangeIndex.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVTemporalRangeIndex.h"
+
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataArray.h"
+#include "vtkDataObject.h"
+#include "vtkFieldData.h"
+#include "vtkInformation.h"
+#include "vtkInformationObjectBaseKey.h"
+#include "vtkMultiProcessController.h"
+#include "vtkMultiProcessControllerHelper.h"
+#include "vtkMultiProcessStream.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+
+#include <vtksys/FStream.hxx>
+#include <vtksys/SystemTools.hxx>
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <sstream>
+#include <string>
+#include <tuple>
+
+namespace
+{
+const char* const HEADER = "# vtkPVTemporalRangeIndex 1";
+
+// Merges the indices serialized in A and B, the result is stored in B.
+void MergeSerializedIndices(vtkMultiProcessStream& A, vtkMultiProcessStream& B)
+{
+  std::string a, b;
+  A >> a;
+  B >> b;
+  vtkNew<vtkPVTemporalRangeIndex> index;
+  std::istringstream streamA(a), streamB(b);
+  index->Load(streamA);
+  index->Load(streamB);
+
+  std::ostringstream result;
+  index->Save(result);
+  B.Reset();
+  B << result.str();
+}
+}
+
+class vtkPVTemporalRangeIndex::vtkInternals
+{
+public:
+  // (field association, array name, component)
+  typedef std::tuple<int, std::string, int> ArrayComponentType;
+  typedef std::map<ArrayComponentType, std::array<double, 2> > RangesType;
+  std::map<double, RangesType> TimeSteps;
+  vtkMTimeType PipelineMTime = 0;
+
+  static void MergeRange(std::array<double, 2>& range, const double other[2])
+  {
+    range[0] = std::min(range[0], other[0]);
+    range[1] = std::max(range[1], other[1]);
+  }
+};
+
+vtkStandardNewMacro(vtkPVTemporalRangeIndex);
+vtkInformationKeyMacro(vtkPVTemporalRangeIndex, TEMPORAL_RANGE_INDEX, ObjectBase);
+//----------------------------------------------------------------------------
+vtkPVTemporalRangeIndex::vtkPVTemporalRangeIndex()
+  : Internals(new vtkPVTemporalRangeIndex::vtkInternals())
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPVTemporalRangeIndex::~vtkPVTemporalRangeIndex() = default;
+
+//----------------------------------------------------------------------------
+vtkPVTemporalRangeIndex* vtkPVTemporalRangeIndex::GetIndex(vtkInformation* outInfo)
+{
+  auto index = vtkPVTemporalRangeIndex::SafeDownCast(
+    outInfo->Get(vtkPVTemporalRangeIndex::TEMPORAL_RANGE_INDEX()));
+  if (!index)
+  {
+    index = vtkPVTemporalRangeIndex::New();
+    outInfo->Set(vtkPVTemporalRangeIndex::TEMPORAL_RANGE_INDEX(), index);
+    index->FastDelete();
+  }
+  return index;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTemporalRangeIndex::Initialize()
+{
+  this->Internals->TimeSteps.clear();
+  this->Internals->PipelineMTime = 0;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTemporalRangeIndex::AddRange(
+  double time, int fieldAssociation, const char* name, int component, const double range[2])
+{
+  if (!name)
+  {
+    return;
+  }
+  auto& ranges = this->Internals->TimeSteps[time];
+  auto iter = ranges.insert(std::make_pair(
+    vtkInternals::ArrayComponentType(fieldAssociation, name, component),
+    std::array<double, 2>{ { range[0], range[1] } }));
+  if (!iter.second)
+  {
+    vtkInternals::MergeRange(iter.first->second, range);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTemporalRangeIndex::AddFieldData(double time, int fieldAssociation, vtkFieldData* fd)
+{
+  if (!fd)
+  {
+    return;
+  }
+  for (int cc = 0; cc < fd->GetNumberOfArrays(); ++cc)
+  {
+    // same ranges as vtkPVArrayInformation.
+    vtkDataArray* array = fd->GetArray(cc);
+    if (array && array->GetName() && array->IsNumeric())
+    {
+      for (int comp = -1; comp < array->GetNumberOfComponents(); ++comp)
+      {
+        double range[2];
+        array->GetFiniteRange(range, comp);
+        this->AddRange(time, fieldAssociation, array->GetName(), comp, range);
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTemporalRangeIndex::AddDataObject(double time, vtkDataObject* dobj)
+{
+  this->Internals->TimeSteps[time];
+  if (!dobj)
+  {
+    return;
+  }
+
+  this->AddFieldData(time, vtkDataObject::FIELD_ASSOCIATION_NONE, dobj->GetFieldData());
+  if (auto cd = vtkCompositeDataSet::SafeDownCast(dobj))
+  {
+    vtkSmartPointer<vtkCompositeDataIterator> iter;
+    iter.TakeReference(cd->NewIterator());
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      this->AddDataObject(time, iter->GetCurrentDataObject());
+    }
+    return;
+  }
+
+  for (int association : { vtkDataObject::FIELD_ASSOCIATION_POINTS,
+         vtkDataObject::FIELD_ASSOCIATION_CELLS, vtkDataObject::FIELD_ASSOCIATION_VERTICES,
+         vtkDataObject::FIELD_ASSOCIATION_EDGES, vtkDataObject::FIELD_ASSOCIATION_ROWS })
+  {
+    this->AddFieldData(time, association, dobj->GetAttributesAsFieldData(association));
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTemporalRangeIndex::Merge(vtkPVTemporalRangeIndex* other)
+{
+  if (!other || other == this)
+  {
+    return;
+  }
+  for (const auto& step : other->Internals->TimeSteps)
+  {
+    auto& ranges = this->Internals->TimeSteps[step.first];
+    for (const auto& item : step.second)
+    {
+      auto iter = ranges.insert(item);
+      if (!iter.second)
+      {
+        vtkInternals::MergeRange(iter.first->second, item.second.data());
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTemporalRangeIndex::AllReduce(vtkMultiProcessController* controller)
+{
+  if (!controller || controller->GetNumberOfProcesses() <= 1)
+  {
+    return;
+  }
+
+  std::ostringstream local;
+  this->Save(local);
+  vtkMultiProcessStream stream;
+  stream << local.str();
+  vtkMultiProcessControllerHelper::ReduceToAll(controller, stream, ::MergeSerializedIndices, 0);
+
+  std::string result;
+  stream >> result;
+  std::istringstream global(result);
+  this->Load(global);
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVTemporalRangeIndex::HasTimeStep(double time) const
+{
+  return this->Internals->TimeSteps.find(time) != this->Internals->TimeSteps.end();
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVTemporalRangeIndex::HasTimeSteps(const std::vector<double>& timesteps) const
+{
+  return std::all_of(
+    timesteps.begin(), timesteps.end(), [this](double time) { return this->HasTimeStep(time); });
+}
+
+//----------------------------------------------------------------------------
+int vtkPVTemporalRangeIndex::GetNumberOfTimeSteps() const
+{
+  return static_cast<int>(this->Internals->TimeSteps.size());
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVTemporalRangeIndex::GetRange(int fieldAssociation, const char* name, int component,
+  const std::vector<double>& timesteps, double range[2]) const
+{
+  std::array<double, 2> result{ { VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX } };
+  bool found = false;
+  const vtkInternals::ArrayComponentType key(fieldAssociation, name ? name : "", component);
+  for (double time : timesteps)
+  {
+    auto step = this->Internals->TimeSteps.find(time);
+    if (step == this->Internals->TimeSteps.end())
+    {
+      return false;
+    }
+    auto iter = step->second.find(key);
+    if (iter != step->second.end())
+    {
+      vtkInternals::MergeRange(result, iter->second.data());
+      found = true;
+    }
+  }
+  range[0] = result[0];
+  range[1] = result[1];
+  return found;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTemporalRangeIndex::CheckPipelineMTime(vtkMTimeType mtime)
+{
+  auto& internals = *this->Internals;
+  if (internals.PipelineMTime != 0 && internals.PipelineMTime != mtime)
+  {
+    internals.TimeSteps.clear();
+    this->Modified();
+  }
+  internals.PipelineMTime = mtime;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVTemporalRangeIndex::Save(ostream& os) const
+{
+  os << HEADER << "\n";
+  os.precision(17);
+  for (const auto& step : this->Internals->TimeSteps)
+  {
+    os << "t " << step.first << "\n";
+    for (const auto& item : step.second)
+    {
+      const std::string& name = std::get<1>(item.first);
+      if (!name.empty() && name.find('\n') == std::string::npos)
+      {
+        os << "r " << std::get<0>(item.first) << " " << std::get<2>(item.first) << " "
+           << item.second[0] << " " << item.second[1] << " " << name << "\n";
+      }
+    }
+  }
+  return !os.fail();
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVTemporalRangeIndex::Save(const char* filename) const
+{
+  if (!filename)
+  {
+    return false;
+  }
+
+  const std::string tmpname = std::string(filename) + ".tmp";
+  {
+    vtksys::ofstream ofs(tmpname.c_str());
+    if (!ofs || !this->Save(ofs))
+    {
+      vtkErrorMacro("Failed to write '" << tmpname.c_str() << "'.");
+      return false;
+    }
+  }
+  if (!vtksys::SystemTools::RenameFile(tmpname, filename))
+  {
+    vtkErrorMacro("Failed to rename '" << tmpname.c_str() << "' to '" << filename << "'.");
+    vtksys::SystemTools::RemoveFile(tmpname);
+    return false;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVTemporalRangeIndex::Load(istream& is)
+{
+  std::string line;
+  if (!std::getline(is, line) || line != HEADER)
+  {
+    return false;
+  }
+
+  // Empty lines and lines that fail to parse are skipped, so are the ranges
+  // following a time step that failed to parse.
+  vtkInternals::RangesType* ranges = nullptr;
+  while (std::getline(is, line))
+  {
+    std::istringstream str(line);
+    char type = '\0';
+    if (!(str >> type))
+    {
+      continue;
+    }
+    if (type == 't')
+    {
+      double time;
+      ranges = (str >> time) ? &this->Internals->TimeSteps[time] : nullptr;
+    }
+    else if (type == 'r' && ranges)
+    {
+      int association, component;
+      double range[2];
+      std::string name;
+      if (!(str >> association >> component >> range[0] >> range[1]) || str.get() != ' ' ||
+        !std::getline(str, name))
+      {
+        continue;
+      }
+      auto iter = ranges->insert(
+        std::make_pair(vtkInternals::ArrayComponentType(association, name, component),
+          std::array<double, 2>{ { range[0], range[1] } }));
+      if (!iter.second)
+      {
+        vtkInternals::MergeRange(iter.first->second, range);
+      }
+    }
+  }
+  this->Modified();
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVTemporalRangeIndex::Load(const char* filename)
+{
+  if (!filename || !vtksys::SystemTools::FileExists(filename, /*isFile=*/true))
+  {
+    return false;
+  }
+  vtksys::ifstream ifs(filename);
+  return ifs && this->Load(ifs);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVTemporalRangeIndex::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfTimeSteps: " << this->GetNumberOfTimeSteps() << endl;
+  os << indent << "PipelineMTime: " << this->Internals->PipelineMTime << endl;
+}
@@ -0,0 +1,173 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVTemporalRangeIndex.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class vtkPVTemporalRangeIndex
+ * @brief ranges of the arrays of an algorithm output at each time step
+ *
+ * vtkPVTemporalRangeIndex records, for each time step of an algorithm output,
+ * the finite range of each component and of the magnitude of its arrays. It
+ * lets vtkPVTemporalDataInformation determine the ranges of arrays over all
+ * time steps without executing the pipeline for each of them once all time
+ * steps are recorded.
+ *
+ * The index is stored in the output information of the algorithm using the
+ * TEMPORAL_RANGE_INDEX() key. vtkPVPostFilter records the ranges of its input
+ * for each time step it executes at, e.g. during animation playback. Readers
+ * and sources that know the ranges of their arrays from metadata can fill it
+ * in `RequestInformation`:
+ *
+ * @code{.cpp}
+ * auto index = vtkPVTemporalRangeIndex::GetIndex(outInfo);
+ * index->Initialize();
+ * for (...)
+ * {
+ *   index->AddRange(time, vtkDataObject::FIELD_ASSOCIATION_POINTS, name, component, range);
+ * }
+ * @endcode
+ *
+ * Ranges recorded on each rank are local to that rank, `AllReduce` merges the
+ * indices of all ranks. The index can be saved to and loaded from a text file,
+ * which ParaView uses as a sidecar file next to the datasets read when the
+ * `UseTemporalRangeIndexFiles` general setting is enabled.
+ */
+
+#ifndef vtkPVTemporalRangeIndex_h
+#define vtkPVTemporalRangeIndex_h
+
+#include "vtkObject.h"
+#include "vtkPVVTKExtensionsCoreModule.h" // needed for export macro
+
+#include <memory> // for std::unique_ptr
+#include <vector> // for std::vector
+
+class vtkDataObject;
+class vtkFieldData;
+class vtkInformation;
+class vtkInformationObjectBaseKey;
+class vtkMultiProcessController;
+
+class VTKPVVTKEXTENSIONSCORE_EXPORT vtkPVTemporalRangeIndex : public vtkObject
+{
+public:
+  static vtkPVTemporalRangeIndex* New();
+  vtkTypeMacro(vtkPVTemporalRangeIndex, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Key used to store the index in the output information of an algorithm.
+   */
+  static vtkInformationObjectBaseKey* TEMPORAL_RANGE_INDEX();
+
+  /**
+   * Returns the index stored in the output information `outInfo`, creating it
+   * if needed.
+   */
+  static vtkPVTemporalRangeIndex* GetIndex(vtkInformation* outInfo);
+
+  /**
+   * Remove all recorded time steps.
+   */
+  void Initialize();
+
+  /**
+   * Record the range of a component of an array at a time step, -1 standing
+   * for the magnitude. Ranges recorded for the same time step and array are
+   * merged.
+   */
+  void AddRange(
+    double time, int fieldAssociation, const char* name, int component, const double range[2]);
+
+  /**
+   * Record the ranges of all the numeric arrays of a data object, or of the
+   * leaves of a composite dataset, at a time step. The time step is recorded
+   * even if the data object has no arrays.
+   */
+  void AddDataObject(double time, vtkDataObject* dobj);
+
+  /**
+   * Merge the time steps and ranges recorded in another index.
+   */
+  void Merge(vtkPVTemporalRangeIndex* other);
+
+  /**
+   * Merge the indices of all the processes of `controller`, so that all of
+   * them end up with the same index. This is a collective operation.
+   */
+  void AllReduce(vtkMultiProcessController* controller);
+
+  //@{
+  /**
+   * Returns whether a time step, or all the given ones, are recorded.
+   */
+  bool HasTimeStep(double time) const;
+  bool HasTimeSteps(const std::vector<double>& timesteps) const;
+  //@}
+
+  /**
+   * Returns the number of time steps recorded.
+   */
+  int GetNumberOfTimeSteps() const;
+
+  /**
+   * Get the range of a component of an array, -1 standing for the magnitude,
+   * over the given time steps. Returns false if one of the time steps is not
+   * recorded or if the array is recorded at none of them.
+   */
+  bool GetRange(int fieldAssociation, const char* name, int component,
+    const std::vector<double>& timesteps, double range[2]) const;
+
+  /**
+   * Drop the recorded time steps if the pipeline the index is filled from was
+   * modified since they were recorded, as reported by
+   * vtkDemandDrivenPipeline::GetPipelineMTime(). Initialize() resets the
+   * pipeline modification time, so that the next one checked is adopted.
+   */
+  void CheckPipelineMTime(vtkMTimeType mtime);
+
+  //@{
+  /**
+   * Save the index as text, to a stream or a file. The file is first written
+   * next to the destination then renamed, so that readers never see a
+   * partially written file. Returns false on failure.
+   */
+  bool Save(ostream& os) const;
+  bool Save(const char* filename) const;
+  //@}
+
+  //@{
+  /**
+   * Load, and merge, an index saved as text. Lines that cannot be parsed are
+   * skipped. Returns false on failure, e.g. if the file does not exist or
+   * does not start with the expected header.
+   */
+  bool Load(istream& is);
+  bool Load(const char* filename);
+  //@}
+
+protected:
+  vtkPVTemporalRangeIndex();
+  ~vtkPVTemporalRangeIndex() override;
+
+private:
+  vtkPVTemporalRangeIndex(const vtkPVTemporalRangeIndex&) = delete;
+  void operator=(const vtkPVTemporalRangeIndex&) = delete;
+
+  void AddFieldData(double time, int fieldAssociation, vtkFieldData* fd);
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+};
+
+#endif
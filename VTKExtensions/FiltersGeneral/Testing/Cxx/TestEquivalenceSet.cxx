@@ -0,0 +1,84 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestEquivalenceSet.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkEquivalenceSet.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+
+#define VERIFY(x, y)                                                                               \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    vtkLogF(ERROR, y);                                                                             \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+int TestEquivalenceSet(int, char*[])
+{
+  vtkNew<vtkEquivalenceSet> set;
+
+  // Adding an equivalence extends the members to include both ids.
+  set->AddEquivalence(2, 3);
+  VERIFY(set->GetNumberOfMembers() == 4, "members not extended.");
+  VERIFY(set->GetReference(3) == 2, "larger root not linked to the smaller one.");
+  VERIFY(set->GetReference(0) == 0 && set->GetReference(1) == 1, "new members not alone.");
+
+  // Builds the chain 3 -> 2 -> 1 -> 0, each merge linking the root of the
+  // larger set.
+  set->AddEquivalence(1, 2);
+  set->AddEquivalence(0, 1);
+  VERIFY(set->GetReference(3) == 2 && set->GetReference(2) == 1 && set->GetReference(1) == 0,
+    "unexpected chain.");
+
+  // A lookup compresses the path to the root.
+  VERIFY(set->GetEquivalentSetId(3) == 0, "invalid root.");
+  VERIFY(set->GetReference(3) == 0 && set->GetReference(2) == 0, "path not compressed.");
+
+  // Merging through members that are not roots.
+  set->AddEquivalence(9, 7);
+  set->AddEquivalence(8, 9);
+  set->AddEquivalence(5, 5);
+  VERIFY(set->GetNumberOfMembers() == 10, "members not extended.");
+  VERIFY(set->GetEquivalentSetId(8) == 7 && set->GetEquivalentSetId(9) == 7, "invalid root.");
+  VERIFY(set->GetEquivalentSetId(5) == 5, "lone member not its own root.");
+
+  // Equivalences between two existing sets, in both orders.
+  set->AddEquivalence(6, 9);
+  set->AddEquivalence(4, 3);
+  VERIFY(set->GetEquivalentSetId(7) == 6 && set->GetEquivalentSetId(4) == 0, "sets not merged.");
+
+  // Sets are {0, 1, 2, 3, 4}, {5}, {6, 7, 8, 9}, numbered in order of their
+  // smallest member.
+  VERIFY(set->ResolveEquivalences() == 3, "unexpected number of sets.");
+  VERIFY(set->GetNumberOfResolvedSets() == 3, "unexpected number of resolved sets.");
+  const int expected[10] = { 0, 0, 0, 0, 0, 1, 2, 2, 2, 2 };
+  for (int ii = 0; ii < 10; ++ii)
+  {
+    VERIFY(set->GetEquivalentSetId(ii) == expected[ii], "unexpected resolved set id.");
+  }
+
+  // A copy shares the resolution.
+  vtkNew<vtkEquivalenceSet> copy;
+  copy->DeepCopy(set);
+  for (int ii = 0; ii < 10; ++ii)
+  {
+    VERIFY(copy->GetEquivalentSetId(ii) == expected[ii], "unexpected copied set id.");
+  }
+
+  // Initialize starts over.
+  set->Initialize();
+  VERIFY(set->GetNumberOfMembers() == 0, "set not initialized.");
+  set->AddEquivalence(1, 0);
+  VERIFY(set->ResolveEquivalences() == 1, "unexpected number of sets after initialize.");
+  return EXIT_SUCCESS;
+}
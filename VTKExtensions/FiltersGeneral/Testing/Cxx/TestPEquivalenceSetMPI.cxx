@@ -0,0 +1,125 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPEquivalenceSetMPI.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Each rank adds part of the equivalences of a global set, including ones
+// that chain the members of other ranks, and checks that the distributed
+// resolution matches the resolution of all equivalences on a single set.
+
+#include "vtkEquivalenceSet.h"
+#include "vtkLogger.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkPEquivalenceSet.h"
+
+#include <utility>
+#include <vector>
+
+namespace
+{
+// Equivalences added by a rank. Members 0 and 1 are always alone, other
+// members are chained across ranks, and the last rank has extra members
+// that only it knows of.
+std::vector<std::pair<int, int> > GetEquivalences(int rank, int numRanks)
+{
+  const int membersPerRank = 10;
+  std::vector<std::pair<int, int> > equivalences;
+  const int first = 2 + rank * membersPerRank;
+  for (int ii = first; ii + 2 < first + membersPerRank; ii += 3)
+  {
+    equivalences.emplace_back(ii + 2, ii);
+  }
+  if (rank + 1 < numRanks)
+  {
+    // link the last member of this rank to the first member of the next one.
+    equivalences.emplace_back(first + membersPerRank - 1, first + membersPerRank);
+  }
+  else
+  {
+    equivalences.emplace_back(first + membersPerRank + 5, first + membersPerRank + 3);
+  }
+  if (rank % 2 == 1)
+  {
+    // merges sets that are only known to other ranks.
+    equivalences.emplace_back(first - membersPerRank + 3, first - membersPerRank + 1);
+  }
+  return equivalences;
+}
+
+bool ResolveEquivalences(vtkMultiProcessController* contr)
+{
+  const int myRank = contr->GetLocalProcessId();
+  const int numRanks = contr->GetNumberOfProcesses();
+
+  vtkNew<vtkEquivalenceSet> expected;
+  expected->AddEquivalence(0, 0);
+  expected->AddEquivalence(1, 1);
+  for (int rank = 0; rank < numRanks; ++rank)
+  {
+    for (const auto& item : GetEquivalences(rank, numRanks))
+    {
+      expected->AddEquivalence(item.first, item.second);
+    }
+  }
+  const int numberOfSets = expected->ResolveEquivalences();
+
+  vtkNew<vtkPEquivalenceSet> set;
+  if (myRank == 0)
+  {
+    // only the first rank knows of the lone members.
+    set->AddEquivalence(0, 0);
+    set->AddEquivalence(1, 1);
+  }
+  for (const auto& item : GetEquivalences(myRank, numRanks))
+  {
+    set->AddEquivalence(item.first, item.second);
+  }
+  if (set->ResolveEquivalences() != numberOfSets)
+  {
+    vtkLogF(ERROR, "expected %d sets, got %d", numberOfSets, set->GetNumberOfResolvedSets());
+    return false;
+  }
+  if (set->GetNumberOfMembers() != expected->GetNumberOfMembers())
+  {
+    vtkLogF(ERROR, "expected %d members, got %d", expected->GetNumberOfMembers(),
+      set->GetNumberOfMembers());
+    return false;
+  }
+  for (int ii = 0; ii < expected->GetNumberOfMembers(); ++ii)
+  {
+    if (set->GetEquivalentSetId(ii) != expected->GetEquivalentSetId(ii))
+    {
+      vtkLogF(ERROR, "member %d is in set %d, expected %d", ii, set->GetEquivalentSetId(ii),
+        expected->GetEquivalentSetId(ii));
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestPEquivalenceSetMPI(int argc, char* argv[])
+{
+  vtkMPIController* contr = vtkMPIController::New();
+  contr->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(contr);
+
+  int success = ResolveEquivalences(contr) ? 1 : 0;
+  int allSuccess = 0;
+  contr->AllReduce(&success, &allSuccess, 1, vtkCommunicator::LOGICAL_AND_OP);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  contr->Finalize();
+  contr->Delete();
+  return allSuccess ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -76,16 +76,27 @@ void vtkEquivalenceSet::PrintSelf(ostream& os, vtkIndent indent)
 // Return the id of the equivalent set.
 int vtkEquivalenceSet::GetEquivalentSetId(int memberId)
 {
-  int ref;
+  int root = memberId;
+  int ref = this->GetReference(root);
+  while (!this->Resolved && ref != root)
+  {
+    root = ref;
+    ref = this->GetReference(root);
+  }
+  if (this->Resolved)
+  {
+    return ref;
+  }
 
-  ref = this->GetReference(memberId);
-  while (!this->Resolved && ref != memberId)
+  // Compress the path so that later lookups of these members are direct.
+  while (memberId != root)
   {
-    memberId = ref;
     ref = this->GetReference(memberId);
+    this->EquivalenceArray->SetValue(memberId, root);
+    memberId = ref;
   }
 
-  return ref;
+  return root;
 }
 
 //----------------------------------------------------------------------------
@@ -121,26 +132,7 @@ void vtkEquivalenceSet::AddEquivalence(int id1, int id2)
     ++num;
   }
 
-  // Our rule for references in the equivalent set is that
-  // all elements must point to a member equal to or smaller
-  // than itself.
-
-  // The only problem we could encounter is changing a reference.
-  // we do not want to orphan anything previously referenced.
-
-  // Replace the larger references.
-  if (id1 < id2)
-  {
-    // We could follow the references to the smallest.  It might
-    // make this processing more efficient.  This is a compromise.
-    // The referenced id will always be smaller than the id so
-    // order does not change.
-    this->EquateInternal(this->GetReference(id1), id2);
-  }
-  else
-  {
-    this->EquateInternal(this->GetReference(id2), id1);
-  }
+  this->EquateInternal(id1, id2);
 }
 
 //----------------------------------------------------------------------------
@@ -168,32 +160,22 @@ vtkIdType vtkEquivalenceSet::Capacity()
 }
 
 //----------------------------------------------------------------------------
-// id1 must be less than or equal to id2.
+// Merge the sets of two members.
 void vtkEquivalenceSet::EquateInternal(int id1, int id2)
 {
-  // This is the reference that might be orphaned in this process.
-  int oldRef = this->GetEquivalentSetId(id2);
+  int root1 = this->GetEquivalentSetId(id1);
+  int root2 = this->GetEquivalentSetId(id2);
 
-  // The two ids are already equal (not the only way they might be equal).
-  if (oldRef == id1)
+  // Our rule for references in the equivalent set is that all elements must
+  // point to a member equal to or smaller than itself, so the larger root is
+  // linked to the smaller one.
+  if (root1 < root2)
   {
-    return;
+    this->EquivalenceArray->SetValue(root2, root1);
   }
-
-  // The only problem we could encounter is changing a reference.
-  // we do not want to orphan anything previously referenced.
-  if (oldRef == id2)
-  {
-    this->EquivalenceArray->SetValue(id2, id1);
-  }
-  else if (oldRef > id1)
+  else if (root2 < root1)
   {
-    this->EquivalenceArray->SetValue(id2, id1);
-    this->EquateInternal(id1, oldRef);
-  }
-  else
-  { // oldRef < id1
-    this->EquateInternal(oldRef, id1);
+    this->EquivalenceArray->SetValue(root1, root2);
   }
 }
 
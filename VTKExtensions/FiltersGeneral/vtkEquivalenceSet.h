@@ -80,7 +80,7 @@ protected:
   // traversed by different processes or passes.
   vtkIntArray* EquivalenceArray;
 
-  // Return the id of the equivalent set.
+  // Merge the sets of two members, linking the larger root to the smaller one.
   void EquateInternal(int id1, int id2);
 
 private:
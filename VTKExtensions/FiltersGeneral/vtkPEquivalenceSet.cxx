@@ -17,6 +17,8 @@
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkPEquivalenceSet);
 
 vtkPEquivalenceSet::vtkPEquivalenceSet() = default;
@@ -31,52 +33,79 @@ void vtkPEquivalenceSet::PrintSelf(ostream& os, vtkIndent indent)
 int vtkPEquivalenceSet::ResolveEquivalences()
 {
   vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  if (!controller || controller->GetNumberOfProcesses() <= 1)
+  {
+    return this->Superclass::ResolveEquivalences();
+  }
   int myProc = controller->GetLocalProcessId();
   int numProcs = controller->GetNumberOfProcesses();
 
-  vtkIntArray* workingSet = vtkIntArray::New();
-  workingSet->SetNumberOfComponents(1);
-
+  // The sets are merged along a binary tree rooted at process 0, in
+  // log2(numProcs) rounds. Only the members that are not the root of their
+  // set are sent, along with their root.
+  std::vector<int> pairs;
   int tag = 475893745;
-  int pivot = (numProcs + 1) / 2;
-  while (pivot > 0 && myProc < (pivot * 2))
+  for (int step = 1; step < numProcs; step *= 2)
   {
-    int tuples;
-    if (myProc >= pivot)
+    if (myProc % (2 * step) == step)
     {
-      tuples = this->EquivalenceArray->GetNumberOfTuples();
-      controller->Send(&tuples, 1, myProc - pivot, tag + pivot + 0);
-      controller->Send(this->EquivalenceArray, myProc - pivot, tag + pivot + 1);
+      // pairs may hold the ones received in earlier rounds.
+      pairs.clear();
+      int numMembers = this->GetNumberOfMembers();
+      for (int ii = 0; ii < numMembers; ++ii)
+      {
+        int root = this->GetEquivalentSetId(ii);
+        if (root != ii)
+        {
+          pairs.push_back(ii);
+          pairs.push_back(root);
+        }
+      }
+      // The trailing members may all be alone, send the length too.
+      int header[2] = { numMembers, static_cast<int>(pairs.size()) };
+      controller->Send(header, 2, myProc - step, tag);
+      if (header[1] > 0)
+      {
+        controller->Send(pairs.data(), header[1], myProc - step, tag + 1);
+      }
+      // This process is done once its set is merged into another one.
+      break;
     }
-    else if ((myProc + pivot) < numProcs)
+    if (myProc % (2 * step) == 0 && myProc + step < numProcs)
     {
-      controller->Receive(&tuples, 1, myProc + pivot, tag + pivot + 0);
-      workingSet->SetNumberOfTuples(tuples);
-
-      controller->Receive(workingSet, myProc + pivot, tag + pivot + 1);
-      while (workingSet->GetNumberOfTuples() > this->EquivalenceArray->GetNumberOfTuples())
+      int header[2];
+      controller->Receive(header, 2, myProc + step, tag);
+      pairs.resize(header[1]);
+      if (header[1] > 0)
       {
-        this->EquivalenceArray->InsertNextTuple1(0);
+        controller->Receive(pairs.data(), header[1], myProc + step, tag + 1);
       }
-      for (int i = 0; i < workingSet->GetNumberOfTuples(); i++)
+      if (header[0] > 0)
       {
-        int workingVal = workingSet->GetValue(i);
-        if (workingVal == 0)
-        {
-          continue;
-        }
-        int existingVal = this->EquivalenceArray->GetValue(i);
-        this->EquivalenceArray->SetValue(i, workingVal);
-        if (existingVal != 0 && existingVal < workingVal)
-        {
-          this->EquateInternal(existingVal, workingVal);
-        }
+        this->AddEquivalence(header[0] - 1, header[0] - 1);
+      }
+      for (int ii = 0; ii < header[1]; ii += 2)
+      {
+        this->AddEquivalence(pairs[ii], pairs[ii + 1]);
       }
     }
-    pivot /= 2;
   }
-  controller->Broadcast(this->EquivalenceArray, 0);
 
-  this->Superclass::ResolveEquivalences();
-  return 1;
+  // Process 0 now has the global set, it assigns sequential ids and shares
+  // them with the others.
+  int header[2] = { 0, 0 };
+  if (myProc == 0)
+  {
+    header[1] = this->Superclass::ResolveEquivalences();
+    header[0] = this->GetNumberOfMembers();
+  }
+  controller->Broadcast(header, 2, 0);
+  this->EquivalenceArray->SetNumberOfTuples(header[0]);
+  if (header[0] > 0)
+  {
+    controller->Broadcast(this->GetPointer(), header[0], 0);
+  }
+  this->Resolved = 1;
+  this->NumberOfResolvedSets = header[1];
+  return this->NumberOfResolvedSets;
 }
@@ -16,7 +16,10 @@
  * @class   vtkPEquivalenceSet
  * @brief   distributed method of Equivalence
  *
- * Same as EquivalenceSet, but resolving is a global operation.
+ * Same as EquivalenceSet, but resolving is a global operation. The sets of
+ * all processes are merged along a binary tree, in log2(P) rounds exchanging
+ * only the members that are not the root of their set, and the resolved ids
+ * are then broadcast from process 0.
  * .SEE vtkEquivalenceSet
 */
 
@@ -34,6 +37,7 @@ public:
   static vtkPEquivalenceSet* New();
 
   // Globally equivalent set IDs are reassigned to be sequential.
+  // Returns the number of resolved sets.
   int ResolveEquivalences() override;
 
 protected:
@@ -54,6 +54,8 @@
 #include "vtkMaterialInterfaceToProcMap.h"
 #include "vtkPointAccumulator.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnsignedIntArray.h"
 // IO & IPC
@@ -340,16 +342,27 @@ void vtkMaterialInterfaceEquivalenceSet::Print()
 // Return the id of the equivalent set.
 int vtkMaterialInterfaceEquivalenceSet::GetEquivalentSetId(int memberId)
 {
-  int ref;
+  int root = memberId;
+  int ref = this->GetReference(root);
+  while (!this->Resolved && ref != root)
+  {
+    root = ref;
+    ref = this->GetReference(root);
+  }
+  if (this->Resolved)
+  {
+    return ref;
+  }
 
-  ref = this->GetReference(memberId);
-  while (!this->Resolved && ref != memberId)
+  // Compress the path so that later lookups of these members are direct.
+  while (memberId != root)
   {
-    memberId = ref;
     ref = this->GetReference(memberId);
+    this->EquivalenceArray->SetValue(memberId, root);
+    memberId = ref;
   }
 
-  return ref;
+  return root;
 }
 
 //----------------------------------------------------------------------------
@@ -385,49 +398,26 @@ void vtkMaterialInterfaceEquivalenceSet::AddEquivalence(int id1, int id2)
     ++num;
   }
 
-  // Our rule for references in the equivalent set is that
-  // all elements must point to a member equal to or smaller
-  // than itself.
-
-  // The only problem we could encounter is changing a reference.
-  // we do not want to orphan anything previously referenced.
-
-  // Replace the larger references.
-  if (id1 < id2)
-  {
-    // We could follow the references to the smallest.  It might
-    // make this processing more efficient.  This is a compromise.
-    // The referenced id will always be smaller than the id so
-    // order does not change.
-    this->EquateInternal(this->GetReference(id1), id2);
-  }
-  else
-  {
-    this->EquateInternal(this->GetReference(id2), id1);
-  }
+  this->EquateInternal(id1, id2);
 }
 
 //----------------------------------------------------------------------------
-// id1 must be less than or equal to id2.
+// Merge the sets of two members.
 void vtkMaterialInterfaceEquivalenceSet::EquateInternal(int id1, int id2)
 {
-  // This is the reference that might be orphaned in this process.
-  int oldRef = this->GetEquivalentSetId(id2);
+  int root1 = this->GetEquivalentSetId(id1);
+  int root2 = this->GetEquivalentSetId(id2);
 
-  // The only problem we could encounter is changing a reference.
-  // we do not want to orphan anything previously referenced.
-  if (oldRef == id2 || oldRef == id1)
+  // Our rule for references in the equivalent set is that all elements must
+  // point to a member equal to or smaller than itself, so the larger root is
+  // linked to the smaller one.
+  if (root1 < root2)
   {
-    this->EquivalenceArray->SetValue(id2, id1);
+    this->EquivalenceArray->SetValue(root2, root1);
   }
-  else if (oldRef > id1)
+  else if (root2 < root1)
   {
-    this->EquivalenceArray->SetValue(id2, id1);
-    this->EquateInternal(id1, oldRef);
-  }
-  else
-  { // oldRef < id1
-    this->EquateInternal(oldRef, id1);
+    this->EquivalenceArray->SetValue(root1, root2);
   }
 }
 
@@ -1624,6 +1614,7 @@ vtkMaterialInterfaceFilter::vtkMaterialInterfaceFilter()
   this->ClipDepthMinimums = nullptr;
 
   this->EquivalenceSet = new vtkMaterialInterfaceEquivalenceSet;
+  this->SearchBlock = nullptr;
   this->LocalToGlobalOffsets = nullptr;
   this->TotalNumberOfRawFragments = 0;
   this->NumberOfResolvedFragments = 0;
@@ -3578,12 +3569,8 @@ int vtkMaterialInterfaceFilter::RequestData(vtkInformation* vtkNotUsed(request),
     // Lets profile to see what takes the most time for large number of processes.
     this->ProcessBlocksTimer->StartTimer();
 #endif
-    int blockId;
-    for (blockId = 0; blockId < this->NumberOfInputBlocks; ++blockId)
-    {
-      // build fragments
-      this->ProcessBlock(blockId);
-    }
+    // build fragments
+    this->LabelBlocks();
 #ifdef vtkMaterialInterfaceFilterPROFILE
     // Lets profile to see what takes the most time for large number of processes.
     this->ProcessBlocksTimer->StopTimer();
@@ -3727,23 +3714,228 @@ int vtkMaterialInterfaceFilter::RequestData(vtkInformation* vtkNotUsed(request),
 }
 
 //----------------------------------------------------------------------------
-int vtkMaterialInterfaceFilter::ProcessBlock(int blockId)
+// Labels blocks with per thread copies of the filter. A copy labels the
+// blocks it is given one after the other, its local ids follow each other.
+struct vtkMaterialInterfaceFilterLabelBlocks
+{
+  vtkMaterialInterfaceFilter* Filter;
+  std::vector<vtkMaterialInterfaceFilterBlock*> Blocks;
+  // For each block, the copy which labelled it and the range of its ids.
+  std::vector<vtkMaterialInterfaceFilter*> Labellers;
+  std::vector<int> FirstFragmentIds;
+  std::vector<int> NumberOfFragments;
+  vtkSMPThreadLocalObject<vtkMaterialInterfaceFilter> Workers;
+
+  void Initialize()
+  {
+    vtkMaterialInterfaceFilter* filter = this->Filter;
+    vtkMaterialInterfaceFilter* worker = this->Workers.Local();
+    worker->MaterialId = filter->MaterialId;
+    worker->scaledMaterialFractionThreshold = filter->scaledMaterialFractionThreshold;
+    worker->ClipWithPlane = filter->ClipWithPlane;
+    for (int q = 0; q < 3; ++q)
+    {
+      worker->ClipCenter[q] = filter->ClipCenter[q];
+      worker->ClipPlaneNormal[q] = filter->ClipPlaneNormal[q];
+    }
+    worker->NToIntegrate = filter->NToIntegrate;
+    worker->IntegratedArrayNames = filter->IntegratedArrayNames;
+    worker->IntegratedArrayNComp = filter->IntegratedArrayNComp;
+
+    // accumulators and arrays of results, indexed by the ids of the worker.
+    ReNewVtkPointer(worker->FragmentVolumes);
+    if (filter->ClipWithPlane)
+    {
+      ReNewVtkPointer(worker->ClipDepthMaximums);
+      ReNewVtkPointer(worker->ClipDepthMinimums);
+    }
+    worker->ComputeMoments = filter->ComputeMoments;
+    if (filter->ComputeMoments)
+    {
+      ReNewVtkPointer(worker->FragmentMoments);
+      worker->FragmentMoments->SetNumberOfComponents(4);
+    }
+    worker->NVolumeWtdAvgs = filter->NVolumeWtdAvgs;
+    worker->FragmentVolumeWtdAvg = filter->FragmentVolumeWtdAvg;
+    ClearVectorOfVtkPointers(worker->FragmentVolumeWtdAvgs);
+    for (int i = 0; i < filter->NVolumeWtdAvgs; ++i)
+    {
+      vtkDoubleArray* da = vtkDoubleArray::New();
+      da->SetNumberOfComponents(filter->FragmentVolumeWtdAvgs[i]->GetNumberOfComponents());
+      worker->FragmentVolumeWtdAvgs.push_back(da);
+    }
+    worker->NMassWtdAvgs = filter->NMassWtdAvgs;
+    worker->FragmentMassWtdAvg = filter->FragmentMassWtdAvg;
+    ClearVectorOfVtkPointers(worker->FragmentMassWtdAvgs);
+    for (int i = 0; i < filter->NMassWtdAvgs; ++i)
+    {
+      vtkDoubleArray* da = vtkDoubleArray::New();
+      da->SetNumberOfComponents(filter->FragmentMassWtdAvgs[i]->GetNumberOfComponents());
+      worker->FragmentMassWtdAvgs.push_back(da);
+    }
+    worker->NToSum = filter->NToSum;
+    worker->FragmentSum = filter->FragmentSum;
+    ClearVectorOfVtkPointers(worker->FragmentSums);
+    for (int i = 0; i < filter->NToSum; ++i)
+    {
+      vtkDoubleArray* da = vtkDoubleArray::New();
+      da->SetNumberOfComponents(filter->FragmentSums[i]->GetNumberOfComponents());
+      worker->FragmentSums.push_back(da);
+    }
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkMaterialInterfaceFilter* worker = this->Workers.Local();
+    for (vtkIdType blockId = begin; blockId < end; ++blockId)
+    {
+      this->FirstFragmentIds[blockId] = worker->FragmentId;
+      worker->ProcessBlock(this->Blocks[blockId]);
+      this->NumberOfFragments[blockId] = worker->FragmentId - this->FirstFragmentIds[blockId];
+      this->Labellers[blockId] = worker;
+    }
+  }
+
+  void Reduce() {}
+};
+
+//----------------------------------------------------------------------------
+// Ghost blocks are labelled too, their voxels are matched with the ones of
+// the processes owning them when equivalences are resolved. Fragments are
+// split at block boundaries, the pieces are equated here and merged when
+// equivalences are resolved.
+void vtkMaterialInterfaceFilter::LabelBlocks()
 {
 #ifdef vtkMaterialInterfaceFilterDEBUG
   ostringstream progressMesg;
-  progressMesg << "vtkMaterialInterfaceFilter::ProcessBlock(" << blockId << ") , Material "
-               << this->MaterialId;
+  progressMesg << "vtkMaterialInterfaceFilter::LabelBlocks() , Material " << this->MaterialId;
   this->SetProgressText(progressMesg.str().c_str());
 #endif
-  this->Progress += this->ProgressBlockInc;
-  this->UpdateProgress(this->Progress);
 
-  vtkMaterialInterfaceFilterBlock* block = this->InputBlocks[blockId];
-  if (block == nullptr)
+  vtkMaterialInterfaceFilterLabelBlocks labeller;
+  labeller.Filter = this;
+  for (int blockId = 0; blockId < this->NumberOfInputBlocks; ++blockId)
+  {
+    if (this->InputBlocks[blockId])
+    {
+      labeller.Blocks.push_back(this->InputBlocks[blockId]);
+    }
+  }
+  labeller.Blocks.insert(labeller.Blocks.end(), this->GhostBlocks.begin(), this->GhostBlocks.end());
+  const vtkIdType numBlocks = static_cast<vtkIdType>(labeller.Blocks.size());
+  labeller.Labellers.resize(numBlocks, nullptr);
+  labeller.FirstFragmentIds.resize(numBlocks, 0);
+  labeller.NumberOfFragments.resize(numBlocks, 0);
+
+  // Blocks do not take the same time to label, hand them out one at a time.
+  vtkSMPTools::For(0, numBlocks, 1, labeller);
+
+  // Gather the fragments in block order, so that the ids do not depend on
+  // how blocks were shared out between threads.
+  vector<int> offsets(numBlocks, 0);
+  for (vtkIdType blockId = 0; blockId < numBlocks; ++blockId)
   {
-    return 0;
+    vtkMaterialInterfaceFilter* worker = labeller.Labellers[blockId];
+    const int firstId = labeller.FirstFragmentIds[blockId];
+    const int lastId = firstId + labeller.NumberOfFragments[blockId];
+    offsets[blockId] = this->FragmentId - firstId;
+    for (int localId = firstId; localId < lastId; ++localId)
+    {
+      this->FragmentMeshes.push_back(worker->FragmentMeshes[localId]);
+      this->EquivalenceSet->AddEquivalence(this->FragmentId, this->FragmentId);
+      this->FragmentVolumes->InsertTuple(this->FragmentId, localId, worker->FragmentVolumes);
+      if (this->ClipWithPlane)
+      {
+        this->ClipDepthMaximums->InsertTuple(this->FragmentId, localId, worker->ClipDepthMaximums);
+        this->ClipDepthMinimums->InsertTuple(this->FragmentId, localId, worker->ClipDepthMinimums);
+      }
+      if (this->ComputeMoments)
+      {
+        this->FragmentMoments->InsertTuple(this->FragmentId, localId, worker->FragmentMoments);
+      }
+      for (int i = 0; i < this->NVolumeWtdAvgs; ++i)
+      {
+        this->FragmentVolumeWtdAvgs[i]->InsertTuple(
+          this->FragmentId, localId, worker->FragmentVolumeWtdAvgs[i]);
+      }
+      for (int i = 0; i < this->NMassWtdAvgs; ++i)
+      {
+        this->FragmentMassWtdAvgs[i]->InsertTuple(
+          this->FragmentId, localId, worker->FragmentMassWtdAvgs[i]);
+      }
+      for (int i = 0; i < this->NToSum; ++i)
+      {
+        this->FragmentSums[i]->InsertTuple(this->FragmentId, localId, worker->FragmentSums[i]);
+      }
+      ++this->FragmentId;
+    }
+  }
+
+  // Move the voxels to the ids of this filter.
+  vtkSMPTools::For(0, numBlocks, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType blockId = begin; blockId < end; ++blockId)
+    {
+      const int offset = offsets[blockId];
+      if (offset == 0 || labeller.NumberOfFragments[blockId] == 0)
+      {
+        continue;
+      }
+      vtkMaterialInterfaceFilterBlock* block = labeller.Blocks[blockId];
+      const int* ext = block->GetBaseCellExtent();
+      int cellIncs[3];
+      block->GetCellIncrements(cellIncs);
+      int* zFragmentIds = block->GetBaseFragmentIdPointer();
+      for (int iz = ext[4]; iz <= ext[5]; ++iz)
+      {
+        int* yFragmentIds = zFragmentIds;
+        for (int iy = ext[2]; iy <= ext[3]; ++iy)
+        {
+          int* xFragmentIds = yFragmentIds;
+          for (int ix = ext[0]; ix <= ext[1]; ++ix)
+          {
+            if (*xFragmentIds != -1)
+            {
+              *xFragmentIds += offset;
+            }
+            xFragmentIds += cellIncs[0];
+          }
+          yFragmentIds += cellIncs[1];
+        }
+        zFragmentIds += cellIncs[2];
+      }
+    }
+  });
+
+  // Now that all the voxels have their final ids, equate the fragments
+  // which meet across blocks.
+  for (auto it = labeller.Workers.begin(); it != labeller.Workers.end(); ++it)
+  {
+    vtkMaterialInterfaceFilter* worker = *it;
+    // The meshes belong to this filter now.
+    worker->FragmentMeshes.clear();
+    const vector<int*>& pairs = worker->BlockEquivalences;
+    for (size_t ii = 0; ii < pairs.size(); ii += 2)
+    {
+      const int id1 = *pairs[ii];
+      const int id2 = *pairs[ii + 1];
+      if (id1 != id2 && id1 != -1 && id2 != -1)
+      {
+        this->EquivalenceSet->AddEquivalence(id1, id2);
+      }
+    }
   }
 
+  this->Progress += this->NumberOfInputBlocks * this->ProgressBlockInc;
+  this->UpdateProgress(this->Progress);
+}
+
+//----------------------------------------------------------------------------
+int vtkMaterialInterfaceFilter::ProcessBlock(vtkMaterialInterfaceFilterBlock* block)
+{
+  // Neighbors outside of this block are left to the thread labelling their
+  // block.
+  this->SearchBlock = block;
+
   vtkMaterialInterfaceFilterIterator* xIterator = new vtkMaterialInterfaceFilterIterator;
   vtkMaterialInterfaceFilterIterator* yIterator = new vtkMaterialInterfaceFilterIterator;
   vtkMaterialInterfaceFilterIterator* zIterator = new vtkMaterialInterfaceFilterIterator;
@@ -3778,7 +3970,6 @@ int vtkMaterialInterfaceFilter::ProcessBlock(int blockId)
           *(xIterator->VolumeFractionPointer) > this->scaledMaterialFractionThreshold)
         { // We have a new fragment.
           this->CurrentFragmentMesh = this->NewFragmentMesh();
-          this->EquivalenceSet->AddEquivalence(this->FragmentId, this->FragmentId);
           // We have to mark every voxel we push on the queue.
           *(xIterator->FragmentIdPointer) = this->FragmentId;
           // There should be no need to clear the queue.
@@ -5464,6 +5655,8 @@ inline int vtkMaterialInterfaceFilter::AccumulateMoments(double* moments, // =(M
 // This integrates quantities at the same time.
 // This is called only when the voxel is part of a fragment.
 // I tried to create a generic API to replace the hard coded conditional ifs.
+// The search does not leave the block being labelled, so that blocks can be
+// labelled by several threads.
 void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingBuffer* queue)
 {
   while (queue->GetSize())
@@ -5549,6 +5742,11 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
         // Neighbor is outside of fragment.  Make a face.
         this->CreateFace(&iterator, &next, ii, 0);
       }
+      else if (next.Block != this->SearchBlock)
+      { // Another thread labels the block of this neighbor. The fragments
+        // are equated once all blocks are labelled.
+        this->AddEquivalence(&iterator, &next);
+      }
       else if (next.FragmentIdPointer[0] == -1)
       { // We have not visited this neighbor yet. Mark the voxel and recurse.
         *(next.FragmentIdPointer) = this->FragmentId;
@@ -5580,6 +5778,10 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
             // Neighbor is outside of fragment.  Make a face.
             this->CreateFace(&iterator, &next2, ii, 0);
           }
+          else if (next2.Block != this->SearchBlock)
+          { // Labelled by another thread, see above.
+            this->AddEquivalence(&iterator, &next2);
+          }
           else if (next2.FragmentIdPointer[0] == -1)
           { // We have not visited this neighbor yet. Mark the voxel and recurse.
             *(next2.FragmentIdPointer) = this->FragmentId;
@@ -5601,6 +5803,10 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
             // Neighbor is outside of fragment.  Make a face.
             this->CreateFace(&iterator, &next2, ii, 0);
           }
+          else if (next2.Block != this->SearchBlock)
+          { // Labelled by another thread, see above.
+            this->AddEquivalence(&iterator, &next2);
+          }
           else if (next2.FragmentIdPointer[0] == -1)
           { // We have not visited this neighbor yet. Mark the voxel and recurse.
             *(next2.FragmentIdPointer) = this->FragmentId;
@@ -5622,6 +5828,10 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
             // Neighbor is outside of fragment.  Make a face.
             this->CreateFace(&iterator, &next, ii, 0);
           }
+          else if (next.Block != this->SearchBlock)
+          { // Labelled by another thread, see above.
+            this->AddEquivalence(&iterator, &next);
+          }
           else if (next.FragmentIdPointer[0] == -1)
           { // We have not visited this neighbor yet. Mark the voxel and recurse.
             *(next.FragmentIdPointer) = this->FragmentId;
@@ -5642,6 +5852,10 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
       { // Neighbor is outside of fragment.  Make a face.
         this->CreateFace(&iterator, &next, ii, 1);
       }
+      else if (next.Block != this->SearchBlock)
+      { // Labelled by another thread, see above.
+        this->AddEquivalence(&iterator, &next);
+      }
       else if (next.FragmentIdPointer[0] == -1)
       { // We have not visited this neighbor yet. Mark the voxel and recurse.
         *(next.FragmentIdPointer) = this->FragmentId;
@@ -5668,6 +5882,10 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
             // Neighbor is outside of fragment.  Make a face.
             this->CreateFace(&iterator, &next2, ii, 1);
           }
+          else if (next2.Block != this->SearchBlock)
+          { // Labelled by another thread, see above.
+            this->AddEquivalence(&iterator, &next2);
+          }
           else if (next2.FragmentIdPointer[0] == -1)
           { // We have not visited this neighbor yet. Mark the voxel and recurse.
             *(next2.FragmentIdPointer) = this->FragmentId;
@@ -5689,6 +5907,10 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
             // Neighbor is outside of fragment.  Make a face.
             this->CreateFace(&iterator, &next2, ii, 1);
           }
+          else if (next2.Block != this->SearchBlock)
+          { // Labelled by another thread, see above.
+            this->AddEquivalence(&iterator, &next2);
+          }
           else if (next2.FragmentIdPointer[0] == -1)
           { // We have not visited this neighbor yet. Mark the voxel and recurse.
             *(next2.FragmentIdPointer) = this->FragmentId;
@@ -5710,6 +5932,10 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
             // Neighbor is outside of fragment.  Make a face.
             this->CreateFace(&iterator, &next, ii, 1);
           }
+          else if (next.Block != this->SearchBlock)
+          { // Labelled by another thread, see above.
+            this->AddEquivalence(&iterator, &next);
+          }
           else if (next.FragmentIdPointer[0] == -1)
           { // We have not visited this neighbor yet. Mark the voxel and recurse.
             *(next.FragmentIdPointer) = this->FragmentId;
@@ -6321,16 +6547,18 @@ void vtkMaterialInterfaceFilter::SetUpperLoadingBound(int nPolys)
 // Chains can leave orphans, loops break when two nodes in the loop are
 // equated a second time.
 // Lets try a directed tree
+// The voxels are kept rather than their ids: the ones of other blocks may
+// not be labelled yet, and all ids are renumbered when blocks are gathered.
 void vtkMaterialInterfaceFilter::AddEquivalence(
   vtkMaterialInterfaceFilterIterator* neighbor1, vtkMaterialInterfaceFilterIterator* neighbor2)
 {
-  int id1 = *(neighbor1->FragmentIdPointer);
-  int id2 = *(neighbor2->FragmentIdPointer);
-
-  if (id1 != id2 && id1 != -1 && id2 != -1)
+  if (neighbor1->Block == this->SearchBlock && neighbor2->Block == this->SearchBlock &&
+    *(neighbor1->FragmentIdPointer) == *(neighbor2->FragmentIdPointer))
   {
-    this->EquivalenceSet->AddEquivalence(id1, id2);
+    return;
   }
+  this->BlockEquivalences.push_back(neighbor1->FragmentIdPointer);
+  this->BlockEquivalences.push_back(neighbor2->FragmentIdPointer);
 }
 
 //----------------------------------------------------------------------------
@@ -8265,24 +8493,7 @@ void vtkMaterialInterfaceFilter::GatherEquivalenceSets(vtkMaterialInterfaceEquiv
   const int numLocalMembers = set->GetNumberOfMembers();
 
   // Find a mapping between local fragment id and the global fragment ids.
-  if (myProcId == 0)
-  {
-    this->NumberOfRawFragmentsInProcess[0] = numLocalMembers;
-    for (int ii = 1; ii < numProcs; ++ii)
-    {
-      this->Controller->Receive(this->NumberOfRawFragmentsInProcess + ii, 1, ii, 875034);
-    }
-    // Now send the results back to all processes.
-    for (int ii = 1; ii < numProcs; ++ii)
-    {
-      this->Controller->Send(this->NumberOfRawFragmentsInProcess, numProcs, ii, 875035);
-    }
-  }
-  else
-  {
-    this->Controller->Send(&numLocalMembers, 1, 0, 875034);
-    this->Controller->Receive(this->NumberOfRawFragmentsInProcess, numProcs, 0, 875035);
-  }
+  this->Controller->AllGather(&numLocalMembers, this->NumberOfRawFragmentsInProcess, 1);
   // Compute offsets.
   int totalNumberOfIds = 0;
   for (int ii = 0; ii < numProcs; ++ii)
@@ -8307,8 +8518,6 @@ void vtkMaterialInterfaceFilter::GatherEquivalenceSets(vtkMaterialInterfaceEquiv
   for (int ii = 0; ii < numLocalMembers; ++ii)
   {
     memberSetId = set->GetEquivalentSetId(ii);
-    // This will be inefficient until I make the scheduled improvemnt to the
-    // add method (Ordered multilevel tree instead of a one level tree).
     globalSet->AddEquivalence(ii + myOffset, memberSetId + myOffset);
   }
 
@@ -8347,58 +8556,70 @@ void vtkMaterialInterfaceFilter::MergeGhostEquivalenceSets(
   vtkMaterialInterfaceEquivalenceSet* globalSet)
 {
   const int myProcId = this->Controller->GetLocalProcessId();
-  int* buf = globalSet->GetPointer();
+  const int numProcs = this->Controller->GetNumberOfProcesses();
   const int numIds = globalSet->GetNumberOfMembers();
 
   // At this point all the sets are global and have the same number of ids.
-  // Send all the sets to process 0 to be merged.
-  if (myProcId > 0)
-  {
-    this->Controller->Send(buf, numIds, 0, 342320);
-    // Now receive the final equivalences.
-    this->Controller->Receive(&this->NumberOfResolvedFragments, 1, 0, 342321);
-    // Domain has numIds,  range has NumberOfResolvedFragments
-    this->Controller->Receive(buf, numIds, 0, 342322);
-    // We have to mark the set as resolved because the set being
-    // received has been resolved.  If we do not do this then
-    // We cannot get the proper set id.  Using the pointer
-    // here is a bad api.  TODO: Fix the API and make "Resolved" private.
-    globalSet->Resolved = 1;
-    return;
-  }
-
-  // Only process 0 from here out.
-
-  int numProcs = this->Controller->GetNumberOfProcesses();
-  int* tmp;
-  tmp = new int[numIds];
-  for (int ii = 1; ii < numProcs; ++ii)
+  // They are merged along a binary tree rooted at process 0, in
+  // log2(numProcs) rounds. Only the members that are not the root of their
+  // set are sent, along with their root.
+  vector<int> pairs;
+  for (int step = 1; step < numProcs; step *= 2)
   {
-    this->Controller->Receive(tmp, numIds, ii, 342320);
-    // Merge the values.
-    for (int jj = 0; jj < numIds; ++jj)
+    if (myProcId % (2 * step) == step)
     {
-      if (tmp[jj] != jj)
-      { // TODO: Make sure this is efficient.  Avoid n^2.
-        globalSet->AddEquivalence(jj, tmp[jj]);
+      // pairs may hold the ones received in earlier rounds.
+      pairs.clear();
+      for (int ii = 0; ii < numIds; ++ii)
+      {
+        int rootId = globalSet->GetEquivalentSetId(ii);
+        if (rootId != ii)
+        {
+          pairs.push_back(ii);
+          pairs.push_back(rootId);
+        }
+      }
+      int numValues = static_cast<int>(pairs.size());
+      this->Controller->Send(&numValues, 1, myProcId - step, 342320);
+      if (numValues > 0)
+      {
+        this->Controller->Send(&pairs[0], numValues, myProcId - step, 342321);
+      }
+      // This process is done once its set is merged into another one.
+      break;
+    }
+    if (myProcId % (2 * step) == 0 && myProcId + step < numProcs)
+    {
+      int numValues;
+      this->Controller->Receive(&numValues, 1, myProcId + step, 342320);
+      pairs.resize(numValues);
+      if (numValues > 0)
+      {
+        this->Controller->Receive(&pairs[0], numValues, myProcId + step, 342321);
+      }
+      for (int ii = 0; ii < numValues; ii += 2)
+      {
+        globalSet->AddEquivalence(pairs[ii], pairs[ii + 1]);
       }
     }
   }
-  delete[] tmp;
 
-  // Make the set ids sequential.
-  this->NumberOfResolvedFragments = globalSet->ResolveEquivalences();
-
-  // The pointers should still be valid.
-  // The array should not resize here.
-  // Number of resolved fragemnts will be smaller
-  // than TotalNumberOfRawFragments
-  for (int ii = 1; ii < numProcs; ++ii)
+  // Make the set ids sequential on process 0 and share them.
+  if (myProcId == 0)
+  {
+    this->NumberOfResolvedFragments = globalSet->ResolveEquivalences();
+  }
+  this->Controller->Broadcast(&this->NumberOfResolvedFragments, 1, 0);
+  // Domain has numIds,  range has NumberOfResolvedFragments
+  if (numIds > 0)
   {
-    this->Controller->Send(&this->NumberOfResolvedFragments, 1, ii, 342321);
-    // Domain has numIds,  range has NumberOfResolvedFragments
-    this->Controller->Send(buf, numIds, ii, 342322);
+    this->Controller->Broadcast(globalSet->GetPointer(), numIds, 0);
   }
+  // We have to mark the set as resolved because the set being
+  // received has been resolved.  If we do not do this then
+  // We cannot get the proper set id.  Using the pointer
+  // here is a bad api.  TODO: Fix the API and make "Resolved" private.
+  globalSet->Resolved = 1;
 }
 
 //----------------------------------------------------------------------------
@@ -8465,6 +8686,7 @@ void vtkMaterialInterfaceFilter::ReceiveGhostFragmentIds(
   int dataSize;
   int* remoteExt;
   int localId, remoteId;
+  int lastLocalId = -1, lastRemoteId = -1;
   const int myProcId = this->Controller->GetLocalProcessId();
   int localOffset = procOffsets[myProcId];
   int remoteOffset;
@@ -8525,9 +8747,13 @@ void vtkMaterialInterfaceFilter::ReceiveGhostFragmentIds(
             // Convert local fragment ids to global ids.
             localId = *px;
             remoteId = *remoteFragmentIds;
-            if (localId >= 0 && remoteId >= 0)
+            // Neighboring voxels mostly belong to the same fragments.
+            if (localId >= 0 && remoteId >= 0 &&
+              (localId != lastLocalId || remoteId + remoteOffset != lastRemoteId))
             {
               globalSet->AddEquivalence(localId + localOffset, remoteId + remoteOffset);
+              lastLocalId = localId;
+              lastRemoteId = remoteId + remoteOffset;
             }
             ++remoteFragmentIds;
             ++px;
@@ -348,8 +348,11 @@ protected:
     std::vector<std::string>& integratedArrayNames);
   // Create a new fragment/piece.
   vtkPolyData* NewFragmentMesh();
+  // Label the input and ghost blocks in parallel, each thread using its
+  // own copy of this filter, then gather their fragments.
+  void LabelBlocks();
   // Process each cell, looking for fragments.
-  int ProcessBlock(int blockId);
+  int ProcessBlock(vtkMaterialInterfaceFilterBlock* block);
   // Cell has been identified as inside the fragment. Integrate, and
   // generate fragment surface etc...
   void ConnectFragment(vtkMaterialInterfaceFilterRingBuffer* iterator);
@@ -388,6 +391,11 @@ protected:
   vtkMaterialInterfaceEquivalenceSet* EquivalenceSet;
   void AddEquivalence(
     vtkMaterialInterfaceFilterIterator* neighbor1, vtkMaterialInterfaceFilterIterator* neighbor2);
+  // Block being labelled, the search does not leave it.
+  vtkMaterialInterfaceFilterBlock* SearchBlock;
+  // Pairs of voxels whose fragments are equivalent. Their ids are compared
+  // once all blocks have been labelled.
+  std::vector<int*> BlockEquivalences;
   //
   void PrepareForResolveEquivalences();
   //
@@ -724,6 +732,8 @@ protected:
 #endif
 
 private:
+  friend struct vtkMaterialInterfaceFilterLabelBlocks;
+
   vtkMaterialInterfaceFilter(const vtkMaterialInterfaceFilter&) = delete;
   void operator=(const vtkMaterialInterfaceFilter&) = delete;
 };
@@ -0,0 +1,244 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestDataObjectMarshaller.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Round trips data objects through vtkPVDataObjectMarshaller with every
+// compression mode and reports the marshalling throughput.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPVDataObjectMarshaller.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSphereSource.h"
+#include "vtkStringArray.h"
+#include "vtkTable.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <initializer_list>
+#include <iostream>
+
+#define VERIFY(x, y)                                                                               \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    vtkLogF(ERROR, y);                                                                             \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+bool SameArray(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b || a->GetDataType() != b->GetDataType() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents() ||
+    a->GetNumberOfTuples() != b->GetNumberOfTuples())
+  {
+    return false;
+  }
+  const size_t size = static_cast<size_t>(a->GetNumberOfValues()) * a->GetDataTypeSize();
+  return size == 0 || memcmp(a->GetVoidPointer(0), b->GetVoidPointer(0), size) == 0;
+}
+
+vtkSmartPointer<vtkDataObject> RoundTrip(vtkDataObject* data, int compression)
+{
+  vtkNew<vtkPVDataObjectMarshaller> marshaller;
+  marshaller->SetCompression(compression);
+  marshaller->SetCompressionThreshold(1024);
+  vtkIdType length = 0;
+  char* buffer = marshaller->Marshal(data, length);
+  if (!buffer || !vtkPVDataObjectMarshaller::IsMarshalledBuffer(buffer, length))
+  {
+    delete[] buffer;
+    return nullptr;
+  }
+  vtkSmartPointer<vtkDataObject> result = marshaller->Unmarshal(buffer, length);
+  delete[] buffer;
+  return result;
+}
+
+bool TestPolyData(int compression)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(64);
+  sphere->SetPhiResolution(64);
+  sphere->Update();
+  vtkPolyData* input = sphere->GetOutput();
+
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName("Ids");
+  ids->SetNumberOfTuples(input->GetNumberOfCells());
+  for (vtkIdType cc = 0; cc < input->GetNumberOfCells(); ++cc)
+  {
+    ids->SetValue(cc, cc);
+  }
+  input->GetCellData()->SetGlobalIds(ids);
+
+  vtkNew<vtkStringArray> strings;
+  strings->SetName("Strings");
+  strings->InsertNextValue("first");
+  strings->InsertNextValue("");
+  strings->InsertNextValue("third");
+  input->GetFieldData()->AddArray(strings);
+
+  auto result = RoundTrip(input, compression);
+  auto output = vtkPolyData::SafeDownCast(result);
+  VERIFY(output != nullptr, "vtkPolyData expected.");
+  VERIFY(output->GetNumberOfPoints() == input->GetNumberOfPoints(), "point count mismatch.");
+  VERIFY(output->GetNumberOfPolys() == input->GetNumberOfPolys(), "polygon count mismatch.");
+  VERIFY(SameArray(output->GetPoints()->GetData(), input->GetPoints()->GetData()),
+    "points mismatch.");
+  VERIFY(SameArray(output->GetPolys()->GetConnectivityArray(),
+           input->GetPolys()->GetConnectivityArray()),
+    "connectivity mismatch.");
+  VERIFY(SameArray(output->GetPointData()->GetNormals(), input->GetPointData()->GetNormals()),
+    "normals mismatch.");
+  VERIFY(SameArray(output->GetCellData()->GetGlobalIds(), ids), "global ids mismatch.");
+
+  auto outStrings =
+    vtkStringArray::SafeDownCast(output->GetFieldData()->GetAbstractArray("Strings"));
+  VERIFY(outStrings != nullptr && outStrings->GetNumberOfValues() == 3, "strings expected.");
+  VERIFY(outStrings->GetValue(0) == "first" && outStrings->GetValue(1).empty() &&
+      outStrings->GetValue(2) == "third",
+    "strings mismatch.");
+  return true;
+}
+
+bool TestImageData(int compression)
+{
+  vtkNew<vtkRTAnalyticSource> wavelet;
+  wavelet->SetWholeExtent(-10, 20, 5, 30, 0, 15);
+  wavelet->Update();
+  vtkImageData* input = wavelet->GetOutput();
+  input->SetOrigin(1, 2, 3);
+  input->SetSpacing(0.5, 0.25, 2);
+
+  auto result = RoundTrip(input, compression);
+  auto output = vtkImageData::SafeDownCast(result);
+  VERIFY(output != nullptr, "vtkImageData expected.");
+  int inExtent[6], outExtent[6];
+  input->GetExtent(inExtent);
+  output->GetExtent(outExtent);
+  VERIFY(std::equal(inExtent, inExtent + 6, outExtent), "extent mismatch.");
+  VERIFY(output->GetOrigin()[1] == 2 && output->GetSpacing()[2] == 2, "geometry mismatch.");
+  VERIFY(SameArray(output->GetPointData()->GetScalars(), input->GetPointData()->GetScalars()),
+    "scalars mismatch.");
+  return true;
+}
+
+bool TestComposite(int compression)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->Update();
+
+  vtkNew<vtkTable> table;
+  vtkNew<vtkIntArray> column;
+  column->SetName("Column");
+  column->SetNumberOfTuples(10);
+  for (int cc = 0; cc < 10; ++cc)
+  {
+    column->SetValue(cc, cc * cc);
+  }
+  table->AddColumn(column);
+
+  vtkNew<vtkMultiBlockDataSet> nested;
+  nested->SetNumberOfBlocks(2);
+  nested->SetBlock(1, sphere->GetOutput());
+
+  vtkNew<vtkMultiBlockDataSet> input;
+  input->SetNumberOfBlocks(3);
+  input->SetBlock(0, nested);
+  input->GetMetaData(0u)->Set(vtkCompositeDataSet::NAME(), "nested");
+  input->SetBlock(2, table);
+
+  auto result = RoundTrip(input, compression);
+  auto output = vtkMultiBlockDataSet::SafeDownCast(result);
+  VERIFY(output != nullptr && output->GetNumberOfBlocks() == 3, "3 blocks expected.");
+  VERIFY(output->HasMetaData(0u) &&
+      strcmp(output->GetMetaData(0u)->Get(vtkCompositeDataSet::NAME()), "nested") == 0,
+    "block name mismatch.");
+  VERIFY(output->GetBlock(1) == nullptr, "empty block expected.");
+  auto outNested = vtkMultiBlockDataSet::SafeDownCast(output->GetBlock(0));
+  VERIFY(outNested != nullptr && outNested->GetNumberOfBlocks() == 2, "nested blocks expected.");
+  auto outSphere = vtkPolyData::SafeDownCast(outNested->GetBlock(1));
+  VERIFY(outSphere != nullptr &&
+      outSphere->GetNumberOfCells() == sphere->GetOutput()->GetNumberOfCells(),
+    "nested vtkPolyData mismatch.");
+  auto outTable = vtkTable::SafeDownCast(output->GetBlock(2));
+  VERIFY(outTable != nullptr && SameArray(outTable->GetRowData()->GetArray("Column"), column),
+    "vtkTable mismatch.");
+  return true;
+}
+
+bool TestNull()
+{
+  vtkNew<vtkPVDataObjectMarshaller> marshaller;
+  vtkIdType length = 0;
+  char* buffer = marshaller->Marshal(nullptr, length);
+  VERIFY(buffer != nullptr, "buffer expected for nullptr.");
+  auto output = marshaller->Unmarshal(buffer, length);
+  delete[] buffer;
+  VERIFY(output == nullptr, "nullptr expected.");
+  return true;
+}
+
+void ReportThroughput(int compression)
+{
+  vtkNew<vtkRTAnalyticSource> wavelet;
+  wavelet->SetWholeExtent(0, 255, 0, 255, 0, 255);
+  wavelet->Update();
+
+  vtkNew<vtkPVDataObjectMarshaller> marshaller;
+  marshaller->SetCompression(compression);
+  vtkIdType length = 0;
+  auto start = std::chrono::steady_clock::now();
+  char* buffer = marshaller->Marshal(wavelet->GetOutput(), length);
+  auto marshalled = std::chrono::steady_clock::now();
+  auto output = marshaller->Unmarshal(buffer, length);
+  auto unmarshalled = std::chrono::steady_clock::now();
+  delete[] buffer;
+
+  const double megabytes = wavelet->GetOutput()->GetActualMemorySize() / 1024.0;
+  const double marshalSeconds = std::chrono::duration<double>(marshalled - start).count();
+  const double unmarshalSeconds = std::chrono::duration<double>(unmarshalled - marshalled).count();
+  std::cout << "compression " << compression << ": " << megabytes << " MB marshalled to "
+            << (length / (1024.0 * 1024.0)) << " MB, marshal "
+            << (marshalSeconds > 0 ? megabytes / marshalSeconds : 0.0) << " MB/s, unmarshal "
+            << (unmarshalSeconds > 0 ? megabytes / unmarshalSeconds : 0.0) << " MB/s"
+            << std::endl;
+}
+}
+
+int TestDataObjectMarshaller(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  bool success = TestNull();
+  for (int compression : { vtkPVDataObjectMarshaller::NONE, vtkPVDataObjectMarshaller::LZ4,
+         vtkPVDataObjectMarshaller::ZLIB })
+  {
+    success = success && TestPolyData(compression) && TestImageData(compression) &&
+      TestComposite(compression);
+    ReportThroughput(compression);
+  }
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -16,6 +16,7 @@
 #include "vtkImageCompressor.h"
 #include "vtkImageData.h"
 #include "vtkLZ4Compressor.h"
+#include "vtkLZ4DeltaCompressor.h"
 #include "vtkNew.h"
 #include "vtkPNGReader.h"
 #include "vtkPointData.h"
@@ -26,8 +27,10 @@
 #include "vtkUnsignedCharArray.h"
 #include "vtkZlibImageCompressor.h"
 
+#include <cstring>
 #include <map>
 #include <string>
+#include <vector>
 #include <vtksys/CommandLineArguments.hxx>
 
 #define TEST_SUCCESS 0
@@ -81,11 +84,159 @@ bool DoTest(Data& data, vtkImageCompressor* compressor, vtkUnsignedCharArray* in
   return true;
 }
 
+// Compresses and decompresses a sequence of frames, as done when interacting
+// with a remote render view. Different instances are used for compressing and
+// decompressing since some compressors depend on the previous frame.
+bool DoSequenceTest(Data& data, vtkImageCompressor* compressor, vtkImageCompressor* decompressor,
+  const std::vector<vtkSmartPointer<vtkUnsignedCharArray> >& frames, int width, int height,
+  bool verify)
+{
+  vtkNew<vtkUnsignedCharArray> outputCompressed;
+  vtkNew<vtkUnsignedCharArray> outputDeCompressed;
+  vtkNew<vtkTimerLog> timer;
+  for (const auto& frame : frames)
+  {
+    outputDeCompressed->SetNumberOfComponents(frame->GetNumberOfComponents());
+    outputDeCompressed->SetNumberOfTuples(frame->GetNumberOfTuples());
+
+    compressor->SetImageResolution(width, height);
+    compressor->SetInput(frame);
+    compressor->SetOutput(outputCompressed.Get());
+    timer->StartTimer();
+    if (!compressor->Compress())
+    {
+      return false;
+    }
+    timer->StopTimer();
+    data.CompressTime += timer->GetElapsedTime();
+
+    decompressor->SetImageResolution(width, height);
+    decompressor->SetInput(outputCompressed.Get());
+    decompressor->SetOutput(outputDeCompressed.Get());
+    timer->StartTimer();
+    if (!decompressor->Decompress())
+    {
+      return false;
+    }
+    timer->StopTimer();
+    data.DecompressTime += timer->GetElapsedTime();
+    data.CompressedSize +=
+      outputCompressed->GetNumberOfTuples() * outputCompressed->GetNumberOfComponents();
+
+    if (verify &&
+      memcmp(frame->GetPointer(0), outputDeCompressed->GetPointer(0),
+        frame->GetNumberOfTuples() * frame->GetNumberOfComponents()) != 0)
+    {
+      cerr << "Decompressed frame does not match the input frame." << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Generates frames from an image by moving a region of the image around, as
+// when interacting with a small object in a large view.
+std::vector<vtkSmartPointer<vtkUnsignedCharArray> > GenerateFrames(
+  vtkUnsignedCharArray* input, int width, int height, int count)
+{
+  std::vector<vtkSmartPointer<vtkUnsignedCharArray> > frames;
+  const int numComps = input->GetNumberOfComponents();
+  const int regionWidth = width / 4;
+  const int regionHeight = height / 4;
+  for (int cc = 0; cc < count; ++cc)
+  {
+    vtkNew<vtkUnsignedCharArray> frame;
+    frame->DeepCopy(input);
+    for (int y = 0; y < regionHeight; ++y)
+    {
+      for (int x = 0; x < regionWidth; ++x)
+      {
+        const vtkIdType source = static_cast<vtkIdType>(y + height / 2) * width + x + width / 2;
+        const vtkIdType target = static_cast<vtkIdType>(y + height / 2) * width +
+          (x + width / 2 + 4 * cc) % width;
+        memcpy(frame->GetPointer(target * numComps), input->GetPointer(source * numComps),
+          numComps);
+      }
+    }
+    frames.push_back(frame.Get());
+  }
+  return frames;
+}
+
+// Benchmarks the compressors on a sequence of frames.
+bool TestSequence(const std::vector<vtkSmartPointer<vtkUnsignedCharArray> >& frames, int width,
+  int height, bool test_lossy)
+{
+  vtkIdType uncompressedSize = 0;
+  for (const auto& frame : frames)
+  {
+    uncompressedSize += frame->GetNumberOfTuples() * frame->GetNumberOfComponents();
+  }
+
+  MapType datas;
+  vtkNew<vtkLZ4Compressor> lz4;
+  lz4->SetQuality(0);
+  if (!DoSequenceTest(
+        datas["LZ4 (quality: 0)"], lz4.Get(), lz4.Get(), frames, width, height, false))
+  {
+    return false;
+  }
+
+  vtkNew<vtkSquirtCompressor> squirt;
+  squirt->SetSquirtLevel(0);
+  if (!DoSequenceTest(datas["SQUIRT (squirt-level: 0)"], squirt.Get(), squirt.Get(), frames,
+        width, height, false))
+  {
+    return false;
+  }
+
+  vtkNew<vtkZlibImageCompressor> zlib;
+  zlib->SetCompressionLevel(1);
+  if (!DoSequenceTest(datas["ZLIB (compression-level: 1, color-space: 0)"], zlib.Get(),
+        zlib.Get(), frames, width, height, false))
+  {
+    return false;
+  }
+
+  vtkNew<vtkLZ4DeltaCompressor> lz4Delta;
+  vtkNew<vtkLZ4DeltaCompressor> lz4DeltaDecompressor;
+  lz4Delta->SetQuality(0);
+  if (!DoSequenceTest(datas["LZ4 DELTA (quality: 0)"], lz4Delta.Get(), lz4DeltaDecompressor.Get(),
+        frames, width, height, true))
+  {
+    return false;
+  }
+  if (test_lossy)
+  {
+    lz4Delta->SetQuality(3);
+    lz4Delta->SetLossLessMode(0);
+    if (!DoSequenceTest(datas["LZ4 DELTA (quality: 3)"], lz4Delta.Get(), lz4DeltaDecompressor.Get(),
+          frames, width, height, false))
+    {
+      return false;
+    }
+  }
+
+  cout << "Sequence: " << frames.size() << " frames of " << width << "x" << height
+       << " (uncompressed size: " << uncompressedSize << ") " << endl;
+  for (MapType::iterator iter = datas.begin(); iter != datas.end(); ++iter)
+  {
+    cout << iter->first.c_str() << " :"
+         << " compress: " << (iter->second.CompressTime / frames.size())
+         << " decompress: " << (iter->second.DecompressTime / frames.size())
+         << " compression ratio: "
+         << ((uncompressedSize - iter->second.CompressedSize) * 100.0 / uncompressedSize)
+         << "( compressed size: " << iter->second.CompressedSize << ")" << endl;
+  }
+  return true;
+}
+
 int TestImageCompressors(int argc, char* argv[])
 {
   int max_count = 10;
   bool test_lossy = true;
   std::string imageFile;
+  std::vector<std::string> sequenceFiles;
 
   // Use --image argument to use this for benchmarking.
   vtksys::CommandLineArguments arg;
@@ -93,6 +244,9 @@ int TestImageCompressors(int argc, char* argv[])
   typedef vtksys::CommandLineArguments argT;
   arg.AddArgument("--image", argT::EQUAL_ARGUMENT, &imageFile,
     "Optionally specify an image to use for compressing.");
+  arg.AddArgument("--sequence", argT::MULTI_ARGUMENT, &sequenceFiles,
+    "Optionally specify a sequence of recorded frames of the same size to use for "
+    "benchmarking the compression of consecutive frames.");
   arg.StoreUnusedArguments(true);
   if (!arg.Parse())
   {
@@ -168,6 +322,14 @@ int TestImageCompressors(int argc, char* argv[])
       }
     }
 
+    vtkNew<vtkLZ4DeltaCompressor> lz4Delta;
+    lz4Delta->SetQuality(0);
+    lz4Delta->SetImageResolution(image->GetDimensions()[0], image->GetDimensions()[1]);
+    if (!DoTest(datas["LZ4 DELTA (quality: 0)"], lz4Delta.Get(), input))
+    {
+      return TEST_FAILED;
+    }
+
     vtkNew<vtkZlibImageCompressor> zlib;
     zlib->SetCompressionLevel(1);
     if (!DoTest(datas["ZLIB (compression-level: 1, color-space: 0)"], zlib.Get(), input))
@@ -206,5 +368,38 @@ int TestImageCompressors(int argc, char* argv[])
          << ((uncompressedSize - iter->second.CompressedSize) * 100.0 / uncompressedSize)
          << "( compressed size: " << iter->second.CompressedSize << ")" << endl;
   }
+
+  std::vector<vtkSmartPointer<vtkUnsignedCharArray> > frames;
+  int width = image->GetDimensions()[0];
+  int height = image->GetDimensions()[1];
+  if (sequenceFiles.empty())
+  {
+    frames = GenerateFrames(input, width, height, 10);
+  }
+  else
+  {
+    for (const auto& fname : sequenceFiles)
+    {
+      vtkNew<vtkPNGReader> frameReader;
+      frameReader->SetFileName(fname.c_str());
+      frameReader->Update();
+      vtkImageData* frameImage = frameReader->GetOutput();
+      auto frame = vtkUnsignedCharArray::SafeDownCast(frameImage->GetPointData()->GetScalars());
+      if (frame == nullptr || (!frames.empty() &&
+                                (frameImage->GetDimensions()[0] != width ||
+                                  frameImage->GetDimensions()[1] != height)))
+      {
+        cerr << "Invalid frame: " << fname.c_str() << endl;
+        return TEST_FAILED;
+      }
+      width = frameImage->GetDimensions()[0];
+      height = frameImage->GetDimensions()[1];
+      frames.push_back(frame);
+    }
+  }
+  if (!TestSequence(frames, width, height, test_lossy))
+  {
+    return TEST_FAILED;
+  }
   return TEST_SUCCESS;
 }
@@ -0,0 +1,243 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestImageCompressorsThroughput.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Reports the throughput, in MB/s, of the image compressors used for remote
+// rendering, with and without strips, and checks the loss-less round trips.
+// Also checks that configurations without the strips token, as sent by older
+// versions, select the legacy format.
+// By default, a single small image is used. Pass `--benchmark` to use common
+// resolutions instead, and `--iterations=<n>` to average over more iterations.
+
+#include "vtkImageCompressor.h"
+#include "vtkLZ4Compressor.h"
+#include "vtkNew.h"
+#include "vtkSmartPointer.h"
+#include "vtkSquirtCompressor.h"
+#include "vtkTimerLog.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <array>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <vtksys/CommandLineArguments.hxx>
+
+#define TEST_SUCCESS 0
+#define TEST_FAILED 1
+
+namespace
+{
+// Generates an image resembling a rendering: a gradient background with a few
+// flat shaded disks.
+vtkSmartPointer<vtkUnsignedCharArray> GenerateImage(int width, int height, int numComps)
+{
+  auto image = vtkSmartPointer<vtkUnsignedCharArray>::New();
+  image->SetNumberOfComponents(numComps);
+  image->SetNumberOfTuples(static_cast<vtkIdType>(width) * height);
+  unsigned char* pixels = image->GetPointer(0);
+  for (int y = 0; y < height; ++y)
+  {
+    for (int x = 0; x < width; ++x)
+    {
+      unsigned char color[4] = { 82, 87, static_cast<unsigned char>(110 + (60 * y) / height), 0 };
+      for (int disk = 0; disk < 3; ++disk)
+      {
+        const int cx = (disk + 1) * width / 4;
+        const int cy = height / 2;
+        const int radius = height / (3 + disk);
+        const int dx = x - cx;
+        const int dy = y - cy;
+        if (dx * dx + dy * dy < radius * radius)
+        {
+          const int shade = 255 - (128 * (dx * dx + dy * dy)) / (radius * radius);
+          color[0] = static_cast<unsigned char>(disk == 0 ? shade : shade / 4);
+          color[1] = static_cast<unsigned char>(disk == 1 ? shade : shade / 4);
+          color[2] = static_cast<unsigned char>(disk == 2 ? shade : shade / 4);
+          color[3] = 255;
+        }
+      }
+      memcpy(pixels + (static_cast<vtkIdType>(y) * width + x) * numComps, color, numComps);
+    }
+  }
+  return image;
+}
+
+// Compresses and decompresses `input`. When `verify` is true, the decompressed
+// image must match the input, with the alpha values masked by `alphaMask`.
+bool Benchmark(const std::string& name, vtkImageCompressor* compressor,
+  vtkUnsignedCharArray* input, int width, int height, int iterations, bool verify,
+  unsigned char alphaMask = 0xFF)
+{
+  vtkNew<vtkUnsignedCharArray> compressed;
+  vtkNew<vtkUnsignedCharArray> decompressed;
+  decompressed->SetNumberOfComponents(input->GetNumberOfComponents());
+  decompressed->SetNumberOfTuples(input->GetNumberOfTuples());
+
+  double compressTime = 0;
+  double decompressTime = 0;
+  vtkNew<vtkTimerLog> timer;
+  for (int cc = 0; cc < iterations; ++cc)
+  {
+    compressor->SetImageResolution(width, height);
+    compressor->SetInput(input);
+    compressor->SetOutput(compressed.Get());
+    timer->StartTimer();
+    if (!compressor->Compress())
+    {
+      cerr << name.c_str() << ": compression failed." << endl;
+      return false;
+    }
+    timer->StopTimer();
+    compressTime += timer->GetElapsedTime();
+
+    compressor->SetInput(compressed.Get());
+    compressor->SetOutput(decompressed.Get());
+    timer->StartTimer();
+    if (!compressor->Decompress())
+    {
+      cerr << name.c_str() << ": decompression failed." << endl;
+      return false;
+    }
+    timer->StopTimer();
+    decompressTime += timer->GetElapsedTime();
+  }
+
+  const vtkIdType size = input->GetNumberOfTuples() * input->GetNumberOfComponents();
+  if (verify)
+  {
+    const int numComps = input->GetNumberOfComponents();
+    const unsigned char* expected = input->GetPointer(0);
+    const unsigned char* actual = decompressed->GetPointer(0);
+    for (vtkIdType cc = 0; cc < size; ++cc)
+    {
+      const unsigned char mask = (numComps == 4 && cc % 4 == 3) ? alphaMask : 0xFF;
+      if ((expected[cc] & mask) != (actual[cc] & mask))
+      {
+        cerr << name.c_str() << ": decompressed image does not match the input at pixel "
+             << cc / numComps << "." << endl;
+        return false;
+      }
+    }
+  }
+
+  const vtkIdType compressedSize =
+    compressed->GetNumberOfTuples() * compressed->GetNumberOfComponents();
+  const double megabytes = iterations * size / (1024.0 * 1024.0);
+  cout << width << "x" << height << "x" << input->GetNumberOfComponents() << " " << name.c_str()
+       << " : compress: " << (compressTime > 0 ? megabytes / compressTime : 0.0) << " MB/s"
+       << " decompress: " << (decompressTime > 0 ? megabytes / decompressTime : 0.0) << " MB/s"
+       << " compression ratio: " << ((size - compressedSize) * 100.0 / size) << endl;
+  return true;
+}
+
+// Restores `config` and checks the strips setting and that the whole
+// configuration was consumed.
+bool CheckConfiguration(vtkImageCompressor* compressor, const char* config, bool useStrips)
+{
+  compressor->SetUseStrips(!useStrips);
+  const char* end = compressor->RestoreConfiguration(config);
+  if (end == nullptr || end != config + strlen(config))
+  {
+    cerr << "'" << config << "': configuration not consumed." << endl;
+    return false;
+  }
+  if (compressor->GetUseStrips() != useStrips)
+  {
+    cerr << "'" << config << "': expected UseStrips " << useStrips << "." << endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestImageCompressorsThroughput(int argc, char* argv[])
+{
+  int iterations = 1;
+  bool benchmark = false;
+  vtksys::CommandLineArguments arg;
+  arg.Initialize(argc, argv);
+  typedef vtksys::CommandLineArguments argT;
+  arg.AddArgument(
+    "--iterations", argT::EQUAL_ARGUMENT, &iterations, "Number of iterations to average over.");
+  arg.AddBooleanArgument(
+    "--benchmark", &benchmark, "Use 1080p and 4K images instead of a single small one.");
+  arg.StoreUnusedArguments(true);
+  if (!arg.Parse())
+  {
+    cerr << "Problem parsing arguments" << endl;
+    return TEST_FAILED;
+  }
+
+  vtkNew<vtkSquirtCompressor> squirtConfig;
+  vtkNew<vtkLZ4Compressor> lz4Config;
+  if (!CheckConfiguration(squirtConfig, "vtkSquirtCompressor 0 3", false) ||
+    !CheckConfiguration(squirtConfig, "vtkSquirtCompressor 0 3 1", true) ||
+    !CheckConfiguration(squirtConfig, "vtkSquirtCompressor 0 3 x", false) ||
+    !CheckConfiguration(lz4Config, "vtkLZ4Compressor 0 3", false) ||
+    !CheckConfiguration(lz4Config, "vtkLZ4Compressor 0 3 1", true) ||
+    !CheckConfiguration(lz4Config, "vtkLZ4Compressor 0 3 0", false))
+  {
+    return TEST_FAILED;
+  }
+
+  // the small image is still large enough to be split in several strips.
+  const std::vector<std::array<int, 2> > resolutions = benchmark
+    ? std::vector<std::array<int, 2> >{ { { 1920, 1080 } }, { { 3840, 2160 } } }
+    : std::vector<std::array<int, 2> >{ { { 640, 480 } } };
+  for (const auto& resolution : resolutions)
+  {
+    for (int numComps = 3; numComps <= 4; ++numComps)
+    {
+      auto input = GenerateImage(resolution[0], resolution[1], numComps);
+      for (int useStrips = 0; useStrips <= 1; ++useStrips)
+      {
+        const std::string suffix = useStrips ? " (strips)" : " (legacy)";
+
+        vtkNew<vtkSquirtCompressor> squirt;
+        squirt->SetUseStrips(useStrips != 0);
+        squirt->SetLossLessMode(1);
+        // SQUIRT only keeps the 4 higher bits of the alpha values.
+        if (!Benchmark("SQUIRT (squirt-level: 0)" + suffix, squirt.Get(), input, resolution[0],
+              resolution[1], iterations, true, 0xF0))
+        {
+          return TEST_FAILED;
+        }
+        squirt->SetLossLessMode(0);
+        squirt->SetSquirtLevel(3);
+        if (!Benchmark("SQUIRT (squirt-level: 3)" + suffix, squirt.Get(), input, resolution[0],
+              resolution[1], iterations, false))
+        {
+          return TEST_FAILED;
+        }
+
+        vtkNew<vtkLZ4Compressor> lz4;
+        lz4->SetUseStrips(useStrips != 0);
+        lz4->SetLossLessMode(1);
+        if (!Benchmark("LZ4 (quality: 0)" + suffix, lz4.Get(), input, resolution[0],
+              resolution[1], iterations, true))
+        {
+          return TEST_FAILED;
+        }
+        lz4->SetLossLessMode(0);
+        lz4->SetQuality(3);
+        if (!Benchmark("LZ4 (quality: 3)" + suffix, lz4.Get(), input, resolution[0],
+              resolution[1], iterations, false))
+        {
+          return TEST_FAILED;
+        }
+      }
+    }
+  }
+  return TEST_SUCCESS;
+}
@@ -0,0 +1,149 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestSortedTableStreamerMPI.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Requests every block of a table distributed over all ranks, in both orders,
+// and checks that together they match the sorted data.
+
+#include "vtkDoubleArray.h"
+#include "vtkLogger.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkSortedTableStreamer.h"
+#include "vtkTable.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+// Ranks have different numbers of rows and many values are shared between
+// ranks, so that equal values span several buckets of the distributed sort.
+vtkIdType GetNumberOfRows(int rank)
+{
+  return 1000 + 377 * rank;
+}
+
+double GetValue(vtkIdType globalRow)
+{
+  return static_cast<double>((globalRow * 7919) % 1000);
+}
+
+bool SortByBlocks(vtkMultiProcessController* contr)
+{
+  const int myRank = contr->GetLocalProcessId();
+  const int numRanks = contr->GetNumberOfProcesses();
+  const vtkIdType blockSize = 128;
+
+  std::vector<double> allValues;
+  vtkIdType offset = 0;
+  for (int rank = 0; rank < numRanks; ++rank)
+  {
+    for (vtkIdType cc = 0; cc < GetNumberOfRows(rank); ++cc)
+    {
+      allValues.push_back(GetValue(allValues.size()));
+    }
+    if (rank < myRank)
+    {
+      offset += GetNumberOfRows(rank);
+    }
+  }
+  const vtkIdType totalSize = static_cast<vtkIdType>(allValues.size());
+
+  vtkNew<vtkDoubleArray> data;
+  data->SetName("data");
+  data->SetNumberOfTuples(GetNumberOfRows(myRank));
+  for (vtkIdType cc = 0; cc < data->GetNumberOfTuples(); ++cc)
+  {
+    data->SetValue(cc, GetValue(offset + cc));
+  }
+  vtkNew<vtkTable> input;
+  input->AddColumn(data);
+
+  vtkNew<vtkSortedTableStreamer> sorter;
+  sorter->SetInputData(input);
+  sorter->SetColumnNameToSort("data");
+  sorter->SetSelectedComponent(0);
+  sorter->SetBlockSize(blockSize);
+
+  for (int invert = 0; invert < 2; ++invert)
+  {
+    std::vector<double> sortedValues(allValues);
+    std::sort(sortedValues.begin(), sortedValues.end());
+    if (invert)
+    {
+      std::reverse(sortedValues.begin(), sortedValues.end());
+    }
+
+    sorter->SetInvertOrder(invert);
+    const vtkIdType numBlocks = (totalSize + blockSize - 1) / blockSize;
+    for (vtkIdType block = numBlocks - 1; block >= 0; --block)
+    {
+      sorter->SetBlock(block);
+      sorter->Update();
+
+      // the block is merged on a single rank.
+      vtkTable* output = sorter->GetOutput();
+      const vtkIdType blockOffset = block * blockSize;
+      const vtkIdType expectedSize = std::min(blockSize, totalSize - blockOffset);
+      vtkIdType numRows = output->GetNumberOfRows();
+      vtkIdType totalRows = 0;
+      contr->AllReduce(&numRows, &totalRows, 1, vtkCommunicator::SUM_OP);
+      if (totalRows != expectedSize)
+      {
+        vtkLogF(ERROR, "block %lld has %lld rows, expected %lld", static_cast<long long>(block),
+          static_cast<long long>(totalRows), static_cast<long long>(expectedSize));
+        return false;
+      }
+      if (numRows == 0)
+      {
+        continue;
+      }
+
+      auto column = vtkDoubleArray::SafeDownCast(output->GetColumnByName("data"));
+      if (column == nullptr || numRows != expectedSize)
+      {
+        vtkLogF(ERROR, "block %lld is not merged on a single rank", static_cast<long long>(block));
+        return false;
+      }
+      for (vtkIdType cc = 0; cc < numRows; ++cc)
+      {
+        if (column->GetValue(cc) != sortedValues[blockOffset + cc])
+        {
+          vtkLogF(ERROR, "invalid value at row %lld of block %lld%s",
+            static_cast<long long>(cc), static_cast<long long>(block),
+            invert ? " (inverted order)" : "");
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestSortedTableStreamerMPI(int argc, char* argv[])
+{
+  vtkMPIController* contr = vtkMPIController::New();
+  contr->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(contr);
+
+  int success = SortByBlocks(contr) ? 1 : 0;
+  int allSuccess = 0;
+  contr->AllReduce(&success, &allSuccess, 1, vtkCommunicator::LOGICAL_AND_OP);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  contr->Finalize();
+  contr->Delete();
+  return allSuccess ? EXIT_SUCCESS : EXIT_FAILURE;
+}
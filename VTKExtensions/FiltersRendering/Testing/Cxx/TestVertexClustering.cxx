@@ -0,0 +1,100 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestVertexClustering.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Decimates a sphere with vtkPVVertexClustering and checks the output is a
+// valid, smaller, mesh with the input attributes.
+
+#include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
+#include "vtkCellData.h"
+#include "vtkIdTypeArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPVVertexClustering.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+
+#include <set>
+
+#define VERIFY(x, y)                                                                               \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    vtkLogF(ERROR, y);                                                                             \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+int TestVertexClustering(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(256);
+  sphere->SetPhiResolution(256);
+  sphere->Update();
+
+  vtkNew<vtkPolyData> input;
+  input->ShallowCopy(sphere->GetOutput());
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  cellIds->SetNumberOfTuples(input->GetNumberOfCells());
+  for (vtkIdType cc = 0; cc < input->GetNumberOfCells(); ++cc)
+  {
+    cellIds->SetValue(cc, cc);
+  }
+  input->GetCellData()->AddArray(cellIds);
+
+  vtkNew<vtkPVVertexClustering> clustering;
+  clustering->SetNumberOfDivisions(32, 32, 32);
+  clustering->SetInputData(input);
+  clustering->Update();
+  vtkPolyData* output = clustering->GetOutput();
+
+  VERIFY(output->GetNumberOfPoints() > 0 &&
+      output->GetNumberOfPoints() < input->GetNumberOfPoints() / 5,
+    "unexpected number of points.");
+  VERIFY(output->GetNumberOfPolys() > 0 &&
+      output->GetNumberOfPolys() < input->GetNumberOfPolys() / 5,
+    "unexpected number of triangles.");
+  VERIFY(output->GetPointData()->GetNormals() != nullptr, "normals expected.");
+
+  auto outCellIds = vtkIdTypeArray::SafeDownCast(output->GetCellData()->GetArray("CellIds"));
+  VERIFY(outCellIds != nullptr && outCellIds->GetNumberOfTuples() == output->GetNumberOfCells(),
+    "cell data expected.");
+
+  // Triangles must neither be degenerate nor duplicated, and only reference
+  // input cells.
+  std::set<std::set<vtkIdType> > triangles;
+  auto iter = vtk::TakeSmartPointer(output->GetPolys()->NewIterator());
+  for (iter->GoToFirstCell(); !iter->IsDoneWithTraversal(); iter->GoToNextCell())
+  {
+    vtkIdType npts;
+    const vtkIdType* pts;
+    iter->GetCurrentCell(npts, pts);
+    std::set<vtkIdType> triangle(pts, pts + npts);
+    VERIFY(npts == 3 && triangle.size() == 3, "degenerate triangle.");
+    VERIFY(triangles.insert(triangle).second, "duplicate triangle.");
+    const vtkIdType cellId = outCellIds->GetValue(iter->GetCurrentCellId());
+    VERIFY(cellId >= 0 && cellId < input->GetNumberOfCells(), "invalid cell data.");
+  }
+
+  // The output is deterministic.
+  vtkNew<vtkPVVertexClustering> clustering2;
+  clustering2->SetNumberOfDivisions(32, 32, 32);
+  clustering2->SetInputData(input);
+  clustering2->Update();
+  VERIFY(clustering2->GetOutput()->GetNumberOfPoints() == output->GetNumberOfPoints() &&
+      clustering2->GetOutput()->GetNumberOfPolys() == output->GetNumberOfPolys(),
+    "output is not deterministic.");
+  return EXIT_SUCCESS;
+}
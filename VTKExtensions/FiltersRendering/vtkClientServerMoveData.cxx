@@ -17,13 +17,13 @@
 #include "vtkCharArray.h"
 #include "vtkDataObject.h"
 #include "vtkDataObjectTypes.h"
-#include "vtkGenericDataObjectReader.h"
-#include "vtkGenericDataObjectWriter.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVDataObjectMarshaller.h"
 #include "vtkPVSession.h"
 #include "vtkPolyData.h"
 #include "vtkProcessModule.h"
@@ -33,6 +33,7 @@
 #include "vtkUnstructuredGrid.h"
 
 #include <sstream>
+#include <vector>
 
 vtkStandardNewMacro(vtkClientServerMoveData);
 vtkCxxSetObjectMacro(vtkClientServerMoveData, Controller, vtkMultiProcessController);
@@ -211,7 +212,23 @@ int vtkClientServerMoveData::SendData(vtkDataObject* input, vtkMultiProcessContr
     }
   }
 
-  return controller->Send(input, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+  vtkNew<vtkPVDataObjectMarshaller> marshaller;
+  vtkIdType length = 0;
+  char* buffer = marshaller->Marshal(input, length);
+  if (!buffer)
+  {
+    vtkErrorMacro("Failed to marshal data.");
+    length = 0;
+  }
+
+  // Send the size of the buffer followed by the buffer.
+  int status = controller->Send(&length, 1, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+  if (status && length > 0)
+  {
+    status = controller->Send(buffer, length, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+  }
+  delete[] buffer;
+  return status;
 }
 
 //-----------------------------------------------------------------------------
@@ -240,7 +257,23 @@ vtkDataObject* vtkClientServerMoveData::ReceiveData(vtkMultiProcessController* c
   }
   else
   {
-    data = controller->ReceiveDataObject(1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+    vtkIdType length = 0;
+    controller->Receive(&length, 1, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+    if (length <= 0)
+    {
+      return nullptr;
+    }
+    std::vector<char> buffer(static_cast<size_t>(length));
+    controller->Receive(buffer.data(), length, 1, vtkClientServerMoveData::TRANSMIT_DATA_OBJECT);
+
+    vtkNew<vtkPVDataObjectMarshaller> marshaller;
+    vtkSmartPointer<vtkDataObject> received = marshaller->Unmarshal(buffer.data(), length);
+    data = received;
+    if (data)
+    {
+      // the caller is responsible for releasing the data.
+      data->Register(this);
+    }
   }
   return data;
 }
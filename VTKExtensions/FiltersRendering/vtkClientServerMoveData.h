@@ -21,7 +21,8 @@
  * server node to the client node. If not in server-client mode,
  * this filter behaves as a simple pass-through filter.
  * This can work with any data type, the application does not need to set
- * the output type before hand.
+ * the output type before hand. The data is marshalled using
+ * vtkPVDataObjectMarshaller, except for vtkSelection which is serialized to XML.
  * @warning
  * This filter may change the output in RequestData().
 */
@@ -17,10 +17,32 @@
 
 #include "vtkCommand.h"
 #include "vtkMultiProcessStream.h"
+#include "vtkSMPTools.h"
 #include "vtkUnsignedCharArray.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <sstream>
 #include <string>
 
+namespace
+{
+// Compressed strips start with this magic, followed by the number of strips,
+// a `StripHeader` per strip and then by the compressed strips.
+const char StripsMagic[8] = { 'v', 't', 'k', 'S', 't', 'r', 'i', 'p' };
+
+// Number of pixels in a strip, except for the last one. This is large enough
+// for the compression ratio to not be affected by the splitting.
+const vtkIdType PixelsPerStrip = 256 * 1024;
+
+struct StripHeader
+{
+  vtkTypeUInt32 NumberOfPixels;
+  vtkTypeUInt32 Size;
+};
+}
+
 //-----------------------------------------------------------------------------
 vtkCxxSetObjectMacro(vtkImageCompressor, Output, vtkUnsignedCharArray);
 
@@ -32,6 +54,7 @@ vtkImageCompressor::vtkImageCompressor()
   : Output(nullptr)
   , Input(nullptr)
   , LossLessMode(0)
+  , UseStrips(false)
   , Configuration(nullptr)
 {
   // Always allocate output array as a convenience.
@@ -96,16 +119,143 @@ const char* vtkImageCompressor::RestoreConfiguration(const char* stream)
     int mode;
     iss >> mode;
     this->SetLossLessMode(mode);
-    return stream + iss.tellg();
+    return iss.good() ? stream + iss.tellg() : stream + strlen(stream);
   }
   return nullptr;
 }
 
+//-----------------------------------------------------------------------------
+bool vtkImageCompressor::CompressStrips(const std::function<bool(const unsigned char* pixels,
+    vtkIdType numPixels, std::vector<unsigned char>& compressed)>& compressStrip)
+{
+  vtkUnsignedCharArray* input = this->Input;
+  const int numComps = input->GetNumberOfComponents();
+  const vtkIdType numPixels = input->GetNumberOfTuples();
+  const vtkIdType numStrips = (numPixels + PixelsPerStrip - 1) / PixelsPerStrip;
+
+  std::vector<std::vector<unsigned char> > strips(numStrips);
+  std::atomic<bool> failed(false);
+  vtkSMPTools::For(0, numStrips, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cc = begin; cc < end && !failed; ++cc)
+    {
+      const vtkIdType first = cc * PixelsPerStrip;
+      const vtkIdType count = std::min(PixelsPerStrip, numPixels - first);
+      if (!compressStrip(input->GetPointer(first * numComps), count, strips[cc]))
+      {
+        failed = true;
+      }
+    }
+  });
+  if (failed)
+  {
+    return false;
+  }
+
+  const vtkTypeUInt32 numStrips32 = static_cast<vtkTypeUInt32>(numStrips);
+  std::vector<vtkIdType> offsets(numStrips);
+  vtkIdType size = sizeof(StripsMagic) + sizeof(numStrips32) + numStrips * sizeof(StripHeader);
+  for (vtkIdType cc = 0; cc < numStrips; ++cc)
+  {
+    offsets[cc] = size;
+    size += static_cast<vtkIdType>(strips[cc].size());
+  }
+
+  this->Output->SetNumberOfComponents(1);
+  this->Output->SetNumberOfTuples(size);
+  unsigned char* output = this->Output->GetPointer(0);
+  memcpy(output, StripsMagic, sizeof(StripsMagic));
+  memcpy(output + sizeof(StripsMagic), &numStrips32, sizeof(numStrips32));
+  unsigned char* headers = output + sizeof(StripsMagic) + sizeof(numStrips32);
+  for (vtkIdType cc = 0; cc < numStrips; ++cc)
+  {
+    StripHeader header;
+    header.NumberOfPixels =
+      static_cast<vtkTypeUInt32>(std::min(PixelsPerStrip, numPixels - cc * PixelsPerStrip));
+    header.Size = static_cast<vtkTypeUInt32>(strips[cc].size());
+    memcpy(headers + cc * sizeof(StripHeader), &header, sizeof(StripHeader));
+  }
+  vtkSMPTools::For(0, numStrips, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      if (!strips[cc].empty())
+      {
+        memcpy(output + offsets[cc], strips[cc].data(), strips[cc].size());
+      }
+    }
+  });
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkImageCompressor::DecompressStrips(const std::function<bool(const unsigned char* compressed,
+    vtkIdType size, unsigned char* pixels, vtkIdType numPixels)>& decompressStrip)
+{
+  if (!vtkImageCompressor::HasStrips(this->Input))
+  {
+    return false;
+  }
+
+  const unsigned char* input = this->Input->GetPointer(0);
+  const vtkIdType inputSize =
+    this->Input->GetNumberOfTuples() * this->Input->GetNumberOfComponents();
+  vtkTypeUInt32 numStrips;
+  memcpy(&numStrips, input + sizeof(StripsMagic), sizeof(numStrips));
+  const unsigned char* headers = input + sizeof(StripsMagic) + sizeof(numStrips);
+  vtkIdType offset = sizeof(StripsMagic) + sizeof(numStrips) +
+    static_cast<vtkIdType>(numStrips) * sizeof(StripHeader);
+  if (offset > inputSize)
+  {
+    return false;
+  }
+
+  std::vector<StripHeader> strips(numStrips);
+  std::vector<vtkIdType> offsets(numStrips);
+  std::vector<vtkIdType> firstPixels(numStrips);
+  vtkIdType numPixels = 0;
+  for (vtkTypeUInt32 cc = 0; cc < numStrips; ++cc)
+  {
+    memcpy(&strips[cc], headers + cc * sizeof(StripHeader), sizeof(StripHeader));
+    offsets[cc] = offset;
+    firstPixels[cc] = numPixels;
+    offset += strips[cc].Size;
+    numPixels += strips[cc].NumberOfPixels;
+  }
+  vtkUnsignedCharArray* output = this->Output;
+  if (offset > inputSize || numPixels != output->GetNumberOfTuples())
+  {
+    return false;
+  }
+
+  const int numComps = output->GetNumberOfComponents();
+  std::atomic<bool> failed(false);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(numStrips), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cc = begin; cc < end && !failed; ++cc)
+    {
+      if (!decompressStrip(input + offsets[cc], strips[cc].Size,
+            output->GetPointer(firstPixels[cc] * numComps), strips[cc].NumberOfPixels))
+      {
+        failed = true;
+      }
+    }
+  });
+  return !failed;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkImageCompressor::HasStrips(vtkUnsignedCharArray* compressed)
+{
+  return compressed &&
+    compressed->GetNumberOfTuples() * compressed->GetNumberOfComponents() >=
+    static_cast<vtkIdType>(sizeof(StripsMagic) + sizeof(vtkTypeUInt32)) &&
+    memcmp(compressed->GetPointer(0), StripsMagic, sizeof(StripsMagic)) == 0;
+}
+
 //-----------------------------------------------------------------------------
 void vtkImageCompressor::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "Input:          " << this->Input << endl
      << indent << "Output:         " << this->Output << endl
-     << indent << "LossLessMode: " << this->LossLessMode << endl;
+     << indent << "LossLessMode: " << this->LossLessMode << endl
+     << indent << "UseStrips: " << this->UseStrips << endl;
 }
@@ -32,6 +32,9 @@
 #include "vtkObject.h"
 #include "vtkPVVTKExtensionsFiltersRenderingModule.h" // needed for export macro
 
+#include <functional> // for std::function
+#include <vector>     // for std::vector
+
 class vtkUnsignedCharArray;
 class vtkMultiProcessStream;
 
@@ -66,6 +69,20 @@ public:
   vtkGetMacro(LossLessMode, int);
   //@}
 
+  //@{
+  /**
+   * When set, compressors that support it split the image into strips of
+   * pixels that are compressed, and decompressed, concurrently. The strips
+   * are framed by a small header, hence the compressed data cannot be
+   * decompressed by older versions. Decompression detects the format used,
+   * hence this only affects compression. Configurations that do not specify
+   * it, as saved by older versions, do not use strips. Default is false.
+   */
+  vtkSetMacro(UseStrips, bool);
+  vtkGetMacro(UseStrips, bool);
+  vtkBooleanMacro(UseStrips, bool);
+  //@}
+
   /**
    * Call this method to compress the input and generate the compressed
    * data.
@@ -122,6 +139,31 @@ protected:
   vtkUnsignedCharArray* Input;
 
   int LossLessMode;
+  bool UseStrips;
+
+  /**
+   * Compresses the input as independent strips of pixels, concurrently, and
+   * frames the compressed strips into the output. `compressStrip` is called
+   * with the first pixel and the number of pixels of a strip and must store
+   * the compressed strip in the buffer passed in. It may be called from
+   * multiple threads at once.
+   */
+  bool CompressStrips(const std::function<bool(const unsigned char* pixels, vtkIdType numPixels,
+      std::vector<unsigned char>& compressed)>& compressStrip);
+
+  /**
+   * Decompresses strips framed by `CompressStrips` into the output.
+   * `decompressStrip` is called with the compressed strip, its size, the
+   * first pixel to decompress to and the number of pixels of the strip. It
+   * may be called from multiple threads at once.
+   */
+  bool DecompressStrips(const std::function<bool(const unsigned char* compressed, vtkIdType size,
+      unsigned char* pixels, vtkIdType numPixels)>& decompressStrip);
+
+  /**
+   * Returns true if `compressed` was generated by `CompressStrips`.
+   */
+  static bool HasStrips(vtkUnsignedCharArray* compressed);
 
   vtkSetStringMacro(Configuration);
   char* Configuration;
@@ -16,12 +16,29 @@
 
 #include "vtkMultiProcessStream.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkUnsignedCharArray.h"
 
 #include "vtk_lz4.h"
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <sstream>
 
+namespace
+{
+// Masks the lower bits of the colors. This is a simple loop that is
+// vectorized by the compiler.
+void MaskPixels(
+  const unsigned int* in, vtkIdType numPixels, unsigned int mask, unsigned int* out)
+{
+  for (vtkIdType cc = 0; cc < numPixels; ++cc)
+  {
+    out[cc] = in[cc] & mask;
+  }
+}
+}
+
 vtkStandardNewMacro(vtkLZ4Compressor);
 //----------------------------------------------------------------------------
 vtkLZ4Compressor::vtkLZ4Compressor()
@@ -54,18 +71,43 @@ int vtkLZ4Compressor::Compress()
   memcpy(&compress_mask, &compress_masks[compress_level], 4);
 
   vtkUnsignedCharArray* input = this->Input;
-  int inputSize = input->GetNumberOfTuples() * input->GetNumberOfComponents();
+  const bool masked = compress_level > 0 && input->GetNumberOfComponents() == 4;
 
-  if (this->Quality > 0 && input->GetNumberOfComponents() == 4)
+  if (this->UseStrips)
+  {
+    // masking is done per strip, while the strip is in cache.
+    return this->CompressStrips([&](const unsigned char* pixels, vtkIdType numPixels,
+             std::vector<unsigned char>& compressed) {
+      const int inputSize = static_cast<int>(numPixels * input->GetNumberOfComponents());
+      if (masked)
+      {
+        std::vector<unsigned char>& strip = this->MaskedStrips.Local();
+        strip.resize(inputSize);
+        MaskPixels(reinterpret_cast<const unsigned int*>(pixels), numPixels, compress_mask,
+          reinterpret_cast<unsigned int*>(strip.data()));
+        pixels = strip.data();
+      }
+      const int maxOutputSize = LZ4_compressBound(inputSize);
+      compressed.resize(maxOutputSize);
+      const int compressedSize = LZ4_compress_fast(reinterpret_cast<const char*>(pixels),
+        reinterpret_cast<char*>(compressed.data()), inputSize, maxOutputSize, 16);
+      compressed.resize(std::max(compressedSize, 0));
+      return compressedSize > 0 || inputSize == 0;
+    })
+      ? VTK_OK
+      : VTK_ERROR;
+  }
+
+  int inputSize = input->GetNumberOfTuples() * input->GetNumberOfComponents();
+  if (masked)
   {
     this->TemporaryBuffer->SetNumberOfComponents(input->GetNumberOfComponents());
     this->TemporaryBuffer->SetNumberOfTuples(input->GetNumberOfTuples());
     const unsigned int* in = reinterpret_cast<const unsigned int*>(input->GetPointer(0));
     unsigned int* out = reinterpret_cast<unsigned int*>(this->TemporaryBuffer->GetPointer(0));
-    for (vtkIdType cc = 0, max = this->Input->GetNumberOfTuples(); cc < max; ++cc)
-    {
-      out[cc] = in[cc] & compress_mask;
-    }
+    vtkSMPTools::For(0, input->GetNumberOfTuples(), [&](vtkIdType begin, vtkIdType end) {
+      MaskPixels(in + begin, end - begin, compress_mask, out + begin);
+    });
     input = this->TemporaryBuffer.Get();
   }
 
@@ -86,6 +128,20 @@ int vtkLZ4Compressor::Decompress()
     return VTK_ERROR;
   }
 
+  if (vtkImageCompressor::HasStrips(this->Input))
+  {
+    const int numComps = this->Output->GetNumberOfComponents();
+    return this->DecompressStrips([numComps](const unsigned char* compressed, vtkIdType size,
+             unsigned char* pixels, vtkIdType numPixels) {
+      const int decompressedSize = static_cast<int>(numPixels * numComps);
+      return LZ4_decompress_safe(reinterpret_cast<const char*>(compressed),
+               reinterpret_cast<char*>(pixels), static_cast<int>(size),
+               decompressedSize) == decompressedSize;
+    })
+      ? VTK_OK
+      : VTK_ERROR;
+  }
+
   int maxDecompressedSize =
     this->Output->GetNumberOfComponents() * this->Output->GetNumberOfTuples();
   int decompressedSize =
@@ -106,7 +162,7 @@ int vtkLZ4Compressor::Decompress()
 void vtkLZ4Compressor::SaveConfiguration(vtkMultiProcessStream* stream)
 {
   this->Superclass::SaveConfiguration(stream);
-  *stream << this->Quality;
+  *stream << this->Quality << (this->UseStrips ? 1 : 0);
 }
 
 //-----------------------------------------------------------------------------
@@ -117,6 +173,13 @@ bool vtkLZ4Compressor::RestoreConfiguration(vtkMultiProcessStream* stream)
     int quality;
     *stream >> quality;
     this->SetQuality(quality);
+    // configurations from older versions do not have this.
+    int useStrips = 0;
+    if (!stream->Empty())
+    {
+      *stream >> useStrips;
+    }
+    this->SetUseStrips(useStrips != 0);
     return true;
   }
   return false;
@@ -126,7 +189,8 @@ bool vtkLZ4Compressor::RestoreConfiguration(vtkMultiProcessStream* stream)
 const char* vtkLZ4Compressor::SaveConfiguration()
 {
   std::ostringstream oss;
-  oss << this->Superclass::SaveConfiguration() << " " << this->Quality;
+  oss << this->Superclass::SaveConfiguration() << " " << this->Quality << " "
+      << (this->UseStrips ? 1 : 0);
   this->SetConfiguration(oss.str().c_str());
   return this->Configuration;
 }
@@ -141,7 +205,10 @@ const char* vtkLZ4Compressor::RestoreConfiguration(const char* stream)
     int quality;
     iss >> quality;
     this->SetQuality(quality);
-    return stream + iss.tellg();
+    // configurations from older versions do not have this.
+    int useStrips;
+    this->SetUseStrips((iss >> useStrips) && useStrips != 0);
+    return iss.good() ? stream + iss.tellg() : stream + strlen(stream);
   }
   return nullptr;
 }
@@ -150,5 +217,5 @@ const char* vtkLZ4Compressor::RestoreConfiguration(const char* stream)
 void vtkLZ4Compressor::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
-  cout << "Quality: " << this->Quality << endl;
+  os << indent << "Quality: " << this->Quality << endl;
 }
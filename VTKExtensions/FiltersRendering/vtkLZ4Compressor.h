@@ -18,7 +18,9 @@
  * that uses LZ4 for fast lossless compression.
  *
  * vtkLZ4Compressor uses LZ4 for fast lossless compression and decompression on
- * data.
+ * data. Unless `UseStrips` is off, the image is split into strips that are
+ * compressed, and decompressed, concurrently. The configuration stream is
+ * [ClassName, LossLessMode, Quality, UseStrips].
 */
 
 #ifndef vtkLZ4Compressor_h
@@ -27,6 +29,9 @@
 #include "vtkImageCompressor.h"
 #include "vtkNew.h"                                   // needed for vtkNew
 #include "vtkPVVTKExtensionsFiltersRenderingModule.h" // needed for exports
+#include "vtkSMPThreadLocal.h"                        // needed for vtkSMPThreadLocal
+
+#include <vector> // needed for std::vector
 
 class vtkMultiProcessStream;
 
@@ -79,6 +84,8 @@ private:
 
   // Used when Quality > 1.
   vtkNew<vtkUnsignedCharArray> TemporaryBuffer;
+  // Per-thread masked strips, used when Quality > 1.
+  vtkSMPThreadLocal<std::vector<unsigned char> > MaskedStrips;
 };
 
 #endif
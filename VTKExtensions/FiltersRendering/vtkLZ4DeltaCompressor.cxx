@@ -0,0 +1,502 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkLZ4DeltaCompressor.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkLZ4DeltaCompressor.h"
+
+#include "vtkMultiProcessStream.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkUnsignedCharArray.h"
+
+#include "vtk_lz4.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+// "PVD1"
+const vtkTypeUInt32 FrameMagic = 0x31445650;
+
+// Every compressed frame starts with this header, followed by a `TileHeader`
+// for every tile that changed and then by the LZ4 compressed tiles.
+struct FrameHeader
+{
+  vtkTypeUInt32 Magic;
+  vtkTypeUInt32 Width;
+  vtkTypeUInt32 Height;
+  vtkTypeUInt32 Components;
+  vtkTypeUInt32 TileWidth;
+  vtkTypeUInt32 TileHeight;
+  // Identifier of this frame, never 0.
+  vtkTypeUInt32 FrameId;
+  // Identifier of the frame this frame is relative to, 0 for key frames.
+  vtkTypeUInt32 ReferenceId;
+  vtkTypeUInt32 NumberOfTiles;
+};
+
+struct TileHeader
+{
+  vtkTypeUInt32 Index;
+  vtkTypeUInt32 Size;
+};
+
+// Extents of a tile, in pixels.
+struct Tile
+{
+  vtkIdType X;
+  vtkIdType Y;
+  vtkIdType Width;
+  vtkIdType Height;
+
+  Tile(const FrameHeader& header, vtkIdType index)
+  {
+    const vtkIdType tilesX = (header.Width + header.TileWidth - 1) / header.TileWidth;
+    this->X = (index % tilesX) * header.TileWidth;
+    this->Y = (index / tilesX) * header.TileHeight;
+    this->Width = std::min<vtkIdType>(header.TileWidth, header.Width - this->X);
+    this->Height = std::min<vtkIdType>(header.TileHeight, header.Height - this->Y);
+  }
+};
+
+vtkIdType GetNumberOfTiles(const FrameHeader& header)
+{
+  const vtkIdType tilesX = (header.Width + header.TileWidth - 1) / header.TileWidth;
+  const vtkIdType tilesY = (header.Height + header.TileHeight - 1) / header.TileHeight;
+  return tilesX * tilesY;
+}
+}
+
+class vtkLZ4DeltaCompressor::vtkInternals
+{
+public:
+  // The last frame compressed or decompressed.
+  std::vector<unsigned char> Reference;
+  vtkTypeUInt32 Width = 0;
+  vtkTypeUInt32 Height = 0;
+  vtkTypeUInt32 Components = 0;
+  vtkTypeUInt32 FrameId = 0;
+  int FramesSinceKeyFrame = 0;
+
+  // Used when compressing, the compressed tiles.
+  std::vector<std::vector<char> > Tiles;
+  // Used when compressing with Quality > 0.
+  std::vector<unsigned char> MaskedInput;
+  // Per-thread buffer for the tiles being XOR-ed.
+  vtkSMPThreadLocal<std::vector<unsigned char> > Scratch;
+
+  void Reset()
+  {
+    this->Reference.clear();
+    this->Width = this->Height = this->Components = 0;
+    this->FrameId = 0;
+    this->FramesSinceKeyFrame = 0;
+  }
+
+  vtkTypeUInt32 NextFrameId() const
+  {
+    return this->FrameId == VTK_TYPE_UINT32_MAX ? 1 : this->FrameId + 1;
+  }
+};
+
+vtkStandardNewMacro(vtkLZ4DeltaCompressor);
+//----------------------------------------------------------------------------
+vtkLZ4DeltaCompressor::vtkLZ4DeltaCompressor()
+  : Quality(3)
+  , TileSize(64)
+  , KeyFrameInterval(60)
+  , ImageWidth(0)
+  , ImageHeight(0)
+  , Internals(new vtkLZ4DeltaCompressor::vtkInternals())
+{
+}
+
+//----------------------------------------------------------------------------
+vtkLZ4DeltaCompressor::~vtkLZ4DeltaCompressor() = default;
+
+//----------------------------------------------------------------------------
+void vtkLZ4DeltaCompressor::Reset()
+{
+  this->Internals->Reset();
+}
+
+//----------------------------------------------------------------------------
+void vtkLZ4DeltaCompressor::SetImageResolution(int width, int height)
+{
+  this->ImageWidth = width;
+  this->ImageHeight = height;
+}
+
+//----------------------------------------------------------------------------
+int vtkLZ4DeltaCompressor::Compress()
+{
+  if (!(this->Input && this->Output))
+  {
+    vtkWarningMacro("Cannot compress, empty input or output detected.");
+    return VTK_ERROR;
+  }
+
+  auto& internals = *this->Internals;
+  vtkUnsignedCharArray* input = this->Input;
+  const int numComps = input->GetNumberOfComponents();
+  const vtkIdType numPixels = input->GetNumberOfTuples();
+
+  FrameHeader header;
+  header.Magic = FrameMagic;
+  header.Components = static_cast<vtkTypeUInt32>(numComps);
+  if (this->ImageWidth > 0 && this->ImageHeight > 0 &&
+    static_cast<vtkIdType>(this->ImageWidth) * this->ImageHeight == numPixels)
+  {
+    header.Width = static_cast<vtkTypeUInt32>(this->ImageWidth);
+    header.Height = static_cast<vtkTypeUInt32>(this->ImageHeight);
+    header.TileWidth = header.TileHeight = static_cast<vtkTypeUInt32>(this->TileSize);
+  }
+  else
+  {
+    // resolution is unknown, treat the image as a single row.
+    header.Width = static_cast<vtkTypeUInt32>(numPixels);
+    header.Height = 1;
+    header.TileWidth = static_cast<vtkTypeUInt32>(this->TileSize * this->TileSize);
+    header.TileHeight = 1;
+  }
+
+  const unsigned char* current = input->GetPointer(0);
+  if (!this->LossLessMode && this->Quality > 0 && numComps == 4)
+  {
+    unsigned char compress_masks[6][4] = { { 0xFF, 0xFF, 0xFF, 0xFF }, { 0xFE, 0xFF, 0xFE, 0xFE },
+      { 0xFC, 0xFE, 0xFC, 0xFC }, { 0xF8, 0xFC, 0xF8, 0xF8 }, { 0xF0, 0xF8, 0xF0, 0xF0 },
+      { 0xE0, 0xF0, 0xE0, 0xE0 } };
+    unsigned int compress_mask;
+    memcpy(&compress_mask, &compress_masks[this->Quality], 4);
+
+    internals.MaskedInput.resize(static_cast<size_t>(numPixels) * 4);
+    const unsigned int* in = reinterpret_cast<const unsigned int*>(current);
+    unsigned int* out = reinterpret_cast<unsigned int*>(internals.MaskedInput.data());
+    vtkSMPTools::For(0, numPixels, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType cc = begin; cc < end; ++cc)
+      {
+        out[cc] = in[cc] & compress_mask;
+      }
+    });
+    current = internals.MaskedInput.data();
+  }
+
+  const bool keyFrame = internals.Width != header.Width || internals.Height != header.Height ||
+    internals.Components != header.Components ||
+    (this->KeyFrameInterval > 0 && internals.FramesSinceKeyFrame >= this->KeyFrameInterval);
+  if (keyFrame)
+  {
+    internals.Reference.resize(static_cast<size_t>(numPixels) * numComps);
+    internals.Width = header.Width;
+    internals.Height = header.Height;
+    internals.Components = header.Components;
+    internals.FramesSinceKeyFrame = 0;
+  }
+  header.ReferenceId = keyFrame ? 0 : internals.FrameId;
+  header.FrameId = internals.NextFrameId();
+
+  // Compare each tile with the previous frame and compress the ones that
+  // changed. Tiles do not overlap, hence the reference frame is updated in
+  // place.
+  const vtkIdType numTiles = GetNumberOfTiles(header);
+  internals.Tiles.resize(static_cast<size_t>(numTiles));
+  unsigned char* reference = internals.Reference.data();
+  std::atomic<bool> failed(false);
+  vtkSMPTools::For(0, numTiles, [&](vtkIdType begin, vtkIdType end) {
+    std::vector<unsigned char>& scratch = internals.Scratch.Local();
+    for (vtkIdType index = begin; index < end; ++index)
+    {
+      const Tile tile(header, index);
+      const size_t rowSize = static_cast<size_t>(tile.Width) * numComps;
+      std::vector<char>& encoded = internals.Tiles[index];
+      encoded.clear();
+
+      bool dirty = keyFrame;
+      for (vtkIdType row = 0; row < tile.Height && !dirty; ++row)
+      {
+        const size_t offset = ((tile.Y + row) * header.Width + tile.X) * numComps;
+        dirty = memcmp(current + offset, reference + offset, rowSize) != 0;
+      }
+      if (!dirty)
+      {
+        continue;
+      }
+
+      scratch.resize(rowSize * tile.Height);
+      for (vtkIdType row = 0; row < tile.Height; ++row)
+      {
+        const size_t offset = ((tile.Y + row) * header.Width + tile.X) * numComps;
+        unsigned char* delta = scratch.data() + row * rowSize;
+        if (keyFrame)
+        {
+          memcpy(delta, current + offset, rowSize);
+        }
+        else
+        {
+          for (size_t cc = 0; cc < rowSize; ++cc)
+          {
+            delta[cc] = current[offset + cc] ^ reference[offset + cc];
+          }
+        }
+        memcpy(reference + offset, current + offset, rowSize);
+      }
+
+      const int inputSize = static_cast<int>(scratch.size());
+      const int maxOutputSize = LZ4_compressBound(inputSize);
+      encoded.resize(static_cast<size_t>(maxOutputSize));
+      const int compressedSize = LZ4_compress_fast(reinterpret_cast<const char*>(scratch.data()),
+        encoded.data(), inputSize, maxOutputSize, 16);
+      if (compressedSize <= 0)
+      {
+        failed = true;
+      }
+      encoded.resize(static_cast<size_t>(std::max(compressedSize, 0)));
+    }
+  });
+
+  if (failed)
+  {
+    // the reference frame is only partially updated.
+    internals.Reset();
+    return VTK_ERROR;
+  }
+
+  std::vector<TileHeader> tileHeaders;
+  size_t outputSize = sizeof(FrameHeader);
+  for (vtkIdType index = 0; index < numTiles; ++index)
+  {
+    const auto& encoded = internals.Tiles[index];
+    if (!encoded.empty())
+    {
+      TileHeader tileHeader;
+      tileHeader.Index = static_cast<vtkTypeUInt32>(index);
+      tileHeader.Size = static_cast<vtkTypeUInt32>(encoded.size());
+      tileHeaders.push_back(tileHeader);
+      outputSize += sizeof(TileHeader) + encoded.size();
+    }
+  }
+  header.NumberOfTiles = static_cast<vtkTypeUInt32>(tileHeaders.size());
+
+  this->Output->SetNumberOfComponents(1);
+  this->Output->SetNumberOfTuples(static_cast<vtkIdType>(outputSize));
+  unsigned char* output = this->Output->GetPointer(0);
+  memcpy(output, &header, sizeof(FrameHeader));
+  output += sizeof(FrameHeader);
+  if (!tileHeaders.empty())
+  {
+    memcpy(output, tileHeaders.data(), tileHeaders.size() * sizeof(TileHeader));
+    output += tileHeaders.size() * sizeof(TileHeader);
+  }
+  for (const auto& tileHeader : tileHeaders)
+  {
+    const auto& encoded = internals.Tiles[tileHeader.Index];
+    memcpy(output, encoded.data(), encoded.size());
+    output += encoded.size();
+  }
+
+  internals.FrameId = header.FrameId;
+  internals.FramesSinceKeyFrame++;
+  return VTK_OK;
+}
+
+//----------------------------------------------------------------------------
+int vtkLZ4DeltaCompressor::Decompress()
+{
+  if (!(this->Input && this->Output))
+  {
+    vtkWarningMacro("Cannot decompress, empty input or output detected.");
+    return VTK_ERROR;
+  }
+
+  auto& internals = *this->Internals;
+  const unsigned char* input = this->Input->GetPointer(0);
+  const size_t inputSize =
+    static_cast<size_t>(this->Input->GetNumberOfTuples()) * this->Input->GetNumberOfComponents();
+
+  FrameHeader header;
+  if (inputSize < sizeof(FrameHeader))
+  {
+    vtkErrorMacro("Invalid compressed frame.");
+    return VTK_ERROR;
+  }
+  memcpy(&header, input, sizeof(FrameHeader));
+  if (header.Magic != FrameMagic || header.TileWidth == 0 || header.TileHeight == 0 ||
+    inputSize < sizeof(FrameHeader) + header.NumberOfTiles * sizeof(TileHeader))
+  {
+    vtkErrorMacro("Invalid compressed frame.");
+    return VTK_ERROR;
+  }
+
+  const size_t frameSize = static_cast<size_t>(header.Width) * header.Height * header.Components;
+  if (static_cast<size_t>(this->Output->GetNumberOfTuples()) *
+      this->Output->GetNumberOfComponents() !=
+    frameSize)
+  {
+    vtkErrorMacro("Output size does not match the compressed frame.");
+    return VTK_ERROR;
+  }
+
+  const bool keyFrame = header.ReferenceId == 0;
+  if (keyFrame)
+  {
+    internals.Reference.resize(frameSize);
+    internals.Width = header.Width;
+    internals.Height = header.Height;
+    internals.Components = header.Components;
+  }
+  else if (header.ReferenceId != internals.FrameId || internals.Width != header.Width ||
+    internals.Height != header.Height || internals.Components != header.Components)
+  {
+    vtkErrorMacro("Cannot decompress frame " << header.FrameId << ", frame " << header.ReferenceId
+                                             << " it depends on is not available.");
+    return VTK_ERROR;
+  }
+
+  std::vector<TileHeader> tileHeaders(header.NumberOfTiles);
+  std::vector<size_t> offsets(header.NumberOfTiles);
+  if (!tileHeaders.empty())
+  {
+    memcpy(tileHeaders.data(), input + sizeof(FrameHeader),
+      tileHeaders.size() * sizeof(TileHeader));
+  }
+  const vtkIdType numTiles = GetNumberOfTiles(header);
+  size_t offset = sizeof(FrameHeader) + tileHeaders.size() * sizeof(TileHeader);
+  for (size_t cc = 0; cc < tileHeaders.size(); ++cc)
+  {
+    if (tileHeaders[cc].Index >= numTiles)
+    {
+      vtkErrorMacro("Invalid compressed frame.");
+      return VTK_ERROR;
+    }
+    offsets[cc] = offset;
+    offset += tileHeaders[cc].Size;
+  }
+  if (offset > inputSize)
+  {
+    vtkErrorMacro("Invalid compressed frame.");
+    return VTK_ERROR;
+  }
+
+  const size_t numComps = header.Components;
+  unsigned char* reference = internals.Reference.data();
+  std::atomic<bool> failed(false);
+  const vtkIdType numDirtyTiles = static_cast<vtkIdType>(tileHeaders.size());
+  vtkSMPTools::For(0, numDirtyTiles, [&](vtkIdType begin, vtkIdType end) {
+    std::vector<unsigned char>& scratch = internals.Scratch.Local();
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      const Tile tile(header, tileHeaders[cc].Index);
+      const size_t rowSize = static_cast<size_t>(tile.Width) * numComps;
+      scratch.resize(rowSize * tile.Height);
+      const int decompressedSize =
+        LZ4_decompress_safe(reinterpret_cast<const char*>(input + offsets[cc]),
+          reinterpret_cast<char*>(scratch.data()), static_cast<int>(tileHeaders[cc].Size),
+          static_cast<int>(scratch.size()));
+      if (decompressedSize != static_cast<int>(scratch.size()))
+      {
+        failed = true;
+        continue;
+      }
+
+      for (vtkIdType row = 0; row < tile.Height; ++row)
+      {
+        unsigned char* target = reference + ((tile.Y + row) * header.Width + tile.X) * numComps;
+        const unsigned char* delta = scratch.data() + row * rowSize;
+        if (keyFrame)
+        {
+          memcpy(target, delta, rowSize);
+        }
+        else
+        {
+          for (size_t kk = 0; kk < rowSize; ++kk)
+          {
+            target[kk] ^= delta[kk];
+          }
+        }
+      }
+    }
+  });
+
+  if (failed)
+  {
+    // the reference frame is only partially updated.
+    internals.Reset();
+    vtkErrorMacro("Failed to decompress frame " << header.FrameId << ".");
+    return VTK_ERROR;
+  }
+
+  internals.FrameId = header.FrameId;
+  if (frameSize > 0)
+  {
+    memcpy(this->Output->GetPointer(0), reference, frameSize);
+  }
+  return VTK_OK;
+}
+
+//-----------------------------------------------------------------------------
+void vtkLZ4DeltaCompressor::SaveConfiguration(vtkMultiProcessStream* stream)
+{
+  this->Superclass::SaveConfiguration(stream);
+  *stream << this->Quality;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkLZ4DeltaCompressor::RestoreConfiguration(vtkMultiProcessStream* stream)
+{
+  if (this->Superclass::RestoreConfiguration(stream))
+  {
+    int quality;
+    *stream >> quality;
+    this->SetQuality(quality);
+    return true;
+  }
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+const char* vtkLZ4DeltaCompressor::SaveConfiguration()
+{
+  std::ostringstream oss;
+  oss << this->Superclass::SaveConfiguration() << " " << this->Quality;
+  this->SetConfiguration(oss.str().c_str());
+  return this->Configuration;
+}
+
+//-----------------------------------------------------------------------------
+const char* vtkLZ4DeltaCompressor::RestoreConfiguration(const char* stream)
+{
+  stream = this->Superclass::RestoreConfiguration(stream);
+  if (stream)
+  {
+    std::istringstream iss(stream);
+    int quality;
+    iss >> quality;
+    this->SetQuality(quality);
+    return stream + iss.tellg();
+  }
+  return nullptr;
+}
+
+//----------------------------------------------------------------------------
+void vtkLZ4DeltaCompressor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Quality: " << this->Quality << endl;
+  os << indent << "TileSize: " << this->TileSize << endl;
+  os << indent << "KeyFrameInterval: " << this->KeyFrameInterval << endl;
+}
@@ -0,0 +1,135 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkLZ4DeltaCompressor.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkLZ4DeltaCompressor
+ * @brief   Image compressor/decompressor
+ * that only transfers the parts of a frame that changed.
+ *
+ * vtkLZ4DeltaCompressor splits images into square tiles and compares each tile
+ * with the same tile in the previous frame. Unchanged tiles are skipped while
+ * the changed ones are XOR-ed against the previous frame and compressed using
+ * LZ4. Tiles are compressed, and decompressed, concurrently using vtkSMPTools.
+ * During interaction, only small parts of the rendered image typically change
+ * between consecutive frames, hence this results in significantly smaller
+ * payloads than compressing each frame independently.
+ *
+ * Unlike the other image compressors, vtkLZ4DeltaCompressor is stateful: the
+ * compressing and the decompressing instances each keep the last frame and
+ * all compressed frames must be decompressed in order. Every frame records the
+ * frame it is relative to, hence a frame that cannot be decompressed is
+ * reported as an error. A key frame, i.e. a frame that does not depend on the
+ * previous one, is generated when the image size changes and every
+ * `KeyFrameInterval` frames, so that the decompressor can recover.
+ *
+ * Like vtkLZ4Compressor, `Quality` values greater than 0 mask the lower bits
+ * of the colors, unless in loss-less mode.
+ */
+
+#ifndef vtkLZ4DeltaCompressor_h
+#define vtkLZ4DeltaCompressor_h
+
+#include "vtkImageCompressor.h"
+#include "vtkPVVTKExtensionsFiltersRenderingModule.h" // needed for exports
+
+#include <memory> // for std::unique_ptr
+
+class vtkMultiProcessStream;
+
+class VTKPVVTKEXTENSIONSFILTERSRENDERING_EXPORT vtkLZ4DeltaCompressor : public vtkImageCompressor
+{
+public:
+  static vtkLZ4DeltaCompressor* New();
+  vtkTypeMacro(vtkLZ4DeltaCompressor, vtkImageCompressor);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Set the quality measure. The value can be between 0 and 5. 0 means preserve
+   * input image quality while 5 means improve compression at the cost of image
+   * quality. Same as vtkLZ4Compressor::SetQuality.
+   */
+  vtkSetClampMacro(Quality, int, 0, 5);
+  vtkGetMacro(Quality, int);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the width and height, in pixels, of the tiles compared with the
+   * previous frame. Smaller tiles skip more unchanged pixels at the cost of
+   * more per-tile overhead. Only used when compressing. Default is 64.
+   */
+  vtkSetClampMacro(TileSize, int, 8, 1024);
+  vtkGetMacro(TileSize, int);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the number of frames after which a key frame is generated. 0
+   * means key frames are only generated when the image size changes. Only
+   * used when compressing. Default is 60.
+   */
+  vtkSetClampMacro(KeyFrameInterval, int, 0, VTK_INT_MAX);
+  vtkGetMacro(KeyFrameInterval, int);
+  //@}
+
+  /**
+   * Forget the previous frame. The next compressed frame will be a key frame.
+   */
+  void Reset();
+
+  //@{
+  /**
+   * Compress/Decompress data array on the objects input with results
+   * in the objects output. See also Set/GetInput/Output.
+   */
+  int Compress() override;
+  int Decompress() override;
+  //@}
+
+  /**
+   * Communicates the next expected image resolution. This is used to
+   * determine the tiles.
+   */
+  void SetImageResolution(int width, int height) override;
+
+  //@{
+  /**
+   * Serialize/Restore compressor configuration (but not the data) into the stream.
+   */
+  void SaveConfiguration(vtkMultiProcessStream* stream) override;
+  bool RestoreConfiguration(vtkMultiProcessStream* stream) override;
+  const char* SaveConfiguration() override;
+  const char* RestoreConfiguration(const char* stream) override;
+  //@}
+
+protected:
+  vtkLZ4DeltaCompressor();
+  ~vtkLZ4DeltaCompressor() override;
+
+  int Quality;
+  int TileSize;
+  int KeyFrameInterval;
+  int ImageWidth;
+  int ImageHeight;
+
+private:
+  vtkLZ4DeltaCompressor(const vtkLZ4DeltaCompressor&) = delete;
+  void operator=(const vtkLZ4DeltaCompressor&) = delete;
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+};
+
+#endif
@@ -16,21 +16,19 @@
 
 #include "vtkAllToNRedistributeCompositePolyData.h"
 #include "vtkCellData.h"
-#include "vtkCharArray.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkDataObjectTypes.h"
-#include "vtkGenericDataObjectReader.h"
-#include "vtkGenericDataObjectWriter.h"
-#include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMPIMToNSocketConnection.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiProcessController.h"
 #include "vtkMultiProcessControllerHelper.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkOutlineFilter.h"
 #include "vtkPVConfig.h"
+#include "vtkPVDataObjectMarshaller.h"
 #include "vtkPVLogger.h"
 #include "vtkPVSession.h"
 #include "vtkPointData.h"
@@ -41,10 +39,6 @@
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTimerLog.h"
 
-#include "vtk_zlib.h"
-#include <sstream>
-#include <vector>
-
 #include <vector>
 
 bool vtkMPIMoveData::UseZLibCompression = false;
@@ -949,69 +943,21 @@ void vtkMPIMoveData::ClearBuffer()
 //-----------------------------------------------------------------------------
 void vtkMPIMoveData::MarshalDataToBuffer(vtkDataObject* data)
 {
-  vtkImageData* imageData = vtkImageData::SafeDownCast(data);
-
-  // Protect from empty data.
-  if (data->GetNumberOfElements(vtkDataObject::POINT) == 0 &&
-    data->GetNumberOfElements(vtkDataObject::VERTEX) == 0)
-  {
-    this->NumberOfBuffers = 0;
-  }
-
-  // Copy input to isolate reader from the pipeline.
-  vtkDataWriter* writer = vtkGenericDataObjectWriter::New();
-  writer->SetInputData(data);
-  if (imageData)
+  vtkNew<vtkPVDataObjectMarshaller> marshaller;
+  if (vtkMPIMoveData::UseZLibCompression)
   {
-    // We add the image extents to the header, since the writer doesn't preserve
-    // the extents.
-    int* extent = imageData->GetExtent();
-    double* origin = imageData->GetOrigin();
-    std::ostringstream stream;
-    stream << "EXTENT " << extent[0] << " " << extent[1] << " " << extent[2] << " " << extent[3]
-           << " " << extent[4] << " " << extent[5];
-    stream << " ORIGIN " << origin[0] << " " << origin[1] << " " << origin[2];
-    writer->SetHeader(stream.str().c_str());
+    marshaller->SetCompressionToZLib();
   }
 
-  writer->SetFileTypeToBinary();
-  writer->WriteToOutputStringOn();
-  writer->Write();
-
-  char* buffer = nullptr;
   vtkIdType buffer_length = 0;
-
-  if (vtkMPIMoveData::UseZLibCompression)
+  char* buffer = marshaller->Marshal(data, buffer_length);
+  if (!buffer)
   {
-    vtkTimerLog::MarkStartEvent("Zlib compress");
-    // Use z-lib compression.
-    uLongf out_size = compressBound(writer->GetOutputStringLength());
-    buffer = new char[out_size + 8];
-    memcpy(buffer, "zlib0000", 8);
-
-    compress2(reinterpret_cast<Bytef*>(buffer + 8), &out_size,
-      reinterpret_cast<const Bytef*>(writer->GetOutputString()), writer->GetOutputStringLength(),
-      /* compression_level */ Z_DEFAULT_COMPRESSION);
-    vtkTimerLog::MarkEndEvent("Zlib compress");
-    int in_size = static_cast<int>(writer->GetOutputStringLength());
-    for (int cc = 0; cc < 4; cc++)
-    {
-      // the first 4 bytes in the header are "zlib" which helps the receiver
-      // identify that zlib compression has been used.
-      // the next 4 bytes are the original length since zlib doesn't provide
-      // that to the receiver.
-      buffer[4 + cc] = (in_size & 0x0ff);
-      in_size = in_size >> 8;
-    }
-    buffer_length = out_size + 8;
-  }
-  else
-  {
-    buffer_length = writer->GetOutputStringLength();
-    buffer = writer->RegisterAndGetOutputString();
+    vtkErrorMacro("Failed to marshal data.");
+    this->NumberOfBuffers = 0;
+    return;
   }
 
-  // Get string.
   this->NumberOfBuffers = 1;
   this->BufferLengths = new vtkIdType[1];
   this->BufferLengths[0] = buffer_length;
@@ -1019,9 +965,6 @@ void vtkMPIMoveData::MarshalDataToBuffer(vtkDataObject* data)
   this->BufferOffsets[0] = 0;
   this->Buffers = buffer;
   this->BufferTotalLength = this->BufferLengths[0];
-
-  writer->Delete();
-  writer = nullptr;
 }
 
 //-----------------------------------------------------------------------------
@@ -1033,86 +976,20 @@ void vtkMPIMoveData::ReconstructDataFromBuffer(vtkDataObject* data)
     return;
   }
 
-  bool is_image_data = data->IsA("vtkImageData") != 0;
+  vtkNew<vtkPVDataObjectMarshaller> marshaller;
   std::vector<vtkSmartPointer<vtkDataObject> > pieces;
-
   for (int idx = 0; idx < this->NumberOfBuffers; ++idx)
   {
-    char* bufferArray = this->Buffers + this->BufferOffsets[idx];
-    vtkIdType bufferLength = this->BufferLengths[idx];
-
-    char* realBuffer = nullptr;
-    if (bufferLength > 4 && strncmp(bufferArray, "zlib", 4) == 0)
-    {
-      // sender used zlib compression. Decompress it.
-      vtkIdType compressed_length = bufferLength - 8; // remove the zlib header.
-      vtkIdType uncompressed_length = 0;
-      for (int cc = 0; cc < 4; cc++)
-      {
-        uncompressed_length = uncompressed_length | ((0xff & (bufferArray[4 + cc])) << 8 * cc);
-      }
-
-      // using zlib compression.
-      realBuffer = new char[uncompressed_length];
-      uLongf destLen = uncompressed_length;
-      vtkTimerLog::MarkStartEvent("Zlib uncompress");
-      uncompress(reinterpret_cast<Bytef*>(realBuffer), &destLen,
-        reinterpret_cast<const Bytef*>(bufferArray + 8), compressed_length);
-      vtkTimerLog::MarkEndEvent("Zlib uncompress");
-
-      bufferArray = realBuffer;
-      bufferLength = uncompressed_length;
-    }
-
-    // Setup a reader.
-    vtkDataReader* reader = vtkGenericDataObjectReader::New();
-    reader->ReadFromInputStringOn();
-
-    vtkCharArray* mystring = vtkCharArray::New();
-    mystring->SetArray(bufferArray, bufferLength, 1);
-    reader->SetInputArray(mystring);
-    reader->Modified(); // For append loop
-    reader->Update();
-
-    if (is_image_data)
+    vtkSmartPointer<vtkDataObject> piece = marshaller->Unmarshal(
+      this->Buffers + this->BufferOffsets[idx], this->BufferLengths[idx]);
+    if (piece)
     {
-      // FIXME: EXTENT and ORIGIN in vtkImageData are lost by reader/writer.
-      // The header hack we used isn't going to work for composite datasets. We
-      // need a more intrusive fix in the reader/writer itself.
-      int extent[6] = { 0, 0, 0, 0, 0, 0 };
-      float origin[3] = { 0, 0, 0 };
-      int values_read = sscanf(reader->GetHeader(), "EXTENT %d %d %d %d %d %d ORIGIN %f %f %f",
-        &extent[0], &extent[1], &extent[2], &extent[3], &extent[4], &extent[5], &origin[0],
-        &origin[1], &origin[2]);
-      if (values_read != 9)
-      {
-        vtkWarningMacro("EXTENT and ORIGIN may not have been read correctly.");
-      }
-      vtkImageData* clone =
-        vtkImageData::SafeDownCast(reader->GetOutputDataObject(0)->NewInstance());
-      clone->ShallowCopy(reader->GetOutputDataObject(0));
-      clone->SetOrigin(origin[0], origin[1], origin[2]);
-      clone->SetExtent(extent);
       // reconstructing data distributted on MPI node, so global ids are valid
       // global ids attributes are removed when appending data so we set
       // the active global ids attribute to nullptr which keeps the global ids array.
-      unsetGlobalIdsAttribute(clone);
-      pieces.push_back(clone);
-      clone->Delete();
-    }
-    else
-    {
-      vtkDataObject* output = reader->GetOutputDataObject(0);
-      // reconstructing data distributted on MPI node, so global ids are valid
-      unsetGlobalIdsAttribute(output);
-      pieces.push_back(output);
+      unsetGlobalIdsAttribute(piece);
+      pieces.push_back(piece);
     }
-    mystring->Delete();
-    mystring = nullptr;
-    reader->Delete();
-    reader = nullptr;
-    delete[] realBuffer;
-    realBuffer = nullptr;
   }
 
   vtkMPIMoveDataMerge(pieces, data);
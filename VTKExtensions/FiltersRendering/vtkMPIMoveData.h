@@ -105,9 +105,10 @@ public:
 
   //@{
   /**
-   * When set to true, zlib compression is used. False by default.
-   * This value has any effect only on the data-sender processes. The receiver
-   * always checks the received data to see if zlib decompression is required.
+   * The data is marshalled using vtkPVDataObjectMarshaller which compresses
+   * large arrays using LZ4. When set to true, zlib compression is used instead.
+   * False by default. This value has any effect only on the data-sender
+   * processes. The receiver always checks how the received data was encoded.
    */
   static void SetUseZLibCompression(bool b);
   static bool GetUseZLibCompression();
@@ -0,0 +1,1298 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVDataObjectMarshaller.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVDataObjectMarshaller.h"
+
+#include "vtkByteSwap.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCharArray.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataObjectTypes.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkFieldData.h"
+#include "vtkGenericDataObjectReader.h"
+#include "vtkGenericDataObjectWriter.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiProcessStream.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPartitionedDataSet.h"
+#include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
+#include "vtkStringArray.h"
+#include "vtkStructuredGrid.h"
+#include "vtkTable.h"
+#include "vtkTimerLog.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include "vtk_lz4.h"
+#include "vtk_zlib.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <climits>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+// A marshalled buffer is laid out as follows:
+//
+//   magic (7 bytes) | byte order of the sender, 'L' or 'B' (1 byte)
+//   table length (8 bytes) | structure length (8 bytes)
+//   table | structure | payloads
+//
+// The structure describes the data object and refers to the payloads in
+// order. The table describes how each payload is split into chunks and how
+// each of these chunks is encoded. Both are serialized with
+// vtkMultiProcessStream which takes care of the byte order; the payloads are
+// swapped, if needed, once decoded.
+const char Magic[] = "vtkPVDO";
+const size_t MagicLength = 7;
+const size_t HeaderLength = MagicLength + 1 + 2 * 8;
+const size_t ChunkSize = 4 * 1024 * 1024;
+// vtkMultiProcessStream sizes its raw data with an unsigned int, which bounds
+// the size of the table and of the structure.
+const size_t MaximumStreamLength = UINT_MAX;
+// Bounds on what a valid buffer describes, so that sizes computed from the
+// values read cannot overflow.
+const vtkTypeUInt64 MaximumPayloadSize = vtkTypeUInt64(1) << 56;
+const int MaximumElementSize = 16;
+
+enum ChunkEncodings
+{
+  RAW_CHUNK = 0,
+  LZ4_CHUNK = 1,
+  ZLIB_CHUNK = 2
+};
+
+enum ObjectKinds
+{
+  NULL_OBJECT = 0,
+  NATIVE_OBJECT = 1,
+  LEGACY_OBJECT = 2
+};
+
+enum ArrayKinds
+{
+  DATA_ARRAY = 0,
+  STRING_ARRAY = 1
+};
+
+//----------------------------------------------------------------------------
+char GetByteOrder()
+{
+  const vtkTypeUInt16 probe = 1;
+  return *reinterpret_cast<const unsigned char*>(&probe) == 1 ? 'L' : 'B';
+}
+
+//----------------------------------------------------------------------------
+void EncodeLength(char* buffer, vtkTypeUInt64 value)
+{
+  for (int cc = 0; cc < 8; ++cc)
+  {
+    buffer[cc] = static_cast<char>(value & 0x0ff);
+    value = value >> 8;
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 DecodeLength(const char* buffer)
+{
+  vtkTypeUInt64 value = 0;
+  for (int cc = 0; cc < 8; ++cc)
+  {
+    value |= static_cast<vtkTypeUInt64>(static_cast<unsigned char>(buffer[cc])) << (8 * cc);
+  }
+  return value;
+}
+
+//----------------------------------------------------------------------------
+bool IsNativeType(int type)
+{
+  switch (type)
+  {
+    case VTK_POLY_DATA:
+    case VTK_UNSTRUCTURED_GRID:
+    case VTK_IMAGE_DATA:
+    case VTK_UNIFORM_GRID:
+    case VTK_STRUCTURED_POINTS:
+    case VTK_RECTILINEAR_GRID:
+    case VTK_STRUCTURED_GRID:
+    case VTK_TABLE:
+    case VTK_MULTIBLOCK_DATA_SET:
+    case VTK_MULTIPIECE_DATA_SET:
+    case VTK_PARTITIONED_DATA_SET:
+      return true;
+    default:
+      return false;
+  }
+}
+
+//----------------------------------------------------------------------------
+// Returns the fixed-size type to use to receive values of the given type when
+// the size of the type differs between the sender and the receiver.
+int GetFixedSizeType(int dataType, int elementSize)
+{
+  const bool isUnsigned = (dataType == VTK_UNSIGNED_LONG);
+  switch (elementSize)
+  {
+    case 4:
+      return isUnsigned ? VTK_TYPE_UINT32 : VTK_TYPE_INT32;
+    case 8:
+      return isUnsigned ? VTK_TYPE_UINT64 : VTK_TYPE_INT64;
+    default:
+      return VTK_VOID;
+  }
+}
+
+//----------------------------------------------------------------------------
+class MarshalWriter
+{
+public:
+  MarshalWriter(int compression, vtkIdType threshold)
+    : Compression(compression)
+    , Threshold(static_cast<size_t>(threshold))
+  {
+  }
+
+  void WriteObject(vtkDataObject* data);
+  char* Finalize(vtkIdType& length);
+
+private:
+  struct Payload
+  {
+    Payload(const char* data, size_t size, int elementSize)
+      : Data(data)
+      , Size(size)
+      , ElementSize(elementSize)
+    {
+    }
+    const char* Data;
+    size_t Size;
+    int ElementSize;
+  };
+
+  struct Chunk
+  {
+    Chunk(size_t payloadIndex, size_t offset, size_t size)
+      : PayloadIndex(payloadIndex)
+      , Offset(offset)
+      , Size(size)
+      , Encoding(RAW_CHUNK)
+    {
+    }
+    size_t PayloadIndex;
+    size_t Offset;
+    size_t Size;
+    unsigned char Encoding;
+    std::vector<char> Encoded;
+  };
+
+  static bool IsSupported(vtkAbstractArray* array)
+  {
+    return vtkDataArray::SafeDownCast(array) || vtkStringArray::SafeDownCast(array);
+  }
+
+  void WriteFieldData(vtkFieldData* fd);
+  void WriteArray(vtkAbstractArray* array);
+  void WriteOptionalArray(vtkAbstractArray* array);
+  void WritePoints(vtkPoints* points);
+  void WriteCells(vtkCellArray* cells);
+  void WriteExtent(const int extent[6]);
+  void WriteChildName(vtkInformation* metaData);
+  void Encode(Chunk& chunk) const;
+
+  int Compression;
+  size_t Threshold;
+  vtkMultiProcessStream Structure;
+  std::vector<Payload> Payloads;
+
+  // Objects and buffers referenced by the payloads.
+  std::vector<vtkSmartPointer<vtkObjectBase> > Holds;
+  std::vector<std::unique_ptr<std::vector<char> > > Buffers;
+};
+
+//----------------------------------------------------------------------------
+void MarshalWriter::WriteObject(vtkDataObject* data)
+{
+  if (!data)
+  {
+    this->Structure << static_cast<unsigned char>(NULL_OBJECT);
+    return;
+  }
+
+  const int type = data->GetDataObjectType();
+  if (!IsNativeType(type))
+  {
+    vtkNew<vtkGenericDataObjectWriter> writer;
+    writer->SetInputData(data);
+    writer->SetFileTypeToBinary();
+    writer->WriteToOutputStringOn();
+    writer->Write();
+    this->Structure << static_cast<unsigned char>(LEGACY_OBJECT) << type;
+    this->Payloads.emplace_back(
+      writer->GetOutputString(), static_cast<size_t>(writer->GetOutputStringLength()), 1);
+    this->Holds.push_back(writer.GetPointer());
+    return;
+  }
+
+  this->Structure << static_cast<unsigned char>(NATIVE_OBJECT) << type;
+  this->WriteFieldData(data->GetFieldData());
+  if (auto ds = vtkDataSet::SafeDownCast(data))
+  {
+    this->WriteFieldData(ds->GetPointData());
+    this->WriteFieldData(ds->GetCellData());
+  }
+
+  if (auto id = vtkImageData::SafeDownCast(data))
+  {
+    this->WriteExtent(id->GetExtent());
+    const double* origin = id->GetOrigin();
+    const double* spacing = id->GetSpacing();
+    this->Structure << origin[0] << origin[1] << origin[2] << spacing[0] << spacing[1]
+                    << spacing[2];
+  }
+  else if (auto rg = vtkRectilinearGrid::SafeDownCast(data))
+  {
+    this->WriteExtent(rg->GetExtent());
+    this->WriteOptionalArray(rg->GetXCoordinates());
+    this->WriteOptionalArray(rg->GetYCoordinates());
+    this->WriteOptionalArray(rg->GetZCoordinates());
+  }
+  else if (auto sg = vtkStructuredGrid::SafeDownCast(data))
+  {
+    this->WriteExtent(sg->GetExtent());
+    this->WritePoints(sg->GetPoints());
+  }
+  else if (auto pd = vtkPolyData::SafeDownCast(data))
+  {
+    this->WritePoints(pd->GetPoints());
+    this->WriteCells(pd->GetVerts());
+    this->WriteCells(pd->GetLines());
+    this->WriteCells(pd->GetPolys());
+    this->WriteCells(pd->GetStrips());
+  }
+  else if (auto ug = vtkUnstructuredGrid::SafeDownCast(data))
+  {
+    this->WritePoints(ug->GetPoints());
+    this->WriteOptionalArray(ug->GetCellTypesArray());
+    this->WriteCells(ug->GetCells());
+    this->WriteOptionalArray(ug->GetFaceLocations());
+    this->WriteOptionalArray(ug->GetFaces());
+  }
+  else if (auto table = vtkTable::SafeDownCast(data))
+  {
+    this->WriteFieldData(table->GetRowData());
+  }
+  else if (auto mb = vtkMultiBlockDataSet::SafeDownCast(data))
+  {
+    const unsigned int numBlocks = mb->GetNumberOfBlocks();
+    this->Structure << numBlocks;
+    for (unsigned int cc = 0; cc < numBlocks; ++cc)
+    {
+      this->WriteChildName(mb->HasMetaData(cc) ? mb->GetMetaData(cc) : nullptr);
+      this->WriteObject(mb->GetBlock(cc));
+    }
+  }
+  else if (auto pds = vtkPartitionedDataSet::SafeDownCast(data))
+  {
+    const unsigned int numPartitions = pds->GetNumberOfPartitions();
+    this->Structure << numPartitions;
+    for (unsigned int cc = 0; cc < numPartitions; ++cc)
+    {
+      this->WriteChildName(pds->HasMetaData(cc) ? pds->GetMetaData(cc) : nullptr);
+      this->WriteObject(pds->GetPartitionAsDataObject(cc));
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void MarshalWriter::WriteFieldData(vtkFieldData* fd)
+{
+  auto dsa = vtkDataSetAttributes::SafeDownCast(fd);
+  const int numArrays = fd ? fd->GetNumberOfArrays() : 0;
+  int numSupportedArrays = 0;
+  for (int cc = 0; cc < numArrays; ++cc)
+  {
+    numSupportedArrays += IsSupported(fd->GetAbstractArray(cc)) ? 1 : 0;
+  }
+
+  this->Structure << numSupportedArrays;
+  for (int cc = 0; cc < numArrays; ++cc)
+  {
+    vtkAbstractArray* array = fd->GetAbstractArray(cc);
+    if (IsSupported(array))
+    {
+      this->WriteArray(array);
+      this->Structure << (dsa ? dsa->IsArrayAnAttribute(cc) : -1);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void MarshalWriter::WriteArray(vtkAbstractArray* array)
+{
+  auto sa = vtkStringArray::SafeDownCast(array);
+  auto da = vtkDataArray::SafeDownCast(array);
+  assert(sa != nullptr || da != nullptr);
+
+  const int numComponents = array->GetNumberOfComponents();
+  const vtkIdType numValues = array->GetNumberOfValues();
+  const int elementSize = da ? std::max(da->GetDataTypeSize(), 1) : 1;
+  this->Structure << static_cast<unsigned char>(sa ? STRING_ARRAY : DATA_ARRAY)
+                  << array->GetDataType() << elementSize << numComponents
+                  << static_cast<vtkTypeInt64>(array->GetNumberOfTuples())
+                  << (array->GetName() ? 1 : 0)
+                  << std::string(array->GetName() ? array->GetName() : "");
+
+  const int numComponentNames = array->HasAComponentName() ? numComponents : 0;
+  this->Structure << numComponentNames;
+  for (int cc = 0; cc < numComponentNames; ++cc)
+  {
+    const char* name = array->GetComponentName(cc);
+    this->Structure << std::string(name ? name : "");
+  }
+
+  if (sa)
+  {
+    // strings are sent null-terminated, one after the other.
+    std::unique_ptr<std::vector<char> > buffer(new std::vector<char>());
+    for (vtkIdType cc = 0; cc < numValues; ++cc)
+    {
+      const vtkStdString& value = sa->GetValue(cc);
+      buffer->insert(buffer->end(), value.begin(), value.end());
+      buffer->push_back('\0');
+    }
+    this->Payloads.emplace_back(buffer->data(), buffer->size(), 1);
+    this->Buffers.push_back(std::move(buffer));
+    return;
+  }
+
+  if (!da->HasStandardMemoryLayout())
+  {
+    // copy arrays using a different memory layout, such as
+    // vtkSOADataArrayTemplate, into a contiguous array.
+    vtkSmartPointer<vtkDataArray> copy;
+    copy.TakeReference(vtkDataArray::CreateDataArray(da->GetDataType()));
+    copy->DeepCopy(da);
+    this->Holds.push_back(copy);
+    da = copy;
+  }
+
+  const size_t size = da->GetDataType() == VTK_BIT
+    ? static_cast<size_t>((numValues + 7) / 8)
+    : static_cast<size_t>(numValues) * static_cast<size_t>(elementSize);
+  this->Payloads.emplace_back(
+    size > 0 ? static_cast<const char*>(da->GetVoidPointer(0)) : nullptr, size, elementSize);
+}
+
+//----------------------------------------------------------------------------
+void MarshalWriter::WriteOptionalArray(vtkAbstractArray* array)
+{
+  this->Structure << (array ? 1 : 0);
+  if (array)
+  {
+    this->WriteArray(array);
+  }
+}
+
+//----------------------------------------------------------------------------
+void MarshalWriter::WritePoints(vtkPoints* points)
+{
+  this->WriteOptionalArray(points ? points->GetData() : nullptr);
+}
+
+//----------------------------------------------------------------------------
+void MarshalWriter::WriteCells(vtkCellArray* cells)
+{
+  this->Structure << (cells ? 1 : 0);
+  if (cells)
+  {
+    this->WriteArray(cells->GetOffsetsArray());
+    this->WriteArray(cells->GetConnectivityArray());
+  }
+}
+
+//----------------------------------------------------------------------------
+void MarshalWriter::WriteExtent(const int extent[6])
+{
+  for (int cc = 0; cc < 6; ++cc)
+  {
+    this->Structure << extent[cc];
+  }
+}
+
+//----------------------------------------------------------------------------
+void MarshalWriter::WriteChildName(vtkInformation* metaData)
+{
+  const char* name = (metaData && metaData->Has(vtkCompositeDataSet::NAME()))
+    ? metaData->Get(vtkCompositeDataSet::NAME())
+    : nullptr;
+  this->Structure << (name ? 1 : 0) << std::string(name ? name : "");
+}
+
+//----------------------------------------------------------------------------
+void MarshalWriter::Encode(Chunk& chunk) const
+{
+  const Payload& payload = this->Payloads[chunk.PayloadIndex];
+  const char* source = payload.Data + chunk.Offset;
+  if (this->Compression == vtkPVDataObjectMarshaller::LZ4)
+  {
+    const int bound = LZ4_compressBound(static_cast<int>(chunk.Size));
+    chunk.Encoded.resize(static_cast<size_t>(bound));
+    const int encodedSize = LZ4_compress_default(
+      source, chunk.Encoded.data(), static_cast<int>(chunk.Size), bound);
+    if (encodedSize > 0 && static_cast<size_t>(encodedSize) < chunk.Size)
+    {
+      chunk.Encoding = LZ4_CHUNK;
+      chunk.Encoded.resize(static_cast<size_t>(encodedSize));
+      return;
+    }
+  }
+  else if (this->Compression == vtkPVDataObjectMarshaller::ZLIB)
+  {
+    uLongf encodedSize = compressBound(static_cast<uLong>(chunk.Size));
+    chunk.Encoded.resize(static_cast<size_t>(encodedSize));
+    if (compress2(reinterpret_cast<Bytef*>(chunk.Encoded.data()), &encodedSize,
+          reinterpret_cast<const Bytef*>(source), static_cast<uLong>(chunk.Size),
+          Z_DEFAULT_COMPRESSION) == Z_OK &&
+      static_cast<size_t>(encodedSize) < chunk.Size)
+    {
+      chunk.Encoding = ZLIB_CHUNK;
+      chunk.Encoded.resize(static_cast<size_t>(encodedSize));
+      return;
+    }
+  }
+
+  // not worth compressing, the chunk is copied from the payload as-is.
+  chunk.Encoding = RAW_CHUNK;
+  std::vector<char>().swap(chunk.Encoded);
+}
+
+//----------------------------------------------------------------------------
+char* MarshalWriter::Finalize(vtkIdType& length)
+{
+  std::vector<Chunk> chunks;
+  for (size_t cc = 0; cc < this->Payloads.size(); ++cc)
+  {
+    for (size_t offset = 0; offset < this->Payloads[cc].Size; offset += ChunkSize)
+    {
+      chunks.emplace_back(cc, offset, std::min(ChunkSize, this->Payloads[cc].Size - offset));
+    }
+  }
+
+  if (this->Compression != vtkPVDataObjectMarshaller::NONE)
+  {
+    vtkTimerLog::MarkStartEvent("vtkPVDataObjectMarshaller::Compress");
+    vtkSMPTools::For(0, static_cast<vtkIdType>(chunks.size()), [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType cc = begin; cc < end; ++cc)
+      {
+        if (this->Payloads[chunks[cc].PayloadIndex].Size >= this->Threshold)
+        {
+          this->Encode(chunks[cc]);
+        }
+      }
+    });
+    vtkTimerLog::MarkEndEvent("vtkPVDataObjectMarshaller::Compress");
+  }
+
+  vtkMultiProcessStream table;
+  table << static_cast<vtkTypeUInt64>(this->Payloads.size());
+  std::vector<size_t> chunkOffsets(chunks.size());
+  size_t payloadsLength = 0;
+  for (size_t cc = 0, chunkIdx = 0; cc < this->Payloads.size(); ++cc)
+  {
+    const Payload& payload = this->Payloads[cc];
+    table << static_cast<vtkTypeUInt64>(payload.Size) << payload.ElementSize;
+    for (; chunkIdx < chunks.size() && chunks[chunkIdx].PayloadIndex == cc; ++chunkIdx)
+    {
+      const Chunk& chunk = chunks[chunkIdx];
+      const size_t encodedSize = chunk.Encoding == RAW_CHUNK ? chunk.Size : chunk.Encoded.size();
+      table << chunk.Encoding << static_cast<vtkTypeUInt64>(encodedSize);
+      chunkOffsets[chunkIdx] = payloadsLength;
+      payloadsLength += encodedSize;
+    }
+  }
+
+  std::vector<unsigned char> tableData, structureData;
+  table.GetRawData(tableData);
+  this->Structure.GetRawData(structureData);
+  if (tableData.size() > MaximumStreamLength || structureData.size() > MaximumStreamLength)
+  {
+    length = 0;
+    return nullptr;
+  }
+
+  const size_t totalLength =
+    HeaderLength + tableData.size() + structureData.size() + payloadsLength;
+  char* buffer = new char[totalLength];
+  std::copy(Magic, Magic + MagicLength, buffer);
+  buffer[MagicLength] = GetByteOrder();
+  EncodeLength(buffer + MagicLength + 1, tableData.size());
+  EncodeLength(buffer + MagicLength + 9, structureData.size());
+  char* cursor = buffer + HeaderLength;
+  cursor = std::copy(tableData.begin(), tableData.end(), cursor);
+  cursor = std::copy(structureData.begin(), structureData.end(), cursor);
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(chunks.size()), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      const Chunk& chunk = chunks[cc];
+      if (chunk.Encoding == RAW_CHUNK)
+      {
+        const char* source = this->Payloads[chunk.PayloadIndex].Data + chunk.Offset;
+        std::copy(source, source + chunk.Size, cursor + chunkOffsets[cc]);
+      }
+      else
+      {
+        std::copy(chunk.Encoded.begin(), chunk.Encoded.end(), cursor + chunkOffsets[cc]);
+      }
+    }
+  });
+
+  length = static_cast<vtkIdType>(totalLength);
+  return buffer;
+}
+
+//----------------------------------------------------------------------------
+class MarshalReader
+{
+public:
+  MarshalReader(const char* buffer, size_t length)
+    : Buffer(buffer)
+    , Length(length)
+    , StructureLength(0)
+    , NextPayload(0)
+    , Swap(false)
+  {
+  }
+
+  bool Read(vtkSmartPointer<vtkDataObject>& result);
+
+private:
+  struct Chunk
+  {
+    Chunk(unsigned char encoding, size_t offset, size_t encodedSize, size_t size)
+      : Encoding(encoding)
+      , Offset(offset)
+      , EncodedSize(encodedSize)
+      , Size(size)
+    {
+    }
+    unsigned char Encoding;
+    size_t Offset;
+    size_t EncodedSize;
+    size_t Size;
+  };
+
+  struct Payload
+  {
+    Payload(size_t size, int elementSize)
+      : Size(size)
+      , ElementSize(elementSize)
+      , Destination(nullptr)
+    {
+    }
+    size_t Size;
+    int ElementSize;
+    char* Destination;
+    std::vector<Chunk> Chunks;
+  };
+
+  using Setter = std::function<void(vtkDataObject*)>;
+
+  bool ReadTable(const char* data, size_t length, size_t payloadsOffset);
+  bool ReadObject(const Setter& setter);
+  bool ReadFieldData(vtkFieldData* fd);
+  bool ReadArray(vtkSmartPointer<vtkAbstractArray>& array);
+  bool ReadOptionalArray(vtkSmartPointer<vtkAbstractArray>& array);
+  bool ReadPoints(vtkPointSet* ps);
+  bool ReadCells(const std::function<void(vtkCellArray*)>& setter);
+  bool ReadExtent(int extent[6]);
+  bool ReadChildName(vtkInformation* metaData);
+  bool Bind(char* destination, size_t size);
+  bool Decode();
+
+  const char* Buffer;
+  size_t Length;
+  vtkMultiProcessStream Structure;
+  size_t StructureLength;
+  std::vector<Payload> Payloads;
+  size_t NextPayload;
+  bool Swap;
+
+  // Steps that need the decoded payloads, executed in order once the payloads
+  // have been decoded.
+  std::vector<std::function<bool()> > Finalizers;
+};
+
+//----------------------------------------------------------------------------
+bool MarshalReader::Read(vtkSmartPointer<vtkDataObject>& result)
+{
+  if (!vtkPVDataObjectMarshaller::IsMarshalledBuffer(
+        this->Buffer, static_cast<vtkIdType>(this->Length)))
+  {
+    return false;
+  }
+
+  this->Swap = (this->Buffer[MagicLength] != GetByteOrder());
+  const vtkTypeUInt64 tableLength = DecodeLength(this->Buffer + MagicLength + 1);
+  const vtkTypeUInt64 structureLength = DecodeLength(this->Buffer + MagicLength + 9);
+  if (tableLength > MaximumStreamLength || structureLength > MaximumStreamLength ||
+    tableLength + structureLength > this->Length - HeaderLength)
+  {
+    return false;
+  }
+  this->StructureLength = static_cast<size_t>(structureLength);
+
+  const char* tableData = this->Buffer + HeaderLength;
+  const char* structureData = tableData + tableLength;
+  if (!this->ReadTable(tableData, static_cast<size_t>(tableLength),
+        static_cast<size_t>(HeaderLength + tableLength + structureLength)))
+  {
+    return false;
+  }
+
+  this->Structure.SetRawData(reinterpret_cast<const unsigned char*>(structureData),
+    static_cast<unsigned int>(structureLength));
+  if (!this->ReadObject([&result](vtkDataObject* data) { result = data; }) ||
+    this->NextPayload != this->Payloads.size() || !this->Decode())
+  {
+    result = nullptr;
+    return false;
+  }
+
+  for (const auto& finalizer : this->Finalizers)
+  {
+    if (!finalizer())
+    {
+      result = nullptr;
+      return false;
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool MarshalReader::ReadTable(const char* data, size_t length, size_t payloadsOffset)
+{
+  vtkMultiProcessStream table;
+  table.SetRawData(reinterpret_cast<const unsigned char*>(data), static_cast<unsigned int>(length));
+
+  // Every payload and chunk takes at least one byte of the table, and every
+  // chunk at least one byte of the buffer, which bounds the counts read.
+  vtkTypeUInt64 numPayloads = 0;
+  table >> numPayloads;
+  if (numPayloads > length)
+  {
+    return false;
+  }
+  size_t offset = payloadsOffset;
+  for (vtkTypeUInt64 cc = 0; cc < numPayloads; ++cc)
+  {
+    vtkTypeUInt64 size;
+    int elementSize;
+    table >> size >> elementSize;
+    if (elementSize < 1 || elementSize > MaximumElementSize || size > MaximumPayloadSize ||
+      size / ChunkSize >= this->Length)
+    {
+      return false;
+    }
+    this->Payloads.emplace_back(static_cast<size_t>(size), elementSize);
+    Payload& payload = this->Payloads.back();
+    for (size_t chunkOffset = 0; chunkOffset < payload.Size; chunkOffset += ChunkSize)
+    {
+      unsigned char encoding;
+      vtkTypeUInt64 encodedSize;
+      table >> encoding >> encodedSize;
+      if (encodedSize == 0 || encodedSize > this->Length - offset || encodedSize > INT_MAX)
+      {
+        return false;
+      }
+      payload.Chunks.emplace_back(encoding, offset, static_cast<size_t>(encodedSize),
+        std::min(ChunkSize, payload.Size - chunkOffset));
+      offset += static_cast<size_t>(encodedSize);
+    }
+  }
+  return offset <= this->Length;
+}
+
+//----------------------------------------------------------------------------
+bool MarshalReader::Bind(char* destination, size_t size)
+{
+  if (this->NextPayload >= this->Payloads.size() ||
+    this->Payloads[this->NextPayload].Size != size || (size > 0 && destination == nullptr))
+  {
+    return false;
+  }
+  this->Payloads[this->NextPayload++].Destination = destination;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool MarshalReader::Decode()
+{
+  std::vector<std::pair<const Payload*, size_t> > chunks;
+  for (const auto& payload : this->Payloads)
+  {
+    for (size_t cc = 0; cc < payload.Chunks.size(); ++cc)
+    {
+      chunks.emplace_back(&payload, cc);
+    }
+  }
+
+  std::atomic<bool> failed(false);
+  vtkTimerLog::MarkStartEvent("vtkPVDataObjectMarshaller::Decompress");
+  vtkSMPTools::For(0, static_cast<vtkIdType>(chunks.size()), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cc = begin; cc < end && !failed; ++cc)
+    {
+      const Payload& payload = *chunks[cc].first;
+      const Chunk& chunk = payload.Chunks[chunks[cc].second];
+      const char* source = this->Buffer + chunk.Offset;
+      char* destination = payload.Destination + chunks[cc].second * ChunkSize;
+      bool valid = false;
+      switch (chunk.Encoding)
+      {
+        case RAW_CHUNK:
+          valid = (chunk.EncodedSize == chunk.Size);
+          if (valid)
+          {
+            std::copy(source, source + chunk.Size, destination);
+          }
+          break;
+
+        case LZ4_CHUNK:
+          valid = LZ4_decompress_safe(source, destination, static_cast<int>(chunk.EncodedSize),
+                    static_cast<int>(chunk.Size)) == static_cast<int>(chunk.Size);
+          break;
+
+        case ZLIB_CHUNK:
+        {
+          uLongf destLength = static_cast<uLongf>(chunk.Size);
+          valid = uncompress(reinterpret_cast<Bytef*>(destination), &destLength,
+                    reinterpret_cast<const Bytef*>(source),
+                    static_cast<uLong>(chunk.EncodedSize)) == Z_OK &&
+            destLength == chunk.Size;
+        }
+        break;
+
+        default:
+          break;
+      }
+      if (!valid)
+      {
+        failed = true;
+      }
+    }
+  });
+  vtkTimerLog::MarkEndEvent("vtkPVDataObjectMarshaller::Decompress");
+
+  if (!failed && this->Swap)
+  {
+    vtkSMPTools::For(0, static_cast<vtkIdType>(this->Payloads.size()),
+      [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType cc = begin; cc < end; ++cc)
+        {
+          const Payload& payload = this->Payloads[cc];
+          if (payload.ElementSize > 1 && payload.Size > 0)
+          {
+            vtkByteSwap::SwapVoidRange(
+              payload.Destination, payload.Size / payload.ElementSize, payload.ElementSize);
+          }
+        }
+      });
+  }
+  return !failed;
+}
+
+//----------------------------------------------------------------------------
+bool MarshalReader::ReadObject(const Setter& setter)
+{
+  unsigned char kind;
+  this->Structure >> kind;
+  if (kind == NULL_OBJECT)
+  {
+    setter(nullptr);
+    return true;
+  }
+
+  int type;
+  this->Structure >> type;
+  if (kind == LEGACY_OBJECT)
+  {
+    if (this->NextPayload >= this->Payloads.size())
+    {
+      return false;
+    }
+    auto buffer = std::make_shared<std::vector<char> >(this->Payloads[this->NextPayload].Size);
+    if (!this->Bind(buffer->data(), buffer->size()))
+    {
+      return false;
+    }
+    this->Finalizers.push_back([buffer, setter]() {
+      vtkNew<vtkCharArray> string;
+      string->SetArray(buffer->data(), static_cast<vtkIdType>(buffer->size()), 1);
+      vtkNew<vtkGenericDataObjectReader> reader;
+      reader->ReadFromInputStringOn();
+      reader->SetInputArray(string);
+      reader->Update();
+      setter(reader->GetOutputDataObject(0));
+      return true;
+    });
+    return true;
+  }
+
+  vtkSmartPointer<vtkDataObject> data;
+  data.TakeReference(vtkDataObjectTypes::NewDataObject(type));
+  if (kind != NATIVE_OBJECT || !IsNativeType(type) || !data)
+  {
+    return false;
+  }
+
+  if (!this->ReadFieldData(data->GetFieldData()))
+  {
+    return false;
+  }
+  if (auto ds = vtkDataSet::SafeDownCast(data))
+  {
+    if (!this->ReadFieldData(ds->GetPointData()) || !this->ReadFieldData(ds->GetCellData()))
+    {
+      return false;
+    }
+  }
+
+  bool status = true;
+  if (auto id = vtkImageData::SafeDownCast(data))
+  {
+    int extent[6];
+    double origin[3], spacing[3];
+    status = this->ReadExtent(extent);
+    this->Structure >> origin[0] >> origin[1] >> origin[2] >> spacing[0] >> spacing[1] >>
+      spacing[2];
+    id->SetExtent(extent);
+    id->SetOrigin(origin);
+    id->SetSpacing(spacing);
+  }
+  else if (auto rg = vtkRectilinearGrid::SafeDownCast(data))
+  {
+    int extent[6];
+    vtkSmartPointer<vtkAbstractArray> coords[3];
+    status = this->ReadExtent(extent) && this->ReadOptionalArray(coords[0]) &&
+      this->ReadOptionalArray(coords[1]) && this->ReadOptionalArray(coords[2]);
+    rg->SetExtent(extent);
+    rg->SetXCoordinates(vtkDataArray::SafeDownCast(coords[0]));
+    rg->SetYCoordinates(vtkDataArray::SafeDownCast(coords[1]));
+    rg->SetZCoordinates(vtkDataArray::SafeDownCast(coords[2]));
+  }
+  else if (auto sg = vtkStructuredGrid::SafeDownCast(data))
+  {
+    int extent[6];
+    status = this->ReadExtent(extent) && this->ReadPoints(sg);
+    sg->SetExtent(extent);
+  }
+  else if (auto pd = vtkPolyData::SafeDownCast(data))
+  {
+    vtkSmartPointer<vtkPolyData> pdRef(pd);
+    status = this->ReadPoints(pd) &&
+      this->ReadCells([pdRef](vtkCellArray* cells) { pdRef->SetVerts(cells); }) &&
+      this->ReadCells([pdRef](vtkCellArray* cells) { pdRef->SetLines(cells); }) &&
+      this->ReadCells([pdRef](vtkCellArray* cells) { pdRef->SetPolys(cells); }) &&
+      this->ReadCells([pdRef](vtkCellArray* cells) { pdRef->SetStrips(cells); });
+  }
+  else if (auto ug = vtkUnstructuredGrid::SafeDownCast(data))
+  {
+    vtkSmartPointer<vtkUnstructuredGrid> ugRef(ug);
+    vtkSmartPointer<vtkAbstractArray> types, faceLocations, faces;
+    auto cellsHolder = std::make_shared<vtkSmartPointer<vtkCellArray> >();
+    status = this->ReadPoints(ug) && this->ReadOptionalArray(types) &&
+      this->ReadCells([cellsHolder](vtkCellArray* cells) { *cellsHolder = cells; }) &&
+      this->ReadOptionalArray(faceLocations) && this->ReadOptionalArray(faces);
+    if (status)
+    {
+      this->Finalizers.push_back([=]() {
+        auto typesArray = vtkUnsignedCharArray::SafeDownCast(types);
+        if (typesArray && *cellsHolder)
+        {
+          ugRef->SetCells(typesArray, *cellsHolder, vtkIdTypeArray::SafeDownCast(faceLocations),
+            vtkIdTypeArray::SafeDownCast(faces));
+        }
+        return true;
+      });
+    }
+  }
+  else if (auto table = vtkTable::SafeDownCast(data))
+  {
+    status = this->ReadFieldData(table->GetRowData());
+  }
+  else if (auto mb = vtkMultiBlockDataSet::SafeDownCast(data))
+  {
+    vtkSmartPointer<vtkMultiBlockDataSet> mbRef(mb);
+    unsigned int numBlocks;
+    this->Structure >> numBlocks;
+    if (numBlocks > this->StructureLength)
+    {
+      return false;
+    }
+    mb->SetNumberOfBlocks(numBlocks);
+    for (unsigned int cc = 0; status && cc < numBlocks; ++cc)
+    {
+      status = this->ReadChildName(mb->GetMetaData(cc)) &&
+        this->ReadObject([mbRef, cc](vtkDataObject* block) { mbRef->SetBlock(cc, block); });
+    }
+  }
+  else if (auto pds = vtkPartitionedDataSet::SafeDownCast(data))
+  {
+    vtkSmartPointer<vtkPartitionedDataSet> pdsRef(pds);
+    unsigned int numPartitions;
+    this->Structure >> numPartitions;
+    if (numPartitions > this->StructureLength)
+    {
+      return false;
+    }
+    pds->SetNumberOfPartitions(numPartitions);
+    for (unsigned int cc = 0; status && cc < numPartitions; ++cc)
+    {
+      status = this->ReadChildName(pds->GetMetaData(cc)) &&
+        this->ReadObject(
+          [pdsRef, cc](vtkDataObject* partition) { pdsRef->SetPartition(cc, partition); });
+    }
+  }
+
+  if (status)
+  {
+    setter(data);
+  }
+  return status;
+}
+
+//----------------------------------------------------------------------------
+bool MarshalReader::ReadFieldData(vtkFieldData* fd)
+{
+  auto dsa = vtkDataSetAttributes::SafeDownCast(fd);
+  int numArrays;
+  this->Structure >> numArrays;
+  if (numArrays < 0 || static_cast<size_t>(numArrays) > this->StructureLength)
+  {
+    return false;
+  }
+  for (int cc = 0; cc < numArrays; ++cc)
+  {
+    vtkSmartPointer<vtkAbstractArray> array;
+    int attributeType;
+    if (!this->ReadArray(array))
+    {
+      return false;
+    }
+    this->Structure >> attributeType;
+    const int index = fd->AddArray(array);
+    if (dsa && attributeType >= 0 && index >= 0)
+    {
+      dsa->SetActiveAttribute(index, attributeType);
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool MarshalReader::ReadArray(vtkSmartPointer<vtkAbstractArray>& array)
+{
+  unsigned char kind;
+  int dataType, elementSize, numComponents, hasName, numComponentNames;
+  vtkTypeInt64 numTuples;
+  std::string name;
+  this->Structure >> kind >> dataType >> elementSize >> numComponents >> numTuples >> hasName >>
+    name >> numComponentNames;
+  if (numComponents < 1 || numTuples < 0 || numComponentNames < 0 ||
+    numComponentNames > numComponents || this->NextPayload >= this->Payloads.size())
+  {
+    return false;
+  }
+
+  // Check the number of values against the size of the payload they are read
+  // from before allocating the array. Every value takes at least a bit, and
+  // every string at least a byte.
+  const vtkTypeUInt64 payloadSize = this->Payloads[this->NextPayload].Size;
+  const vtkTypeUInt64 tuplesRead = static_cast<vtkTypeUInt64>(numTuples);
+  if (tuplesRead > payloadSize * 8 / static_cast<vtkTypeUInt64>(numComponents))
+  {
+    return false;
+  }
+  const vtkTypeUInt64 valuesRead = tuplesRead * static_cast<vtkTypeUInt64>(numComponents);
+  bool validSize;
+  if (kind == STRING_ARRAY)
+  {
+    validSize = valuesRead <= payloadSize;
+  }
+  else if (dataType == VTK_BIT)
+  {
+    validSize = (valuesRead + 7) / 8 == payloadSize;
+  }
+  else
+  {
+    validSize = elementSize <= MaximumElementSize &&
+      valuesRead * static_cast<vtkTypeUInt64>(elementSize) == payloadSize;
+  }
+  if (!validSize)
+  {
+    return false;
+  }
+
+  if (kind == STRING_ARRAY)
+  {
+    array = vtkSmartPointer<vtkStringArray>::New();
+  }
+  else
+  {
+    array.TakeReference(vtkDataArray::CreateDataArray(dataType));
+  }
+  if (!array)
+  {
+    return false;
+  }
+
+  array->SetNumberOfComponents(numComponents);
+  array->SetName(hasName ? name.c_str() : nullptr);
+  for (int cc = 0; cc < numComponentNames; ++cc)
+  {
+    std::string componentName;
+    this->Structure >> componentName;
+    array->SetComponentName(cc, componentName.c_str());
+  }
+  array->SetNumberOfTuples(static_cast<vtkIdType>(numTuples));
+  const vtkIdType numValues = array->GetNumberOfValues();
+
+  if (auto sa = vtkStringArray::SafeDownCast(array))
+  {
+    if (this->NextPayload >= this->Payloads.size())
+    {
+      return false;
+    }
+    auto buffer = std::make_shared<std::vector<char> >(this->Payloads[this->NextPayload].Size);
+    vtkSmartPointer<vtkStringArray> saRef(sa);
+    this->Finalizers.push_back([buffer, saRef, numValues]() {
+      const char* cursor = buffer->data();
+      const char* end = cursor + buffer->size();
+      for (vtkIdType cc = 0; cc < numValues; ++cc)
+      {
+        const char* next = std::find(cursor, end, '\0');
+        if (next == end)
+        {
+          return false;
+        }
+        saRef->SetValue(cc, vtkStdString(cursor, next - cursor));
+        cursor = next + 1;
+      }
+      return true;
+    });
+    return this->Bind(buffer->data(), buffer->size());
+  }
+
+  auto da = vtkDataArray::SafeDownCast(array);
+  if (dataType == VTK_BIT)
+  {
+    return this->Bind(numValues > 0 ? static_cast<char*>(da->GetVoidPointer(0)) : nullptr,
+      static_cast<size_t>((numValues + 7) / 8));
+  }
+  if (da->GetDataTypeSize() == elementSize)
+  {
+    return this->Bind(numValues > 0 ? static_cast<char*>(da->GetVoidPointer(0)) : nullptr,
+      static_cast<size_t>(numValues) * static_cast<size_t>(elementSize));
+  }
+
+  // The size of the type differs between the sender and this process, as is
+  // the case for `vtkIdType` or `long` on some platforms. Receive the values
+  // in an array of the sender's size and convert them once decoded.
+  vtkSmartPointer<vtkDataArray> received;
+  received.TakeReference(vtkDataArray::CreateDataArray(GetFixedSizeType(dataType, elementSize)));
+  if (!received)
+  {
+    return false;
+  }
+  received->SetNumberOfComponents(numComponents);
+  received->SetNumberOfTuples(static_cast<vtkIdType>(numTuples));
+  vtkSmartPointer<vtkDataArray> daRef(da);
+  this->Finalizers.push_back([received, daRef]() {
+    daRef->InsertTuples(0, received->GetNumberOfTuples(), 0, received);
+    return true;
+  });
+  return this->Bind(numValues > 0 ? static_cast<char*>(received->GetVoidPointer(0)) : nullptr,
+    static_cast<size_t>(numValues) * static_cast<size_t>(elementSize));
+}
+
+//----------------------------------------------------------------------------
+bool MarshalReader::ReadOptionalArray(vtkSmartPointer<vtkAbstractArray>& array)
+{
+  int hasArray;
+  this->Structure >> hasArray;
+  return hasArray ? this->ReadArray(array) : true;
+}
+
+//----------------------------------------------------------------------------
+bool MarshalReader::ReadPoints(vtkPointSet* ps)
+{
+  vtkSmartPointer<vtkAbstractArray> array;
+  if (!this->ReadOptionalArray(array))
+  {
+    return false;
+  }
+  if (auto da = vtkDataArray::SafeDownCast(array))
+  {
+    vtkNew<vtkPoints> points;
+    points->SetData(da);
+    ps->SetPoints(points);
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool MarshalReader::ReadCells(const std::function<void(vtkCellArray*)>& setter)
+{
+  int hasCells;
+  this->Structure >> hasCells;
+  if (!hasCells)
+  {
+    return true;
+  }
+
+  vtkSmartPointer<vtkAbstractArray> offsets, connectivity;
+  if (!this->ReadArray(offsets) || !this->ReadArray(connectivity))
+  {
+    return false;
+  }
+
+  // vtkCellArray may copy the arrays it is given, hence it can only be set up
+  // once the payloads have been decoded.
+  this->Finalizers.push_back([offsets, connectivity, setter]() {
+    vtkNew<vtkCellArray> cells;
+    if (!cells->SetData(
+          vtkDataArray::SafeDownCast(offsets), vtkDataArray::SafeDownCast(connectivity)))
+    {
+      return false;
+    }
+    setter(cells);
+    return true;
+  });
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool MarshalReader::ReadExtent(int extent[6])
+{
+  for (int cc = 0; cc < 6; ++cc)
+  {
+    this->Structure >> extent[cc];
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool MarshalReader::ReadChildName(vtkInformation* metaData)
+{
+  int hasName;
+  std::string name;
+  this->Structure >> hasName >> name;
+  if (hasName)
+  {
+    metaData->Set(vtkCompositeDataSet::NAME(), name.c_str());
+  }
+  return true;
+}
+}
+
+vtkStandardNewMacro(vtkPVDataObjectMarshaller);
+//----------------------------------------------------------------------------
+vtkPVDataObjectMarshaller::vtkPVDataObjectMarshaller()
+  : Compression(vtkPVDataObjectMarshaller::LZ4)
+  , CompressionThreshold(64 * 1024)
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPVDataObjectMarshaller::~vtkPVDataObjectMarshaller() = default;
+
+//----------------------------------------------------------------------------
+char* vtkPVDataObjectMarshaller::Marshal(vtkDataObject* data, vtkIdType& length)
+{
+  vtkTimerLog::MarkStartEvent("vtkPVDataObjectMarshaller::Marshal");
+  MarshalWriter writer(this->Compression, this->CompressionThreshold);
+  writer.WriteObject(data);
+  char* buffer = writer.Finalize(length);
+  vtkTimerLog::MarkEndEvent("vtkPVDataObjectMarshaller::Marshal");
+  return buffer;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVDataObjectMarshaller::Marshal(vtkDataObject* data, vtkCharArray* buffer)
+{
+  vtkIdType length = 0;
+  char* raw = this->Marshal(data, length);
+  if (!raw)
+  {
+    return false;
+  }
+  buffer->SetNumberOfComponents(1);
+  buffer->SetArray(raw, length, 0, vtkCharArray::VTK_DATA_ARRAY_DELETE);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkPVDataObjectMarshaller::Unmarshal(
+  const char* buffer, vtkIdType length)
+{
+  vtkTimerLog::MarkStartEvent("vtkPVDataObjectMarshaller::Unmarshal");
+  vtkSmartPointer<vtkDataObject> result;
+  MarshalReader reader(buffer, static_cast<size_t>(length));
+  if (!reader.Read(result))
+  {
+    vtkErrorMacro("Failed to unmarshal data object.");
+  }
+  vtkTimerLog::MarkEndEvent("vtkPVDataObjectMarshaller::Unmarshal");
+  return result;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkPVDataObjectMarshaller::Unmarshal(vtkCharArray* buffer)
+{
+  return buffer ? this->Unmarshal(buffer->GetPointer(0), buffer->GetNumberOfValues()) : nullptr;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVDataObjectMarshaller::IsMarshalledBuffer(const char* buffer, vtkIdType length)
+{
+  return buffer != nullptr && length >= static_cast<vtkIdType>(HeaderLength) &&
+    std::equal(Magic, Magic + MagicLength, buffer) &&
+    (buffer[MagicLength] == 'L' || buffer[MagicLength] == 'B');
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataObjectMarshaller::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Compression: " << this->Compression << endl;
+  os << indent << "CompressionThreshold: " << this->CompressionThreshold << endl;
+}
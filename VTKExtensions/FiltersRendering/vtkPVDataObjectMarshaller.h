@@ -0,0 +1,126 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVDataObjectMarshaller.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class vtkPVDataObjectMarshaller
+ * @brief marshals data objects to and from a compact binary buffer.
+ *
+ * vtkPVDataObjectMarshaller is used by vtkMPIMoveData and
+ * vtkClientServerMoveData to serialize the data being delivered between
+ * processes. Unlike the legacy VTK writer and reader, the array buffers are
+ * copied as-is: the buffer consists of a small description of the data object
+ * followed by the raw array payloads. Hence, no text is generated or parsed.
+ *
+ * Array payloads are split into fixed-size chunks which are compressed, and
+ * decompressed, concurrently using vtkSMPTools. Payloads smaller than
+ * `CompressionThreshold` bytes are left uncompressed since compressing them is
+ * rarely worth the overhead. Chunks that do not compress are stored as-is too.
+ *
+ * vtkPolyData, vtkUnstructuredGrid, vtkImageData (and subclasses),
+ * vtkRectilinearGrid, vtkStructuredGrid, vtkTable, vtkMultiBlockDataSet and
+ * vtkPartitionedDataSet (and subclasses) are marshalled natively. Other data
+ * objects are marshalled using vtkGenericDataObjectWriter, with the resulting
+ * string being handled as a payload.
+ *
+ * The buffer records the byte order of the sender, hence it can be
+ * unmarshalled on a process with a different byte order, or with a different
+ * size for `vtkIdType`.
+ */
+
+#ifndef vtkPVDataObjectMarshaller_h
+#define vtkPVDataObjectMarshaller_h
+
+#include "vtkObject.h"
+#include "vtkPVVTKExtensionsFiltersRenderingModule.h" //needed for exports
+#include "vtkSmartPointer.h"                          // for vtkSmartPointer
+
+class vtkCharArray;
+class vtkDataObject;
+
+class VTKPVVTKEXTENSIONSFILTERSRENDERING_EXPORT vtkPVDataObjectMarshaller : public vtkObject
+{
+public:
+  static vtkPVDataObjectMarshaller* New();
+  vtkTypeMacro(vtkPVDataObjectMarshaller, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  enum CompressionModes
+  {
+    NONE = 0,
+    LZ4 = 1,
+    ZLIB = 2
+  };
+
+  //@{
+  /**
+   * Set/Get the compression used for array payloads. LZ4 is fast enough to
+   * pay off on most networks while ZLIB trades speed for a better compression
+   * ratio. Default is LZ4.
+   */
+  vtkSetClampMacro(Compression, int, NONE, ZLIB);
+  vtkGetMacro(Compression, int);
+  void SetCompressionToNone() { this->SetCompression(NONE); }
+  void SetCompressionToLZ4() { this->SetCompression(LZ4); }
+  void SetCompressionToZLib() { this->SetCompression(ZLIB); }
+  //@}
+
+  //@{
+  /**
+   * Set/Get the size, in bytes, below which array payloads are not
+   * compressed. Default is 64 KiB.
+   */
+  vtkSetClampMacro(CompressionThreshold, vtkIdType, 0, VTK_ID_MAX);
+  vtkGetMacro(CompressionThreshold, vtkIdType);
+  //@}
+
+  /**
+   * Marshals `data`, which may be nullptr, into a newly allocated buffer. The
+   * length of the buffer is returned in `length`. The caller is responsible
+   * for releasing the buffer using `delete[]`. Returns nullptr on failure.
+   */
+  char* Marshal(vtkDataObject* data, vtkIdType& length);
+
+  /**
+   * Marshals `data`, which may be nullptr, into `buffer`. Returns false on
+   * failure.
+   */
+  bool Marshal(vtkDataObject* data, vtkCharArray* buffer);
+
+  //@{
+  /**
+   * Reconstructs a data object from a buffer generated by `Marshal`. Returns
+   * nullptr if the marshalled data object was nullptr or on failure.
+   */
+  vtkSmartPointer<vtkDataObject> Unmarshal(const char* buffer, vtkIdType length);
+  vtkSmartPointer<vtkDataObject> Unmarshal(vtkCharArray* buffer);
+  //@}
+
+  /**
+   * Returns true if `buffer` looks like a buffer generated by `Marshal`.
+   */
+  static bool IsMarshalledBuffer(const char* buffer, vtkIdType length);
+
+protected:
+  vtkPVDataObjectMarshaller();
+  ~vtkPVDataObjectMarshaller() override;
+
+  int Compression;
+  vtkIdType CompressionThreshold;
+
+private:
+  vtkPVDataObjectMarshaller(const vtkPVDataObjectMarshaller&) = delete;
+  void operator=(const vtkPVDataObjectMarshaller&) = delete;
+};
+
+#endif
@@ -31,6 +31,7 @@
 #include "vtkExplicitStructuredGrid.h"
 #include "vtkExplicitStructuredGridSurfaceFilter.h"
 #include "vtkFeatureEdges.h"
+#include "vtkFieldData.h"
 #include "vtkFloatArray.h"
 #include "vtkGarbageCollector.h"
 #include "vtkGenericDataSet.h"
@@ -55,10 +56,14 @@
 #include "vtkPVTrivialProducer.h"
 #include "vtkPartitionedDataSetCollection.h"
 #include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkRectilinearGridOutlineFilter.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSelectionNode.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -74,11 +79,13 @@
 #include "vtkUnstructuredGridGeometryFilter.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cmath>
 #include <map>
 #include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
 template <typename T>
@@ -151,6 +158,69 @@ public:
   int Commutative() override { return 1; }
 };
 
+//----------------------------------------------------------------------------
+class vtkPVGeometryFilter::BlockWorkers
+{
+public:
+  BlockWorkers(vtkPVGeometryFilter* self, vtkIdType numberOfBlocks)
+    : Self(self)
+    , NumberOfBlocks(numberOfBlocks)
+    , NumberOfBlocksDone(0)
+    , MainThread(std::this_thread::get_id())
+  {
+  }
+
+  /**
+   * Returns the filter to use on the calling thread. Each thread gets its own
+   * instance, with its own internal filters, configured like `Self`.
+   */
+  vtkPVGeometryFilter* Local()
+  {
+    auto& worker = this->Workers.Local();
+    if (!worker)
+    {
+      vtkPVGeometryFilter* self = this->Self;
+      worker.TakeReference(self->NewInstance());
+      worker->SetController(self->Controller);
+      worker->UseOutline = self->UseOutline;
+      worker->GenerateFeatureEdges = self->GenerateFeatureEdges;
+      worker->GenerateCellNormals = self->GenerateCellNormals;
+      worker->GenerateProcessIds = self->GenerateProcessIds;
+      worker->Triangulate = self->Triangulate;
+      worker->UseStrips = self->UseStrips;
+      worker->ForceUseStrips = self->ForceUseStrips;
+      worker->BlockColorsDistinctValues = self->BlockColorsDistinctValues;
+      worker->DataSetSurfaceFilter->SetUseStrips(self->UseStrips);
+      worker->SetNonlinearSubdivisionLevel(self->NonlinearSubdivisionLevel);
+      worker->SetPassThroughCellIds(self->PassThroughCellIds);
+      worker->SetPassThroughPointIds(self->PassThroughPointIds);
+    }
+    return worker;
+  }
+
+  /**
+   * Called after each block is done. Progress is only reported from the thread
+   * that is executing the filter so that observers are not called concurrently.
+   * Returns false if the execution was aborted.
+   */
+  bool BlockDone()
+  {
+    const vtkIdType done = ++this->NumberOfBlocksDone;
+    if (std::this_thread::get_id() == this->MainThread)
+    {
+      this->Self->UpdateProgress(static_cast<double>(done) / this->NumberOfBlocks);
+    }
+    return !this->Self->AbortExecute;
+  }
+
+private:
+  vtkPVGeometryFilter* Self;
+  vtkIdType NumberOfBlocks;
+  std::atomic<vtkIdType> NumberOfBlocksDone;
+  std::thread::id MainThread;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkPVGeometryFilter> > Workers;
+};
+
 //----------------------------------------------------------------------------
 vtkPVGeometryFilter::vtkPVGeometryFilter()
 {
@@ -716,6 +786,52 @@ static vtkPolyData* vtkPVGeometryFilterMergePieces(vtkPartitionedDataSet* mp)
     vtkPVGeometryFilter::STRIPS_OFFSETS(), &strips_offsets[0], static_cast<int>(num_pieces));
   return output;
 }
+
+//----------------------------------------------------------------------------
+void vtkPVGeometryFilterAddArrays(vtkFieldData* fd, std::vector<vtkObject*>& objects)
+{
+  for (int cc = 0; fd && cc < fd->GetNumberOfArrays(); ++cc)
+  {
+    if (vtkAbstractArray* array = fd->GetAbstractArray(cc))
+    {
+      objects.push_back(array);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+// Collects the objects of a block on which extracting its surface may update
+// cached state, such as bounds, array ranges or cell links.
+void vtkPVGeometryFilterGetBlockObjects(vtkDataObject* block, std::vector<vtkObject*>& objects)
+{
+  objects.push_back(block);
+  if (auto ps = vtkPointSet::SafeDownCast(block))
+  {
+    if (vtkPoints* points = ps->GetPoints())
+    {
+      objects.push_back(points);
+      objects.push_back(points->GetData());
+    }
+  }
+  else if (auto rg = vtkRectilinearGrid::SafeDownCast(block))
+  {
+    vtkDataArray* coordinates[3] = { rg->GetXCoordinates(), rg->GetYCoordinates(),
+      rg->GetZCoordinates() };
+    for (auto array : coordinates)
+    {
+      if (array)
+      {
+        objects.push_back(array);
+      }
+    }
+  }
+  if (auto ds = vtkDataSet::SafeDownCast(block))
+  {
+    vtkPVGeometryFilterAddArrays(ds->GetPointData(), objects);
+    vtkPVGeometryFilterAddArrays(ds->GetCellData(), objects);
+  }
+  vtkPVGeometryFilterAddArrays(block->GetFieldData(), objects);
+}
 };
 
 //----------------------------------------------------------------------------
@@ -824,6 +940,19 @@ int vtkPVGeometryFilter::RequestAMRData(
     memcpy(bounds, received_bounds, sizeof(double) * 6);
   }
 
+  // Determine the blocks, and their faces, to extract first; the extraction
+  // itself is done concurrently below.
+  struct AMRBlock
+  {
+    vtkUniformGrid* Grid;
+    unsigned int Level;
+    unsigned int Index;
+    unsigned int BlockId;
+    double Bounds[6];
+    bool ExtractFace[6];
+  };
+  std::vector<AMRBlock> blocks;
+
   unsigned int block_id = 0;
   for (unsigned int level = 0; level < amr->GetNumberOfLevels(); ++level)
   {
@@ -891,28 +1020,61 @@ int vtkPVGeometryFilter::RequestAMRData(
         continue;
       }
 
+      AMRBlock block;
+      block.Grid = ug;
+      block.Level = level;
+      block.Index = dataIdx;
+      block.BlockId = block_id;
+      std::copy(data_bounds, data_bounds + 6, block.Bounds);
+      std::copy(extractface, extractface + 6, block.ExtractFace);
+      blocks.push_back(block);
+    }
+  }
+
+  // Each block is extracted into its own slot so that the pieces, and hence
+  // the offsets computed when merging them, are independent of the order in
+  // which the threads process the blocks.
+  const vtkIdType numBlocks = static_cast<vtkIdType>(blocks.size());
+  std::vector<vtkSmartPointer<vtkPolyData> > outputBlocks(blocks.size());
+  vtkPVGeometryFilter::BlockWorkers workers(this, numBlocks);
+  vtkSMPTools::For(0, numBlocks, [&](vtkIdType begin, vtkIdType end) {
+    vtkPVGeometryFilter* worker = workers.Local();
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      const AMRBlock& block = blocks[cc];
       vtkNew<vtkPolyData> outputBlock;
-      if (this->UseOutline)
+      if (worker->UseOutline)
       {
-        this->ExecuteAMRBlockOutline(data_bounds, outputBlock.GetPointer(), extractface);
+        worker->ExecuteAMRBlockOutline(block.Bounds, outputBlock.GetPointer(), block.ExtractFace);
       }
       else
       {
-        this->ExecuteAMRBlock(ug, outputBlock.GetPointer(), extractface);
-      }
-      if (!this->UseOutline)
-      {
-        // don't process attribute arrays when generating outlines.
+        worker->ExecuteAMRBlock(block.Grid, outputBlock.GetPointer(), block.ExtractFace);
 
-        this->CleanupOutputData(outputBlock.GetPointer(), /*doCommunicate=*/0);
-        this->AddCompositeIndex(outputBlock.GetPointer(), amr->GetCompositeIndex(level, dataIdx));
-        this->AddHierarchicalIndex(outputBlock.GetPointer(), level, dataIdx);
+        // don't process attribute arrays when generating outlines.
+        worker->CleanupOutputData(outputBlock.GetPointer(), /*doCommunicate=*/0);
+        worker->AddCompositeIndex(
+          outputBlock.GetPointer(), amr->GetCompositeIndex(block.Level, block.Index));
+        worker->AddHierarchicalIndex(outputBlock.GetPointer(), block.Level, block.Index);
         // we don't call this->AddBlockColors() for AMR dataset since it doesn't
         // make sense,  nor can be supported since all datasets merged into a
         // single polydata for rendering.
       }
-      amrDatasets->SetPiece(block_id, outputBlock.GetPointer());
+      outputBlocks[cc] = outputBlock.GetPointer();
+      if (!workers.BlockDone())
+      {
+        break;
+      }
     }
+  });
+
+  for (vtkIdType cc = 0; cc < numBlocks; ++cc)
+  {
+    amrDatasets->SetPiece(blocks[cc].BlockId, outputBlocks[cc]);
+  }
+  if (numBlocks > 0)
+  {
+    this->OutlineFlag = this->UseOutline ? 1 : 0;
   }
 
   // to avoid overburdening the rendering code with having to render a large
@@ -970,35 +1132,98 @@ int vtkPVGeometryFilter::RequestDataObjectTree(
 
   int* wholeExtent =
     vtkStreamingDemandDrivenPipeline::GetWholeExtent(inputVector[0]->GetInformationObject(0));
-  int numInputs = 0;
+
+  // Extract the surfaces of the blocks concurrently. Each block is extracted
+  // into its own slot and the results are added to the output in traversal
+  // order, so that the output does not depend on how the blocks are scheduled.
+  std::vector<vtkDataObject*> blocks;
+  blocks.reserve(totNumBlocks);
   for (inIter->InitTraversal(); !inIter->IsDoneWithTraversal(); inIter->GoToNextItem())
   {
-    vtkDataObject* block = inIter->GetCurrentDataObject();
-    if (!block)
+    blocks.push_back(inIter->GetCurrentDataObject());
+  }
+
+  // A dataset, or its points or arrays, may appear in more than one leaf.
+  // Since extracting the surface can update state cached on the input, such
+  // as bounds, array ranges or cell links, these are extracted serially
+  // afterwards.
+  std::vector<std::vector<vtkObject*> > blockObjects(blocks.size());
+  std::map<vtkObject*, int> objectCounts;
+  for (size_t cc = 0; cc < blocks.size(); ++cc)
+  {
+    vtkPVGeometryFilterGetBlockObjects(blocks[cc], blockObjects[cc]);
+    for (auto object : blockObjects[cc])
+    {
+      ++objectCounts[object];
+    }
+  }
+  std::vector<bool> shared(blocks.size());
+  for (size_t cc = 0; cc < blocks.size(); ++cc)
+  {
+    shared[cc] = std::any_of(blockObjects[cc].begin(), blockObjects[cc].end(),
+      [&objectCounts](vtkObject* object) { return objectCounts[object] > 1; });
+  }
+
+  const vtkIdType numBlocks = static_cast<vtkIdType>(blocks.size());
+  std::vector<vtkSmartPointer<vtkPolyData> > outputBlocks(blocks.size());
+  // The executes set OutlineFlag but may leave it unchanged. Blocks start from
+  // an unset flag so that the value after the last block that sets it is
+  // carried over, as when the blocks are extracted one after another.
+  std::vector<int> outlineFlags(blocks.size(), -1);
+  const int initialOutlineFlag = this->OutlineFlag;
+  auto extractBlock = [&](vtkPVGeometryFilter* self, vtkIdType cc) {
+    vtkNew<vtkPolyData> tmpOut;
+    self->OutlineFlag = -1;
+    self->ExecuteBlock(blocks[cc], tmpOut, 0, 0, 1, 0, wholeExtent);
+    self->CleanupOutputData(tmpOut, 0);
+    outlineFlags[cc] = self->OutlineFlag;
+    outputBlocks[cc] = tmpOut.GetPointer();
+  };
+
+  vtkPVGeometryFilter::BlockWorkers workers(this, numBlocks);
+  vtkSMPTools::For(0, numBlocks, [&](vtkIdType begin, vtkIdType end) {
+    vtkPVGeometryFilter* worker = workers.Local();
+    for (vtkIdType cc = begin; cc < end; ++cc)
     {
-      continue;
+      if (!shared[cc])
+      {
+        extractBlock(worker, cc);
+        if (!workers.BlockDone())
+        {
+          break;
+        }
+      }
     }
+  });
+  for (vtkIdType cc = 0; cc < numBlocks && !this->AbortExecute; ++cc)
+  {
+    if (shared[cc])
+    {
+      extractBlock(this, cc);
+      workers.BlockDone();
+    }
+  }
 
-    vtkPolyData* tmpOut = vtkPolyData::New();
-    this->ExecuteBlock(block, tmpOut, 0, 0, 1, 0, wholeExtent);
-    this->CleanupOutputData(tmpOut, 0);
+  vtkIdType cc = 0;
+  for (inIter->InitTraversal(); !inIter->IsDoneWithTraversal(); inIter->GoToNextItem(), ++cc)
+  {
+    vtkPolyData* tmpOut = outputBlocks[cc];
     // skip empty nodes.
-    if (tmpOut->GetNumberOfPoints() > 0)
+    if (tmpOut && tmpOut->GetNumberOfPoints() > 0)
     {
       output->SetDataSet(inIter, tmpOut);
-      tmpOut->FastDelete();
 
       const unsigned int current_flat_index = inIter->GetCurrentFlatIndex();
       this->AddCompositeIndex(tmpOut, current_flat_index);
     }
-    else
+  }
+  this->OutlineFlag = initialOutlineFlag;
+  for (auto flag : outlineFlags)
+  {
+    if (flag != -1)
     {
-      tmpOut->Delete();
-      tmpOut = nullptr;
+      this->OutlineFlag = flag;
     }
-
-    numInputs++;
-    this->UpdateProgress(static_cast<float>(numInputs) / totNumBlocks);
   }
   vtkTimerLog::MarkEndEvent("vtkPVGeometryFilter::ExecuteCompositeDataSet");
 
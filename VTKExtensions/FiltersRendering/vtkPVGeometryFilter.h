@@ -348,6 +348,12 @@ private:
   void AddHierarchicalIndex(vtkPolyData* pd, unsigned int level, unsigned int index);
   class BoundsReductionOperation;
   //@}
+
+  /**
+   * Provides per-thread copies of this filter that are used to extract the
+   * surfaces of the blocks of a composite dataset concurrently.
+   */
+  class BlockWorkers;
 };
 
 #endif
@@ -0,0 +1,449 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVVertexClustering.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVVertexClustering.h"
+
+#include "vtkArrayDispatch.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkDataArrayRange.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// An output cell: a vertex, a line segment or a triangle referencing up to 3
+// clusters (unused ids are -1) and the input cell it originates from.
+struct Primitive
+{
+  std::array<vtkIdType, 3> Ids;
+  vtkIdType CellId;
+
+  bool operator<(const Primitive& other) const
+  {
+    return this->Ids < other.Ids || (this->Ids == other.Ids && this->CellId < other.CellId);
+  }
+};
+
+using PrimitiveLists = std::array<std::vector<Primitive>, 3>;
+
+//----------------------------------------------------------------------------
+// Bins the points and picks, for each non-empty bin, the point closest to the
+// bin's center of mass.
+struct ClusterPointsWorker
+{
+  int Divisions[3];
+  std::vector<vtkIdType> PointMap;        // input point id -> cluster id
+  std::vector<vtkIdType> Representatives; // cluster id -> input point id
+
+  template <typename ArrayT>
+  void operator()(ArrayT* array)
+  {
+    const auto points = vtk::DataArrayTupleRange<3>(array);
+    const vtkIdType numPts = points.size();
+
+    // Bounds are computed here rather than using vtkPoints::GetBounds() which
+    // caches them in the input.
+    const double inf = std::numeric_limits<double>::infinity();
+    const std::array<double, 6> empty = { { inf, -inf, inf, -inf, inf, -inf } };
+    vtkSMPThreadLocal<std::array<double, 6> > tlBounds(empty);
+    vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+      auto& bds = tlBounds.Local();
+      for (vtkIdType cc = begin; cc < end; ++cc)
+      {
+        const auto pt = points[cc];
+        for (int axis = 0; axis < 3; ++axis)
+        {
+          const double x = static_cast<double>(pt[axis]);
+          bds[2 * axis] = std::min(bds[2 * axis], x);
+          bds[2 * axis + 1] = std::max(bds[2 * axis + 1], x);
+        }
+      }
+    });
+    std::array<double, 6> bounds = empty;
+    for (auto iter = tlBounds.begin(); iter != tlBounds.end(); ++iter)
+    {
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        bounds[2 * axis] = std::min(bounds[2 * axis], (*iter)[2 * axis]);
+        bounds[2 * axis + 1] = std::max(bounds[2 * axis + 1], (*iter)[2 * axis + 1]);
+      }
+    }
+
+    double scale[3];
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      const double length = bounds[2 * axis + 1] - bounds[2 * axis];
+      scale[axis] = length > 0 ? this->Divisions[axis] / length : 0.0;
+    }
+
+    // Sorting (bin, point id) pairs groups the points of each bin together.
+    std::vector<std::pair<vtkIdType, vtkIdType> > bins(numPts);
+    vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType cc = begin; cc < end; ++cc)
+      {
+        const auto pt = points[cc];
+        vtkIdType bin = 0;
+        for (int axis = 2; axis >= 0; --axis)
+        {
+          const double x = (static_cast<double>(pt[axis]) - bounds[2 * axis]) * scale[axis];
+          // `x > 0` is also false for NaN.
+          const int index =
+            x > 0 ? static_cast<int>(std::min(x, this->Divisions[axis] - 1.0)) : 0;
+          bin = bin * this->Divisions[axis] + index;
+        }
+        bins[cc] = std::make_pair(bin, cc);
+      }
+    });
+    vtkSMPTools::Sort(bins.begin(), bins.end());
+
+    std::vector<vtkIdType> starts;
+    for (vtkIdType cc = 0; cc < numPts; ++cc)
+    {
+      if (cc == 0 || bins[cc].first != bins[cc - 1].first)
+      {
+        starts.push_back(cc);
+      }
+    }
+    starts.push_back(numPts);
+
+    const vtkIdType numClusters = static_cast<vtkIdType>(starts.size()) - 1;
+    this->PointMap.resize(numPts);
+    this->Representatives.resize(numClusters);
+    vtkSMPTools::For(0, numClusters, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType cluster = begin; cluster < end; ++cluster)
+      {
+        const vtkIdType first = starts[cluster];
+        const vtkIdType last = starts[cluster + 1];
+        double center[3] = { 0.0, 0.0, 0.0 };
+        for (vtkIdType cc = first; cc < last; ++cc)
+        {
+          const auto pt = points[bins[cc].second];
+          for (int axis = 0; axis < 3; ++axis)
+          {
+            center[axis] += static_cast<double>(pt[axis]);
+          }
+          this->PointMap[bins[cc].second] = cluster;
+        }
+        for (int axis = 0; axis < 3; ++axis)
+        {
+          center[axis] /= (last - first);
+        }
+
+        // Points of a bin are sorted by id, hence ties are resolved
+        // deterministically.
+        vtkIdType closest = bins[first].second;
+        double closestDistance = inf;
+        for (vtkIdType cc = first; cc < last; ++cc)
+        {
+          const auto pt = points[bins[cc].second];
+          double distance = 0.0;
+          for (int axis = 0; axis < 3; ++axis)
+          {
+            const double delta = static_cast<double>(pt[axis]) - center[axis];
+            distance += delta * delta;
+          }
+          if (distance < closestDistance)
+          {
+            closestDistance = distance;
+            closest = bins[cc].second;
+          }
+        }
+        this->Representatives[cluster] = closest;
+      }
+    });
+  }
+};
+
+//----------------------------------------------------------------------------
+void AddTriangle(std::vector<Primitive>& triangles, vtkIdType a, vtkIdType b, vtkIdType c,
+  vtkIdType cellId)
+{
+  if (a == b || b == c || a == c)
+  {
+    return;
+  }
+  // Rotate the smallest id first, preserving orientation, so that identical
+  // triangles compare equal.
+  if (b < a && b < c)
+  {
+    triangles.push_back(Primitive{ { { b, c, a } }, cellId });
+  }
+  else if (c < a && c < b)
+  {
+    triangles.push_back(Primitive{ { { c, a, b } }, cellId });
+  }
+  else
+  {
+    triangles.push_back(Primitive{ { { a, b, c } }, cellId });
+  }
+}
+
+//----------------------------------------------------------------------------
+// Maps the cells of `cells`, which are of type `cellType` and whose first cell
+// has id `firstCellId` in the input, to the clusters. Resulting vertices, line
+// segments and triangles are appended to `primitives`.
+void MapCells(vtkCellArray* cells, int cellType, vtkIdType firstCellId,
+  const std::vector<vtkIdType>& pointMap, PrimitiveLists& primitives)
+{
+  const vtkIdType numCells = cells ? cells->GetNumberOfCells() : 0;
+  if (numCells == 0)
+  {
+    return;
+  }
+
+  vtkSMPThreadLocalObject<vtkIdList> tlIds;
+  vtkSMPThreadLocal<PrimitiveLists> tlPrimitives;
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* ids = tlIds.Local();
+    auto& local = tlPrimitives.Local();
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      cells->GetCellAtId(cellId, ids);
+      const vtkIdType npts = ids->GetNumberOfIds();
+      vtkIdType* pts = ids->GetPointer(0);
+      for (vtkIdType cc = 0; cc < npts; ++cc)
+      {
+        pts[cc] = pointMap[pts[cc]];
+      }
+
+      const vtkIdType outCellId = firstCellId + cellId;
+      switch (cellType)
+      {
+        case VTK_POLY_VERTEX:
+          for (vtkIdType cc = 0; cc < npts; ++cc)
+          {
+            local[0].push_back(Primitive{ { { pts[cc], -1, -1 } }, outCellId });
+          }
+          break;
+
+        case VTK_POLY_LINE:
+          for (vtkIdType cc = 1; cc < npts; ++cc)
+          {
+            if (pts[cc - 1] != pts[cc])
+            {
+              local[1].push_back(Primitive{
+                { { std::min(pts[cc - 1], pts[cc]), std::max(pts[cc - 1], pts[cc]), -1 } },
+                outCellId });
+            }
+          }
+          break;
+
+        case VTK_POLYGON:
+          for (vtkIdType cc = 1; cc + 1 < npts; ++cc)
+          {
+            AddTriangle(local[2], pts[0], pts[cc], pts[cc + 1], outCellId);
+          }
+          break;
+
+        case VTK_TRIANGLE_STRIP:
+          for (vtkIdType cc = 0; cc + 2 < npts; ++cc)
+          {
+            if (cc % 2 == 0)
+            {
+              AddTriangle(local[2], pts[cc], pts[cc + 1], pts[cc + 2], outCellId);
+            }
+            else
+            {
+              AddTriangle(local[2], pts[cc + 1], pts[cc], pts[cc + 2], outCellId);
+            }
+          }
+          break;
+      }
+    }
+  });
+
+  for (auto iter = tlPrimitives.begin(); iter != tlPrimitives.end(); ++iter)
+  {
+    for (int kind = 0; kind < 3; ++kind)
+    {
+      primitives[kind].insert(primitives[kind].end(), (*iter)[kind].begin(), (*iter)[kind].end());
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkCellArray> BuildCells(
+  const std::vector<Primitive>& primitives, int cellSize, const std::vector<vtkIdType>& newIds)
+{
+  const vtkIdType numCells = static_cast<vtkIdType>(primitives.size());
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numCells + 1);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(numCells * cellSize);
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      offsets->SetValue(cc, cc * cellSize);
+      for (int kk = 0; kk < cellSize; ++kk)
+      {
+        connectivity->SetValue(cc * cellSize + kk, newIds[primitives[cc].Ids[kk]]);
+      }
+    }
+  });
+  offsets->SetValue(numCells, numCells * cellSize);
+
+  auto cells = vtkSmartPointer<vtkCellArray>::New();
+  cells->SetData(offsets, connectivity);
+  return cells;
+}
+}
+
+vtkStandardNewMacro(vtkPVVertexClustering);
+//----------------------------------------------------------------------------
+vtkPVVertexClustering::vtkPVVertexClustering()
+{
+  this->NumberOfDivisions[0] = this->NumberOfDivisions[1] = this->NumberOfDivisions[2] = 64;
+}
+
+//----------------------------------------------------------------------------
+vtkPVVertexClustering::~vtkPVVertexClustering() = default;
+
+//----------------------------------------------------------------------------
+int vtkPVVertexClustering::RequestData(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkPolyData* input = vtkPolyData::GetData(inputVector[0], 0);
+  vtkPolyData* output = vtkPolyData::GetData(outputVector, 0);
+
+  vtkPoints* inPts = input->GetPoints();
+  if (inPts == nullptr || inPts->GetNumberOfPoints() == 0 || input->GetNumberOfCells() == 0)
+  {
+    return 1;
+  }
+
+  ClusterPointsWorker worker;
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    worker.Divisions[axis] = std::max(this->NumberOfDivisions[axis], 1);
+  }
+  using Dispatcher = vtkArrayDispatch::DispatchByValueType<vtkArrayDispatch::Reals>;
+  if (!Dispatcher::Execute(inPts->GetData(), worker))
+  {
+    worker(inPts->GetData());
+  }
+  this->UpdateProgress(0.4);
+
+  // Input cell ids are numbered verts first, then lines, polys and strips.
+  PrimitiveLists primitives;
+  vtkIdType firstCellId = 0;
+  MapCells(input->GetVerts(), VTK_POLY_VERTEX, firstCellId, worker.PointMap, primitives);
+  firstCellId += input->GetNumberOfVerts();
+  MapCells(input->GetLines(), VTK_POLY_LINE, firstCellId, worker.PointMap, primitives);
+  firstCellId += input->GetNumberOfLines();
+  MapCells(input->GetPolys(), VTK_POLYGON, firstCellId, worker.PointMap, primitives);
+  firstCellId += input->GetNumberOfPolys();
+  MapCells(input->GetStrips(), VTK_TRIANGLE_STRIP, firstCellId, worker.PointMap, primitives);
+  this->UpdateProgress(0.7);
+
+  // Remove duplicate cells, keeping the one with the smallest input cell id.
+  const vtkIdType numClusters = static_cast<vtkIdType>(worker.Representatives.size());
+  std::vector<vtkIdType> newIds(numClusters, -1);
+  for (auto& list : primitives)
+  {
+    vtkSMPTools::Sort(list.begin(), list.end());
+    list.erase(std::unique(list.begin(), list.end(),
+                 [](const Primitive& a, const Primitive& b) { return a.Ids == b.Ids; }),
+      list.end());
+    for (const auto& primitive : list)
+    {
+      for (vtkIdType id : primitive.Ids)
+      {
+        if (id >= 0)
+        {
+          newIds[id] = 0;
+        }
+      }
+    }
+  }
+
+  // Only pass the clusters that are referenced by the output cells.
+  vtkIdType numNewPts = 0;
+  for (auto& id : newIds)
+  {
+    id = id == 0 ? numNewPts++ : -1;
+  }
+
+  vtkNew<vtkPoints> newPts;
+  newPts->SetDataType(inPts->GetDataType());
+  newPts->SetNumberOfPoints(numNewPts);
+  vtkPointData* inPD = input->GetPointData();
+  vtkPointData* outPD = output->GetPointData();
+  outPD->CopyAllocate(inPD, numNewPts);
+  for (vtkIdType cluster = 0; cluster < numClusters; ++cluster)
+  {
+    if (newIds[cluster] >= 0)
+    {
+      double x[3];
+      inPts->GetPoint(worker.Representatives[cluster], x);
+      newPts->SetPoint(newIds[cluster], x);
+      outPD->CopyData(inPD, worker.Representatives[cluster], newIds[cluster]);
+    }
+  }
+  output->SetPoints(newPts);
+
+  vtkCellData* inCD = input->GetCellData();
+  vtkCellData* outCD = output->GetCellData();
+  const size_t numNewCells = primitives[0].size() + primitives[1].size() + primitives[2].size();
+  outCD->CopyAllocate(inCD, static_cast<vtkIdType>(numNewCells));
+  vtkIdType outCellId = 0;
+  for (const auto& list : primitives)
+  {
+    for (const auto& primitive : list)
+    {
+      outCD->CopyData(inCD, primitive.CellId, outCellId++);
+    }
+  }
+
+  if (!primitives[0].empty())
+  {
+    output->SetVerts(BuildCells(primitives[0], 1, newIds));
+  }
+  if (!primitives[1].empty())
+  {
+    output->SetLines(BuildCells(primitives[1], 2, newIds));
+  }
+  if (!primitives[2].empty())
+  {
+    output->SetPolys(BuildCells(primitives[2], 3, newIds));
+  }
+  output->GetFieldData()->PassData(input->GetFieldData());
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVVertexClustering::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfDivisions: " << this->NumberOfDivisions[0] << ", "
+     << this->NumberOfDivisions[1] << ", " << this->NumberOfDivisions[2] << endl;
+}
@@ -0,0 +1,74 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVVertexClustering.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkPVVertexClustering
+ * @brief   multithreaded vertex clustering decimation
+ *
+ * vtkPVVertexClustering reduces the number of points and cells in a vtkPolyData
+ * by binning points into a uniform grid spanning the input bounds. All points
+ * in a bin are replaced by the input point closest to the bin's center of
+ * mass, and cells that collapse (i.e. that reference the same output point
+ * more than once) or that duplicate another output cell are discarded.
+ * Polygons and triangle strips are triangulated; polylines are split into line
+ * segments.
+ *
+ * This is the same algorithm as vtkmLevelOfDetail, but implemented using
+ * vtkSMPTools so that all stages (binning, clustering and cell mapping) are
+ * executed in parallel with whichever SMP backend VTK is built with. Unlike
+ * vtkQuadricClustering, its cost does not depend on the number of divisions.
+ *
+ * Point data and cell data are passed to the output. Output cells are in no
+ * particular order, but the output is deterministic.
+ *
+ * @sa
+ * vtkQuadricClustering vtkmLevelOfDetail
+ */
+
+#ifndef vtkPVVertexClustering_h
+#define vtkPVVertexClustering_h
+
+#include "vtkPVVTKExtensionsFiltersRenderingModule.h" // needed for export macro
+#include "vtkPolyDataAlgorithm.h"
+
+class VTKPVVTKEXTENSIONSFILTERSRENDERING_EXPORT vtkPVVertexClustering : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkPVVertexClustering* New();
+  vtkTypeMacro(vtkPVVertexClustering, vtkPolyDataAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Set/Get the number of bins along each axis of the grid used to cluster
+   * points. Default is 64 along each axis.
+   */
+  vtkSetVector3Macro(NumberOfDivisions, int);
+  vtkGetVector3Macro(NumberOfDivisions, int);
+  //@}
+
+protected:
+  vtkPVVertexClustering();
+  ~vtkPVVertexClustering() override;
+
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
+  int NumberOfDivisions[3];
+
+private:
+  vtkPVVertexClustering(const vtkPVVertexClustering&) = delete;
+  void operator=(const vtkPVVertexClustering&) = delete;
+};
+
+#endif
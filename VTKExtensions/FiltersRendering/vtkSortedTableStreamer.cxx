@@ -52,9 +52,11 @@
 #include <algorithm>
 #include <map>
 #include <set>
+#include <utility>
 #include <vector>
 
 #include <cfloat>
+#include <cstring>
 
 #include <sstream>
 #include <string>
@@ -429,6 +431,7 @@ public:
     {
       this->Array = nullptr;
       this->Histo = nullptr;
+      this->ArraySize = 0;
     }
 
     ~ArraySorter() { this->Clear(); }
@@ -440,6 +443,7 @@ public:
         delete[] this->Array;
         this->Array = nullptr;
       }
+      this->ArraySize = 0;
       if (this->Histo)
       {
         delete this->Histo;
@@ -550,12 +554,53 @@ public:
       }
     }
   };
+  // Item of the distributed sample sort: a value and its location in the
+  // locally sorted array of its process.
+  struct IndexItem
+  {
+    T Value;
+    vtkIdType Process;
+    vtkIdType Position;
+  };
+
+  // IndexItem are exchanged as packed records so that padding bytes, which
+  // are not initialized, are not sent.
+  static size_t GetPackedItemSize() { return sizeof(T) + 2 * sizeof(vtkIdType); }
+
+  static void PackItems(const std::vector<IndexItem>& items, std::vector<char>& buffer)
+  {
+    buffer.resize(items.size() * GetPackedItemSize());
+    char* ptr = buffer.data();
+    for (const auto& item : items)
+    {
+      memcpy(ptr, &item.Value, sizeof(T));
+      ptr += sizeof(T);
+      memcpy(ptr, &item.Process, sizeof(vtkIdType));
+      ptr += sizeof(vtkIdType);
+      memcpy(ptr, &item.Position, sizeof(vtkIdType));
+      ptr += sizeof(vtkIdType);
+    }
+  }
+
+  static void UnpackItems(const std::vector<char>& buffer, std::vector<IndexItem>& items)
+  {
+    items.resize(buffer.size() / GetPackedItemSize());
+    const char* ptr = buffer.data();
+    for (auto& item : items)
+    {
+      memcpy(&item.Value, ptr, sizeof(T));
+      ptr += sizeof(T);
+      memcpy(&item.Process, ptr, sizeof(vtkIdType));
+      ptr += sizeof(vtkIdType);
+      memcpy(&item.Position, ptr, sizeof(vtkIdType));
+      ptr += sizeof(vtkIdType);
+    }
+  }
 
   Internals()
   {
     // Only used for testing
     this->LocalSorter = nullptr;
-    this->GlobalHistogram = nullptr;
     this->Debug = false;
   }
 
@@ -580,14 +625,9 @@ public:
 
     // Create internal objects
     this->LocalSorter = new ArraySorter();
-    this->GlobalHistogram = new Histogram(HISTOGRAM_SIZE);
   }
 
-  ~Internals() override
-  {
-    delete this->LocalSorter;
-    delete this->GlobalHistogram;
-  }
+  ~Internals() override { delete this->LocalSorter; }
 
   // --------------------------------------------------------------------------
   bool IsSortable() override
@@ -658,9 +698,6 @@ public:
     // We are building the cache so no need to build it next time
     this->NeedToBuildCache = false;
 
-    // Communication buffer
-    vtkIdType* bufferHistogramValues = new vtkIdType[this->NumProcs * HISTOGRAM_SIZE];
-
     // Is there something to sort ???
     if (!sortableArray)
     {
@@ -681,33 +718,218 @@ public:
       }
       else
       {
-        // Build empty local histogram
         this->LocalSorter->Clear();
-        this->LocalSorter->Histo = new Histogram(HISTOGRAM_SIZE);
-        this->LocalSorter->Histo->SetScalarRange(this->CommonRange);
-        this->LocalSorter->Histo->Inverted = invertOrder;
       }
 
-      // Initialize the global histogram with same range
-      this->LocalSorter->Histo->CopyRangeTo(*this->GlobalHistogram);
+      // Build the global sorted index used to locate the requested blocks
+      this->BuildGlobalIndex(invertOrder);
+    }
 
-      // Make sure that the global histogram is properly initialized
-      this->GlobalHistogram->ClearHistogramValues();
-      this->GlobalHistogram->Inverted = invertOrder;
+    return 1;
+  }
 
-      // Send local histogram and receive every histogram from everybody
-      this->MPI->AllGather(this->LocalSorter->Histo->Values, bufferHistogramValues, HISTOGRAM_SIZE);
+  // --------------------------------------------------------------------------
+  // Total order used for the global sort: values are compared in the
+  // requested order and equal values are ordered by process and by position
+  // in the locally sorted array, which matches the local order.
+  static bool Precedes(const IndexItem& a, const IndexItem& b, bool invertOrder)
+  {
+    if (a.Value != b.Value)
+    {
+      return invertOrder ? a.Value > b.Value : a.Value < b.Value;
+    }
+    if (a.Process != b.Process)
+    {
+      return a.Process < b.Process;
+    }
+    return a.Position < b.Position;
+  }
 
-      // Merge all histogram into the GlobalHistogram
-      for (int idx = 0, nb = this->NumProcs * HISTOGRAM_SIZE; idx < nb; ++idx)
+  // --------------------------------------------------------------------------
+  // Distributed sample sort of the locally sorted arrays. Process p ends up
+  // owning the p-th bucket of the global order, stored as the location of its
+  // items in the locally sorted arrays of their processes. Once built, the
+  // processes contributing to any range of the global order, and the range of
+  // their locally sorted array they contribute, can be found with a single
+  // reduction instead of iteratively refining histograms for every block.
+  void BuildGlobalIndex(bool invertOrder)
+  {
+    const vtkIdType localSize = this->LocalSorter->Array ? this->LocalSorter->ArraySize : 0;
+    this->GlobalIndex.clear();
+    this->GlobalIndexOffsets.assign(this->NumProcs + 1, 0);
+    if (this->NumProcs == 1)
+    {
+      this->GlobalIndexOffsets[1] = localSize;
+      return;
+    }
+
+    auto localItem = [this](vtkIdType position) {
+      IndexItem item;
+      item.Value = this->LocalSorter->Array[position].Value;
+      item.Process = this->Me;
+      item.Position = position;
+      return item;
+    };
+    auto precedes = [invertOrder](const IndexItem& a, const IndexItem& b) {
+      return Precedes(a, b, invertOrder);
+    };
+
+    // Select regularly spaced samples of the locally sorted array, use -1 as
+    // process id for missing samples so that every process sends as many.
+    std::vector<IndexItem> samples(this->NumProcs);
+    for (int cc = 0; cc < this->NumProcs; ++cc)
+    {
+      if (localSize > 0)
       {
-        this->GlobalHistogram->TotalValues += bufferHistogramValues[idx];
-        this->GlobalHistogram->Values[idx % HISTOGRAM_SIZE] += bufferHistogramValues[idx];
+        samples[cc] = localItem((cc * localSize) / this->NumProcs);
+      }
+      else
+      {
+        samples[cc].Value = 0;
+        samples[cc].Process = -1;
+        samples[cc].Position = 0;
+      }
+    }
+    const vtkIdType itemSize = static_cast<vtkIdType>(GetPackedItemSize());
+    std::vector<char> sendBuffer;
+    std::vector<char> recvBuffer(this->NumProcs * this->NumProcs * itemSize);
+    PackItems(samples, sendBuffer);
+    this->MPI->AllGather(sendBuffer.data(), recvBuffer.data(), itemSize * this->NumProcs);
+    std::vector<IndexItem> allSamples;
+    UnpackItems(recvBuffer, allSamples);
+    allSamples.erase(std::remove_if(allSamples.begin(), allSamples.end(),
+                       [](const IndexItem& item) { return item.Process < 0; }),
+      allSamples.end());
+    std::sort(allSamples.begin(), allSamples.end(), precedes);
+
+    // Split the locally sorted array in buckets using the same splitters on
+    // all processes.
+    std::vector<vtkIdType> bucketOffsets(this->NumProcs + 1, localSize);
+    bucketOffsets[0] = 0;
+    if (!allSamples.empty())
+    {
+      const vtkIdType nbSamples = static_cast<vtkIdType>(allSamples.size());
+      for (int bucket = 1; bucket < this->NumProcs; ++bucket)
+      {
+        const IndexItem& splitter = allSamples[(bucket * nbSamples) / this->NumProcs];
+        vtkIdType low = bucketOffsets[bucket - 1];
+        vtkIdType high = localSize;
+        while (low < high)
+        {
+          const vtkIdType middle = low + (high - low) / 2;
+          if (precedes(localItem(middle), splitter))
+          {
+            low = middle + 1;
+          }
+          else
+          {
+            high = middle;
+          }
+        }
+        bucketOffsets[bucket] = low;
       }
     }
 
-    delete[] bufferHistogramValues;
-    return 1;
+    // Exchange the bucket sizes, then gather each bucket on its owner.
+    std::vector<vtkIdType> bucketSizes(this->NumProcs);
+    for (int bucket = 0; bucket < this->NumProcs; ++bucket)
+    {
+      bucketSizes[bucket] = bucketOffsets[bucket + 1] - bucketOffsets[bucket];
+    }
+    std::vector<vtkIdType> allBucketSizes(this->NumProcs * this->NumProcs);
+    this->MPI->AllGather(bucketSizes.data(), allBucketSizes.data(), this->NumProcs);
+
+    std::vector<IndexItem> bucketItems;
+    std::vector<IndexItem> ownedItems;
+    std::vector<char> ownedBuffer;
+    std::vector<vtkIdType> recvLengths(this->NumProcs);
+    std::vector<vtkIdType> recvOffsets(this->NumProcs);
+    for (int bucket = 0; bucket < this->NumProcs; ++bucket)
+    {
+      bucketItems.clear();
+      for (vtkIdType cc = bucketOffsets[bucket]; cc < bucketOffsets[bucket + 1]; ++cc)
+      {
+        bucketItems.push_back(localItem(cc));
+      }
+      PackItems(bucketItems, sendBuffer);
+
+      vtkIdType nbOwnedItems = 0;
+      for (int pid = 0; pid < this->NumProcs; ++pid)
+      {
+        const vtkIdType size = allBucketSizes[pid * this->NumProcs + bucket];
+        recvLengths[pid] = size * itemSize;
+        recvOffsets[pid] = nbOwnedItems * itemSize;
+        nbOwnedItems += size;
+      }
+      if (bucket == this->Me)
+      {
+        ownedBuffer.resize(nbOwnedItems * itemSize);
+      }
+
+      // Make sure that buffers are valid even if empty
+      char dummy;
+      this->MPI->GatherV(sendBuffer.empty() ? &dummy : sendBuffer.data(),
+        ownedBuffer.empty() ? &dummy : ownedBuffer.data(),
+        static_cast<vtkIdType>(sendBuffer.size()), recvLengths.data(), recvOffsets.data(), bucket);
+    }
+    UnpackItems(ownedBuffer, ownedItems);
+
+    // Order the items received from all processes
+    std::sort(ownedItems.begin(), ownedItems.end(), precedes);
+    this->GlobalIndex.reserve(ownedItems.size());
+    for (const auto& item : ownedItems)
+    {
+      this->GlobalIndex.push_back(std::make_pair(item.Process, item.Position));
+    }
+
+    // Offset of each bucket in the global order
+    for (int bucket = 0; bucket < this->NumProcs; ++bucket)
+    {
+      vtkIdType size = 0;
+      for (int pid = 0; pid < this->NumProcs; ++pid)
+      {
+        size += allBucketSizes[pid * this->NumProcs + bucket];
+      }
+      this->GlobalIndexOffsets[bucket + 1] = this->GlobalIndexOffsets[bucket] + size;
+    }
+  }
+
+  // --------------------------------------------------------------------------
+  // Find the range of the locally sorted array that belongs to the
+  // [first, last[ range of the global order, using the global index.
+  void LocateGlobalRange(vtkIdType first, vtkIdType last, vtkIdType& localOffset,
+    vtkIdType& localSize)
+  {
+    if (this->NumProcs == 1)
+    {
+      localOffset = first;
+      localSize = std::max(static_cast<vtkIdType>(0), last - first);
+      return;
+    }
+
+    // Items of a given process in a range of the global order are contiguous
+    // in its locally sorted array, so their first position and their count
+    // is enough to locate them.
+    std::vector<vtkIdType> offsets(this->NumProcs, VTK_ID_MAX);
+    std::vector<vtkIdType> sizes(this->NumProcs, 0);
+    const vtkIdType bucketStart = this->GlobalIndexOffsets[this->Me];
+    const vtkIdType begin = std::max(first, bucketStart);
+    const vtkIdType end = std::min(last, this->GlobalIndexOffsets[this->Me + 1]);
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      const auto& item = this->GlobalIndex[cc - bucketStart];
+      offsets[item.first] = std::min(offsets[item.first], item.second);
+      sizes[item.first]++;
+    }
+
+    std::vector<vtkIdType> globalOffsets(this->NumProcs);
+    std::vector<vtkIdType> globalSizes(this->NumProcs);
+    this->MPI->AllReduce(
+      offsets.data(), globalOffsets.data(), this->NumProcs, vtkCommunicator::MIN_OP);
+    this->MPI->AllReduce(
+      sizes.data(), globalSizes.data(), this->NumProcs, vtkCommunicator::SUM_OP);
+    localSize = globalSizes[this->Me];
+    localOffset = localSize > 0 ? globalOffsets[this->Me] : 0;
   }
 
   // --------------------------------------------------------------------------
@@ -850,38 +1072,23 @@ public:
   {
     // ------------------------------------------------------------------------
     // Make sure that the Cache is built
-    //    This will sort the local array, that's why we don't want to do it
+    //    This will sort the data globally, that's why we don't want to do it
     //    at each execution. Specially when we only change the requested block.
     // ------------------------------------------------------------------------
-    if (this->NeedToBuildCache)
+    if (this->NeedToBuildCache || this->GlobalIndexOffsets.empty())
     {
       this->BuildCache(true, revertOrder);
     }
 
     // ------------------------------------------------------------------------
-    // Search for lower bound
+    // Locate the requested block in the locally sorted array
     // ------------------------------------------------------------------------
-    vtkIdType nbElementsToRemoveFromHead = 0;
+    const vtkIdType totalSize = this->GlobalIndexOffsets.back();
+    const vtkIdType first = std::min(block * blockSize, totalSize);
+    const vtkIdType last = std::min(first + blockSize, totalSize);
     vtkIdType localOffset = 0;
-    vtkIdType nbElementsInBar = 0;
-    this->SearchGlobalIndexLocation((block * blockSize), this->LocalSorter->Histo,
-      this->GlobalHistogram, nbElementsToRemoveFromHead, localOffset, nbElementsInBar);
-
-    // ------------------------------------------------------------------------
-    // Search for upper bound
-    // ------------------------------------------------------------------------
-    vtkIdType upperOffset = 0;
-    vtkIdType globalUpperOffset = 0;
-    vtkIdType searchIdx = (this->GlobalHistogram->TotalValues < (block + 1) * blockSize)
-      ? this->GlobalHistogram->TotalValues
-      : ((block + 1) * blockSize);
-    searchIdx--; // It is not a size it is an index (so -1)
-
-    this->SearchGlobalIndexLocation(searchIdx, this->LocalSorter->Histo, this->GlobalHistogram,
-      globalUpperOffset, upperOffset, nbElementsInBar);
-
-    // We have to include our searched index (so +1)
-    vtkIdType localSize = (upperOffset + nbElementsInBar) - localOffset + 1;
+    vtkIdType localSize = 0;
+    this->LocateGlobalRange(first, last, localOffset, localSize);
 
     // ------------------------------------------------------------------------
     // Build local subset table
@@ -903,7 +1110,7 @@ public:
       vtkSmartPointer<vtkIdTypeArray> processIdArray = vtkSmartPointer<vtkIdTypeArray>::New();
       processIdArray->SetName("vtkOriginalProcessIds");
       processIdArray->SetNumberOfComponents(1);
-      processIdArray->Allocate((blockSize < localSize) ? localSize : blockSize);
+      processIdArray->Allocate(blockSize);
       for (vtkIdType idx = 0; idx < localSubset->GetNumberOfRows(); idx++)
       {
         processIdArray->InsertNextTuple1(mergePid);
@@ -949,14 +1156,14 @@ public:
         vtkSortedTableStreamer::PrintInfo(localSubset.GetPointer());
       }
 
+      // The merged table only contains the requested block, just sort it
       ArraySorter sorter;
       sorter.Update(static_cast<T*>(subsetArray->GetVoidPointer(0)),
         subsetArray->GetNumberOfTuples(), subsetArray->GetNumberOfComponents(),
         this->SelectedComponent, HISTOGRAM_SIZE, this->CommonRange, revertOrder);
 
-      // trim it (remove head and tail that don't belong to the result)
-      localSubset.TakeReference(this->NewSubsetTable(
-        localSubset.GetPointer(), &sorter, nbElementsToRemoveFromHead, blockSize));
+      localSubset.TakeReference(
+        this->NewSubsetTable(localSubset.GetPointer(), &sorter, 0, blockSize));
 
       // Add extra information such as structured indices, block number...
       this->DecorateTable(input, localSubset.GetPointer(), mergePid);
@@ -973,73 +1180,6 @@ public:
     return 1;
   }
 
-  // --------------------------------------------------------------------------
-  // nbGlobalToSkip is the number of elements that should be skipped at the end
-  // if you exactly want to reach the searchedGlobalIndex.
-  // localOffset is the corresponding local index in the sorted table to the
-  // global index of (searchedGlobalIndex - nbGlobalToSkip)
-  // nbInLocalBar is the local number of elements that are available
-  // in the histogram bar where the searchedGlobalIndex has been found.
-  // nbInLocalBar is used when you want to get an upper bound that
-  // will include the searchedGlobalIndex.
-  void SearchGlobalIndexLocation(vtkIdType searchedGlobalIndex, Histogram* localHistogram,
-    Histogram* globalHistogram, vtkIdType& nbGlobalToSkip, vtkIdType& localOffset,
-    vtkIdType& nbInLocalBar)
-  {
-    // Communication buffer
-    vtkIdType* bufferHistogramValues = new vtkIdType[this->NumProcs * HISTOGRAM_SIZE];
-
-    // Local internal working var
-    vtkIdType histogramBarIdx = -1;
-    double currentRange[2];
-    vtkIdType idx, idxEnd;
-
-    // Setup initial histogram range and values
-    Histogram _globalHistogram;
-    Histogram _localHistogram;
-    localHistogram->CopyTo(_localHistogram);
-    globalHistogram->CopyTo(_globalHistogram);
-
-    // Reset local offsets
-    localOffset = 0;
-    nbGlobalToSkip = searchedGlobalIndex;
-
-    do
-    {
-      nbGlobalToSkip -= _globalHistogram.GetNewRange(nbGlobalToSkip, histogramBarIdx, currentRange);
-
-      localOffset += _localHistogram.GetNumberOfElements(0, histogramBarIdx);
-      nbInLocalBar = _localHistogram.GetNumberOfElements(histogramBarIdx, histogramBarIdx + 1);
-
-      // Based on a narrowed range, build local histogram to get closer to the
-      // real index of the object
-      _localHistogram.SetScalarRange(currentRange);
-      _localHistogram.ClearHistogramValues();
-
-      idxEnd = localOffset + nbInLocalBar;
-      for (idx = localOffset; idx < idxEnd; ++idx)
-      {
-        _localHistogram.AddValue(this->LocalSorter->Array[idx].Value);
-      }
-
-      // Exchange local histo with everyone
-      this->MPI->AllGather(_localHistogram.Values, bufferHistogramValues, HISTOGRAM_SIZE);
-
-      // Build global histogram
-      _globalHistogram.SetScalarRange(currentRange);
-      _globalHistogram.ClearHistogramValues();
-
-      idxEnd = this->NumProcs * HISTOGRAM_SIZE;
-      for (idx = 0; idx < idxEnd; ++idx)
-      {
-        _globalHistogram.TotalValues += bufferHistogramValues[idx];
-        _globalHistogram.Values[idx % HISTOGRAM_SIZE] += bufferHistogramValues[idx];
-      }
-    } while (nbGlobalToSkip > 0 && _globalHistogram.CanBeReduced());
-
-    delete[] bufferHistogramValues;
-  }
-
   // --------------------------------------------------------------------------
   static vtkTable* NewSubsetTable(
     vtkTable* srcTable, ArraySorter* sorter, vtkIdType offset, vtkIdType size)
@@ -1315,7 +1455,6 @@ private:
   vtkMTimeType DataMTime;     // Keep the original data MTime
   vtkDataArray* DataToSort;   // DataArray to sort
   ArraySorter* LocalSorter;   // Local ArraySorter based on global range
-  Histogram* GlobalHistogram; // Globaly merged Histogram based on global range
   double CommonRange[2];      // Scalar range used across processes
   int Me;                     // Current process ID
   int NumProcs;               // Number of processes involved
@@ -1324,6 +1463,12 @@ private:
   bool NeedToBuildCache;
   bool Debug;
 
+  // Bucket of the global order owned by this process, as (process id,
+  // position in the locally sorted array) pairs, and offsets of all the
+  // buckets in the global order.
+  std::vector<std::pair<vtkIdType, vtkIdType> > GlobalIndex;
+  std::vector<vtkIdType> GlobalIndexOffsets;
+
   const static int VTK_TABLE_EXCHANGE_TAG = 50;
   // HISTOGRAM_SIZE could be computed dynamically based on the type of the
   // array to sort but to make sure that unsigned char won't be distributed
@@ -1333,6 +1478,25 @@ private:
   // the best.
   const static int HISTOGRAM_SIZE = 256;
 };
+//****************************************************************************
+namespace
+{
+// Returns the modification time of a partitioned dataset, accounting for
+// its partitions.
+vtkMTimeType GetMTimeWithPartitions(vtkPartitionedDataSet* ptd)
+{
+  vtkMTimeType mtime = ptd->GetMTime();
+  for (unsigned int cc = 0, max = ptd->GetNumberOfPartitions(); cc < max; ++cc)
+  {
+    if (auto dobj = ptd->GetPartitionAsDataObject(cc))
+    {
+      mtime = std::max(mtime, dobj->GetMTime());
+    }
+  }
+  return mtime;
+}
+}
+
 //****************************************************************************
 vtkStandardNewMacro(vtkSortedTableStreamer);
 vtkCxxSetObjectMacro(vtkSortedTableStreamer, Controller, vtkMultiProcessController);
@@ -1348,6 +1512,7 @@ vtkSortedTableStreamer::vtkSortedTableStreamer()
   this->BlockSize = 1024;
   this->Internal = nullptr;
   this->SelectedComponent = 0;
+  this->MergedInputMTime = 0;
   this->SetController(vtkMultiProcessController::GetGlobalController());
 }
 
@@ -1504,25 +1669,33 @@ int vtkSortedTableStreamer::RequestData(vtkInformation* vtkNotUsed(request),
   // Manage multiblock dataset by merging data into a single vtkTable
   auto inputPTD = vtkPartitionedDataSet::GetData(inputVector[0], 0);
 
-  vtkSmartPointer<vtkTable> input = this->MergeBlocks(inputPTD);
-  if (vtkDataTabulator::HasInputCompositeIds(inputPTD))
+  // Merging the partitions creates a new table, which would invalidate the
+  // sorted index, hence only merge them again when the input has changed.
+  if (!this->MergedInput || this->MergedInputMTime != ::GetMTimeWithPartitions(inputPTD))
   {
-    if (input->GetColumnByName("vtkCompositeIndexArray") == nullptr)
+    vtkSmartPointer<vtkTable> merged = this->MergeBlocks(inputPTD);
+    if (vtkDataTabulator::HasInputCompositeIds(inputPTD))
     {
-      auto array = this->GenerateCompositeIndexArray(inputPTD, input->GetNumberOfRows());
-      input->GetRowData()->AddArray(array);
-    }
-    if (input->GetColumnByName("vtkBlockNameIndices") == nullptr)
-    {
-      // add name array.
-      auto array_pair = this->GenerateBlockNameArray(inputPTD, input->GetNumberOfRows());
-      if (array_pair.first && array_pair.second)
+      if (merged->GetColumnByName("vtkCompositeIndexArray") == nullptr)
       {
-        input->GetRowData()->AddArray(array_pair.second);
-        input->GetFieldData()->AddArray(array_pair.first);
+        auto array = this->GenerateCompositeIndexArray(inputPTD, merged->GetNumberOfRows());
+        merged->GetRowData()->AddArray(array);
+      }
+      if (merged->GetColumnByName("vtkBlockNameIndices") == nullptr)
+      {
+        // add name array.
+        auto array_pair = this->GenerateBlockNameArray(inputPTD, merged->GetNumberOfRows());
+        if (array_pair.first && array_pair.second)
+        {
+          merged->GetRowData()->AddArray(array_pair.second);
+          merged->GetFieldData()->AddArray(array_pair.first);
+        }
       }
     }
+    this->MergedInput = merged;
+    this->MergedInputMTime = ::GetMTimeWithPartitions(inputPTD);
   }
+  vtkTable* input = this->MergedInput;
 
   // Get input data
   vtkInformation* outInfo = outputVector->GetInformationObject(0);
@@ -1586,6 +1759,11 @@ const char* vtkSortedTableStreamer::GetColumnNameToSort()
 //----------------------------------------------------------------------------
 void vtkSortedTableStreamer::SetColumnNameToSort(const char* columnName)
 {
+  // Keep the sorted index when the column does not change
+  if (columnName && this->ColumnToSort && strcmp(columnName, this->ColumnToSort) == 0)
+  {
+    return;
+  }
   this->SetColumnToSort(columnName);
   if (strcmp("vtkOriginalProcessIds", this->GetColumnToSort()) != 0)
   {
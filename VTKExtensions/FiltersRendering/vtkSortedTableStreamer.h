@@ -20,6 +20,11 @@
  * This filter is used quickly get a sorted subset of a given vtkTable.
  * By sorted we mean a subset build from a global sort even if some optimisation
  * allow us to skip a global table sorting.
+ *
+ * The first request sorts the table across all processes using a sample sort
+ * and keeps the resulting global sorted index until the input data, the
+ * column to sort or the order changes. Requesting another block then only
+ * costs a reduction over the processes and the exchange of the block rows.
 */
 
 #ifndef vtkSortedTableStreamer_h
@@ -137,6 +142,11 @@ private:
   vtkSortedTableStreamer(const vtkSortedTableStreamer&) = delete;
   void operator=(const vtkSortedTableStreamer&) = delete;
 
+  // Input partitions merged into a single table, kept between requests so
+  // that the sorted index stays valid until the input changes.
+  vtkSmartPointer<vtkTable> MergedInput;
+  vtkMTimeType MergedInputMTime;
+
   vtkSmartPointer<vtkTable> MergeBlocks(vtkPartitionedDataSet* cd);
   vtkSmartPointer<vtkUnsignedIntArray> GenerateCompositeIndexArray(
     vtkPartitionedDataSet* cd, vtkIdType maxSize);
@@ -21,10 +21,181 @@
 #include "vtkObjectFactory.h"
 #include "vtkUnsignedCharArray.h"
 #include <algorithm>
+#include <cassert>
+#include <cstring>
 #include <sstream>
 
 vtkStandardNewMacro(vtkSquirtCompressor);
 
+namespace
+{
+// Returns the number of consecutive set bits, starting from the lowest one.
+inline int CountTrailingOnes(unsigned int bits)
+{
+#if defined(__GNUC__)
+  return bits == ~0u ? 32 : __builtin_ctz(~bits);
+#else
+  int count = 0;
+  for (; count < 32 && (bits & 1u); bits >>= 1)
+  {
+    ++count;
+  }
+  return count;
+#endif
+}
+
+// Returns the number of pixels following `pixels[0]`, at most 15, whose masked
+// color is the same as that of `pixels[0]`. `available` is the number of
+// pixels, including `pixels[0]`, that can be read. When enough pixels are
+// available, the 15 pixels are compared without any early exit so that the
+// comparison is vectorized by the compiler.
+inline int RunLengthRGBA(const unsigned int* pixels, vtkIdType available, unsigned int mask)
+{
+  const unsigned int color = pixels[0] & mask;
+  if (available > 15)
+  {
+    unsigned int same = 0;
+    for (int cc = 1; cc <= 15; ++cc)
+    {
+      same |= static_cast<unsigned int>((pixels[cc] & mask) == color) << (cc - 1);
+    }
+    return CountTrailingOnes(same & 0x7FFF);
+  }
+
+  int count = 0;
+  while (count + 1 < available && (pixels[count + 1] & mask) == color)
+  {
+    ++count;
+  }
+  return count;
+}
+
+// Run-length encodes `numPixels` RGBA pixels into `runs`, which must be able to
+// hold `numPixels` runs. Returns the number of runs.
+vtkIdType CompressRGBA(
+  const unsigned int* pixels, vtkIdType numPixels, unsigned int mask, unsigned int* runs)
+{
+  vtkIdType index = 0;
+  vtkIdType comp_index = 0;
+  while (index < numPixels)
+  {
+    // Record color
+    const unsigned int current_color = runs[comp_index] = pixels[index];
+    unsigned char opacity = *(((const unsigned char*)&current_color) + 3);
+
+    // Compute Run
+    int count = RunLengthRGBA(pixels + index, numPixels - index, mask);
+    index += count + 1;
+    if (opacity > 0)
+    {
+      opacity /= 16; // since we want to encode 8-bit opacity into 4 bits.
+      opacity = opacity << 4;
+      count |= opacity;
+    }
+
+    // Record Run length
+    *((unsigned char*)runs + comp_index * 4 + 3) = (unsigned char)count;
+    comp_index++;
+  }
+  return comp_index;
+}
+
+// Run-length encodes `numPixels` RGB pixels into `runs`, which must be able to
+// hold `numPixels` runs. Returns the number of runs.
+vtkIdType CompressRGB(
+  const unsigned char* pixels, vtkIdType numPixels, unsigned int mask, unsigned int* runs)
+{
+  vtkIdType index = 0;
+  vtkIdType comp_index = 0;
+  while (index < numPixels)
+  {
+    // Record color
+    unsigned int current_color = 0;
+    memcpy(&current_color, pixels + 3 * index, 3);
+    runs[comp_index] = current_color;
+    index++;
+
+    // Compute Run
+    const unsigned int masked_color = current_color & mask;
+    int count = 0;
+    for (; index < numPixels && count < 255; ++index, ++count)
+    {
+      unsigned int next_color = 0;
+      memcpy(&next_color, pixels + 3 * index, 3);
+      if ((next_color & mask) != masked_color)
+      {
+        break;
+      }
+    }
+
+    // Record Run length
+    reinterpret_cast<unsigned char*>(runs)[comp_index * 4 + 3] = static_cast<unsigned char>(count);
+    comp_index++;
+  }
+  return comp_index;
+}
+
+// Decodes `numRuns` runs into at most `numPixels` RGBA pixels. Returns the
+// number of pixels decoded.
+vtkIdType DecompressRGBA(
+  const unsigned int* runs, vtkIdType numRuns, unsigned int* pixels, vtkIdType numPixels)
+{
+  vtkIdType index = 0;
+  for (vtkIdType i = 0; i < numRuns; i++)
+  {
+    // Get color and count
+    unsigned int current_color = runs[i];
+
+    // Get run length count;
+    int count = *((unsigned char*)&current_color + 3);
+
+    if (count > 0x0f)
+    {
+      // we have some opacity.
+      unsigned char opacity = (count & 0xF0);
+      opacity = opacity >> 4;
+      opacity *= 16;
+      *((unsigned char*)&current_color + 3) = opacity;
+    }
+    else
+    {
+      *((unsigned char*)&current_color + 3) = 0;
+    }
+    count &= 0x0F;
+
+    // Blast color into color buffer
+    const vtkIdType length = std::min<vtkIdType>(count + 1, numPixels - index);
+    std::fill_n(pixels + index, length, current_color);
+    index += length;
+  }
+  return index;
+}
+
+// Decodes `numRuns` runs into at most `numPixels` RGB pixels. Returns the
+// number of pixels decoded.
+vtkIdType DecompressRGB(
+  const unsigned int* runs, vtkIdType numRuns, unsigned char* pixels, vtkIdType numPixels)
+{
+  vtkIdType index = 0;
+  for (vtkIdType i = 0; i < numRuns; i++)
+  {
+    // Get color and count
+    const unsigned int current_color = runs[i];
+
+    // Get run length count;
+    const int count = *((const unsigned char*)&current_color + 3);
+
+    const vtkIdType length = std::min<vtkIdType>(count + 1, numPixels - index);
+    for (vtkIdType j = 0; j < length; j++)
+    {
+      memcpy(pixels + 3 * (index + j), &current_color, 3);
+    }
+    index += length;
+  }
+  return index;
+}
+}
+
 //-----------------------------------------------------------------------------
 vtkSquirtCompressor::vtkSquirtCompressor()
   : SquirtLevel(3)
@@ -44,19 +215,14 @@ int vtkSquirtCompressor::Compress()
   }
 
   vtkUnsignedCharArray* input = this->GetInput();
-
-  if (input->GetNumberOfComponents() != 4 && input->GetNumberOfComponents() != 3)
+  const int numComps = input->GetNumberOfComponents();
+  if (numComps != 4 && numComps != 3)
   {
     vtkErrorMacro("Squirt only works with RGBA or RGB");
     return VTK_ERROR;
   }
 
-  int count = 0;
-  int index = 0;
-  int comp_index = 0;
-  int end_index;
   int compress_level = this->LossLessMode ? 0 : this->SquirtLevel;
-  unsigned int current_color;
   unsigned char compress_masks[6][4] = { { 0xFF, 0xFF, 0xFF, 0xFF }, { 0xFE, 0xFF, 0xFE, 0xFE },
     { 0xFC, 0xFE, 0xFC, 0xFC }, { 0xF8, 0xFC, 0xF8, 0xF8 }, { 0xF0, 0xF8, 0xF0, 0xF0 },
     { 0xE0, 0xF0, 0xE0, 0xE0 } };
@@ -72,104 +238,35 @@ int vtkSquirtCompressor::Compress()
   // I shifted the level by one so that 0 means no compression.
   memcpy(&compress_mask, &compress_masks[compress_level], 4);
 
-  // Access raw arrays directly
-  if (input->GetNumberOfComponents() == 4)
-  {
-    unsigned int* _rawColorBuffer;
-    unsigned int* _rawCompressedBuffer;
-    int numPixels = input->GetNumberOfTuples();
-    _rawColorBuffer = (unsigned int*)input->GetPointer(0);
-    _rawCompressedBuffer = (unsigned int*)this->Output->WritePointer(0, numPixels * 4);
-    end_index = numPixels;
-
-    // Go through color buffer and put RLE format into compressed buffer
-    while ((index < end_index) && (comp_index < end_index))
-    {
-
-      // Record color
-      current_color = _rawCompressedBuffer[comp_index] = _rawColorBuffer[index];
-      unsigned char opacity = *(((unsigned char*)&current_color) + 3);
-      index++;
-
-      // Compute Run
-      while ((index < end_index) && (count < 0x0F) &&
-        ((current_color & compress_mask) == (_rawColorBuffer[index] & compress_mask)))
-      {
-        index++;
-        count++;
-      }
-      if (opacity > 0)
-      {
-        opacity /= 16; // since we want to encode 8-bit opacity into 4 bits.
-        opacity = opacity << 4;
-        count |= opacity;
-      }
-
-      // Record Run length
-      *((unsigned char*)_rawCompressedBuffer + comp_index * 4 + 3) = (unsigned char)count;
-      comp_index++;
+  // Each pixel results in at most one run.
+  auto compress = [&](const unsigned char* pixels, vtkIdType numPixels, unsigned int* runs) {
+    return numComps == 4 ? ::CompressRGBA(reinterpret_cast<const unsigned int*>(pixels), numPixels,
+                             compress_mask, runs)
+                         : ::CompressRGB(pixels, numPixels, compress_mask, runs);
+  };
 
-      count = 0;
-    }
-  }
-  else if (input->GetNumberOfComponents() == 3)
+  if (this->UseStrips)
   {
-    unsigned char* _rawColorBuffer;
-    unsigned int* _rawCompressedBuffer;
-    int numPixels = input->GetNumberOfTuples();
-    _rawColorBuffer = (unsigned char*)input->GetPointer(0);
-    _rawCompressedBuffer = (unsigned int*)this->Output->WritePointer(0, numPixels * 4);
-    end_index = numPixels;
-
-    // Go through color buffer and put RLE format into compressed buffer
-    while ((index < 3 * numPixels) && (comp_index < end_index))
-    {
-
-      int next_color = 0;
-      // Record color
-      unsigned char* p = (unsigned char*)&current_color;
-      *p++ = _rawColorBuffer[index];
-      *p++ = _rawColorBuffer[index + 1];
-      *p++ = _rawColorBuffer[index + 2];
-      *p = 0x0;
-
-      _rawCompressedBuffer[comp_index] = current_color;
-      index += 3;
-
-      p = (unsigned char*)&next_color;
-      *p++ = _rawColorBuffer[index];
-      *p++ = _rawColorBuffer[index + 1];
-      *p++ = _rawColorBuffer[index + 2];
-      *p = 0x0;
-
-      // Compute Run
-      while (((current_color & compress_mask) == (next_color & compress_mask)) &&
-        (index < 3 * numPixels) && (count < 255))
-      {
-        index += 3;
-        count++;
-        if (index < 3 * numPixels)
-        {
-          p = (unsigned char*)&next_color;
-          *p++ = _rawColorBuffer[index];
-          *p++ = _rawColorBuffer[index + 1];
-          *p++ = _rawColorBuffer[index + 2];
-          *p = 0x0;
-        }
-      }
-
-      // Record Run length
-      reinterpret_cast<unsigned char*>(_rawCompressedBuffer)[comp_index * 4 + 3] =
-        static_cast<unsigned char>(count);
-      comp_index++;
-
-      count = 0;
-    }
+    return this->CompressStrips([&](const unsigned char* pixels, vtkIdType numPixels,
+             std::vector<unsigned char>& compressed) {
+      compressed.resize(static_cast<size_t>(numPixels) * 4);
+      const vtkIdType numRuns =
+        compress(pixels, numPixels, reinterpret_cast<unsigned int*>(compressed.data()));
+      compressed.resize(static_cast<size_t>(numRuns) * 4);
+      return true;
+    })
+      ? VTK_OK
+      : VTK_ERROR;
   }
 
+  const vtkIdType numPixels = input->GetNumberOfTuples();
+  unsigned int* runs =
+    reinterpret_cast<unsigned int*>(this->Output->WritePointer(0, numPixels * 4));
+  const vtkIdType numRuns = compress(input->GetPointer(0), numPixels, runs);
+
   // Back to vtk arrays :)
   this->Output->SetNumberOfComponents(1);
-  this->Output->SetNumberOfTuples(4 * comp_index);
+  this->Output->SetNumberOfTuples(4 * numRuns);
 
   return VTK_OK;
 }
@@ -207,51 +304,21 @@ int vtkSquirtCompressor::DecompressRGBA()
   vtkUnsignedCharArray* out = this->GetOutput();
   assert(out->GetNumberOfComponents() == 4);
 
-  int count = 0;
-  int index = 0;
-  unsigned int current_color;
-  unsigned int* _rawColorBuffer;
-  unsigned int* _rawCompressedBuffer;
-
-  // Get compressed buffer size
-  int CompSize = in->GetNumberOfTuples() / 4; /// NOTE 1->4
-
-  // Access raw arrays directly
-  _rawColorBuffer = (unsigned int*)out->GetPointer(0);
-  _rawCompressedBuffer = (unsigned int*)in->GetPointer(0);
-
-  // Go through compress buffer and extract RLE format into color buffer
-  for (int i = 0; i < CompSize; i++)
+  if (vtkImageCompressor::HasStrips(in))
   {
-    // Get color and count
-    current_color = _rawCompressedBuffer[i];
-
-    // Get run length count;
-    count = *((unsigned char*)&current_color + 3);
-
-    if (count > 0x0f)
-    {
-      // we have some opacity.
-      unsigned char opacity = (count & 0xF0);
-      opacity = opacity >> 4;
-      opacity *= 16;
-      *((unsigned char*)&current_color + 3) = opacity;
-    }
-    else
-    {
-      *((unsigned char*)&current_color + 3) = 0;
-    }
-    count &= 0x0F;
-
-    // Set color
-    _rawColorBuffer[index++] = current_color;
-
-    // Blast color into color buffer
-    for (int j = 0; j < count; j++)
-    {
-      _rawColorBuffer[index++] = current_color;
-    }
+    return this->DecompressStrips([](const unsigned char* compressed, vtkIdType size,
+             unsigned char* pixels, vtkIdType numPixels) {
+      return ::DecompressRGBA(reinterpret_cast<const unsigned int*>(compressed), size / 4,
+               reinterpret_cast<unsigned int*>(pixels), numPixels) == numPixels;
+    })
+      ? VTK_OK
+      : VTK_ERROR;
   }
+
+  // Get compressed buffer size
+  const vtkIdType CompSize = in->GetNumberOfTuples() / 4; /// NOTE 1->4
+  ::DecompressRGBA(reinterpret_cast<const unsigned int*>(in->GetPointer(0)), CompSize,
+    reinterpret_cast<unsigned int*>(out->GetPointer(0)), out->GetNumberOfTuples());
   return VTK_OK;
 }
 
@@ -262,40 +329,21 @@ int vtkSquirtCompressor::DecompressRGB()
   vtkUnsignedCharArray* out = this->GetOutput();
   assert(out->GetNumberOfComponents() == 3);
 
-  int count = 0;
-  unsigned int current_color;
-  unsigned char* _rawColorBuffer;
-  unsigned int* _rawCompressedBuffer;
-
-  // Get compressed buffer size
-  int CompSize = in->GetNumberOfTuples() / 4; /// NOTE 1->4
-
-  // Access raw arrays directly
-  _rawColorBuffer = (unsigned char*)out->GetPointer(0);
-  _rawCompressedBuffer = (unsigned int*)in->GetPointer(0);
-
-  // Go through compress buffer and extract RLE format into color buffer
-  for (int i = 0; i < CompSize; i++)
+  if (vtkImageCompressor::HasStrips(in))
   {
-    // Get color and count
-    current_color = _rawCompressedBuffer[i];
-
-    // Get run length count;
-    count = *((unsigned char*)&current_color + 3);
-
-    *((unsigned char*)&current_color + 3) = 0xff;
-
-    unsigned char current_color_rgb[3];
-    std::copy(reinterpret_cast<const unsigned char*>(&current_color),
-      reinterpret_cast<const unsigned char*>(&current_color) + 3, current_color_rgb);
-    std::copy(current_color_rgb, current_color_rgb + 3, _rawColorBuffer);
-    _rawColorBuffer += 3;
-    for (int j = 0; j < count; j++)
-    {
-      std::copy(current_color_rgb, current_color_rgb + 3, _rawColorBuffer);
-      _rawColorBuffer += 3;
-    }
+    return this->DecompressStrips([](const unsigned char* compressed, vtkIdType size,
+             unsigned char* pixels, vtkIdType numPixels) {
+      return ::DecompressRGB(reinterpret_cast<const unsigned int*>(compressed), size / 4, pixels,
+               numPixels) == numPixels;
+    })
+      ? VTK_OK
+      : VTK_ERROR;
   }
+
+  // Get compressed buffer size
+  const vtkIdType CompSize = in->GetNumberOfTuples() / 4; /// NOTE 1->4
+  ::DecompressRGB(reinterpret_cast<const unsigned int*>(in->GetPointer(0)), CompSize,
+    out->GetPointer(0), out->GetNumberOfTuples());
   return VTK_OK;
 }
 
@@ -303,7 +351,7 @@ int vtkSquirtCompressor::DecompressRGB()
 void vtkSquirtCompressor::SaveConfiguration(vtkMultiProcessStream* stream)
 {
   vtkImageCompressor::SaveConfiguration(stream);
-  *stream << this->SquirtLevel;
+  *stream << this->SquirtLevel << (this->UseStrips ? 1 : 0);
 }
 
 //-----------------------------------------------------------------------------
@@ -312,6 +360,13 @@ bool vtkSquirtCompressor::RestoreConfiguration(vtkMultiProcessStream* stream)
   if (vtkImageCompressor::RestoreConfiguration(stream))
   {
     *stream >> this->SquirtLevel;
+    // configurations from older versions do not have this.
+    int useStrips = 0;
+    if (!stream->Empty())
+    {
+      *stream >> useStrips;
+    }
+    this->SetUseStrips(useStrips != 0);
     return true;
   }
   return false;
@@ -321,7 +376,8 @@ bool vtkSquirtCompressor::RestoreConfiguration(vtkMultiProcessStream* stream)
 const char* vtkSquirtCompressor::SaveConfiguration()
 {
   std::ostringstream oss;
-  oss << vtkImageCompressor::SaveConfiguration() << " " << this->SquirtLevel;
+  oss << vtkImageCompressor::SaveConfiguration() << " " << this->SquirtLevel << " "
+      << (this->UseStrips ? 1 : 0);
 
   this->SetConfiguration(oss.str().c_str());
 
@@ -336,7 +392,10 @@ const char* vtkSquirtCompressor::RestoreConfiguration(const char* stream)
   {
     std::istringstream iss(stream);
     iss >> this->SquirtLevel;
-    return stream + iss.tellg();
+    // configurations from older versions do not have this.
+    int useStrips;
+    this->SetUseStrips((iss >> useStrips) && useStrips != 0);
+    return iss.good() ? stream + iss.tellg() : stream + strlen(stream);
   }
   return nullptr;
 }
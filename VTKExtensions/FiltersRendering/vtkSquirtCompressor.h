@@ -44,6 +44,10 @@
  * The compressor uses a modified SQUIRT implementation where encode 4-bit
  * opacity information as well. This is needed to improve background color
  * blending for translucent renderings in ParaView.
+ *
+ * Unless `UseStrips` is off, the image is split into strips that are
+ * compressed, and decompressed, concurrently. The configuration stream is
+ * [ClassName, LossLessMode, SquirtLevel, UseStrips].
  * @par Thanks:
  * Thanks to Sandia National Laboratories for this compression technique
 */
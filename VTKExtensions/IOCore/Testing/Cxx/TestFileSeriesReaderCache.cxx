@@ -0,0 +1,133 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestFileSeriesReaderCache.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkCellArray.h"
+#include "vtkFileSeriesReader.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTestUtilities.h"
+#include "vtkXMLPolyDataReader.h"
+#include "vtkXMLPolyDataWriter.h"
+
+#include <string>
+
+#define TASSERT(x)                                                                                 \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << "ERROR: failed at " << __LINE__ << "!" << endl;                                        \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+// Each file in the series has a different number of points so that the
+// output identifies the file it was read from.
+vtkIdType NumberOfPointsForFile(int index)
+{
+  return 10 * (index + 1);
+}
+
+void WriteFile(const std::string& fname, int index)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> verts;
+  for (vtkIdType cc = 0; cc < NumberOfPointsForFile(index); ++cc)
+  {
+    points->InsertNextPoint(cc, index, 0);
+    verts->InsertNextCell(1, &cc);
+  }
+  vtkNew<vtkPolyData> pd;
+  pd->SetPoints(points);
+  pd->SetVerts(verts);
+
+  vtkNew<vtkXMLPolyDataWriter> writer;
+  writer->SetFileName(fname.c_str());
+  writer->SetInputData(pd);
+  writer->Write();
+}
+}
+
+int TestFileSeriesReaderCache(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string prefix = std::string(tempDir) + "/TestFileSeriesReaderCache_";
+  delete[] tempDir;
+
+  vtkNew<vtkXMLPolyDataReader> xmlReader;
+  vtkNew<vtkFileSeriesReader> reader;
+  reader->SetReader(xmlReader);
+  for (int cc = 0; cc < 3; ++cc)
+  {
+    const std::string fname = prefix + std::to_string(cc) + ".vtp";
+    WriteFile(fname, cc);
+    reader->AddFileName(fname.c_str());
+  }
+
+  vtkFileSeriesReader::SetCacheLimit(16);
+
+  // First visit of each time step reads the file.
+  for (int cc = 0; cc < 3; ++cc)
+  {
+    reader->UpdateTimeStep(cc);
+    auto output = vtkPolyData::SafeDownCast(reader->GetOutputDataObject(0));
+    TASSERT(output && output->GetNumberOfPoints() == NumberOfPointsForFile(cc));
+  }
+
+  // Going back is served from the cache: the internal reader's file name is
+  // not changed.
+  for (int cc : { 0, 1, 2, 1 })
+  {
+    const vtkMTimeType readerMTime = xmlReader->GetMTime();
+    reader->UpdateTimeStep(cc);
+    auto output = vtkPolyData::SafeDownCast(reader->GetOutputDataObject(0));
+    TASSERT(output && output->GetNumberOfPoints() == NumberOfPointsForFile(cc));
+    TASSERT(xmlReader->GetMTime() == readerMTime);
+  }
+
+  // Changing a reader setting invalidates cached outputs.
+  xmlReader->Modified();
+  reader->UpdateTimeStep(0);
+  {
+    auto output = vtkPolyData::SafeDownCast(reader->GetOutputDataObject(0));
+    TASSERT(output && output->GetNumberOfPoints() == NumberOfPointsForFile(0));
+  }
+  const vtkMTimeType readerMTime = xmlReader->GetMTime();
+  reader->UpdateTimeStep(1);
+  TASSERT(xmlReader->GetMTime() != readerMTime);
+
+  // Without a limit, nothing is cached.
+  vtkFileSeriesReader::SetCacheLimit(0);
+  for (int cc : { 0, 1 })
+  {
+    const vtkMTimeType mtime = xmlReader->GetMTime();
+    reader->UpdateTimeStep(cc);
+    auto output = vtkPolyData::SafeDownCast(reader->GetOutputDataObject(0));
+    TASSERT(output && output->GetNumberOfPoints() == NumberOfPointsForFile(cc));
+    TASSERT(xmlReader->GetMTime() != mtime);
+  }
+
+  // Prefetching upcoming files does not change what is read, in either
+  // direction.
+  vtkFileSeriesReader::SetPrefetchDepth(2);
+  for (int cc : { 0, 1, 2, 1, 0 })
+  {
+    reader->UpdateTimeStep(cc);
+    auto output = vtkPolyData::SafeDownCast(reader->GetOutputDataObject(0));
+    TASSERT(output && output->GetNumberOfPoints() == NumberOfPointsForFile(cc));
+  }
+  vtkFileSeriesReader::SetPrefetchDepth(0);
+
+  return EXIT_SUCCESS;
+}
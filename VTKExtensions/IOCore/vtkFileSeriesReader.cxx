@@ -27,6 +27,7 @@
 #include "vtkClientServerInterpreter.h"
 #include "vtkClientServerInterpreterInitializer.h"
 #include "vtkClientServerStream.h"
+#include "vtkDataObject.h"
 #include "vtkGenericDataObjectReader.h"
 #include "vtkInformation.h"
 #include "vtkInformationIntegerKey.h"
@@ -46,10 +47,17 @@
 #define VTK_CREATE(type, name) vtkSmartPointer<type> name = vtkSmartPointer<type>::New()
 
 #include <algorithm>
+#include <atomic>
 #include <cctype> // for isprint().
+#include <condition_variable>
+#include <deque>
+#include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "vtk_jsoncpp.h"
@@ -379,6 +387,150 @@ private:
 };
 }
 
+//=============================================================================
+// An output produced by the internal reader, along with the request it
+// satisfied.
+struct vtkFileSeriesReaderCachedOutput
+{
+  int FileIndex;
+  bool HasTime;
+  double Time;
+  int Piece;
+  int NumberOfPieces;
+  int GhostLevel;
+  vtkSmartPointer<vtkDataObject> Data;
+  unsigned long Size; // in KBs
+
+  void SetRequest(int index, vtkInformation* outInfo)
+  {
+    this->FileIndex = index;
+    this->HasTime = outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP()) != 0;
+    this->Time =
+      this->HasTime ? outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP()) : 0.0;
+    this->Piece = outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER())
+      ? outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER())
+      : 0;
+    this->NumberOfPieces =
+      outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES())
+      ? outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES())
+      : 1;
+    this->GhostLevel =
+      outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS())
+      ? outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS())
+      : 0;
+  }
+
+  bool SameRequest(const vtkFileSeriesReaderCachedOutput& other) const
+  {
+    return this->FileIndex == other.FileIndex && this->HasTime == other.HasTime &&
+      (!this->HasTime || this->Time == other.Time) && this->Piece == other.Piece &&
+      this->NumberOfPieces == other.NumberOfPieces && this->GhostLevel == other.GhostLevel;
+  }
+};
+
+//=============================================================================
+// Reads files on a background thread so that their contents are in the
+// operating system's file cache by the time the internal reader opens them.
+// The internal reader itself is never used from that thread.
+class vtkFileSeriesReaderPrefetcher
+{
+public:
+  ~vtkFileSeriesReaderPrefetcher()
+  {
+    if (this->Thread.joinable())
+    {
+      {
+        std::lock_guard<std::mutex> lock(this->Mutex);
+        this->Terminate = true;
+        this->Pending.clear();
+      }
+      this->Condition.notify_one();
+      this->Thread.join();
+    }
+  }
+
+  // Replaces any files still waiting to be prefetched.
+  void Prefetch(const std::vector<std::string>& files)
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Pending.clear();
+      for (const auto& fname : files)
+      {
+        if (std::find(this->Recent.begin(), this->Recent.end(), fname) == this->Recent.end())
+        {
+          this->Pending.push_back(fname);
+        }
+      }
+      if (this->Pending.empty())
+      {
+        return;
+      }
+      ++this->Generation;
+    }
+    if (!this->Thread.joinable())
+    {
+      this->Thread = std::thread(&vtkFileSeriesReaderPrefetcher::Run, this);
+    }
+    this->Condition.notify_one();
+  }
+
+  // Allows a file to be prefetched again, e.g. once the reader has read it.
+  void Forget(const std::string& fname)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->Recent.erase(
+      std::remove(this->Recent.begin(), this->Recent.end(), fname), this->Recent.end());
+  }
+
+private:
+  void Run()
+  {
+    std::vector<char> buffer(1 << 20);
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    while (true)
+    {
+      this->Condition.wait(lock, [this]() { return this->Terminate || !this->Pending.empty(); });
+      if (this->Terminate)
+      {
+        return;
+      }
+      const std::string fname = this->Pending.front();
+      this->Pending.pop_front();
+      const unsigned int generation = this->Generation;
+      lock.unlock();
+
+      // Stop early if new files were queued meanwhile, they are more relevant.
+      vtksys::ifstream file(fname.c_str(), std::ios::in | std::ios::binary);
+      while (file && this->Generation == generation && !this->Terminate)
+      {
+        file.read(buffer.data(), buffer.size());
+      }
+
+      const bool complete = file.eof() && !file.bad();
+      lock.lock();
+      if (complete)
+      {
+        // Remember files read completely so they are not read again until
+        // the reader consumes them.
+        this->Recent.push_back(fname);
+        if (this->Recent.size() > 64)
+        {
+          this->Recent.pop_front();
+        }
+      }
+    }
+  }
+
+  std::thread Thread;
+  std::mutex Mutex;
+  std::condition_variable Condition;
+  std::deque<std::string> Pending;
+  std::deque<std::string> Recent;
+  std::atomic<unsigned int> Generation{ 0 };
+  std::atomic<bool> Terminate{ false };
+};
+
 //=============================================================================
 struct vtkFileSeriesReaderInternals
 {
@@ -387,8 +539,29 @@ struct vtkFileSeriesReaderInternals
   std::vector<double> TimeValues;
   bool FileNameIsSet;
   vtkFileSeriesReaderTimeRanges* TimeRanges;
+
+  // Cached outputs, most recently used first. All entries were produced with
+  // the reader settings as of CacheMTime.
+  typedef std::list<vtkFileSeriesReaderCachedOutput> CacheType;
+  CacheType Cache;
+  unsigned long CacheSize = 0;
+  vtkMTimeType CacheMTime = 0;
+
+  // Set in RequestUpdateExtent when the next RequestData is to be served from
+  // the cache. The output then shares its arrays with the cache entry.
+  bool UseCachedOutput = false;
+  bool OutputSharesCache = false;
+
+  // Last file read and change in file index since the one before it, used to
+  // guess which files come next.
+  int LastFileIndex = -1;
+  int FileIndexStride = 1;
+  std::unique_ptr<vtkFileSeriesReaderPrefetcher> Prefetcher;
 };
 
+unsigned long vtkFileSeriesReader::CacheLimit = 0;
+int vtkFileSeriesReader::PrefetchDepth = 0;
+
 //=============================================================================
 vtkFileSeriesReader::vtkFileSeriesReader()
 {
@@ -408,6 +581,7 @@ vtkFileSeriesReader::vtkFileSeriesReader()
 //-----------------------------------------------------------------------------
 vtkFileSeriesReader::~vtkFileSeriesReader()
 {
+  this->ClearCachedOutputs();
   delete this->Internal->TimeRanges;
   delete this->Internal;
 }
@@ -693,10 +867,15 @@ int vtkFileSeriesReader::RequestUpdateExtent(vtkInformation* request,
   }
 
   // Make sure that the reader file name is set correctly and that
-  // RequestInformation has been called.
+  // RequestInformation has been called. If the output for this file is cached,
+  // the reader is left as is since it will not be asked for data.
   outputVector->GetInformationObject(requestFromPort)
     ->Set(FILE_SERIES_CURRENT_FILE_NUMBER(), index);
-  this->RequestInformationForInput(index);
+  this->Internal->UseCachedOutput = this->FindCachedOutput(index, outInfo);
+  if (!this->Internal->UseCachedOutput)
+  {
+    this->RequestInformationForInput(index);
+  }
 
 // I commented out the following block because it is probably not important
 // and it is causing a crash in some circumstances (bug #7253).
@@ -724,12 +903,39 @@ int vtkFileSeriesReader::RequestData(
     : 0;
   assert(requestFromPort < this->GetNumberOfOutputPorts());
 
+  vtkInformation* outInfo = outputVector->GetInformationObject(requestFromPort);
+  vtkDataObject* output = vtkDataObject::GetData(outInfo);
+  if (this->Internal->UseCachedOutput && !this->Internal->Cache.empty() && output)
+  {
+    // RequestUpdateExtent moved the entry for this request to the front.
+    this->Internal->UseCachedOutput = false;
+    output->ShallowCopy(this->Internal->Cache.front().Data);
+    this->Internal->OutputSharesCache = true;
+    this->PrefetchFilesAfter(this->Internal->Cache.front().FileIndex);
+    return 1;
+  }
+  this->Internal->UseCachedOutput = false;
+
+  if (this->Internal->OutputSharesCache && output)
+  {
+    // Make sure the reader does not modify arrays owned by a cached output.
+    output->Initialize();
+    this->Internal->OutputSharesCache = false;
+  }
+
   // We have modified the TIME_STEPS information in the output vector.  Some
   // readers (e.g. the Exodus reader) reuse this array to get time indices.
   // Just in case, restore the vector.
-  vtkInformation* outInfo = outputVector->GetInformationObject(requestFromPort);
   this->Internal->TimeRanges->GetInputTimeInfo(this->_FileIndex, outInfo);
 
+  if (this->Internal->Prefetcher && this->GetNumberOfFileNames() > 0)
+  {
+    // Once read, the file is either cached or has to be prefetched again the
+    // next time playback reaches it.
+    this->Internal->Prefetcher->Forget(
+      this->GetFileName(static_cast<unsigned int>(this->_FileIndex)));
+  }
+
   int retVal = this->Reader->ProcessRequest(request, inputVector, outputVector);
 
   if (this->GetNumberOfFileNames() > 0)
@@ -738,6 +944,12 @@ int vtkFileSeriesReader::RequestData(
     this->Internal->TimeRanges->GetAggregateTimeInfo(outInfo);
   }
 
+  if (retVal && output && vtkFileSeriesReader::CacheLimit > 0)
+  {
+    this->AddCachedOutput(static_cast<int>(this->_FileIndex), outInfo);
+  }
+
+  this->PrefetchFilesAfter(static_cast<int>(this->_FileIndex));
   return retVal;
 }
 
@@ -985,6 +1197,9 @@ void vtkFileSeriesReader::PrintSelf(ostream& os, vtkIndent indent)
      << endl;
   os << indent << "UseMetaFile: " << this->UseMetaFile << endl;
   os << indent << "IgnoreReaderTime: " << this->IgnoreReaderTime << endl;
+  os << indent << "CacheLimit: " << vtkFileSeriesReader::CacheLimit << endl;
+  os << indent << "PrefetchDepth: " << vtkFileSeriesReader::PrefetchDepth << endl;
+  os << indent << "Number of cached outputs: " << this->Internal->Cache.size() << endl;
 }
 
 //-----------------------------------------------------------------------------
@@ -992,3 +1207,150 @@ int vtkFileSeriesReader::ChooseInput(vtkInformation* outInfo)
 {
   return this->Internal->TimeRanges->ChooseInput(outInfo);
 }
+
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReader::SetCacheLimit(unsigned long limit)
+{
+  vtkFileSeriesReader::CacheLimit = limit;
+}
+
+//-----------------------------------------------------------------------------
+unsigned long vtkFileSeriesReader::GetCacheLimit()
+{
+  return vtkFileSeriesReader::CacheLimit;
+}
+
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReader::SetPrefetchDepth(int depth)
+{
+  vtkFileSeriesReader::PrefetchDepth = depth;
+}
+
+//-----------------------------------------------------------------------------
+int vtkFileSeriesReader::GetPrefetchDepth()
+{
+  return vtkFileSeriesReader::PrefetchDepth;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkFileSeriesReader::FindCachedOutput(int index, vtkInformation* outInfo)
+{
+  // Within ProcessRequest(), BeforeFileNameMTime is the MTime of this reader
+  // and the internal reader ignoring the file name changes we make.
+  auto& internals = *this->Internal;
+  if (vtkFileSeriesReader::CacheLimit == 0 || internals.CacheMTime != this->BeforeFileNameMTime)
+  {
+    // Either caching was turned off or the reader settings changed since the
+    // outputs were cached, they are stale.
+    this->ClearCachedOutputs();
+    return false;
+  }
+
+  vtkFileSeriesReaderCachedOutput request;
+  request.SetRequest(index, outInfo);
+  for (auto iter = internals.Cache.begin(); iter != internals.Cache.end(); ++iter)
+  {
+    if (iter->SameRequest(request))
+    {
+      internals.Cache.splice(internals.Cache.begin(), internals.Cache, iter);
+      vtkLogF(TRACE, "%s: using cached output for file %d", vtkLogIdentifier(this), index);
+      return true;
+    }
+  }
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReader::AddCachedOutput(int index, vtkInformation* outInfo)
+{
+  auto& internals = *this->Internal;
+  if (internals.CacheMTime != this->BeforeFileNameMTime)
+  {
+    this->ClearCachedOutputs();
+    internals.CacheMTime = this->BeforeFileNameMTime;
+  }
+
+  vtkDataObject* output = vtkDataObject::GetData(outInfo);
+  vtkFileSeriesReaderCachedOutput entry;
+  entry.SetRequest(index, outInfo);
+  entry.Data.TakeReference(output->NewInstance());
+  entry.Data->ShallowCopy(output);
+  entry.Size = entry.Data->GetActualMemorySize();
+
+  const unsigned long limit = vtkFileSeriesReader::CacheLimit * 1024;
+  if (entry.Size > limit)
+  {
+    return;
+  }
+
+  // The output now shares arrays with the cache entry.
+  internals.OutputSharesCache = true;
+  for (auto iter = internals.Cache.begin(); iter != internals.Cache.end(); ++iter)
+  {
+    if (iter->SameRequest(entry))
+    {
+      internals.CacheSize -= iter->Size;
+      internals.Cache.erase(iter);
+      break;
+    }
+  }
+  while (!internals.Cache.empty() && internals.CacheSize + entry.Size > limit)
+  {
+    internals.CacheSize -= internals.Cache.back().Size;
+    internals.Cache.pop_back();
+  }
+  internals.CacheSize += entry.Size;
+  internals.Cache.push_front(entry);
+}
+
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReader::ClearCachedOutputs()
+{
+  this->Internal->Cache.clear();
+  this->Internal->CacheSize = 0;
+  this->Internal->UseCachedOutput = false;
+}
+
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReader::PrefetchFilesAfter(int index)
+{
+  auto& internals = *this->Internal;
+  if (internals.LastFileIndex >= 0 && index != internals.LastFileIndex)
+  {
+    internals.FileIndexStride = index - internals.LastFileIndex;
+  }
+  internals.LastFileIndex = index;
+
+  const int numFiles = static_cast<int>(this->GetNumberOfFileNames());
+  if (vtkFileSeriesReader::PrefetchDepth <= 0 || numFiles < 2)
+  {
+    return;
+  }
+
+  std::vector<std::string> files;
+  for (int cc = 1; cc <= vtkFileSeriesReader::PrefetchDepth; ++cc)
+  {
+    const int next = index + cc * internals.FileIndexStride;
+    if (next < 0 || next >= numFiles)
+    {
+      break;
+    }
+    // Outputs still cached do not need their file.
+    if (std::find_if(internals.Cache.begin(), internals.Cache.end(),
+          [next](const vtkFileSeriesReaderCachedOutput& entry) {
+            return entry.FileIndex == next;
+          }) != internals.Cache.end())
+    {
+      continue;
+    }
+    files.push_back(this->GetFileName(static_cast<unsigned int>(next)));
+  }
+  if (!files.empty())
+  {
+    if (!internals.Prefetcher)
+    {
+      internals.Prefetcher.reset(new vtkFileSeriesReaderPrefetcher());
+    }
+    internals.Prefetcher->Prefetch(files);
+  }
+}
@@ -75,6 +75,12 @@
  * with SetMetaFileName in this case. Do not use the AddFileName() method when
  * using SetMetaFileName() as names set with AddFileName() will be ignored.
  *
+ * When a cache limit is set with SetCacheLimit(), the outputs produced for
+ * previously read files are kept, least recently used first out, until the
+ * limit is reached. Requesting a cached file (and time step) again, with the
+ * same piece request and reader settings, reuses that output and skips both
+ * the RequestInformation and RequestData passes on the internal reader.
+ *
 */
 
 #ifndef vtkFileSeriesReader_h
@@ -153,6 +159,28 @@ public:
   vtkBooleanMacro(IgnoreReaderTime, bool);
   //@}
 
+  //@{
+  /**
+   * Set/get the memory limit, in MBs, used by each vtkFileSeriesReader to keep
+   * outputs of previously read files. 0 (default) disables the cache.
+   */
+  static void SetCacheLimit(unsigned long limit);
+  static unsigned long GetCacheLimit();
+  //@}
+
+  //@{
+  /**
+   * Set/get the number of upcoming files each vtkFileSeriesReader reads ahead
+   * on a background thread after reading a file, so that they are in the
+   * operating system's file cache when the internal reader opens them. The
+   * upcoming files are guessed from the last change in file index, which
+   * follows the direction and stride of animation playback. 0 (default)
+   * disables prefetching.
+   */
+  static void SetPrefetchDepth(int depth);
+  static int GetPrefetchDepth();
+  //@}
+
   // Expose number of files, first filename and current file number as
   // information keys for potential use in the internal reader
   static vtkInformationIntegerKey* FILE_SERIES_NUMBER_OF_FILES();
@@ -235,11 +263,30 @@ protected:
 
   int ChooseInput(vtkInformation*);
 
+  //@{
+  /**
+   * Look up, and record, outputs of previously read files. FindCachedOutput()
+   * returns true when RequestData() can be satisfied from the cache for the
+   * given file index and output request.
+   */
+  bool FindCachedOutput(int index, vtkInformation* outInfo);
+  void AddCachedOutput(int index, vtkInformation* outInfo);
+  void ClearCachedOutputs();
+  //@}
+
+  /**
+   * Queue the files following `index` for prefetching, if enabled.
+   */
+  void PrefetchFilesAfter(int index);
+
 private:
   vtkFileSeriesReader(const vtkFileSeriesReader&) = delete;
   void operator=(const vtkFileSeriesReader&) = delete;
 
   vtkFileSeriesReaderInternals* Internal;
+
+  static unsigned long CacheLimit;
+  static int PrefetchDepth;
 };
 
 #endif
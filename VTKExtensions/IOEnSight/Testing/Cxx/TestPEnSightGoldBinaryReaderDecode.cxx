@@ -0,0 +1,131 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPEnSightGoldBinaryReaderDecode.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compares decoding EnSight Gold binary data through a file stream, on a
+// single thread, with the memory-mapped path, where coordinates and variables
+// are decoded concurrently with vtkSMPTools. Reports the time taken by each
+// and checks that both produce the same output.
+
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPEnSightGoldBinaryReader.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPointSet.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+double ReadCase(const char* fname, bool useMemoryMapping, int iterations,
+  vtkSmartPointer<vtkMultiBlockDataSet>& output)
+{
+  double seconds = 0.0;
+  for (int iter = 0; iter < iterations; ++iter)
+  {
+    vtkNew<vtkPEnSightGoldBinaryReader> reader;
+    reader->SetCaseFileName(fname);
+    reader->SetUseMemoryMapping(useMemoryMapping);
+    auto start = std::chrono::steady_clock::now();
+    reader->Update();
+    seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    output = reader->GetOutput();
+  }
+  return seconds / iterations;
+}
+
+bool SameArrays(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b || a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfValues(); ++i)
+  {
+    if (a->GetComponent(i / a->GetNumberOfComponents(), i % a->GetNumberOfComponents()) !=
+      b->GetComponent(i / b->GetNumberOfComponents(), i % b->GetNumberOfComponents()))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestPEnSightGoldBinaryReaderDecode(int argc, char* argv[])
+{
+  char* fname =
+    vtkTestUtilities::ExpandDataFileName(argc, argv, "Testing/Data/EnSight/TEST_bin.case");
+
+  const int iterations = 5;
+  vtkSmartPointer<vtkMultiBlockDataSet> serial;
+  vtkSmartPointer<vtkMultiBlockDataSet> threaded;
+  // the baseline must not go through the threaded scatter of the decoder.
+  vtkSMPTools::Initialize(1);
+  double serialTime = ReadCase(fname, false, iterations, serial);
+  vtkSMPTools::Initialize();
+  double threadedTime = ReadCase(fname, true, iterations, threaded);
+  delete[] fname;
+
+  std::cout << "serial decode: " << serialTime << "s, threaded decode: " << threadedTime << "s"
+            << std::endl;
+
+  if (serial->GetNumberOfBlocks() != threaded->GetNumberOfBlocks())
+  {
+    std::cerr << "Number of blocks differ." << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (unsigned int cc = 0; cc < serial->GetNumberOfBlocks(); ++cc)
+  {
+    vtkDataSet* sds = vtkDataSet::SafeDownCast(serial->GetBlock(cc));
+    vtkDataSet* tds = vtkDataSet::SafeDownCast(threaded->GetBlock(cc));
+    if (!sds || !tds)
+    {
+      continue;
+    }
+    vtkPointSet* sps = vtkPointSet::SafeDownCast(sds);
+    vtkPointSet* tps = vtkPointSet::SafeDownCast(tds);
+    if (sps && tps && !SameArrays(sps->GetPoints()->GetData(), tps->GetPoints()->GetData()))
+    {
+      std::cerr << "Points differ in block " << cc << std::endl;
+      return EXIT_FAILURE;
+    }
+    vtkPointData* spd = sds->GetPointData();
+    vtkPointData* tpd = tds->GetPointData();
+    if (spd->GetNumberOfArrays() != tpd->GetNumberOfArrays())
+    {
+      std::cerr << "Number of point arrays differ in block " << cc << std::endl;
+      return EXIT_FAILURE;
+    }
+    for (int a = 0; a < spd->GetNumberOfArrays(); ++a)
+    {
+      if (!SameArrays(spd->GetArray(a), tpd->GetArray(spd->GetArrayName(a))))
+      {
+        std::cerr << "Point array " << spd->GetArrayName(a) << " differs in block " << cc
+                  << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -11,26 +11,187 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
 #include "vtkStructuredGrid.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
+#include "vtksys/Encoding.hxx"
 #include "vtksys/FStream.hxx"
 #include "vtksys/SystemTools.hxx"
 
 #include <cctype>
+#include <streambuf>
 #include <string>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 vtkStandardNewMacro(vtkPEnSightGoldBinaryReader);
 
 // This is half the precision of an int.
 #define MAXIMUM_PART_ID 65536
 
+//----------------------------------------------------------------------------
+// Read-only memory mapping of a whole file.
+class vtkPEnSightGoldBinaryReader::vtkMappedFile
+{
+public:
+  vtkMappedFile(const std::string& filename, const vtksys::SystemTools::Stat_t& fs)
+    : FileName(filename)
+    , ModificationTime(fs.st_mtime)
+    , Size(static_cast<size_t>(fs.st_size))
+  {
+    if (this->Size == 0)
+    {
+      return;
+    }
+#ifdef _WIN32
+    HANDLE file = CreateFileW(vtksys::Encoding::ToWindowsExtendedPath(filename).c_str(),
+      GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+      return;
+    }
+    this->Mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (this->Mapping)
+    {
+      this->Data = static_cast<const char*>(MapViewOfFile(this->Mapping, FILE_MAP_READ, 0, 0, 0));
+    }
+#else
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+      return;
+    }
+    void* data = mmap(nullptr, this->Size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data != MAP_FAILED)
+    {
+      this->Data = static_cast<const char*>(data);
+    }
+#endif
+  }
+
+  ~vtkMappedFile()
+  {
+#ifdef _WIN32
+    if (this->Data)
+    {
+      UnmapViewOfFile(this->Data);
+    }
+    if (this->Mapping)
+    {
+      CloseHandle(this->Mapping);
+    }
+#else
+    if (this->Data)
+    {
+      munmap(const_cast<char*>(this->Data), this->Size);
+    }
+#endif
+  }
+
+  bool IsValid() const { return this->Data != nullptr; }
+
+  // Whether this mapping still reflects the file on disk.
+  bool Matches(const std::string& filename, const vtksys::SystemTools::Stat_t& fs) const
+  {
+    return this->FileName == filename && this->ModificationTime == fs.st_mtime &&
+      this->Size == static_cast<size_t>(fs.st_size);
+  }
+
+  const char* GetData() const { return this->Data; }
+  size_t GetSize() const { return this->Size; }
+
+private:
+  std::string FileName;
+  time_t ModificationTime;
+  size_t Size;
+  const char* Data = nullptr;
+#ifdef _WIN32
+  HANDLE Mapping = nullptr;
+#endif
+
+  vtkMappedFile(const vtkMappedFile&) = delete;
+  void operator=(const vtkMappedFile&) = delete;
+};
+
+namespace
+{
+//----------------------------------------------------------------------------
+// An istream reading directly from a vtkMappedFile. Seeks only move the get
+// pointer and reads are plain memory copies.
+class vtkPEnSightMappedStream : public std::istream
+{
+  class MappedBuffer : public std::streambuf
+  {
+  public:
+    MappedBuffer(const char* data, size_t size)
+    {
+      char* begin = const_cast<char*>(data);
+      this->setg(begin, begin, begin + size);
+    }
+
+  protected:
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode) override
+    {
+      off_type base = 0;
+      if (dir == std::ios_base::cur)
+      {
+        base = this->gptr() - this->eback();
+      }
+      else if (dir == std::ios_base::end)
+      {
+        base = this->egptr() - this->eback();
+      }
+      return this->seekpos(pos_type(base + off), std::ios_base::in);
+    }
+
+    pos_type seekpos(pos_type pos, std::ios_base::openmode) override
+    {
+      const off_type offset = static_cast<off_type>(pos);
+      if (offset < 0 || offset > this->egptr() - this->eback())
+      {
+        return pos_type(off_type(-1));
+      }
+      this->setg(this->eback(), this->eback() + offset, this->egptr());
+      return pos;
+    }
+  };
+
+public:
+  vtkPEnSightMappedStream(const char* data, size_t size, std::shared_ptr<const void> owner)
+    : std::istream(nullptr)
+    , Owner(std::move(owner))
+    , Buffer(data, size)
+  {
+    this->rdbuf(&this->Buffer);
+  }
+
+private:
+  // Keeps the mapping alive for the lifetime of the stream.
+  std::shared_ptr<const void> Owner;
+  MappedBuffer Buffer;
+};
+}
+
 //----------------------------------------------------------------------------
 vtkPEnSightGoldBinaryReader::vtkPEnSightGoldBinaryReader()
 {
   this->IFile = nullptr;
   this->FileSize = 0;
+  this->UseMemoryMapping = true;
   this->Fortran = 0;
   this->NodeIdsListed = 0;
   this->ElementIdsListed = 0;
@@ -77,11 +238,38 @@ int vtkPEnSightGoldBinaryReader::OpenFile(const char* filename)
     // Find out how big the file is.
     this->FileSize = (long)(fs.st_size);
 
+    if (this->UseMemoryMapping)
+    {
+      // Reuse the previous mapping when reading the same, unchanged file.
+      if (!this->MappedFile || !this->MappedFile->Matches(filename, fs))
+      {
+        this->MappedFile.reset();
+        this->MappedFile = std::make_shared<vtkMappedFile>(filename, fs);
+      }
+      if (this->MappedFile->IsValid())
+      {
+        this->IFile = new vtkPEnSightMappedStream(
+          this->MappedFile->GetData(), this->MappedFile->GetSize(), this->MappedFile);
+      }
+      else
+      {
+        vtkDebugMacro(<< "Could not map " << filename << ", using a file stream instead.");
+        this->MappedFile.reset();
+      }
+    }
+    else
+    {
+      this->MappedFile.reset();
+    }
+
+    if (!this->IFile)
+    {
 #ifdef _WIN32
-    this->IFile = new vtksys::ifstream(filename, ios::in | ios::binary);
+      this->IFile = new vtksys::ifstream(filename, ios::in | ios::binary);
 #else
-    this->IFile = new vtksys::ifstream(filename, ios::in);
+      this->IFile = new vtksys::ifstream(filename, ios::in);
 #endif
+    }
   }
   else
   {
@@ -1396,11 +1584,8 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerNode(const char* fileName, const
       // For complex scalars, there is a file for the real part and another
       // file for the imaginary part, but we are storing them as a 2-component
       // array.
-      for (i = 0; i < numPts; i++)
-      {
-        this->InsertVariableComponent(
-          scalars, i, component, &(scalarsRead[i]), partId, 0, SCALAR_PER_NODE);
-      }
+      this->InsertVariableComponents(
+        scalars, numPts, component, scalarsRead, partId, 0, SCALAR_PER_NODE);
       scalars->SetName(description);
       output->GetPointData()->AddArray(scalars);
       if (!output->GetPointData()->GetScalars())
@@ -1444,11 +1629,8 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerNode(const char* fileName, const
       scalarsRead = new float[numPts];
       this->ReadFloatArray(scalarsRead, numPts);
 
-      for (i = 0; i < numPts; i++)
-      {
-        this->InsertVariableComponent(
-          scalars, i, component, &(scalarsRead[i]), realId, 0, SCALAR_PER_NODE);
-      }
+      this->InsertVariableComponents(
+        scalars, numPts, component, scalarsRead, realId, 0, SCALAR_PER_NODE);
       if (component == 0)
       {
         scalars->SetName(description);
@@ -1488,7 +1670,6 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerNode(const char* fileName, const
   char line[80];
   int partId, realId, numPts, i, lineRead;
   vtkFloatArray* vectors;
-  float tuple[3];
   float *comp1, *comp2, *comp3;
   float* vectorsRead;
   vtkDataSet* output;
@@ -1653,13 +1834,8 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerNode(const char* fileName, const
       this->ReadFloatArray(comp1, numPts);
       this->ReadFloatArray(comp2, numPts);
       this->ReadFloatArray(comp3, numPts);
-      for (i = 0; i < numPts; i++)
-      {
-        tuple[0] = comp1[i];
-        tuple[1] = comp2[i];
-        tuple[2] = comp3[i];
-        this->InsertVariableComponent(vectors, i, -1, tuple, realId, 0, VECTOR_PER_NODE);
-      }
+      const float* components[3] = { comp1, comp2, comp3 };
+      this->InsertVariableComponents(vectors, numPts, components, 3, realId, 0, VECTOR_PER_NODE);
       vectors->SetName(description);
       output->GetPointData()->AddArray(vectors);
       if (!output->GetPointData()->GetVectors())
@@ -1695,7 +1871,6 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerNode(const char* fileName, const
   int partId, realId, numPts, i, lineRead;
   vtkFloatArray* tensors;
   float *comp1, *comp2, *comp3, *comp4, *comp5, *comp6;
-  float tuple[6];
   vtkDataSet* output;
 
   // Initialize
@@ -1810,16 +1985,9 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerNode(const char* fileName, const
       this->ReadFloatArray(comp4, numPts);
       this->ReadFloatArray(comp6, numPts);
       this->ReadFloatArray(comp5, numPts);
-      for (i = 0; i < numPts; i++)
-      {
-        tuple[0] = comp1[i];
-        tuple[1] = comp2[i];
-        tuple[2] = comp3[i];
-        tuple[3] = comp4[i];
-        tuple[4] = comp5[i];
-        tuple[5] = comp6[i];
-        this->InsertVariableComponent(tensors, i, -1, tuple, realId, 0, TENSOR_SYMM_PER_NODE);
-      }
+      const float* components[6] = { comp1, comp2, comp3, comp4, comp5, comp6 };
+      this->InsertVariableComponents(
+        tensors, numPts, components, 6, realId, 0, TENSOR_SYMM_PER_NODE);
       tensors->SetName(description);
       output->GetPointData()->AddArray(tensors);
       tensors->Delete();
@@ -2004,11 +2172,8 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerElement(const char* fileName,
       {
         scalarsRead = new float[numCells];
         this->ReadFloatArray(scalarsRead, numCells);
-        for (i = 0; i < numCells; i++)
-        {
-          this->InsertVariableComponent(
-            scalars, i, component, &(scalarsRead[i]), realId, 0, SCALAR_PER_ELEMENT);
-        }
+        this->InsertVariableComponents(
+          scalars, numCells, component, scalarsRead, realId, 0, SCALAR_PER_ELEMENT);
         if (this->IFile->eof())
         {
           lineRead = 0;
@@ -2040,11 +2205,8 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerElement(const char* fileName,
           numCellsPerElement = this->GetCellIds(idx, elementType)->GetNumberOfIds();
           scalarsRead = new float[numCellsPerElement];
           this->ReadFloatArray(scalarsRead, numCellsPerElement);
-          for (i = 0; i < numCellsPerElement; i++)
-          {
-            this->InsertVariableComponent(
-              scalars, i, component, &(scalarsRead[i]), idx, elementType, SCALAR_PER_ELEMENT);
-          }
+          this->InsertVariableComponents(scalars, numCellsPerElement, component, scalarsRead, idx,
+            elementType, SCALAR_PER_ELEMENT);
           this->IFile->peek();
           if (this->IFile->eof())
           {
@@ -2101,7 +2263,6 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerElement(const char* fileName,
   vtkFloatArray* vectors;
   float *comp1, *comp2, *comp3;
   int lineRead, elementType;
-  float tuple[3];
   vtkDataSet* output;
 
   // Initialize
@@ -2247,13 +2408,9 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerElement(const char* fileName,
         this->ReadFloatArray(comp1, numCells);
         this->ReadFloatArray(comp2, numCells);
         this->ReadFloatArray(comp3, numCells);
-        for (i = 0; i < numCells; i++)
-        {
-          tuple[0] = comp1[i];
-          tuple[1] = comp2[i];
-          tuple[2] = comp3[i];
-          this->InsertVariableComponent(vectors, i, -1, tuple, realId, 0, VECTOR_PER_ELEMENT);
-        }
+        const float* components[3] = { comp1, comp2, comp3 };
+        this->InsertVariableComponents(
+          vectors, numCells, components, 3, realId, 0, VECTOR_PER_ELEMENT);
         this->IFile->peek();
         if (this->IFile->eof())
         {
@@ -2288,14 +2445,9 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerElement(const char* fileName,
           this->ReadFloatArray(comp1, numCellsPerElement);
           this->ReadFloatArray(comp2, numCellsPerElement);
           this->ReadFloatArray(comp3, numCellsPerElement);
-          for (i = 0; i < numCellsPerElement; i++)
-          {
-            tuple[0] = comp1[i];
-            tuple[1] = comp2[i];
-            tuple[2] = comp3[i];
-            this->InsertVariableComponent(
-              vectors, i, 0, tuple, idx, elementType, VECTOR_PER_ELEMENT);
-          }
+          const float* components[3] = { comp1, comp2, comp3 };
+          this->InsertVariableComponents(
+            vectors, numCellsPerElement, components, 3, idx, elementType, VECTOR_PER_ELEMENT);
           this->IFile->peek();
           if (this->IFile->eof())
           {
@@ -2347,7 +2499,6 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerElement(const char* fileName,
   vtkFloatArray* tensors;
   int lineRead, elementType;
   float *comp1, *comp2, *comp3, *comp4, *comp5, *comp6;
-  float tuple[6];
   vtkDataSet* output;
 
   // Initialize
@@ -2500,16 +2651,9 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerElement(const char* fileName,
         this->ReadFloatArray(comp4, numCells);
         this->ReadFloatArray(comp6, numCells);
         this->ReadFloatArray(comp5, numCells);
-        for (i = 0; i < numCells; i++)
-        {
-          tuple[0] = comp1[i];
-          tuple[1] = comp2[i];
-          tuple[2] = comp3[i];
-          tuple[3] = comp4[i];
-          tuple[4] = comp5[i];
-          tuple[5] = comp6[i];
-          this->InsertVariableComponent(tensors, i, -1, tuple, realId, 0, TENSOR_SYMM_PER_ELEMENT);
-        }
+        const float* components[6] = { comp1, comp2, comp3, comp4, comp5, comp6 };
+        this->InsertVariableComponents(
+          tensors, numCells, components, 6, realId, 0, TENSOR_SYMM_PER_ELEMENT);
         this->IFile->peek();
         if (this->IFile->eof())
         {
@@ -2553,17 +2697,9 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerElement(const char* fileName,
           this->ReadFloatArray(comp4, numCellsPerElement);
           this->ReadFloatArray(comp6, numCellsPerElement);
           this->ReadFloatArray(comp5, numCellsPerElement);
-          for (i = 0; i < numCellsPerElement; i++)
-          {
-            tuple[0] = comp1[i];
-            tuple[1] = comp2[i];
-            tuple[2] = comp3[i];
-            tuple[3] = comp4[i];
-            tuple[4] = comp5[i];
-            tuple[5] = comp6[i];
-            this->InsertVariableComponent(
-              tensors, i, 0, tuple, idx, elementType, TENSOR_SYMM_PER_ELEMENT);
-          }
+          const float* components[6] = { comp1, comp2, comp3, comp4, comp5, comp6 };
+          this->InsertVariableComponents(tensors, numCellsPerElement, components, 6, idx,
+            elementType, TENSOR_SYMM_PER_ELEMENT);
           this->IFile->peek();
           if (this->IFile->eof())
           {
@@ -4328,7 +4464,6 @@ int vtkPEnSightGoldBinaryReader::ReadOrSkipCoordinates(
   this->FloatBufferFilePosition = currentPositionInFile;
   this->FloatBufferIndexBegin = 0;
   this->FloatBufferNumberOfVectors = numPts;
-  this->UpdateFloatBuffer();
 
   // Position to reach at the end of this method
   long endFilePosition = currentPositionInFile + 3 * numPts * (long)sizeof(float);
@@ -4362,24 +4497,62 @@ int vtkPEnSightGoldBinaryReader::ReadOrSkipCoordinates(
     else
     {
       // Inject really needed points
-      vtkIdType i;
-      int localNumberOfIds = this->GetPointIds(partId)->GetLocalNumberOfIds();
+      vtkPEnSightReaderCellIds* pointIds = this->GetPointIds(partId);
+      int localNumberOfIds = pointIds->GetLocalNumberOfIds();
       points->Allocate(localNumberOfIds);
       points->SetNumberOfPoints(localNumberOfIds);
-      int maxId = -1;
-      int minId = -1;
-      for (i = 0; i < numPts; i++)
+
+      const char* coords =
+        this->GetMappedData(currentPositionInFile, endFilePosition - currentPositionInFile);
+      vtkFloatArray* pointsArray = vtkFloatArray::FastDownCast(points->GetData());
+      if (coords && pointsArray)
+      {
+        // The x, y and z blocks are available in memory: decode and scatter
+        // them concurrently instead of going through the float buffer.
+        const vtkIdType blockSize = numPts * sizeof(float) + (this->Fortran ? 8 : 0);
+        const char* blocks[3];
+        for (int c = 0; c < 3; ++c)
+        {
+          blocks[c] = coords + (this->Fortran ? 4 : 0) + c * blockSize;
+        }
+        float* out = pointsArray->GetPointer(0);
+        const bool littleEndian = (this->ByteOrder == FILE_LITTLE_ENDIAN);
+        vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+          for (vtkIdType i = begin; i < end; ++i)
+          {
+            const int id = pointIds->GetId(static_cast<int>(i));
+            if (id != -1)
+            {
+              for (int c = 0; c < 3; ++c)
+              {
+                float value;
+                memcpy(&value, blocks[c] + i * sizeof(float), sizeof(float));
+                if (littleEndian)
+                {
+                  vtkByteSwap::Swap4LE(&value);
+                }
+                else
+                {
+                  vtkByteSwap::Swap4BE(&value);
+                }
+                out[3 * static_cast<vtkIdType>(id) + c] = value;
+              }
+            }
+          }
+        });
+      }
+      else
       {
-        float vec[3];
-        int id = this->GetPointIds(partId)->GetId(i);
-        if (id != -1)
+        this->UpdateFloatBuffer();
+        for (vtkIdType i = 0; i < numPts; i++)
         {
-          if ((minId == -1) || (minId > id))
-            minId = id;
-          if ((maxId == -1) || (maxId < id))
-            maxId = id;
-          this->GetVectorFromFloatBuffer(i, vec);
-          points->SetPoint(id, vec[0], vec[1], vec[2]);
+          float vec[3];
+          int id = pointIds->GetId(i);
+          if (id != -1)
+          {
+            this->GetVectorFromFloatBuffer(i, vec);
+            points->SetPoint(id, vec[0], vec[1], vec[2]);
+          }
         }
       }
 
@@ -4443,6 +4616,17 @@ int vtkPEnSightGoldBinaryReader::InjectCoordinatesAtEnd(
   return pointsRead;
 }
 
+//----------------------------------------------------------------------------
+const char* vtkPEnSightGoldBinaryReader::GetMappedData(vtkTypeInt64 position, vtkTypeInt64 length)
+{
+  if (!this->IFile || !this->MappedFile || position < 0 || length < 0 ||
+    static_cast<vtkTypeUInt64>(position + length) > this->MappedFile->GetSize())
+  {
+    return nullptr;
+  }
+  return this->MappedFile->GetData() + position;
+}
+
 //----------------------------------------------------------------------------
 void vtkPEnSightGoldBinaryReader::GetVectorFromFloatBuffer(vtkIdType i, float* vector)
 {
@@ -4518,4 +4702,5 @@ void vtkPEnSightGoldBinaryReader::UpdateFloatBuffer()
 void vtkPEnSightGoldBinaryReader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "UseMemoryMapping: " << this->UseMemoryMapping << endl;
 }
@@ -35,6 +35,8 @@
 #include "vtkPEnSightReader.h"
 #include "vtkPVVTKExtensionsIOEnSightModule.h" //needed for exports
 
+#include <memory> // for std::shared_ptr
+
 class vtkMultiBlockDataSet;
 class vtkUnstructuredGrid;
 class vtkPoints;
@@ -46,6 +48,21 @@ public:
   vtkTypeMacro(vtkPEnSightGoldBinaryReader, vtkPEnSightReader);
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
+  //@{
+  /**
+   * When enabled (default), files are memory-mapped and read through an
+   * in-memory stream instead of a file stream, so that the many small
+   * seek/read calls issued per part and per variable do not each go
+   * through a system call. The mapping of the last file read is kept so
+   * that reading further time steps from the same file, using the
+   * offsets index, does not map it again. Falls back to regular file
+   * streams if the file cannot be mapped.
+   */
+  vtkSetMacro(UseMemoryMapping, bool);
+  vtkGetMacro(UseMemoryMapping, bool);
+  vtkBooleanMacro(UseMemoryMapping, bool);
+  //@}
+
 protected:
   vtkPEnSightGoldBinaryReader();
   ~vtkPEnSightGoldBinaryReader() override;
@@ -208,6 +225,14 @@ protected:
   // The size of the file could be used to choose byte order.
   long FileSize;
 
+  bool UseMemoryMapping;
+  class vtkMappedFile;
+  std::shared_ptr<vtkMappedFile> MappedFile;
+
+  // Pointer to the given range of the current file when it is memory-mapped,
+  // nullptr otherwise.
+  const char* GetMappedData(vtkTypeInt64 position, vtkTypeInt64 length);
+
   // Float Vector Buffer utils
   void GetVectorFromFloatBuffer(vtkIdType i, float* vector);
   void UpdateFloatBuffer();
@@ -29,6 +29,7 @@
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredData.h"
@@ -2299,6 +2300,66 @@ void vtkPEnSightReader::InsertVariableComponent(vtkFloatArray* array, int i, int
   }
 }
 
+//----------------------------------------------------------------------------
+vtkPEnSightReader::vtkPEnSightReaderCellIds* vtkPEnSightReader::GetVariableIds(
+  int partId, int ensightCellType, int insertionType)
+{
+  if ((insertionType == SCALAR_PER_ELEMENT) || (insertionType == VECTOR_PER_ELEMENT) ||
+    (insertionType == TENSOR_SYMM_PER_ELEMENT))
+  {
+    return this->GetCellIds(partId, ensightCellType);
+  }
+  return this->GetPointIds(partId);
+}
+
+namespace
+{
+// Scatter values read in file order to their local ids. Every value maps to
+// a distinct local id, and id lookups are read-only, so this runs
+// concurrently.
+void vtkPEnSightScatterComponents(vtkPEnSightReader::vtkPEnSightReaderCellIds* ids,
+  vtkFloatArray* array, vtkIdType numberOfValues, const float* const* components,
+  int numberOfComponents, int firstComponent)
+{
+  vtkSMPTools::For(0, numberOfValues, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      const int realId = ids->GetId(static_cast<int>(i));
+      if (realId != -1)
+      {
+        for (int c = 0; c < numberOfComponents; ++c)
+        {
+          array->SetTypedComponent(realId, firstComponent + c, components[c][i]);
+        }
+      }
+    }
+  });
+}
+}
+
+//----------------------------------------------------------------------------
+void vtkPEnSightReader::InsertVariableComponents(vtkFloatArray* array, vtkIdType numberOfValues,
+  int component, const float* content, int partId, int ensightCellType, int insertionType)
+{
+  vtkPEnSightReaderCellIds* ids = this->GetVariableIds(partId, ensightCellType, insertionType);
+  if (ids && numberOfValues > 0)
+  {
+    vtkPEnSightScatterComponents(ids, array, numberOfValues, &content, 1, component);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPEnSightReader::InsertVariableComponents(vtkFloatArray* array, vtkIdType numberOfValues,
+  const float* const* components, int numberOfComponents, int partId, int ensightCellType,
+  int insertionType)
+{
+  vtkPEnSightReaderCellIds* ids = this->GetVariableIds(partId, ensightCellType, insertionType);
+  if (ids && numberOfValues > 0)
+  {
+    vtkPEnSightScatterComponents(ids, array, numberOfValues, components, numberOfComponents, 0);
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkPEnSightReader::MapToGlobalIds(
   const vtkIdType* inputIds, vtkIdType numPoints, int partId, vtkIdType* globalIds)
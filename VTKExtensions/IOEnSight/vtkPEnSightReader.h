@@ -220,11 +220,11 @@ public:
         }
         case SPARSE_MODE:
         {
-          std::map<int, int>::iterator it = this->cellMap->find(id);
+          std::map<int, int>::const_iterator it = this->cellMap->find(id);
           if (it == this->cellMap->end())
             return -1;
           else
-            return (*this->cellMap)[id];
+            return it->second;
           break;
         }
         default:
@@ -788,6 +788,28 @@ protected:
     int partId, int ensightCellType, int insertionType);
   //@}
 
+  //@{
+  /**
+   * Bulk version of InsertVariableComponent for all the values read for a
+   * part (or for one element type of a part). The first form sets \c
+   * component of each tuple from \c content, the second sets whole tuples
+   * from \c numberOfComponents separate component arrays, as laid out in
+   * EnSight Gold binary files. Values are scattered to their local ids
+   * concurrently using vtkSMPTools.
+   */
+  void InsertVariableComponents(vtkFloatArray* array, vtkIdType numberOfValues, int component,
+    const float* content, int partId, int ensightCellType, int insertionType);
+  void InsertVariableComponents(vtkFloatArray* array, vtkIdType numberOfValues,
+    const float* const* components, int numberOfComponents, int partId, int ensightCellType,
+    int insertionType);
+  //@}
+
+  /**
+   * Get the point or cell ids used to insert a variable of the given
+   * insertion type.
+   */
+  vtkPEnSightReaderCellIds* GetVariableIds(int partId, int ensightCellType, int insertionType);
+
   /**
    * Convenience method to map the point ids from current rank to global ids.
    */
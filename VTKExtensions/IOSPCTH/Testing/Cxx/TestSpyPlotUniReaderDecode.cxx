@@ -0,0 +1,178 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestSpyPlotUniReaderDecode.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compares the cell fields decoded by vtkSpyPlotUniReader from a memory
+// mapped file, in parallel and reusing the blocks cached from the previous
+// time step, with the ones decoded from a buffered stream without cache.
+// Time steps are walked forward and back so that cached blocks are reused
+// both before and after their bad ghost cells have been fixed.
+
+#include "vtkDataArray.h"
+#include "vtkDataArraySelection.h"
+#include "vtkNew.h"
+#include "vtkSpyPlotUniReader.h"
+#include "vtkTestUtilities.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+// Stands in for the bad ghost cells removal of vtkSpyPlotReader: the array
+// is shifted and shrunk in place, which the cache must cope with.
+void FixGhostCells(vtkSpyPlotUniReader* reader, vtkDataArray* array, int block, int field)
+{
+  const vtkIdType numTuples = array->GetNumberOfTuples();
+  for (vtkIdType cc = 1; cc < numTuples; ++cc)
+  {
+    array->SetTuple(cc - 1, cc, array);
+  }
+  array->SetNumberOfTuples(numTuples > 0 ? numTuples - 1 : 0);
+  reader->MarkCellFieldDataFixed(block, field);
+}
+
+bool SameArrays(vtkDataArray* a, vtkDataArray* b)
+{
+  if (a->GetDataType() != b->GetDataType() || a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfValues(); ++i)
+  {
+    if (a->GetComponent(i / a->GetNumberOfComponents(), i % a->GetNumberOfComponents()) !=
+      b->GetComponent(i / b->GetNumberOfComponents(), i % b->GetNumberOfComponents()))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CompareTimeStep(vtkSpyPlotUniReader* reference, vtkSpyPlotUniReader* reader, int timeStep)
+{
+  reference->SetCurrentTimeStep(timeStep);
+  reader->SetCurrentTimeStep(timeStep);
+  if (!reference->MakeCurrent() || !reader->MakeCurrent())
+  {
+    std::cerr << "Could not read time step " << timeStep << std::endl;
+    return false;
+  }
+  if (reference->GetNumberOfDataBlocks() != reader->GetNumberOfDataBlocks())
+  {
+    std::cerr << "Number of blocks differ at time step " << timeStep << std::endl;
+    return false;
+  }
+
+  for (int field = 0; field < reference->GetNumberOfCellFields(); ++field)
+  {
+    for (int block = 0; block < reference->GetNumberOfDataBlocks(); ++block)
+    {
+      int referenceFixed = 0;
+      int fixed = 0;
+      vtkDataArray* expected = reference->GetCellFieldData(block, field, &referenceFixed);
+      vtkDataArray* array = reader->GetCellFieldData(block, field, &fixed);
+      if (!expected && !array)
+      {
+        continue;
+      }
+      if (!expected || !array)
+      {
+        std::cerr << "Field " << reference->GetCellFieldName(field) << " of block " << block
+                  << " is missing at time step " << timeStep << std::endl;
+        return false;
+      }
+      if (!referenceFixed)
+      {
+        FixGhostCells(reference, expected, block, field);
+      }
+      if (!fixed)
+      {
+        FixGhostCells(reader, array, block, field);
+      }
+      if (!SameArrays(expected, array))
+      {
+        std::cerr << "Field " << reference->GetCellFieldName(field) << " of block " << block
+                  << " differs at time step " << timeStep << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool TestFile(const char* fname)
+{
+  vtkNew<vtkDataArraySelection> referenceSelection;
+  vtkNew<vtkSpyPlotUniReader> reference;
+  reference->SetFileName(fname);
+  reference->SetCellArraySelection(referenceSelection);
+  reference->SetUseMemoryMapping(false);
+  reference->SetCacheDecodedBlocks(false);
+
+  vtkNew<vtkDataArraySelection> selection;
+  vtkNew<vtkSpyPlotUniReader> reader;
+  reader->SetFileName(fname);
+  reader->SetCellArraySelection(selection);
+
+  if (!reference->ReadInformation() || !reader->ReadInformation())
+  {
+    std::cerr << "Could not read " << fname << std::endl;
+    return false;
+  }
+  referenceSelection->EnableAllArrays();
+  selection->EnableAllArrays();
+
+  int range[2];
+  reference->GetTimeStepRange(range);
+  std::vector<int> timeSteps;
+  for (int step = range[0]; step <= range[1]; ++step)
+  {
+    timeSteps.push_back(step);
+  }
+  for (int step = range[1] - 1; step >= range[0]; --step)
+  {
+    timeSteps.push_back(step);
+  }
+
+  for (int step : timeSteps)
+  {
+    if (!CompareTimeStep(reference, reader, step))
+    {
+      std::cerr << "in " << fname << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestSpyPlotUniReaderDecode(int argc, char* argv[])
+{
+  const char* files[] = { "Testing/Data/SPCTH/spcth.0",
+    "Testing/Data/SPCTH/Dave_Karelitz_Small/spcth_a.0" };
+
+  int status = EXIT_SUCCESS;
+  for (const char* file : files)
+  {
+    char* fname = vtkTestUtilities::ExpandDataFileName(argc, argv, file);
+    if (!TestFile(fname))
+    {
+      status = EXIT_FAILURE;
+    }
+    delete[] fname;
+  }
+  return status;
+}
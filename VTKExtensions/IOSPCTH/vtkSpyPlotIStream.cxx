@@ -1,32 +1,136 @@
 #include "vtkSpyPlotIStream.h"
 #include "vtkByteSwap.h"
 
-int vtkSpyPlotIStream::ReadString(char* str, size_t len)
+#include <vtksys/FStream.hxx>
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(_WIN32)
+#include <vtksys/Encoding.hxx>
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+// Maps the whole file in memory, returns nullptr on failure, e.g. for empty
+// files or when the address space is exhausted.
+const unsigned char* MapFile(const char* filename, vtkTypeInt64& size)
 {
-  this->IStream->read(str, len);
-  if (len != static_cast<size_t>(this->IStream->gcount()))
+#if defined(_WIN32)
+  const std::wstring wfilename = vtksys::Encoding::ToWindowsExtendedPath(filename);
+  HANDLE file = CreateFileW(wfilename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
   {
-    return 0;
+    return nullptr;
   }
-  return 1;
+  LARGE_INTEGER fileSize;
+  const unsigned char* data = nullptr;
+  if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+  {
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping)
+    {
+      // the view keeps the mapping alive.
+      data = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+      CloseHandle(mapping);
+      size = fileSize.QuadPart;
+    }
+  }
+  CloseHandle(file);
+  return data;
+#else
+  const int fd = open(filename, O_RDONLY);
+  if (fd < 0)
+  {
+    return nullptr;
+  }
+  struct stat info;
+  void* data = MAP_FAILED;
+  if (fstat(fd, &info) == 0 && info.st_size > 0 &&
+    static_cast<vtkTypeUInt64>(info.st_size) <= static_cast<vtkTypeUInt64>(SIZE_MAX))
+  {
+    // the mapping stays valid once the file is closed.
+    data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    size = info.st_size;
+  }
+  close(fd);
+  return data != MAP_FAILED ? static_cast<const unsigned char*>(data) : nullptr;
+#endif
+}
+
+// Returns true if `len` bytes can be read at `position` in a mapping of
+// `size` bytes.
+bool CanReadMapped(vtkTypeInt64 position, vtkTypeInt64 size, size_t len)
+{
+  return position >= 0 && position <= size &&
+    static_cast<vtkTypeUInt64>(size - position) >= static_cast<vtkTypeUInt64>(len);
+}
+
+void UnmapFile(const unsigned char* data, vtkTypeInt64 size)
+{
+#if defined(_WIN32)
+  (void)size;
+  UnmapViewOfFile(data);
+#else
+  munmap(const_cast<unsigned char*>(data), static_cast<size_t>(size));
+#endif
+}
+}
+
+//-----------------------------------------------------------------------------
+bool vtkSpyPlotIStream::Read(void* data, size_t len)
+{
+  if (this->MappedData)
+  {
+    if (!::CanReadMapped(this->MappedPosition, this->MappedSize, len))
+    {
+      this->MappedPosition = this->MappedSize;
+      return false;
+    }
+    memcpy(data, this->MappedData + this->MappedPosition, len);
+    this->MappedPosition += len;
+    return true;
+  }
+  this->IStream->read(reinterpret_cast<char*>(data), len);
+  return len == static_cast<size_t>(this->IStream->gcount());
+}
+
+//-----------------------------------------------------------------------------
+int vtkSpyPlotIStream::ReadString(char* str, size_t len)
+{
+  return this->Read(str, len) ? 1 : 0;
 }
 //-----------------------------------------------------------------------------
 int vtkSpyPlotIStream::ReadString(unsigned char* str, size_t len)
 {
-  this->IStream->read(reinterpret_cast<char*>(str), len);
-  if (len != static_cast<size_t>(this->IStream->gcount()))
+  return this->Read(str, len) ? 1 : 0;
+}
+
+//-----------------------------------------------------------------------------
+const unsigned char* vtkSpyPlotIStream::ReadMapped(size_t len)
+{
+  if (!this->MappedData || !::CanReadMapped(this->MappedPosition, this->MappedSize, len))
   {
-    return 0;
+    return nullptr;
   }
-  return 1;
+  const unsigned char* data = this->MappedData + this->MappedPosition;
+  this->MappedPosition += len;
+  return data;
 }
 
 //-----------------------------------------------------------------------------
 int vtkSpyPlotIStream::ReadInt32s(int* val, int num)
 {
   size_t len = 4 * num;
-  this->IStream->read(reinterpret_cast<char*>(val), len);
-  if (len != static_cast<size_t>(this->IStream->gcount()))
+  if (!this->Read(val, len))
   {
     return 0;
   }
@@ -39,14 +143,11 @@ int vtkSpyPlotIStream::ReadInt32sNoSwap(int* val, int num)
 {
   size_t len = 4 * num;
 
-  //
-  // We are not going to check the length of the read, rely on the
-  // read itself for errors.
   //
   // We are going to return the array unswapped. This is for performance.
   // Calling funcitons will have to deal with unswapped data.
   //
-  if (!(this->IStream->read(reinterpret_cast<char*>(val), len)))
+  if (!this->Read(val, len))
   {
     return 0;
   }
@@ -74,8 +175,7 @@ int vtkSpyPlotIStream::ReadInt64s(vtkTypeInt64* val, int num)
 int vtkSpyPlotIStream::ReadDoubles(double* val, int num)
 {
   size_t len = 8 * num;
-  this->IStream->read(reinterpret_cast<char*>(val), len);
-  if (len != static_cast<size_t>(this->IStream->gcount()))
+  if (!this->Read(val, len))
   {
     return 0;
   }
@@ -85,7 +185,11 @@ int vtkSpyPlotIStream::ReadDoubles(double* val, int num)
 
 void vtkSpyPlotIStream::Seek(vtkTypeInt64 offset, bool rel)
 {
-  if (rel)
+  if (this->MappedData)
+  {
+    this->MappedPosition = rel ? this->MappedPosition + offset : offset;
+  }
+  else if (rel)
   {
     this->IStream->seekg(offset, ios::cur);
   }
@@ -97,11 +201,19 @@ void vtkSpyPlotIStream::Seek(vtkTypeInt64 offset, bool rel)
 
 vtkTypeInt64 vtkSpyPlotIStream::Tell()
 {
+  if (this->MappedData)
+  {
+    return this->MappedPosition;
+  }
   return this->IStream->tellg();
 }
 
 void vtkSpyPlotIStream::SetStream(istream* ist)
 {
+  if (ist != this->OwnedStream)
+  {
+    this->Close();
+  }
   if (!this->Buffer)
   {
     this->Buffer = new char[this->FileBufferSize];
@@ -112,15 +224,67 @@ void vtkSpyPlotIStream::SetStream(istream* ist)
   this->IStream = ist;
 }
 
+bool vtkSpyPlotIStream::Open(const char* filename, bool map)
+{
+  this->Close();
+  if (!filename)
+  {
+    return false;
+  }
+
+  this->MappedData = map ? ::MapFile(filename, this->MappedSize) : nullptr;
+  if (this->MappedData)
+  {
+    this->MappedPosition = 0;
+    return true;
+  }
+
+  this->MappedSize = 0;
+  vtksys::ifstream* ifs = new vtksys::ifstream(filename, ios::binary | ios::in);
+  this->OwnedStream = ifs;
+  if (!*ifs)
+  {
+    this->Close();
+    return false;
+  }
+  this->SetStream(ifs);
+  return true;
+}
+
+void vtkSpyPlotIStream::Close()
+{
+  if (this->MappedData)
+  {
+    ::UnmapFile(this->MappedData, this->MappedSize);
+    this->MappedData = nullptr;
+    this->MappedSize = 0;
+    this->MappedPosition = 0;
+  }
+  if (this->OwnedStream)
+  {
+    if (this->IStream == this->OwnedStream)
+    {
+      this->IStream = nullptr;
+    }
+    delete this->OwnedStream;
+    this->OwnedStream = nullptr;
+  }
+}
+
 vtkSpyPlotIStream::vtkSpyPlotIStream()
   : FileBufferSize(2097152)
   , Buffer(nullptr)
   , IStream(nullptr)
+  , OwnedStream(nullptr)
+  , MappedData(nullptr)
+  , MappedSize(0)
+  , MappedPosition(0)
 {
 }
 
 vtkSpyPlotIStream::~vtkSpyPlotIStream()
 {
+  this->Close();
   if (this->Buffer)
   {
     delete[] this->Buffer;
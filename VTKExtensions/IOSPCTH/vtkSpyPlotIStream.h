@@ -17,8 +17,10 @@ PURPOSE.  See the above copyright notice for more information.
  *
  * vtkSpyPlotIStream represents input functionality required by
  * the vtkSpyPlotReader and vtkSpyPlotUniReader classes.  The class
- * was factored out of vtkSpyPlotReader.cxx.  The class wraps an already
- * opened istream
+ * was factored out of vtkSpyPlotReader.cxx.  The class either wraps an
+ * already opened istream or opens a file itself, memory mapping it when
+ * the platform supports it. When memory mapped, ReadMapped() gives access to
+ * the file content without copying it.
  *
 */
 
@@ -35,6 +37,27 @@ public:
   virtual ~vtkSpyPlotIStream();
   void SetStream(istream*);
   istream* GetStream();
+
+  /**
+   * Opens `filename`, memory mapping it when supported and `map` is true,
+   * else reading it through a stream owned by this object. Returns false if
+   * the file cannot be opened.
+   */
+  bool Open(const char* filename, bool map = true);
+
+  /**
+   * Returns true if the file opened by Open() is memory mapped.
+   */
+  bool IsMapped() const { return this->MappedData != nullptr; }
+
+  /**
+   * When the file is memory mapped, returns a pointer to its next `len` bytes
+   * and skips them. The pointer is valid as long as this object is. Returns
+   * nullptr if the file is not memory mapped or fewer than `len` bytes
+   * remain.
+   */
+  const unsigned char* ReadMapped(size_t len);
+
   int ReadString(char* str, size_t len);
   int ReadString(unsigned char* str, size_t len);
   int ReadInt32s(int* val, int num);
@@ -45,9 +68,17 @@ public:
   vtkTypeInt64 Tell();
 
 protected:
+  bool Read(void* data, size_t len);
+  void Close();
+
   const int FileBufferSize;
   char* Buffer;
   istream* IStream;
+  istream* OwnedStream;
+
+  const unsigned char* MappedData;
+  vtkTypeInt64 MappedSize;
+  vtkTypeInt64 MappedPosition;
 
 private:
   vtkSpyPlotIStream(const vtkSpyPlotIStream&) = delete;
@@ -5,14 +5,20 @@
 #include "vtkFloatArray.h"
 #include "vtkIntArray.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkSpyPlotBlock.h"
 #include "vtkSpyPlotIStream.h"
 #include "vtkUnsignedCharArray.h"
 
-#include "vtksys/FStream.hxx"
 #include "vtksys/RegularExpression.hxx"
 
+#include <atomic>
+#include <cstring>
+#include <map>
 #include <sstream>
+#include <string>
+#include <utility>
 #include <vector>
 
 //=============================================================================
@@ -41,6 +47,144 @@ inline ostream& operator<<(ostream& os, const vtkSpyPlotWriteString& c)
   return os;
 }
 
+//-----------------------------------------------------------------------------
+// Keeps the last array decoded for each block of each variable, along with
+// its compressed planes, to reuse it when the block's compressed data is
+// identical in another time step, e.g. for material ids on static blocks.
+class vtkSpyPlotUniReader::vtkDecodedBlockCache
+{
+public:
+  struct Item
+  {
+    vtkSmartPointer<vtkDataArray> Array;
+    int PlaneSize = 0;
+    std::vector<int> PlaneBytes;
+    std::vector<unsigned char> Compressed;
+    bool GhostCellsFixed = false;
+
+    // Returns true if `planes` are identical to the planes the array was
+    // decoded from. Plane sizes are compared before the bytes.
+    bool Matches(const BlockPlanes& planes) const;
+
+    // Remembers the array decoded from `planes`, and a copy of the planes.
+    void Store(const BlockPlanes& planes);
+
+    // Returns a copy of the array and whether its bad ghost cells were
+    // removed already. Arrays whose ghost cells are not fixed yet are deep
+    // copied, since fixing them shrinks them in place, and the copy replaces
+    // the cached array.
+    vtkSmartPointer<vtkDataArray> Copy(int& ghostCellsFixed);
+  };
+
+  // Returns the entry of the block of a variable, adding an empty one if
+  // needed. Entries are not moved by adding other entries.
+  Item& Get(const char* name, int block)
+  {
+    return this->Items[std::make_pair(std::string(name), block)];
+  }
+
+  // Records that the bad ghost cells of the array last handed out for the
+  // block were removed.
+  void MarkGhostCellsFixed(const char* name, int block, vtkDataArray* array)
+  {
+    auto iter = this->Items.find(std::make_pair(std::string(name), block));
+    if (iter != this->Items.end() && iter->second.Array == array)
+    {
+      iter->second.GhostCellsFixed = true;
+    }
+  }
+
+  void Remove(const char* name)
+  {
+    auto iter = this->Items.lower_bound(std::make_pair(std::string(name), 0));
+    while (iter != this->Items.end() && iter->first.first == name)
+    {
+      iter = this->Items.erase(iter);
+    }
+  }
+
+  void Clear() { this->Items.clear(); }
+
+private:
+  std::map<std::pair<std::string, int>, Item> Items;
+};
+
+//-----------------------------------------------------------------------------
+// Run-length encoded planes of a block of a variable, and the array they
+// decode to. Planes point either in the memory mapped file or in Buffer.
+struct vtkSpyPlotUniReader::BlockPlanes
+{
+  vtkDataArray* Array = nullptr;
+  int PlaneSize = 0;
+  std::vector<const unsigned char*> Planes;
+  std::vector<int> PlaneBytes;
+  std::vector<unsigned char> Buffer;
+
+  // Where the variable keeps the array of the block and its ghost cells state.
+  vtkDataArray** DataBlock = nullptr;
+  int* GhostCellsFixed = nullptr;
+
+  // Entry of the decoded block cache, if any, and whether its array can be
+  // used instead of decoding the planes.
+  vtkDecodedBlockCache::Item* CacheItem = nullptr;
+  bool Cached = false;
+};
+
+//-----------------------------------------------------------------------------
+bool vtkSpyPlotUniReader::vtkDecodedBlockCache::Item::Matches(const BlockPlanes& planes) const
+{
+  if (!this->Array || this->Array->GetDataType() != planes.Array->GetDataType() ||
+    this->PlaneSize != planes.PlaneSize || this->PlaneBytes != planes.PlaneBytes)
+  {
+    return false;
+  }
+  const unsigned char* compressed = this->Compressed.data();
+  for (size_t cc = 0; cc < planes.Planes.size(); ++cc)
+  {
+    if (memcmp(compressed, planes.Planes[cc], planes.PlaneBytes[cc]) != 0)
+    {
+      return false;
+    }
+    compressed += planes.PlaneBytes[cc];
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+void vtkSpyPlotUniReader::vtkDecodedBlockCache::Item::Store(const BlockPlanes& planes)
+{
+  this->Array = planes.Array;
+  this->PlaneSize = planes.PlaneSize;
+  this->PlaneBytes = planes.PlaneBytes;
+  this->Compressed.clear();
+  for (size_t cc = 0; cc < planes.Planes.size(); ++cc)
+  {
+    this->Compressed.insert(
+      this->Compressed.end(), planes.Planes[cc], planes.Planes[cc] + planes.PlaneBytes[cc]);
+  }
+  this->GhostCellsFixed = false;
+}
+
+//-----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataArray> vtkSpyPlotUniReader::vtkDecodedBlockCache::Item::Copy(
+  int& ghostCellsFixed)
+{
+  vtkSmartPointer<vtkDataArray> copy;
+  copy.TakeReference(this->Array->NewInstance());
+  if (this->GhostCellsFixed)
+  {
+    copy->ShallowCopy(this->Array);
+  }
+  else
+  {
+    copy->DeepCopy(this->Array);
+    this->Array = copy;
+  }
+  copy->SetName(this->Array->GetName());
+  ghostCellsFixed = this->GhostCellsFixed ? 1 : 0;
+  return copy;
+}
+
 //-----------------------------------------------------------------------------
 vtkSpyPlotUniReader::vtkSpyPlotUniReader()
 {
@@ -91,11 +235,17 @@ vtkSpyPlotUniReader::vtkSpyPlotUniReader()
 
   this->MarkersOn = 0;
   this->GenerateMarkers = 1;
+
+  this->DecodedBlocks = new vtkDecodedBlockCache;
+  this->CacheDecodedBlocks = true;
+  this->UseMemoryMapping = true;
 }
 
 //-----------------------------------------------------------------------------
 vtkSpyPlotUniReader::~vtkSpyPlotUniReader()
 {
+  delete this->DecodedBlocks;
+
   // Cleanup header
   delete[] this->CellFields;
   delete[] this->MaterialFields;
@@ -184,6 +334,21 @@ int vtkSpyPlotUniReader::IsVolumeFraction(Variable* var)
   return re.find(var->Name) ? 1 : 0;
 }
 
+//-----------------------------------------------------------------------------
+void vtkSpyPlotUniReader::SetCacheDecodedBlocks(bool cache)
+{
+  if (this->CacheDecodedBlocks == cache)
+  {
+    return;
+  }
+  this->CacheDecodedBlocks = cache;
+  if (!cache)
+  {
+    this->DecodedBlocks->Clear();
+  }
+  this->Modified();
+}
+
 //-----------------------------------------------------------------------------
 void vtkSpyPlotUniReader::SetDownConvertVolumeFraction(int vf)
 {
@@ -215,9 +380,12 @@ int vtkSpyPlotUniReader::MakeCurrent()
   }
 
   std::vector<unsigned char> arrayBuffer;
-  vtksys::ifstream ifs(this->FileName, ios::binary | ios::in);
   vtkSpyPlotIStream spis;
-  spis.SetStream(&ifs);
+  if (!spis.Open(this->FileName, this->UseMemoryMapping))
+  {
+    vtkErrorMacro("Cannot open file: " << this->FileName);
+    return 0;
+  }
   int dump;
   vtkSpyPlotUniReader::DataDump* dp;
   int blocksUpdated = 0;
@@ -328,6 +496,7 @@ int vtkSpyPlotUniReader::MakeCurrent()
   dump = this->CurrentTimeStep;
   dp = this->DataDumps + dump;
 
+  std::vector<BlockPlanes> blocksToDecode;
   for (int fieldCnt = 0; fieldCnt < dp->NumVars; ++fieldCnt)
   {
     vtkSpyPlotUniReader::Variable* var = dp->Variables + fieldCnt;
@@ -363,6 +532,7 @@ int vtkSpyPlotUniReader::MakeCurrent()
       vtkDebugMacro(" *** Ignore variable: " << var->Name);
       if (!this->CellArraySelection->ArrayIsEnabled(var->Name))
       {
+        this->DecodedBlocks->Remove(var->Name);
         continue;
       }
     }
@@ -386,9 +556,8 @@ int vtkSpyPlotUniReader::MakeCurrent()
       continue;
     }
 
-    // vtkDebugMacro( "  Field: " << fieldCnt << " / " << dp->NumVars
-    // << " [" << var->Name << "]" );
-    // vtkDebugMacro( "    Jump to: " << dp->SavedVariableOffsets[fieldCnt] );
+    // Read the compressed planes of each block, to decode them in parallel
+    // once all variables have been read.
     spis.Seek(dp->SavedVariableOffsets[fieldCnt]);
     int numBytes;
     int block;
@@ -398,75 +567,133 @@ int vtkSpyPlotUniReader::MakeCurrent()
       vtkSpyPlotBlock* bk = this->Blocks + block;
       if (bk->IsAllocated())
       {
-        vtkFloatArray* floatArray = nullptr;
-        vtkUnsignedCharArray* unsignedCharArray = nullptr;
-        vtkDataArray* dataArray = nullptr;
-        if (this->CellArraySelection->ArrayIsEnabled(var->Name) && !var->DataBlocks[actualBlockId])
+        int zax;
+        int bdims[3];
+        bk->GetDimensions(bdims);
+        if (!this->CellArraySelection->ArrayIsEnabled(var->Name) || var->DataBlocks[actualBlockId])
         {
-          if (this->DownConvertVolumeFraction && this->IsVolumeFraction(var))
+          for (zax = 0; zax < bdims[2]; ++zax)
           {
-            unsignedCharArray = vtkUnsignedCharArray::New();
-            dataArray = unsignedCharArray;
-          }
-          else
-          {
-            floatArray = vtkFloatArray::New();
-            dataArray = floatArray;
+            if (!spis.ReadInt32s(&numBytes, 1))
+            {
+              vtkErrorMacro("Problem reading the number of bytes");
+              this->DecodedBlocks->Clear();
+              return 0;
+            }
+            spis.Seek(numBytes, true);
           }
-          dataArray->SetNumberOfComponents(1);
-          dataArray->SetNumberOfTuples(
-            bk->GetDimension(0) * bk->GetDimension(1) * bk->GetDimension(2));
-          dataArray->SetName(var->Name);
-          // vtkDebugMacro( "*** Create data array: "
-          // << dataArray->GetNumberOfTuples() );
+          actualBlockId++;
+          continue;
         }
-        int zax;
-        int bdims[3];
-        bk->GetDimensions(bdims);
+
+        vtkDataArray* dataArray = nullptr;
+        if (this->DownConvertVolumeFraction && this->IsVolumeFraction(var))
+        {
+          dataArray = vtkUnsignedCharArray::New();
+        }
+        else
+        {
+          dataArray = vtkFloatArray::New();
+        }
+        dataArray->SetNumberOfComponents(1);
+        dataArray->SetNumberOfTuples(bdims[0] * bdims[1] * bdims[2]);
+        dataArray->SetName(var->Name);
+
+        BlockPlanes planes;
+        planes.Array = dataArray;
+        planes.PlaneSize = bdims[0] * bdims[1];
         for (zax = 0; zax < bdims[2]; ++zax)
         {
-          int planeSize = bdims[0] * bdims[1];
-          if (!spis.ReadInt32s(&numBytes, 1))
+          if (!spis.ReadInt32s(&numBytes, 1) || numBytes < 0)
           {
             vtkErrorMacro("Problem reading the number of bytes");
+            dataArray->Delete();
+            this->DecodedBlocks->Clear();
             return 0;
           }
-          if (static_cast<int>(arrayBuffer.size()) < numBytes)
+          planes.PlaneBytes.push_back(numBytes);
+          const unsigned char* plane = spis.ReadMapped(numBytes);
+          if (!plane && !spis.IsMapped())
           {
-            arrayBuffer.resize(numBytes);
+            const size_t offset = planes.Buffer.size();
+            planes.Buffer.resize(offset + numBytes);
+            plane = spis.ReadString(planes.Buffer.data() + offset, numBytes)
+              ? planes.Buffer.data() + offset
+              : nullptr;
           }
-          if (!spis.ReadString(&*arrayBuffer.begin(), numBytes))
+          if (!plane)
           {
             vtkErrorMacro("Problem reading the bytes");
+            dataArray->Delete();
+            this->DecodedBlocks->Clear();
             return 0;
           }
-          if (floatArray)
-          {
-            float* ptr = floatArray->GetPointer(zax * planeSize);
-            if (!this->RunLengthDataDecode(&*arrayBuffer.begin(), numBytes, ptr, planeSize))
-            {
-              vtkErrorMacro("Problem RLD decoding float data array");
-              return 0;
-            }
-          }
-          if (unsignedCharArray)
+          planes.Planes.push_back(plane);
+        }
+        if (!planes.Buffer.empty())
+        {
+          // the buffer may have been reallocated while reading.
+          size_t offset = 0;
+          for (zax = 0; zax < bdims[2]; ++zax)
           {
-            unsigned char* ptr = unsignedCharArray->GetPointer(zax * planeSize);
-            if (!this->RunLengthDataDecode(&*arrayBuffer.begin(), numBytes, ptr, planeSize))
-            {
-              vtkErrorMacro("Problem RLD decoding unsigned char data array");
-              return 0;
-            }
+            planes.Planes[zax] = planes.Buffer.data() + offset;
+            offset += planes.PlaneBytes[zax];
           }
         }
-        if (dataArray)
+
+        planes.DataBlock = var->DataBlocks + actualBlockId;
+        planes.GhostCellsFixed = var->GhostCellsFixed + actualBlockId;
+        if (this->CacheDecodedBlocks)
+        {
+          planes.CacheItem = &this->DecodedBlocks->Get(var->Name, actualBlockId);
+        }
+        blocksToDecode.push_back(std::move(planes));
+        var->DataBlocks[actualBlockId] = dataArray;
+        vtkDebugMacro(" " << dataArray << " initialized: " << dataArray->GetName());
+        actualBlockId++;
+      }
+    }
+  }
+
+  // Blocks identical to the ones last decoded are compared, and the others
+  // decoded, concurrently. Each block only touches its own cache entry.
+  std::atomic<bool> decoded(true);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(blocksToDecode.size()),
+    [&](vtkIdType first, vtkIdType last) {
+      for (vtkIdType cc = first; cc < last && decoded; ++cc)
+      {
+        BlockPlanes& planes = blocksToDecode[cc];
+        if (planes.CacheItem && planes.CacheItem->Matches(planes))
         {
-          var->DataBlocks[actualBlockId] = dataArray;
-          var->GhostCellsFixed[actualBlockId] = 0;
-          vtkDebugMacro(" " << dataArray << " initialized: " << dataArray->GetName());
-          actualBlockId++;
+          planes.Cached = true;
+        }
+        else if (!this->DecodeBlockPlanes(planes))
+        {
+          decoded = false;
+        }
+        else if (planes.CacheItem)
+        {
+          planes.CacheItem->Store(planes);
         }
       }
+    });
+  if (!decoded)
+  {
+    vtkErrorMacro("Problem RLD decoding data array");
+    this->DecodedBlocks->Clear();
+    return 0;
+  }
+
+  for (auto& planes : blocksToDecode)
+  {
+    if (planes.Cached)
+    {
+      // Identical to the block last decoded, possibly with its bad ghost
+      // cells removed already.
+      vtkSmartPointer<vtkDataArray> dataArray = planes.CacheItem->Copy(*planes.GhostCellsFixed);
+      dataArray->Register(this);
+      planes.Array->Delete();
+      *planes.DataBlock = dataArray;
     }
   }
 
@@ -747,6 +974,30 @@ int vtkSpyPlotUniReader::RunLengthDataDecode(
     this, in, inSize, out, outSize, static_cast<unsigned char>(255));
 }
 
+//-----------------------------------------------------------------------------
+int vtkSpyPlotUniReader::DecodeBlockPlanes(const BlockPlanes& planes)
+{
+  vtkFloatArray* floatArray = vtkFloatArray::SafeDownCast(planes.Array);
+  vtkUnsignedCharArray* unsignedCharArray = vtkUnsignedCharArray::SafeDownCast(planes.Array);
+  for (size_t zax = 0; zax < planes.Planes.size(); ++zax)
+  {
+    const vtkIdType offset = static_cast<vtkIdType>(zax) * planes.PlaneSize;
+    if (floatArray &&
+      !this->RunLengthDataDecode(planes.Planes[zax], planes.PlaneBytes[zax],
+        floatArray->GetPointer(offset), planes.PlaneSize))
+    {
+      return 0;
+    }
+    if (unsignedCharArray &&
+      !this->RunLengthDataDecode(planes.Planes[zax], planes.PlaneBytes[zax],
+        unsignedCharArray->GetPointer(offset), planes.PlaneSize))
+    {
+      return 0;
+    }
+  }
+  return 1;
+}
+
 //-----------------------------------------------------------------------------
 int vtkSpyPlotUniReader::SetCurrentTime(double time)
 {
@@ -975,6 +1226,7 @@ int vtkSpyPlotUniReader::MarkCellFieldDataFixed(int block, int field)
     return 0;
   }
   var->GhostCellsFixed[block] = 1;
+  this->DecodedBlocks->MarkGhostCellsFixed(var->Name, block, var->DataBlocks[block]);
   vtkDebugMacro(" " << var->DataBlocks[block] << " fixed: " << var->DataBlocks[block]->GetName());
   return 1;
 }
@@ -1340,6 +1592,8 @@ void vtkSpyPlotUniReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "DataTypeChanged: " << this->DataTypeChanged << endl;
   os << indent << "NumberOfCellFields: " << this->NumberOfCellFields << endl;
   os << indent << "NeedToCheck: " << this->NeedToCheck << endl;
+  os << indent << "CacheDecodedBlocks: " << this->CacheDecodedBlocks << endl;
+  os << indent << "UseMemoryMapping: " << this->UseMemoryMapping << endl;
 }
 
 //-----------------------------------------------------------------------------
@@ -1361,14 +1615,12 @@ int vtkSpyPlotUniReader::ReadInformation()
     vtkErrorMacro("FileName not specified");
     return 0;
   }
-  vtksys::ifstream ifs(this->FileName, ios::binary | ios::in);
-  if (!ifs)
+  vtkSpyPlotIStream spis;
+  if (!spis.Open(this->FileName, this->UseMemoryMapping))
   {
     vtkErrorMacro("Cannot open file: " << this->FileName);
     return 0;
   }
-  vtkSpyPlotIStream spis;
-  spis.SetStream(&ifs);
 
   if (!this->ReadHeader(&spis))
   {
@@ -233,6 +233,25 @@ public:
   vtkSetMacro(DataTypeChanged, int);
   void SetDownConvertVolumeFraction(int vf);
 
+  //@{
+  /**
+   * When set, the file is memory mapped, when supported, instead of being
+   * read through a stream. Default is true.
+   */
+  vtkSetMacro(UseMemoryMapping, bool);
+  vtkGetMacro(UseMemoryMapping, bool);
+  //@}
+
+  //@{
+  /**
+   * When set, the last array decoded for each block of each variable is
+   * reused for later time steps with identical compressed data, instead of
+   * being decoded again. Default is true.
+   */
+  void SetCacheDecodedBlocks(bool cache);
+  vtkGetMacro(CacheDecodedBlocks, bool);
+  //@}
+
 protected:
   vtkSpyPlotUniReader();
   ~vtkSpyPlotUniReader() override;
@@ -243,6 +262,10 @@ private:
   int RunLengthDataDecode(const unsigned char* in, int inSize, int* out, int outSize);
   int RunLengthDataDecode(const unsigned char* in, int inSize, unsigned char* out, int outSize);
 
+  // Decodes the planes of a block read by MakeCurrent
+  struct BlockPlanes;
+  int DecodeBlockPlanes(const BlockPlanes& planes);
+
   int ReadHeader(vtkSpyPlotIStream* spis);
   int ReadMarkerHeader(vtkSpyPlotIStream* spis);
   int ReadCellVariableInfo(vtkSpyPlotIStream* spis);
@@ -313,6 +336,14 @@ private:
 
   vtkDataArraySelection* CellArraySelection;
 
+  // Last decoded array of each block of each variable, reused when the
+  // compressed data of the block does not change between time steps
+  class vtkDecodedBlockCache;
+  vtkDecodedBlockCache* DecodedBlocks;
+  bool CacheDecodedBlocks;
+
+  bool UseMemoryMapping;
+
   Variable* GetCellField(int field);
   int IsVolumeFraction(Variable* var);
 
@@ -41,7 +41,10 @@
 #include "vtkUnsignedIntArray.h"
 #include "vtkUnsignedShortArray.h"
 
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <functional>
 #include <map>
 #include <string>
 #include <vector>
@@ -431,6 +434,174 @@ inline int vtkExtractHistogramClamp(int value, int min, int max)
   return value;
 }
 
+//-----------------------------------------------------------------------------
+namespace
+{
+// Bins the values of an array, and accumulates the per-bin totals of other
+// arrays, using thread-local bins which are summed once done.
+template <typename ArrayT>
+class BinArrayFunctor
+{
+public:
+  BinArrayFunctor(ArrayT* array, int component, vtkUnsignedCharArray* ghostArray,
+    unsigned char hiddenFlag, double min, double binDelta, double shift, int binCount,
+    const std::vector<vtkDataArray*>& averageArrays)
+    : Array(array)
+    , Component(component)
+    , GhostArray(ghostArray)
+    , HiddenFlag(hiddenFlag)
+    , Min(min)
+    , BinDelta(binDelta)
+    , Shift(shift)
+    , BinCount(binCount)
+    , AverageArrays(averageArrays)
+  {
+  }
+
+  // The array may be binned in several passes, the bins then accumulate over
+  // the passes.
+  void Initialize()
+  {
+    auto& bins = this->TLBins.Local();
+    if (!bins.empty())
+    {
+      return;
+    }
+    bins.assign(this->BinCount, 0);
+    auto& totals = this->TLTotals.Local();
+    totals.resize(this->AverageArrays.size());
+    for (size_t cc = 0; cc < this->AverageArrays.size(); ++cc)
+    {
+      totals[cc].assign(
+        static_cast<size_t>(this->BinCount) * this->AverageArrays[cc]->GetNumberOfComponents(),
+        0.0);
+    }
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    auto& bins = this->TLBins.Local();
+    auto& totals = this->TLTotals.Local();
+    const auto tuples = vtk::DataArrayTupleRange(this->Array, begin, end);
+    const bool computeMagnitude = this->Component == this->Array->GetNumberOfComponents();
+
+    vtkIdType tupleIdx = begin;
+    for (const auto tuple : tuples)
+    {
+      const vtkIdType idx = tupleIdx++;
+
+      // Skip if the array value is blanked.
+      if (this->GhostArray && (this->GhostArray->GetValue(idx) & this->HiddenFlag))
+      {
+        continue;
+      }
+
+      double value;
+      // if component is equal to the number of components, then the magnitude was requested.
+      if (computeMagnitude)
+      {
+        value = std::sqrt(static_cast<double>(vtkMath::SquaredNorm(tuple)));
+      }
+      else
+      {
+        value = static_cast<double>(tuple[this->Component]);
+      }
+      int index = static_cast<int>((value - this->Min + this->Shift) / this->BinDelta);
+
+      // If the value is equal to max, include it in the last bin.
+      index = ::vtkExtractHistogramClamp(index, 0, this->BinCount - 1);
+      ++bins[index];
+
+      for (size_t cc = 0; cc < this->AverageArrays.size(); ++cc)
+      {
+        vtkDataArray* array = this->AverageArrays[cc];
+        const int numComps = array->GetNumberOfComponents();
+        double* total = &totals[cc][static_cast<size_t>(index) * numComps];
+        for (int comp = 0; comp < numComps; ++comp)
+        {
+          total[comp] += array->GetComponent(idx, comp);
+        }
+      }
+    }
+  }
+
+  void Reduce()
+  {
+    this->Bins.assign(this->BinCount, 0);
+    this->Totals.resize(this->AverageArrays.size());
+    for (size_t cc = 0; cc < this->AverageArrays.size(); ++cc)
+    {
+      this->Totals[cc].assign(
+        static_cast<size_t>(this->BinCount) * this->AverageArrays[cc]->GetNumberOfComponents(),
+        0.0);
+    }
+
+    for (auto iter = this->TLBins.begin(); iter != this->TLBins.end(); ++iter)
+    {
+      std::transform(
+        iter->begin(), iter->end(), this->Bins.begin(), this->Bins.begin(), std::plus<vtkIdType>());
+    }
+    for (auto iter = this->TLTotals.begin(); iter != this->TLTotals.end(); ++iter)
+    {
+      for (size_t cc = 0; cc < iter->size(); ++cc)
+      {
+        std::transform((*iter)[cc].begin(), (*iter)[cc].end(), this->Totals[cc].begin(),
+          this->Totals[cc].begin(), std::plus<double>());
+      }
+    }
+  }
+
+  std::vector<vtkIdType> Bins;
+  std::vector<std::vector<double> > Totals;
+
+private:
+  ArrayT* Array;
+  int Component;
+  vtkUnsignedCharArray* GhostArray;
+  unsigned char HiddenFlag;
+  double Min;
+  double BinDelta;
+  double Shift;
+  int BinCount;
+  const std::vector<vtkDataArray*>& AverageArrays;
+  vtkSMPThreadLocal<std::vector<vtkIdType> > TLBins;
+  vtkSMPThreadLocal<std::vector<std::vector<double> > > TLTotals;
+};
+
+// Functor for array dispatch
+struct BinArrayWorker
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* array, int component, vtkUnsignedCharArray* ghostArray,
+    unsigned char hiddenFlag, double min, double binDelta, double shift, int binCount,
+    const std::vector<vtkDataArray*>& averageArrays, vtkAlgorithm* self)
+  {
+    BinArrayFunctor<ArrayT> functor(
+      array, component, ghostArray, hiddenFlag, min, binDelta, shift, binCount, averageArrays);
+    // Bin the array in a few passes so that progress is reported from the
+    // calling thread in between.
+    const vtkIdType numTuples = array->GetNumberOfTuples();
+    const vtkIdType passSize = std::max<vtkIdType>(numTuples / 10, 1);
+    if (numTuples == 0)
+    {
+      // no pass below, zero the bins and totals explicitly.
+      functor.Reduce();
+    }
+    for (vtkIdType begin = 0; begin < numTuples; begin += passSize)
+    {
+      const vtkIdType end = std::min(begin + passSize, numTuples);
+      vtkSMPTools::For(begin, end, functor);
+      self->UpdateProgress(0.10 + 0.90 * end / numTuples);
+    }
+    this->Bins = std::move(functor.Bins);
+    this->Totals = std::move(functor.Totals);
+  }
+
+  std::vector<vtkIdType> Bins;
+  std::vector<std::vector<double> > Totals;
+};
+}
+
 //-----------------------------------------------------------------------------
 void vtkExtractHistogram::BinAnArray(
   vtkDataArray* data_array, vtkIntArray* bin_values, double min, double max, vtkFieldData* field)
@@ -443,7 +614,6 @@ void vtkExtractHistogram::BinAnArray(
     return;
   }
 
-  int num_of_tuples = data_array->GetNumberOfTuples();
   double bin_delta =
     (max - min) / (this->CenterBinsAroundMinAndMax ? (this->BinCount - 1) : this->BinCount);
   double half_delta = bin_delta / 2.0;
@@ -460,68 +630,63 @@ void vtkExtractHistogram::BinAnArray(
     ? (vtkDataSetAttributes::HIDDENPOINT | vtkDataSetAttributes::DUPLICATEPOINT)
     : (vtkDataSetAttributes::HIDDENCELL | vtkDataSetAttributes::DUPLICATECELL);
 
-  for (int i = 0; i != num_of_tuples; ++i)
+  // Get all other arrays, their values are added to the bins to compute the
+  // averages.
+  std::vector<vtkDataArray*> averageArrays;
+  if (this->CalculateAverages)
   {
-    if (i % 1000 == 0)
+    int num_arrays = field->GetNumberOfArrays();
+    for (int idx = 0; idx < num_arrays; idx++)
     {
-      this->UpdateProgress(0.10 + 0.90 * i / num_of_tuples);
-    }
-
-    // Skip if the array value is blanked.
-    if (blanking && blanking->GetTypedComponent(i, 0) & ghostIndicator)
-    {
-      continue;
-    }
-
-    double value;
-    // if component is equal to the number of components, then the magnitude was requested.
-    if (this->Component == data_array->GetNumberOfComponents())
-    {
-      value = 0;
-      double comp;
-      for (int j = 0; j < data_array->GetNumberOfComponents(); ++j)
+      vtkDataArray* array = field->GetArray(idx);
+      if (array && array != data_array && array->GetName())
       {
-        comp = data_array->GetComponent(i, j);
-        value += comp * comp;
+        averageArrays.push_back(array);
       }
-      value = sqrt(value);
     }
-    else
-    {
-      value = data_array->GetComponent(i, this->Component);
-    }
-    int index = static_cast<int>(
-      (value - min + (this->CenterBinsAroundMinAndMax ? half_delta : 0.)) / bin_delta);
+  }
 
-    // If the value is equal to max, include it in the last bin.
-    index = ::vtkExtractHistogramClamp(index, 0, this->BinCount - 1);
-    bin_values->SetValue(index, bin_values->GetValue(index) + 1);
+  using FastArrayTypes = vtkTypeList::Unique<
+    vtkTypeList::Create<vtkCharArray, vtkShortArray, vtkIntArray, vtkUnsignedCharArray,
+      vtkUnsignedShortArray, vtkUnsignedIntArray, vtkFloatArray, vtkDoubleArray> >::Result;
+  using BinArrayWorkerDispatch = vtkArrayDispatch::DispatchByArray<FastArrayTypes>;
+  BinArrayWorker worker;
+  const double shift = this->CenterBinsAroundMinAndMax ? half_delta : 0.;
+  if (!BinArrayWorkerDispatch::Execute(data_array, worker, this->Component, blanking,
+        ghostIndicator, min, bin_delta, shift, this->BinCount, averageArrays, this))
+  {
+    worker(data_array, this->Component, blanking, ghostIndicator, min, bin_delta, shift,
+      this->BinCount, averageArrays, this);
+  }
+
+  for (int bin = 0; bin < this->BinCount; ++bin)
+  {
+    bin_values->SetValue(bin, bin_values->GetValue(bin) + static_cast<int>(worker.Bins[bin]));
+  }
 
-    if (this->CalculateAverages)
+  // For each bin, we will need 2 values per array -> total, num. elements
+  // at the end, divide each total by num. elements
+  for (size_t cc = 0; cc < averageArrays.size(); ++cc)
+  {
+    vtkEHInternals::ArrayValuesType& arrayValues =
+      this->Internal->ArrayValues[averageArrays[cc]->GetName()];
+    arrayValues.TotalValues.resize(this->BinCount);
+    const int numComps = averageArrays[cc]->GetNumberOfComponents();
+    for (int bin = 0; bin < this->BinCount; ++bin)
     {
-      // Get all other arrays, add their value to the bin
-      // For each bin, we will need 2 values per array ->
-      // total, num. elements
-      // at the end, divide each total by num. elements
-      int num_arrays = field->GetNumberOfArrays();
-      for (int idx = 0; idx < num_arrays; idx++)
+      if (worker.Bins[bin] == 0)
       {
-        vtkDataArray* array = field->GetArray(idx);
-        if (array && array != data_array && array->GetName())
-        {
-          vtkEHInternals::ArrayValuesType& arrayValues =
-            this->Internal->ArrayValues[array->GetName()];
-          arrayValues.TotalValues.resize(this->BinCount);
-          int numComps = array->GetNumberOfComponents();
-          arrayValues.TotalValues[index].resize(numComps);
-          for (int comp = 0; comp < numComps; comp++)
-          {
-            arrayValues.TotalValues[index][comp] += array->GetComponent(i, comp);
-          }
-        }
+        continue;
+      }
+      arrayValues.TotalValues[bin].resize(numComps);
+      for (int comp = 0; comp < numComps; comp++)
+      {
+        arrayValues.TotalValues[bin][comp] +=
+          worker.Totals[cc][static_cast<size_t>(bin) * numComps + comp];
       }
     }
   }
+  this->UpdateProgress(1.0);
 }
 
 //-----------------------------------------------------------------------------
@@ -29,7 +29,10 @@
 #include "vtkSmartPointer.h"
 #include "vtkTable.h"
 
+#include <algorithm>
+#include <functional>
 #include <string>
+#include <vector>
 #include <vtksys/RegularExpression.hxx>
 
 vtkStandardNewMacro(vtkPExtractHistogram);
@@ -61,12 +64,14 @@ bool vtkPExtractHistogram::GetInputArrayRange(vtkInformationVector** inputVector
   // return value in this call.
   this->Superclass::GetInputArrayRange(inputVector, local_range);
 
-  if (!this->Controller->AllReduce(&local_range[0], &range[0], 1, vtkCommunicator::MIN_OP) ||
-    !this->Controller->AllReduce(&local_range[1], &range[1], 1, vtkCommunicator::MAX_OP))
+  // negate the max so that both ends are reduced in a single call.
+  local_range[1] = -local_range[1];
+  if (!this->Controller->AllReduce(local_range, range, 2, vtkCommunicator::MIN_OP))
   {
     vtkErrorMacro("Parallel communication error. Could not reduce ranges.");
     return false;
   }
+  range[1] = -range[1];
 
   return true;
 }
@@ -94,61 +99,15 @@ int vtkPExtractHistogram::RequestData(
       // Nothing to do if there is no data
       return 1;
     }
-    // Now we need to collect and reduce data from all nodes on the root.
-    vtkSmartPointer<vtkReductionFilter> reduceFilter = vtkSmartPointer<vtkReductionFilter>::New();
-    reduceFilter->SetController(this->Controller);
-
-    if (isRoot)
+    // a communication failure may leave ranks at different stages, hence
+    // falling back to reducing tables could mismatch collective calls.
+    const ReduceBinsStatus status = this->ReduceBins(output);
+    if (status == REDUCE_BINS_FAILED ||
+      (status == REDUCE_BINS_MISMATCHED && !this->ReduceTables(output)))
     {
-      // PostGatherHelper needs to be set only on the root node.
-      vtkSmartPointer<vtkAttributeDataReductionFilter> rf =
-        vtkSmartPointer<vtkAttributeDataReductionFilter>::New();
-      rf->SetAttributeType(vtkAttributeDataReductionFilter::ROW_DATA);
-      rf->SetReductionType(vtkAttributeDataReductionFilter::ADD);
-      reduceFilter->SetPostGatherHelper(rf);
-    }
-
-    vtkSmartPointer<vtkTable> copy = vtkSmartPointer<vtkTable>::New();
-    copy->ShallowCopy(output);
-    reduceFilter->SetInputData(copy);
-    reduceFilter->Update();
-    if (isRoot)
-    {
-      // We save the old bin_extents and then revert to be restored later since
-      // the reduction reduces the bin_extents as well.
-      output->ShallowCopy(reduceFilter->GetOutput());
-      if (output->GetRowData()->GetNumberOfArrays() == 0)
-      {
-        vtkErrorMacro(<< "Reduced data has 0 arrays");
-        return 0;
-      }
-      output->GetRowData()->GetArray("bin_extents")->DeepCopy(oldExtents);
-      if (this->CalculateAverages)
-      {
-        vtkDataArray* bin_values = output->GetRowData()->GetArray("bin_values");
-        vtksys::RegularExpression reg_ex("^(.*)_average$");
-        int numArrays = output->GetRowData()->GetNumberOfArrays();
-        for (int i = 0; i < numArrays; i++)
-        {
-          vtkDataArray* array = output->GetRowData()->GetArray(i);
-          if (array && reg_ex.find(array->GetName()))
-          {
-            int numComps = array->GetNumberOfComponents();
-            std::string name = reg_ex.match(1) + "_total";
-            vtkDataArray* tarray = output->GetRowData()->GetArray(name.c_str());
-            for (vtkIdType idx = 0; idx < this->BinCount; idx++)
-            {
-              for (int j = 0; j < numComps; j++)
-              {
-                array->SetComponent(
-                  idx, j, tarray->GetComponent(idx, j) / bin_values->GetTuple1(idx));
-              }
-            }
-          }
-        }
-      }
+      return 0;
     }
-    else
+    if (!isRoot)
     {
       output->Initialize();
     }
@@ -185,6 +144,166 @@ int vtkPExtractHistogram::RequestData(
   return 1;
 }
 
+//-----------------------------------------------------------------------------
+vtkPExtractHistogram::ReduceBinsStatus vtkPExtractHistogram::ReduceBins(vtkTable* output)
+{
+  // The bin values and the per-bin totals are reduced together, hence all
+  // ranks must agree on these arrays. Their names and sizes are checked
+  // using a signature first. Ranks without bin values still take part in
+  // the reductions, contributing zeros.
+  const bool isRoot = (this->Controller->GetLocalProcessId() == 0);
+  std::vector<vtkDataArray*> arrays;
+  vtkDataArray* binValues = output->GetRowData()->GetArray("bin_values");
+  if (binValues)
+  {
+    arrays.push_back(binValues);
+    vtksys::RegularExpression reg_ex("^(.*)_total$");
+    const int numArrays = output->GetRowData()->GetNumberOfArrays();
+    for (int i = 0; i < numArrays; i++)
+    {
+      vtkDataArray* array = output->GetRowData()->GetArray(i);
+      if (array && array->GetName() && reg_ex.find(array->GetName()))
+      {
+        arrays.push_back(array);
+      }
+    }
+  }
+  std::string signature;
+  vtkIdType bufferSize = 0;
+  for (auto array : arrays)
+  {
+    signature += std::string(array->GetName()) + ":" +
+      std::to_string(array->GetNumberOfComponents()) + ";";
+    bufferSize += array->GetNumberOfValues();
+  }
+
+  // The maximum of the negated values is the opposite of the minimum, ranks
+  // without bin values contribute the lowest values so that they do not
+  // change the result. The root needs the arrays to hold the result.
+  const vtkIdType hash =
+    static_cast<vtkIdType>(std::hash<std::string>()(signature) % static_cast<size_t>(VTK_ID_MAX));
+  vtkIdType localSignature[5] = { bufferSize, hash, -bufferSize, -hash, 0 };
+  if (!binValues)
+  {
+    localSignature[0] = localSignature[1] = 0;
+    localSignature[2] = localSignature[3] = -VTK_ID_MAX;
+    localSignature[4] = isRoot ? 1 : 0;
+  }
+  vtkIdType globalSignature[5];
+  if (!this->Controller->AllReduce(localSignature, globalSignature, 5, vtkCommunicator::MAX_OP))
+  {
+    vtkErrorMacro("Parallel communication error. Could not reduce histogram signatures.");
+    return REDUCE_BINS_FAILED;
+  }
+  if (globalSignature[0] != -globalSignature[2] || globalSignature[1] != -globalSignature[3] ||
+    globalSignature[4] != 0)
+  {
+    vtkDebugMacro("Ranks have different histogram arrays, reducing tables instead.");
+    return REDUCE_BINS_MISMATCHED;
+  }
+  bufferSize = globalSignature[0];
+
+  std::vector<double> localBuffer(static_cast<size_t>(bufferSize), 0.0);
+  auto iter = localBuffer.begin();
+  for (auto array : arrays)
+  {
+    const auto range = vtk::DataArrayValueRange(array);
+    iter = std::copy(range.begin(), range.end(), iter);
+  }
+
+  std::vector<double> globalBuffer(isRoot ? localBuffer.size() : 0);
+  if (!this->Controller->Reduce(
+        localBuffer.data(), globalBuffer.data(), bufferSize, vtkCommunicator::SUM_OP, 0))
+  {
+    vtkErrorMacro("Parallel communication error. Could not reduce histogram.");
+    return REDUCE_BINS_FAILED;
+  }
+
+  if (isRoot)
+  {
+    auto globalIter = globalBuffer.cbegin();
+    for (auto array : arrays)
+    {
+      auto range = vtk::DataArrayValueRange(array);
+      std::copy(globalIter, globalIter + range.size(), range.begin());
+      globalIter += range.size();
+    }
+    if (this->CalculateAverages)
+    {
+      this->ComputeAverages(output);
+    }
+  }
+  return REDUCE_BINS_SUCCEEDED;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkPExtractHistogram::ReduceTables(vtkTable* output)
+{
+  bool isRoot = (this->Controller->GetLocalProcessId() == 0);
+  vtkSmartPointer<vtkDataArray> oldExtents = output->GetRowData()->GetArray("bin_extents");
+
+  // Now we need to collect and reduce data from all nodes on the root.
+  vtkSmartPointer<vtkReductionFilter> reduceFilter = vtkSmartPointer<vtkReductionFilter>::New();
+  reduceFilter->SetController(this->Controller);
+
+  if (isRoot)
+  {
+    // PostGatherHelper needs to be set only on the root node.
+    vtkSmartPointer<vtkAttributeDataReductionFilter> rf =
+      vtkSmartPointer<vtkAttributeDataReductionFilter>::New();
+    rf->SetAttributeType(vtkAttributeDataReductionFilter::ROW_DATA);
+    rf->SetReductionType(vtkAttributeDataReductionFilter::ADD);
+    reduceFilter->SetPostGatherHelper(rf);
+  }
+
+  vtkSmartPointer<vtkTable> copy = vtkSmartPointer<vtkTable>::New();
+  copy->ShallowCopy(output);
+  reduceFilter->SetInputData(copy);
+  reduceFilter->Update();
+  if (isRoot)
+  {
+    // We save the old bin_extents and then revert to be restored later since
+    // the reduction reduces the bin_extents as well.
+    output->ShallowCopy(reduceFilter->GetOutput());
+    if (output->GetRowData()->GetNumberOfArrays() == 0)
+    {
+      vtkErrorMacro(<< "Reduced data has 0 arrays");
+      return false;
+    }
+    output->GetRowData()->GetArray("bin_extents")->DeepCopy(oldExtents);
+    if (this->CalculateAverages)
+    {
+      this->ComputeAverages(output);
+    }
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+void vtkPExtractHistogram::ComputeAverages(vtkTable* output)
+{
+  vtkDataArray* bin_values = output->GetRowData()->GetArray("bin_values");
+  vtksys::RegularExpression reg_ex("^(.*)_average$");
+  int numArrays = output->GetRowData()->GetNumberOfArrays();
+  for (int i = 0; i < numArrays; i++)
+  {
+    vtkDataArray* array = output->GetRowData()->GetArray(i);
+    if (array && reg_ex.find(array->GetName()))
+    {
+      int numComps = array->GetNumberOfComponents();
+      std::string name = reg_ex.match(1) + "_total";
+      vtkDataArray* tarray = output->GetRowData()->GetArray(name.c_str());
+      for (vtkIdType idx = 0; idx < this->BinCount; idx++)
+      {
+        for (int j = 0; j < numComps; j++)
+        {
+          array->SetComponent(idx, j, tarray->GetComponent(idx, j) / bin_values->GetTuple1(idx));
+        }
+      }
+    }
+  }
+}
+
 //-----------------------------------------------------------------------------
 void vtkPExtractHistogram::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -27,6 +27,7 @@
 #include "vtkPVVTKExtensionsMiscModule.h" //needed for exports
 
 class vtkMultiProcessController;
+class vtkTable;
 
 class VTKPVVTKEXTENSIONSMISC_EXPORT vtkPExtractHistogram : public vtkExtractHistogram
 {
@@ -64,6 +65,34 @@ protected:
   int RequestData(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector) override;
 
+  enum ReduceBinsStatus
+  {
+    REDUCE_BINS_SUCCEEDED,
+    REDUCE_BINS_MISMATCHED,
+    REDUCE_BINS_FAILED
+  };
+
+  /**
+   * Reduces the bin values and the per-bin totals on the root using a single
+   * reduction over a contiguous buffer. Returns REDUCE_BINS_MISMATCHED, on all
+   * ranks and without doing any reduction, if the ranks do not agree on the
+   * arrays to reduce, and REDUCE_BINS_FAILED if the communication failed.
+   */
+  ReduceBinsStatus ReduceBins(vtkTable* output);
+
+  /**
+   * Reduces the histogram tables on the root using vtkReductionFilter. This is
+   * used when the ranks do not agree on the arrays to reduce. Returns false on
+   * failure.
+   */
+  bool ReduceTables(vtkTable* output);
+
+  /**
+   * Computes the `*_average` arrays from the `*_total` arrays and the bin
+   * values.
+   */
+  void ComputeAverages(vtkTable* output);
+
   vtkMultiProcessController* Controller;
   bool Normalize = false;
 
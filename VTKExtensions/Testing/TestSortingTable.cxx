@@ -24,7 +24,9 @@
 #include "vtkTestUtilities.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
 #include <cfloat>
+#include <vector>
 // ----------------------------------------------------------------------------
 void fillArray(vtkDoubleArray* array, double* dataPointer, int dataSize, const char* name)
 {
@@ -164,6 +166,60 @@ int sortMagnitudeOnUnsignedCharVector()
   return EXIT_SUCCESS;
 }
 
+// ----------------------------------------------------------------------------
+// Request every block, in both orders, and make sure that together they
+// match the sorted data.
+int sortByBlocks(bool debug)
+{
+  const int size = 10000;
+  const int blockSize = 128;
+  std::vector<double> dataArray(size);
+  for (int i = 0; i < size; i++)
+  {
+    dataArray[i] = (i * 7919) % 1000; // many similar values
+  }
+
+  vtkSmartPointer<vtkDoubleArray> dataToSort = vtkSmartPointer<vtkDoubleArray>::New();
+  fillArray(dataToSort.GetPointer(), &dataArray[0], size, "data");
+
+  vtkSmartPointer<vtkTable> input = vtkSmartPointer<vtkTable>::New();
+  input->AddColumn(dataToSort);
+  vtkSmartPointer<vtkSortedTableStreamer> sortingfilter =
+    vtkSmartPointer<vtkSortedTableStreamer>::New();
+
+  sortingfilter->SetInputData(input.GetPointer());
+  sortingfilter->SetSelectedComponent(0);
+  sortingfilter->SetColumnNameToSort("data");
+  sortingfilter->SetBlockSize(blockSize);
+
+  for (int invert = 0; invert < 2; invert++)
+  {
+    std::vector<double> sortedArray(dataArray);
+    std::sort(sortedArray.begin(), sortedArray.end());
+    if (invert)
+    {
+      std::reverse(sortedArray.begin(), sortedArray.end());
+    }
+
+    sortingfilter->SetInvertOrder(invert);
+    const int nbBlocks = (size + blockSize - 1) / blockSize;
+    for (int block = nbBlocks - 1; block >= 0; block--)
+    {
+      sortingfilter->SetBlock(block);
+      sortingfilter->Update();
+      const int offset = block * blockSize;
+      const int count = std::min(blockSize, size - offset);
+      if (!compareArray(sortingfilter->GetOutput(), "data", &sortedArray[offset], count, debug))
+      {
+        cout << "Invalid block " << block << (invert ? " (inverted order)" : "") << endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
 // ----------------------------------------------------------------------------
 int TestSortingTable(int vtkNotUsed(argc), char** vtkNotUsed(argv))
 {
@@ -183,6 +239,9 @@ int TestSortingTable(int vtkNotUsed(argc), char** vtkNotUsed(argv))
   cout << "Testing sorting with magnitude on unsigned char: "
        << ((result += sortMagnitudeOnUnsignedCharVector()) ? "FAILED" : "SUCCESS") << endl;
   // --------------------------------------------------------------------------
+  cout << "Testing sorting by blocks: "
+       << ((result += sortByBlocks(debug)) ? "FAILED" : "SUCCESS") << endl;
+  // --------------------------------------------------------------------------
   // --------------------------------------------------------------------------
 
   // Delete Fake MPI controller